@@ -111,12 +111,18 @@ public:
 	bool satisfiedBy(const RealAlgebraicPoint<Number>& r, const std::vector<Variable>& _variables) const {
 		assert(_variables.size() == r.dim());
 		
-		auto res = RealAlgebraicNumberEvaluation::evaluate(this->polynomial, r, _variables);
-		CARL_LOG_DEBUG("carl.cad.constraint", *this << " evaluates to " << res << " on " << r);
+		Sign s;
+		if (RealAlgebraicNumberEvaluation::evaluateSign(this->polynomial, r, _variables, s)) {
+			CARL_LOG_DEBUG("carl.cad.constraint", *this << " has sign " << s << " on " << r);
+		} else {
+			auto res = RealAlgebraicNumberEvaluation::evaluate(this->polynomial, r, _variables);
+			CARL_LOG_DEBUG("carl.cad.constraint", *this << " evaluates to " << res << " on " << r);
+			s = res.sgn();
+		}
 		if (this->negated) {
-			return res.sgn() != this->sign;
+			return s != this->sign;
 		} else {
-			return res.sgn() == this->sign;
+			return s == this->sign;
 		}
 	}
 
@@ -0,0 +1,10 @@
+/**
+ * Auto generated file config.h from config.h.in.
+ */ 
+#pragma once
+
+#define CARL_BUILD_DEBUG
+/* #undef LOGGING */
+/* #undef LOGGING_DISABLE_INEFFICIENT */
+/* #undef THREAD_SAFE */
+/* #undef USE_COCOA */
@@ -0,0 +1,134 @@
+/**
+ * @file CoprimeBase.h
+ *
+ * Refinement of a set of polynomials to a coprime base.
+ */
+
+#pragma once
+
+#include "../config.h"
+#include "Monomial.h"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace carl
+{
+	/**
+	 * Computes a coprime base of a set of polynomials, that is a set of pairwise coprime polynomials such
+	 * that each of the given polynomials is a product of powers of them (also known as factor refinement).
+	 *
+	 * The base is computed in rounds. Every round computes the gcds of all pairs of elements that share a
+	 * variable and are not known to be coprime, where the pairs are distributed over a pool of threads.
+	 * Afterwards, the pairs with a nontrivial gcd are merged in the order of the pairs: an element is split
+	 * into the gcd and its cofactor unless it has already been split in this round, in which case the pair is
+	 * considered again in the next round. Hence the result does not depend on the scheduling of the threads.
+	 * Elements obtained by splitting an element inherit the elements this element is known to be coprime to.
+	 *
+	 * The polynomials may be assigned to groups, for example the operands they are factors of. Then only elements
+	 * of different groups are made coprime, which suffices to cancel the gcd of the products of the groups and
+	 * saves the gcds within the groups: two elements are compared unless both belong to the same single group.
+	 * Every element belongs to the groups of the polynomials it divides.
+	 *
+	 * The polynomials must be normalized such that their coprime factor is one. Then the gcds and cofactors
+	 * are normalized as well, and the polynomials are products of the base elements without any constant.
+	 *
+	 * Polynomial arithmetic uses global pools, hence multiple threads are only used if carl is built with THREAD_SAFE.
+	 */
+	template<typename P>
+	class CoprimeBase
+	{
+	public:
+		/// Pairs of indices in base() and exponents.
+		using Decomposition = std::vector<std::pair<std::size_t, carl::exponent>>;
+		/// A set of groups, one bit per group.
+		using Groups = std::uint64_t;
+		/// The default groups, for which all elements are made pairwise coprime.
+		static constexpr Groups ALL_GROUPS = ~Groups(0);
+	private:
+		struct Element {
+			P polynomial;
+			bool irreducible;
+			Groups groups;
+			std::set<Variable> variables;
+			/// The elements this element has been split into, empty if it is part of the base.
+			std::vector<std::size_t> parts;
+			/// The elements that are known to be coprime to this element.
+			std::set<std::size_t> coprime;
+		};
+		/// A pair of elements with a nontrivial gcd.
+		struct Split {
+			std::size_t lhs;
+			std::size_t rhs;
+			P gcd;
+			P restLhs;
+			P restRhs;
+		};
+
+		std::size_t mThreads;
+		std::vector<Element> mElements;
+		/// All elements by their polynomial.
+		std::unordered_map<P, std::size_t> mIndex;
+		/// The element of every polynomial that was added.
+		std::vector<std::size_t> mInputs;
+		std::vector<P> mBase;
+		std::vector<Decomposition> mDecompositions;
+		std::size_t mRounds = 0;
+		std::size_t mGCDs = 0;
+
+		/// @return The element of the given polynomial, which is created if it does not exist yet.
+		std::size_t element(const P& p, Groups groups, bool irreducible);
+		/// Adds the groups to the element and all its parts.
+		void addGroups(std::size_t element, Groups groups);
+		void setCoprime(std::size_t lhs, std::size_t rhs);
+		void split(const Split& s);
+		/// Adds the base elements of the given element with the given exponent to the result.
+		void expand(std::size_t element, carl::exponent exp, std::map<std::size_t, carl::exponent>& result) const;
+		/// Calls f for 0, ..., n-1, distributed over the threads.
+		template<typename F>
+		void parallelFor(std::size_t n, const F& f) const;
+	public:
+		/**
+		 * @param threads The number of threads, 0 meaning one per hardware thread.
+		 */
+		explicit CoprimeBase(std::size_t threads = 1);
+
+		/**
+		 * Adds a normalized polynomial that is not constant.
+		 * @param p The polynomial.
+		 * @param groups The groups of the polynomial.
+		 * @param irreducible True if the polynomial is known to be irreducible, such that no gcd with another irreducible polynomial is computed.
+		 * @return The index of the polynomial, which refers to its decomposition.
+		 */
+		std::size_t add(const P& p, Groups groups = ALL_GROUPS, bool irreducible = false);
+
+		/**
+		 * Computes the base and the decompositions of all polynomials added so far.
+		 */
+		void compute();
+
+		/// @return The coprime base, available after compute().
+		const std::vector<P>& base() const {
+			return mBase;
+		}
+		/// @return The decomposition of the polynomial with the given index over base(), available after compute().
+		const Decomposition& decomposition(std::size_t input) const {
+			assert(input < mDecompositions.size());
+			return mDecompositions[input];
+		}
+		/// @return The number of rounds of the last call of compute().
+		std::size_t rounds() const {
+			return mRounds;
+		}
+		/// @return The number of gcds computed by the last call of compute().
+		std::size_t gcds() const {
+			return mGCDs;
+		}
+	};
+}
+
+#include "CoprimeBase.tpp"
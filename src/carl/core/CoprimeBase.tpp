@@ -0,0 +1,190 @@
+/**
+ * @file CoprimeBase.tpp
+ */
+
+#pragma once
+
+#include "CoprimeBase.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace carl
+{
+	template<typename P>
+	CoprimeBase<P>::CoprimeBase(std::size_t threads):
+		mThreads(threads)
+	{
+		if (mThreads == 0) mThreads = std::max(1u, std::thread::hardware_concurrency());
+#ifndef THREAD_SAFE
+		mThreads = 1;
+#endif
+	}
+
+	template<typename P>
+	std::size_t CoprimeBase<P>::element(const P& p, Groups groups, bool irreducible) {
+		auto it = mIndex.find(p);
+		if (it != mIndex.end()) {
+			if (irreducible) mElements[it->second].irreducible = true;
+			addGroups(it->second, groups);
+			return it->second;
+		}
+		mElements.push_back(Element{p, irreducible, groups, p.gatherVariables(), {}, {}});
+		mIndex.emplace(p, mElements.size() - 1);
+		return mElements.size() - 1;
+	}
+
+	template<typename P>
+	void CoprimeBase<P>::addGroups(std::size_t element, Groups groups) {
+		if ((mElements[element].groups | groups) == mElements[element].groups) return;
+		mElements[element].groups |= groups;
+		for (std::size_t part: mElements[element].parts) addGroups(part, groups);
+	}
+
+	template<typename P>
+	void CoprimeBase<P>::setCoprime(std::size_t lhs, std::size_t rhs) {
+		assert(lhs != rhs);
+		mElements[lhs].coprime.insert(rhs);
+		mElements[rhs].coprime.insert(lhs);
+	}
+
+	template<typename P>
+	void CoprimeBase<P>::split(const Split& s) {
+		// The polynomials are normalized, hence an element that divides the other one equals the gcd.
+		bool keepLhs = s.restLhs.isConstant();
+		bool keepRhs = s.restRhs.isConstant();
+		assert(!keepLhs || !keepRhs);
+		bool irreducible = mElements[s.lhs].irreducible || mElements[s.rhs].irreducible;
+		Groups groups = mElements[s.lhs].groups | mElements[s.rhs].groups;
+		std::size_t gcd = keepLhs ? s.lhs : (keepRhs ? s.rhs : element(s.gcd, groups, irreducible));
+		addGroups(gcd, groups);
+		std::vector<std::size_t> rests;
+		for (const auto& side: {std::make_pair(s.lhs, &s.restLhs), std::make_pair(s.rhs, &s.restRhs)}) {
+			if (side.second->isConstant()) continue;
+			std::size_t rest = element(*side.second, mElements[side.first].groups, false);
+			rests.push_back(rest);
+			mElements[side.first].parts = {gcd, rest};
+			// Divisors of an element are coprime to everything the element is coprime to.
+			std::set<std::size_t> coprime = mElements[side.first].coprime;
+			for (std::size_t c: coprime) {
+				if (c != gcd) setCoprime(gcd, c);
+				if (c != rest) setCoprime(rest, c);
+			}
+		}
+		// The cofactors of the gcd are coprime.
+		if (rests.size() == 2) setCoprime(rests[0], rests[1]);
+	}
+
+	template<typename P>
+	void CoprimeBase<P>::expand(std::size_t element, carl::exponent exp, std::map<std::size_t, carl::exponent>& result) const {
+		if (mElements[element].parts.empty()) {
+			result[element] += exp;
+			return;
+		}
+		for (std::size_t part: mElements[element].parts) expand(part, exp, result);
+	}
+
+	template<typename P>
+	template<typename F>
+	void CoprimeBase<P>::parallelFor(std::size_t n, const F& f) const {
+		std::size_t threads = std::min(mThreads, n);
+		if (threads <= 1) {
+			for (std::size_t i = 0; i < n; i++) f(i);
+			return;
+		}
+		std::atomic<std::size_t> next(0);
+		auto work = [&next, n, &f]() {
+			for (std::size_t i = next++; i < n; i = next++) f(i);
+		};
+		std::vector<std::thread> workers;
+		for (std::size_t t = 1; t < threads; t++) workers.emplace_back(work);
+		work();
+		for (auto& w: workers) w.join();
+	}
+
+	template<typename P>
+	std::size_t CoprimeBase<P>::add(const P& p, Groups groups, bool irreducible) {
+		assert(!p.isConstant());
+		assert(carl::isOne(p.coprimeFactor()));
+		assert(groups != 0);
+		mInputs.push_back(element(p, groups, irreducible));
+		return mInputs.size() - 1;
+	}
+
+	template<typename P>
+	void CoprimeBase<P>::compute() {
+		mRounds = 0;
+		mGCDs = 0;
+		while (true) {
+			std::vector<std::size_t> active;
+			for (std::size_t i = 0; i < mElements.size(); i++) {
+				if (mElements[i].parts.empty()) active.push_back(i);
+			}
+			std::vector<std::pair<std::size_t, std::size_t>> pairs;
+			for (auto i = active.begin(); i != active.end(); i++) {
+				for (auto j = i + 1; j != active.end(); j++) {
+					if (mElements[*i].coprime.count(*j) > 0) continue;
+					Groups groups = mElements[*i].groups;
+					if (groups == mElements[*j].groups && (groups & (groups - 1)) == 0) continue;
+					const auto& vars = mElements[*j].variables;
+					bool disjoint = std::none_of(mElements[*i].variables.begin(), mElements[*i].variables.end(), [&vars](Variable v){ return vars.count(v) > 0; });
+					if (disjoint || (mElements[*i].irreducible && mElements[*j].irreducible)) {
+						setCoprime(*i, *j);
+						continue;
+					}
+					pairs.emplace_back(*i, *j);
+				}
+			}
+			if (pairs.empty()) break;
+			mRounds++;
+			mGCDs += pairs.size();
+			std::vector<P> gcds(pairs.size());
+			parallelFor(pairs.size(), [this, &pairs, &gcds](std::size_t k) {
+				gcds[k] = carl::gcd(mElements[pairs[k].first].polynomial, mElements[pairs[k].second].polynomial);
+			});
+
+			// Merge the results in the order of the pairs, splitting every element at most once.
+			std::vector<Split> splits;
+			std::vector<bool> used(mElements.size(), false);
+			for (std::size_t k = 0; k < pairs.size(); k++) {
+				std::size_t i = pairs[k].first;
+				std::size_t j = pairs[k].second;
+				if (gcds[k].isConstant()) {
+					setCoprime(i, j);
+				} else if (!used[i] && !used[j]) {
+					used[i] = true;
+					used[j] = true;
+					splits.push_back(Split{i, j, std::move(gcds[k]), P(), P()});
+				}
+			}
+			parallelFor(splits.size(), [this, &splits](std::size_t k) {
+				Split& s = splits[k];
+				s.gcd *= s.gcd.coprimeFactor();
+				s.restLhs = mElements[s.lhs].polynomial.quotient(s.gcd);
+				s.restRhs = mElements[s.rhs].polynomial.quotient(s.gcd);
+				assert(s.restLhs.isConstant() || carl::isOne(s.restLhs.coprimeFactor()));
+				assert(s.restRhs.isConstant() || carl::isOne(s.restRhs.coprimeFactor()));
+			});
+			for (const auto& s: splits) split(s);
+		}
+
+		mBase.clear();
+		std::vector<std::size_t> position(mElements.size());
+		for (std::size_t i = 0; i < mElements.size(); i++) {
+			if (!mElements[i].parts.empty()) continue;
+			position[i] = mBase.size();
+			mBase.push_back(mElements[i].polynomial);
+		}
+		mDecompositions.clear();
+		for (std::size_t input: mInputs) {
+			std::map<std::size_t, carl::exponent> exponents;
+			expand(input, 1, exponents);
+			Decomposition decomposition;
+			for (const auto& e: exponents) decomposition.emplace_back(position[e.first], e.second);
+			mDecompositions.push_back(std::move(decomposition));
+		}
+		CARL_LOG_DEBUG("carl.core.coprimebase", "Refined " << mInputs.size() << " polynomials to " << mBase.size() << " in " << mRounds << " rounds with " << mGCDs << " gcds");
+	}
+}
@@ -8,8 +8,10 @@
 #pragma once
 
 #include <iostream>
+#include "../config.h"
 #include "../numbers/typetraits.h"
 #include "../util/Cache.h"
+#include "../util/ShardedCache.h"
 #include "DivisionResult.h"
 #include "PolynomialFactorizationPair.h"
 
@@ -43,11 +45,21 @@ namespace carl
         using PolyType = P;
         ///
         using TermsType = typename P::TermsType;
-        ///
+        /// The cache of the polynomials and their factorizations, which allows for concurrent use if carl is built with THREAD_SAFE.
+#ifdef THREAD_SAFE
+        using CACHE = ShardedCache<PolynomialFactorizationPair<P>>;
+#else
         using CACHE = Cache<PolynomialFactorizationPair<P>>;
+#endif
     
         enum ConstructorOperation : unsigned { ADD, SUB, MUL, DIV };
 
+        /**
+         * The number of threads refining the factorizations of the numerator and the denominator when a rational function
+         * is simplified, 0 meaning one per hardware thread. If it is one, they are refined by gcd(), otherwise by refineFactorizations().
+         */
+        static std::size_t refinementThreads;
+
     private:
         // Members
 
@@ -87,7 +99,7 @@ namespace carl
         template<typename P1>
         friend bool existsFactorization( const FactorizedPolynomial<P1>& fpoly )
         {
-            assert( fpoly.mpCache == nullptr || fpoly.mCacheRef != Cache<PolynomialFactorizationPair<P1>>::NO_REF );
+            assert( fpoly.mpCache == nullptr || fpoly.mCacheRef != FactorizedPolynomial<P1>::CACHE::NO_REF );
             return fpoly.mpCache != nullptr;
         }
         
@@ -751,6 +763,19 @@ namespace carl
          */
         template<typename P1>
         friend std::pair<FactorizedPolynomial<P1>,FactorizedPolynomial<P1>> lazyDiv( const FactorizedPolynomial<P1>& _fpolyA, const FactorizedPolynomial<P1>& _fpolyB );
+
+        /**
+         * Refines the factorizations of the two given factorized polynomials to factorizations over a common base of all
+         * their factors, in which the factors of the one are coprime to the factors of the other one unless they are equal.
+         * The gcds of the factors are computed by the given number of threads (see CoprimeBase).
+         * Afterwards, their greatest common divisor consists of their common factors, which are cancelled by lazyDiv().
+         * @param _fpolyA The first factorized polynomial.
+         * @param _fpolyB The second factorized polynomial.
+         * @param _threads The number of threads, 0 meaning one per hardware thread.
+         * @return true, if one of the factorizations has been refined.
+         */
+        template<typename P1>
+        friend bool refineFactorizations( const FactorizedPolynomial<P1>& _fpolyA, const FactorizedPolynomial<P1>& _fpolyB, std::size_t _threads );
         
         /**
          * @param _fpoly The polynomial to calculate the factorization for.
@@ -12,6 +12,9 @@
 
 namespace carl
 {
+    template<typename P>
+    std::size_t FactorizedPolynomial<P>::refinementThreads = 1;
+
     template<typename P>
     FactorizedPolynomial<P>::FactorizedPolynomial():
         mCacheRef( CACHE::NO_REF ),
@@ -59,9 +62,8 @@ namespace carl
                 Factorization<P> factorization;
                 PolynomialFactorizationPair<P>* pfPair = new PolynomialFactorizationPair<P>( std::move( factorization), new P(poly) );
                 //Factorization is not set yet
-                auto ret = mpCache->cache( pfPair );//, &carl::canBeUpdated, &carl::update );
+                auto ret = mpCache->cacheAndReg( pfPair );//, &carl::canBeUpdated, &carl::update );
                 mCacheRef = ret.first;
-                mpCache->reg( mCacheRef );
                 if( ret.second )
                 {
                     assert( content().mFactorization.empty() );
@@ -102,9 +104,8 @@ namespace carl
             for ( auto factor = _factorization.begin(); factor != _factorization.end(); factor++ )
             assert( carl::isOne(factor->first.coefficient()) );
             PolynomialFactorizationPair<P>* pfPair = new PolynomialFactorizationPair<P>( std::move( _factorization ) );
-            auto ret = mpCache->cache( pfPair );//, &carl::canBeUpdated, &carl::update );
+            auto ret = mpCache->cacheAndReg( pfPair );//, &carl::canBeUpdated, &carl::update );
             mCacheRef = ret.first;
-            mpCache->reg( mCacheRef );
             if( !ret.second )
             {
                 delete pfPair;
@@ -1320,6 +1321,25 @@ namespace carl
         return std::make_pair( resultA, resultB );
     }
 
+    template<typename P>
+    bool refineFactorizations( const FactorizedPolynomial<P>& _fpolyA, const FactorizedPolynomial<P>& _fpolyB, std::size_t _threads )
+    {
+        ASSERT_CACHE_EQUAL( _fpolyA.pCache(), _fpolyB.pCache() );
+        if( !existsFactorization( _fpolyA ) || !existsFactorization( _fpolyB ) )
+            return false;
+        _fpolyA.strengthenActivity();
+        _fpolyB.strengthenActivity();
+        bool rehashFPolyA = false;
+        bool rehashFPolyB = false;
+        refine( _fpolyA.content(), _fpolyB.content(), _threads, rehashFPolyA, rehashFPolyB );
+        if( rehashFPolyA )
+            _fpolyA.rehash();
+        if( rehashFPolyB )
+            _fpolyB.rehash();
+        assert( carl::gcd( computePolynomial( lazyDiv( _fpolyA, _fpolyB ).first ), computePolynomial( lazyDiv( _fpolyA, _fpolyB ).second ) ).isConstant() );
+        return rehashFPolyA || rehashFPolyB;
+    }
+
     template<typename P>
     FactorizedPolynomial<P> lcm( const FactorizedPolynomial<P>& _fpolyA, const FactorizedPolynomial<P>& _fpolyB )
     {
@@ -0,0 +1,366 @@
+/**
+ * @file FactorizedRationalFunction.h
+ *
+ * Rational functions over factorized polynomials with lazy simplification.
+ */
+
+#pragma once
+
+#include "FactorizedPolynomial.h"
+#include "RationalFunction.h"
+
+#include <map>
+#include <set>
+
+namespace carl
+{
+    /**
+     * A quotient of two factorized polynomials, designed for long chains of operations on rational functions,
+     * as they occur for example in parametric Markov chains.
+     *
+     * The denominator is kept as a multiset of factors with coefficient one, while the numerator carries the
+     * rational coefficient of the quotient. Common denominators are computed as the union of the factors of
+     * both denominators (see commonMultiple()), hence the cofactors of both operands are obtained by subtracting
+     * exponents instead of multiplying or dividing polynomials. After each operation, factors occurring in both
+     * the numerator and the denominator are cancelled syntactically (see lazyDiv()).
+     *
+     * Factors that are equal only up to a common divisor are not detected this way. They are found by simplify(),
+     * which computes the gcd of the numerator and the denominator and thereby refines the factorizations in the
+     * cache. If AutoSimplify is true, simplify() is called whenever the quotient has become considerably more
+     * complex since the last simplification, otherwise it has to be called explicitly.
+     *
+     * In contrast to RationalFunction, the numerator and the denominator are stored inline.
+     */
+    template<typename P, bool AutoSimplify = true>
+    class FactorizedRationalFunction
+    {
+    public:
+
+        using PolyType = FactorizedPolynomial<P>;
+        using CoeffType = typename PolyType::CoeffType;
+        using CACHE = typename PolyType::CACHE;
+
+        /// The factor by which the complexity of the quotient has to grow until it is simplified automatically.
+        static constexpr std::size_t SIMPLIFICATION_GROWTH = 2;
+        /// The complexity below which the quotient is not simplified automatically.
+        static constexpr std::size_t SIMPLIFICATION_MIN_COMPLEXITY = 32;
+
+    private:
+
+        /// The numerator, which carries the coefficient of the quotient.
+        PolyType mNumerator;
+        /// The denominator, whose coefficient is always one.
+        PolyType mDenominator;
+        /// The complexity of the quotient after its last simplification.
+        std::size_t mSimplifiedComplexity;
+        bool mIsSimplified;
+
+    public:
+
+        FactorizedRationalFunction():
+            mNumerator(),
+            mDenominator( constant_one<CoeffType>::get() ),
+            mSimplifiedComplexity( 0 ),
+            mIsSimplified( true )
+        {}
+
+        explicit FactorizedRationalFunction( const CoeffType& _c ):
+            mNumerator( _c ),
+            mDenominator( constant_one<CoeffType>::get() ),
+            mSimplifiedComplexity( 0 ),
+            mIsSimplified( true )
+        {}
+
+        explicit FactorizedRationalFunction( const PolyType& _p ):
+            mNumerator( _p ),
+            mDenominator( constant_one<CoeffType>::get() ),
+            mSimplifiedComplexity( complexity() ),
+            mIsSimplified( true )
+        {}
+
+        /**
+         * Constructs the quotient of the given polynomials, of which only common factors are cancelled.
+         * @param _nom The numerator.
+         * @param _denom The denominator, which must not be zero.
+         */
+        FactorizedRationalFunction( const PolyType& _nom, const PolyType& _denom ):
+            mNumerator( _nom ),
+            mDenominator( _denom ),
+            mSimplifiedComplexity( 0 ),
+            mIsSimplified( false )
+        {
+            assert( !_denom.isZero() );
+            normalize();
+        }
+
+        /**
+         * @return The numerator.
+         */
+        const PolyType& nominator() const
+        {
+            return mNumerator;
+        }
+
+        /**
+         * @return The denominator, whose coefficient is one.
+         */
+        const PolyType& denominator() const
+        {
+            return mDenominator;
+        }
+
+        /**
+         * Checks if this rational function has been simplified since its last modification.
+         * @return If this is simplified.
+         */
+        bool isSimplified() const
+        {
+            return mIsSimplified;
+        }
+
+        /**
+         * Cancels the gcd of the numerator and the denominator, which is computed by refineFactorizations()
+         * if FactorizedPolynomial::refinementThreads is not one and by gcd() otherwise.
+         */
+        void simplify();
+
+        bool isZero() const
+        {
+            return mNumerator.isZero();
+        }
+
+        bool isOne() const
+        {
+            return mDenominator.isOne() && mNumerator.isOne();
+        }
+
+        bool isConstant() const
+        {
+            return mDenominator.isConstant() && mNumerator.isConstant();
+        }
+
+        /**
+         * @return The value of this rational function, which must be constant.
+         */
+        const CoeffType& constantPart() const
+        {
+            assert( isConstant() );
+            return mNumerator.coefficient();
+        }
+
+        /**
+         * @return A measure of the size of the numerator and the denominator, see FactorizedPolynomial::complexity().
+         */
+        std::size_t complexity() const
+        {
+            return mNumerator.complexity() + mDenominator.complexity();
+        }
+
+        /**
+         * @return The inverse of this rational function, which must not be zero.
+         */
+        FactorizedRationalFunction inverse() const
+        {
+            assert( !isZero() );
+            return FactorizedRationalFunction( mDenominator, mNumerator );
+        }
+
+        std::set<Variable> gatherVariables() const
+        {
+            std::set<Variable> vars;
+            gatherVariables( vars );
+            return vars;
+        }
+
+        void gatherVariables( std::set<Variable>& _vars ) const
+        {
+            mNumerator.gatherVariables( _vars );
+            mDenominator.gatherVariables( _vars );
+        }
+
+        /**
+         * Evaluate the rational function at the point described by substitutions.
+         * @param _substitutions A mapping from variable to constant values.
+         * @return The result of the substitution.
+         */
+        template<typename SubstitutionType>
+        SubstitutionType evaluate( const std::map<Variable, SubstitutionType>& _substitutions ) const
+        {
+            return mNumerator.evaluate( _substitutions ) / mDenominator.evaluate( _substitutions );
+        }
+
+        /**
+         * @return This rational function as a RationalFunction over factorized polynomials.
+         */
+        template<bool AS>
+        RationalFunction<PolyType, AS> toRationalFunction() const
+        {
+            if( isConstant() )
+                return RationalFunction<PolyType, AS>( constantPart() );
+            return RationalFunction<PolyType, AS>( mNumerator, mDenominator );
+        }
+
+    private:
+
+        /**
+         * Moves the coefficient of the denominator to the numerator and cancels the factors they have in common.
+         */
+        void normalize();
+
+        /**
+         * Normalizes this rational function after a modification and simplifies it, if AutoSimplify is true and it
+         * has grown too much since its last simplification.
+         * @param _simplifiedComplexity The complexity after the last simplification of the operands of the modification.
+         */
+        void update( std::size_t _simplifiedComplexity );
+
+        template<bool byInverse>
+        FactorizedRationalFunction& add( const FactorizedRationalFunction& _rhs );
+
+    public:
+
+        /// @name In-place arithmetic operators
+        /// @{
+        FactorizedRationalFunction& operator+=( const FactorizedRationalFunction& _rhs )
+        {
+            return this->template add<false>( _rhs );
+        }
+
+        FactorizedRationalFunction& operator+=( const PolyType& _rhs )
+        {
+            return this->template add<false>( FactorizedRationalFunction( _rhs ) );
+        }
+
+        FactorizedRationalFunction& operator+=( const CoeffType& _rhs )
+        {
+            return this->template add<false>( FactorizedRationalFunction( _rhs ) );
+        }
+
+        FactorizedRationalFunction& operator-=( const FactorizedRationalFunction& _rhs )
+        {
+            return this->template add<true>( _rhs );
+        }
+
+        FactorizedRationalFunction& operator-=( const PolyType& _rhs )
+        {
+            return this->template add<true>( FactorizedRationalFunction( _rhs ) );
+        }
+
+        FactorizedRationalFunction& operator-=( const CoeffType& _rhs )
+        {
+            return this->template add<true>( FactorizedRationalFunction( _rhs ) );
+        }
+
+        FactorizedRationalFunction& operator*=( const FactorizedRationalFunction& _rhs );
+
+        FactorizedRationalFunction& operator*=( const PolyType& _rhs )
+        {
+            return *this *= FactorizedRationalFunction( _rhs );
+        }
+
+        FactorizedRationalFunction& operator*=( const CoeffType& _rhs );
+
+        FactorizedRationalFunction& operator/=( const FactorizedRationalFunction& _rhs );
+
+        FactorizedRationalFunction& operator/=( const PolyType& _rhs )
+        {
+            return *this /= FactorizedRationalFunction( _rhs );
+        }
+
+        FactorizedRationalFunction& operator/=( const CoeffType& _rhs )
+        {
+            assert( !carl::isZero( _rhs ) );
+            return *this *= CoeffType( 1 ) / _rhs;
+        }
+        /// @}
+
+        FactorizedRationalFunction operator-() const
+        {
+            FactorizedRationalFunction result( *this );
+            result.mNumerator = -mNumerator;
+            return result;
+        }
+    };
+
+    /**
+     * Checks whether the numerators and the denominators are equal, which is only guaranteed for equal rational
+     * functions if both are simplified.
+     */
+    template<typename P, bool AS>
+    inline bool operator==( const FactorizedRationalFunction<P, AS>& _lhs, const FactorizedRationalFunction<P, AS>& _rhs )
+    {
+        return _lhs.nominator() == _rhs.nominator() && _lhs.denominator() == _rhs.denominator();
+    }
+
+    template<typename P, bool AS>
+    inline bool operator!=( const FactorizedRationalFunction<P, AS>& _lhs, const FactorizedRationalFunction<P, AS>& _rhs )
+    {
+        return !( _lhs == _rhs );
+    }
+
+    template<typename P, bool AS>
+    inline FactorizedRationalFunction<P, AS> operator+( const FactorizedRationalFunction<P, AS>& _lhs, const FactorizedRationalFunction<P, AS>& _rhs )
+    {
+        return FactorizedRationalFunction<P, AS>( _lhs ) += _rhs;
+    }
+
+    template<typename P, bool AS>
+    inline FactorizedRationalFunction<P, AS> operator+( const FactorizedRationalFunction<P, AS>& _lhs, const typename FactorizedRationalFunction<P, AS>::CoeffType& _rhs )
+    {
+        return FactorizedRationalFunction<P, AS>( _lhs ) += _rhs;
+    }
+
+    template<typename P, bool AS>
+    inline FactorizedRationalFunction<P, AS> operator-( const FactorizedRationalFunction<P, AS>& _lhs, const FactorizedRationalFunction<P, AS>& _rhs )
+    {
+        return FactorizedRationalFunction<P, AS>( _lhs ) -= _rhs;
+    }
+
+    template<typename P, bool AS>
+    inline FactorizedRationalFunction<P, AS> operator-( const FactorizedRationalFunction<P, AS>& _lhs, const typename FactorizedRationalFunction<P, AS>::CoeffType& _rhs )
+    {
+        return FactorizedRationalFunction<P, AS>( _lhs ) -= _rhs;
+    }
+
+    template<typename P, bool AS>
+    inline FactorizedRationalFunction<P, AS> operator*( const FactorizedRationalFunction<P, AS>& _lhs, const FactorizedRationalFunction<P, AS>& _rhs )
+    {
+        return FactorizedRationalFunction<P, AS>( _lhs ) *= _rhs;
+    }
+
+    template<typename P, bool AS>
+    inline FactorizedRationalFunction<P, AS> operator*( const FactorizedRationalFunction<P, AS>& _lhs, const typename FactorizedRationalFunction<P, AS>::CoeffType& _rhs )
+    {
+        return FactorizedRationalFunction<P, AS>( _lhs ) *= _rhs;
+    }
+
+    template<typename P, bool AS>
+    inline FactorizedRationalFunction<P, AS> operator/( const FactorizedRationalFunction<P, AS>& _lhs, const FactorizedRationalFunction<P, AS>& _rhs )
+    {
+        return FactorizedRationalFunction<P, AS>( _lhs ) /= _rhs;
+    }
+
+    template<typename P, bool AS>
+    inline FactorizedRationalFunction<P, AS> operator/( const FactorizedRationalFunction<P, AS>& _lhs, const typename FactorizedRationalFunction<P, AS>::CoeffType& _rhs )
+    {
+        return FactorizedRationalFunction<P, AS>( _lhs ) /= _rhs;
+    }
+
+    template<typename P, bool AS>
+    std::ostream& operator<<( std::ostream& _out, const FactorizedRationalFunction<P, AS>& _rf );
+}
+
+namespace std
+{
+    template<typename P, bool AS>
+    struct hash<carl::FactorizedRationalFunction<P, AS>>
+    {
+        std::size_t operator()( const carl::FactorizedRationalFunction<P, AS>& _rf ) const
+        {
+            std::hash<carl::FactorizedPolynomial<P>> h;
+            return (h( _rf.nominator() ) << 8) ^ (h( _rf.denominator() ) >> 8);
+        }
+    };
+}
+
+#include "FactorizedRationalFunction.tpp"
@@ -0,0 +1,145 @@
+/**
+ * @file FactorizedRationalFunction.tpp
+ */
+
+#pragma once
+
+#include "FactorizedRationalFunction.h"
+
+#include <algorithm>
+
+namespace carl
+{
+    template<typename P, bool AS>
+    void FactorizedRationalFunction<P, AS>::simplify()
+    {
+        if( mIsSimplified )
+            return;
+        if( !mDenominator.isConstant() && !mNumerator.isConstant() )
+        {
+            if( PolyType::refinementThreads != 1 )
+            {
+                // After refining both factorizations to a coprime base, normalize() cancels the gcd syntactically.
+                refineFactorizations( mNumerator, mDenominator, PolyType::refinementThreads );
+            }
+            else
+            {
+                PolyType restNumerator, restDenominator;
+                gcd( mNumerator, mDenominator, restNumerator, restDenominator );
+                mNumerator = std::move( restNumerator );
+                mDenominator = std::move( restDenominator );
+            }
+            normalize();
+        }
+        mIsSimplified = true;
+        mSimplifiedComplexity = complexity();
+    }
+
+    template<typename P, bool AS>
+    void FactorizedRationalFunction<P, AS>::normalize()
+    {
+        if( mNumerator.isZero() )
+        {
+            mDenominator = PolyType( constant_one<CoeffType>::get() );
+            mIsSimplified = true;
+            return;
+        }
+        // Only the factors that are syntactically equal are cancelled, which does not need any gcd computation.
+        auto quotient = lazyDiv( mNumerator, mDenominator );
+        mNumerator = std::move( quotient.first );
+        mDenominator = std::move( quotient.second );
+        assert( carl::isOne( mDenominator.coefficient() ) );
+        if( mDenominator.isConstant() )
+            mIsSimplified = true;
+    }
+
+    template<typename P, bool AS>
+    void FactorizedRationalFunction<P, AS>::update( std::size_t _simplifiedComplexity )
+    {
+        mIsSimplified = false;
+        mSimplifiedComplexity = _simplifiedComplexity;
+        normalize();
+        if( AS && !mIsSimplified )
+        {
+            std::size_t currentComplexity = complexity();
+            if( currentComplexity > SIMPLIFICATION_MIN_COMPLEXITY && currentComplexity > SIMPLIFICATION_GROWTH * mSimplifiedComplexity )
+            {
+                CARL_LOG_TRACE( "carl.core.rationalfunction", "Simplify " << *this << " of complexity " << currentComplexity );
+                simplify();
+            }
+        }
+    }
+
+    template<typename P, bool AS>
+    template<bool byInverse>
+    FactorizedRationalFunction<P, AS>& FactorizedRationalFunction<P, AS>::add( const FactorizedRationalFunction<P, AS>& _rhs )
+    {
+        if( _rhs.isZero() )
+            return *this;
+        std::size_t simplifiedComplexity = std::max( mSimplifiedComplexity, _rhs.mSimplifiedComplexity );
+        if( mDenominator == _rhs.mDenominator )
+        {
+            if( byInverse )
+                mNumerator -= _rhs.mNumerator;
+            else
+                mNumerator += _rhs.mNumerator;
+        }
+        else
+        {
+            // The common denominator is the union of the factors of both denominators, hence the cofactors are
+            // obtained by subtracting the exponents of the factors.
+            PolyType multiple = commonMultiple( mDenominator, _rhs.mDenominator );
+            PolyType lhsNumerator = mNumerator * lazyDiv( multiple, mDenominator ).first;
+            PolyType rhsNumerator = _rhs.mNumerator * lazyDiv( multiple, _rhs.mDenominator ).first;
+            if( byInverse )
+                mNumerator = lhsNumerator - rhsNumerator;
+            else
+                mNumerator = lhsNumerator + rhsNumerator;
+            mDenominator = std::move( multiple );
+        }
+        update( simplifiedComplexity );
+        return *this;
+    }
+
+    template<typename P, bool AS>
+    FactorizedRationalFunction<P, AS>& FactorizedRationalFunction<P, AS>::operator*=( const FactorizedRationalFunction<P, AS>& _rhs )
+    {
+        std::size_t simplifiedComplexity = std::max( mSimplifiedComplexity, _rhs.mSimplifiedComplexity );
+        PolyType numerator = mNumerator * _rhs.mNumerator;
+        PolyType denominator = mDenominator * _rhs.mDenominator;
+        mNumerator = std::move( numerator );
+        mDenominator = std::move( denominator );
+        update( simplifiedComplexity );
+        return *this;
+    }
+
+    template<typename P, bool AS>
+    FactorizedRationalFunction<P, AS>& FactorizedRationalFunction<P, AS>::operator*=( const CoeffType& _rhs )
+    {
+        if( carl::isZero( _rhs ) )
+            return *this = FactorizedRationalFunction<P, AS>();
+        mNumerator *= _rhs;
+        return *this;
+    }
+
+    template<typename P, bool AS>
+    FactorizedRationalFunction<P, AS>& FactorizedRationalFunction<P, AS>::operator/=( const FactorizedRationalFunction<P, AS>& _rhs )
+    {
+        assert( !_rhs.isZero() );
+        std::size_t simplifiedComplexity = std::max( mSimplifiedComplexity, _rhs.mSimplifiedComplexity );
+        PolyType numerator = mNumerator * _rhs.mDenominator;
+        PolyType denominator = mDenominator * _rhs.mNumerator;
+        mNumerator = std::move( numerator );
+        mDenominator = std::move( denominator );
+        update( simplifiedComplexity );
+        return *this;
+    }
+
+    template<typename P, bool AS>
+    std::ostream& operator<<( std::ostream& _out, const FactorizedRationalFunction<P, AS>& _rf )
+    {
+        if( _rf.denominator().isOne() )
+            return _out << _rf.nominator();
+        return _out << "(" << _rf.nominator() << ")/(" << _rf.denominator() << ")";
+    }
+}
@@ -0,0 +1,183 @@
+/**
+ * @file FlatHorner.h
+ *
+ * A Horner scheme flattened into a contiguous instruction array for repeated interval evaluation.
+ */
+
+#pragma once
+
+#include "../config.h"
+#include "MultivariateHorner.h"
+#include "../interval/Interval.h"
+#include "../interval/IntervalBatch.h"
+#include "../util/Singleton.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace carl
+{
+	/**
+	 * Horner scheme of a polynomial compiled into a program for a stack machine.
+	 *
+	 * The variables are numbered by their position in variables(), the powers of the variables
+	 * that occur in the scheme are collected in a table such that every power is computed only
+	 * once per evaluation. The instructions refer to variables, powers and constants by index.
+	 * The variable selection heuristic given by strategy is applied once upon construction.
+	 */
+	template<typename PolynomialType, class strategy = carl::strategy>
+	class FlatHorner
+	{
+	public:
+		enum class Opcode : unsigned char {
+			/// Push constant arg.
+			CONSTANT,
+			/// Push power arg.
+			POWER,
+			/// Multiply the top of the stack with power arg.
+			MUL_POWER,
+			/// Add constant arg to the top of the stack.
+			ADD_CONSTANT,
+			/// Pop the top of the stack and add it to the new top.
+			ADD
+		};
+		struct Instruction {
+			Opcode op;
+			std::size_t arg;
+		};
+	private:
+		/// Variables, indexed by their position.
+		std::vector<Variable> mVariables;
+		/// Powers as pairs of variable index and exponent.
+		std::vector<std::pair<std::size_t, uint>> mPowers;
+		std::vector<Interval<double>> mConstants;
+		std::vector<Instruction> mInstructions;
+		/// Maximal size of the stack during evaluation.
+		std::size_t mStackSize = 0;
+
+		std::size_t variableIndex(Variable::Arg v);
+		std::size_t powerIndex(Variable::Arg v, uint exp);
+		std::size_t constantIndex(const typename PolynomialType::CoeffType& c);
+		/// Appends the instructions for the given scheme, the stack has the given size before.
+		void compile(const MultivariateHorner<PolynomialType, strategy>& h, std::size_t stack);
+	public:
+		explicit FlatHorner(const PolynomialType& p);
+
+		const std::vector<Variable>& variables() const {
+			return mVariables;
+		}
+		const std::vector<Instruction>& instructions() const {
+			return mInstructions;
+		}
+
+		/**
+		 * Evaluates the scheme for the intervals of the variables given by their position in variables().
+		 */
+		Interval<double> evaluate(const std::vector<Interval<double>>& values) const;
+		/**
+		 * Evaluates the scheme for the given intervals, which contain all variables of the scheme.
+		 */
+		Interval<double> evaluate(const std::map<Variable, Interval<double>>& map) const;
+		/**
+		 * Evaluates the scheme for a batch of boxes, where the variables are given by their position in variables().
+		 * The boxes are evaluated in blocks with the kernels of IntervalBatchKernels, boxes with infinite
+		 * or empty intervals fall back to evaluate().
+		 * @param values Intervals of the variables in all boxes.
+		 * @param result Is set to the results for all boxes.
+		 */
+		void evaluate(const IntervalBatch& values, std::vector<Interval<double>>& result) const;
+
+		template<typename P, class S>
+		friend std::ostream& operator<<(std::ostream& os, const FlatHorner<P, S>& fh);
+	};
+
+	/**
+	 * Global cache of flattened Horner schemes, keyed by the polynomial.
+	 * Schemes are shared, for example between all Contraction objects for the same polynomial.
+	 * The cache only holds weak references: a scheme is freed as soon as it is no longer used and
+	 * is constructed again when it is requested the next time.
+	 */
+	template<typename PolynomialType, class strategy = carl::strategy>
+	class FlatHornerPool: public Singleton<FlatHornerPool<PolynomialType, strategy>>
+	{
+		friend Singleton<FlatHornerPool>;
+	public:
+		using Scheme = FlatHorner<PolynomialType, strategy>;
+	private:
+		/// Minimal number of entries at which entries of freed schemes are removed.
+		static constexpr std::size_t MIN_PRUNE_SIZE = 64;
+		std::unordered_map<PolynomialType, std::weak_ptr<const Scheme>> mSchemes;
+		/// Number of entries at which the entries of freed schemes are removed.
+		std::size_t mPruneSize = MIN_PRUNE_SIZE;
+		/// Mutex to avoid multiple access to the pool
+		mutable std::mutex mMutex;
+
+		#ifdef THREAD_SAFE
+		#define FLAT_HORNER_POOL_LOCK_GUARD std::lock_guard<std::mutex> lock(mMutex);
+		#else
+		#define FLAT_HORNER_POOL_LOCK_GUARD
+		#endif
+
+		/**
+		 * Removes the entries of freed schemes, the mutex must be locked.
+		 * The next removal happens once the number of entries has doubled, hence the cost is amortized over the insertions.
+		 */
+		void prune()
+		{
+			for (auto it = mSchemes.begin(); it != mSchemes.end();) {
+				if (it->second.expired()) {
+					it = mSchemes.erase(it);
+				} else {
+					++it;
+				}
+			}
+			mPruneSize = std::max(std::size_t(MIN_PRUNE_SIZE), 2 * mSchemes.size());
+		}
+	protected:
+		FlatHornerPool() = default;
+	public:
+		/**
+		 * @return The scheme for p, which is constructed if p is not in the cache or its scheme has been freed.
+		 */
+		std::shared_ptr<const Scheme> get(const PolynomialType& p)
+		{
+			FLAT_HORNER_POOL_LOCK_GUARD
+			auto it = mSchemes.find(p);
+			if (it != mSchemes.end()) {
+				std::shared_ptr<const Scheme> scheme = it->second.lock();
+				if (scheme) return scheme;
+			}
+			auto scheme = std::make_shared<const Scheme>(p);
+			if (it != mSchemes.end()) {
+				it->second = scheme;
+			} else {
+				if (mSchemes.size() >= mPruneSize) prune();
+				mSchemes.emplace(p, scheme);
+			}
+			return scheme;
+		}
+		/**
+		 * @return The number of schemes in the cache that are still in use.
+		 */
+		std::size_t size() const
+		{
+			FLAT_HORNER_POOL_LOCK_GUARD
+			return std::size_t(std::count_if(mSchemes.begin(), mSchemes.end(), [](const auto& entry){ return !entry.second.expired(); }));
+		}
+		/**
+		 * Removes all schemes from the cache. Schemes that are still in use stay valid.
+		 */
+		void clear()
+		{
+			FLAT_HORNER_POOL_LOCK_GUARD
+			mSchemes.clear();
+			mPruneSize = MIN_PRUNE_SIZE;
+		}
+	};
+}
+
+#include "FlatHorner.tpp"
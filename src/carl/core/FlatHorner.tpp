@@ -0,0 +1,209 @@
+/**
+ * @file FlatHorner.tpp
+ */
+
+#pragma once
+
+#include "FlatHorner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace carl
+{
+	template<typename PolynomialType, class strategy>
+	std::size_t FlatHorner<PolynomialType, strategy>::variableIndex(Variable::Arg v)
+	{
+		auto it = std::find(mVariables.begin(), mVariables.end(), v);
+		if (it != mVariables.end()) return std::size_t(it - mVariables.begin());
+		mVariables.push_back(v);
+		return mVariables.size() - 1;
+	}
+
+	template<typename PolynomialType, class strategy>
+	std::size_t FlatHorner<PolynomialType, strategy>::powerIndex(Variable::Arg v, uint exp)
+	{
+		std::pair<std::size_t, uint> power(variableIndex(v), exp);
+		auto it = std::find(mPowers.begin(), mPowers.end(), power);
+		if (it != mPowers.end()) return std::size_t(it - mPowers.begin());
+		mPowers.push_back(power);
+		return mPowers.size() - 1;
+	}
+
+	template<typename PolynomialType, class strategy>
+	std::size_t FlatHorner<PolynomialType, strategy>::constantIndex(const typename PolynomialType::CoeffType& c)
+	{
+		mConstants.emplace_back(c);
+		return mConstants.size() - 1;
+	}
+
+	template<typename PolynomialType, class strategy>
+	void FlatHorner<PolynomialType, strategy>::compile(const MultivariateHorner<PolynomialType, strategy>& h, std::size_t stack)
+	{
+		// h = var^exp * dependent + independent, where both parts are either schemes or constants.
+		mStackSize = std::max(mStackSize, stack + 1);
+		if (h.getVariable() == Variable::NO_VARIABLE) {
+			mInstructions.push_back({Opcode::CONSTANT, constantIndex(h.getIndepConstant())});
+			return;
+		}
+		std::size_t power = powerIndex(h.getVariable(), h.getExponent());
+		if (h.getDependent()) {
+			compile(*h.getDependent(), stack);
+			mInstructions.push_back({Opcode::MUL_POWER, power});
+		} else if (carl::isOne(h.getDepConstant())) {
+			mInstructions.push_back({Opcode::POWER, power});
+		} else {
+			mInstructions.push_back({Opcode::CONSTANT, constantIndex(h.getDepConstant())});
+			mInstructions.push_back({Opcode::MUL_POWER, power});
+		}
+		if (h.getIndependent()) {
+			compile(*h.getIndependent(), stack + 1);
+			mInstructions.push_back({Opcode::ADD, 0});
+		} else if (!carl::isZero(h.getIndepConstant())) {
+			mInstructions.push_back({Opcode::ADD_CONSTANT, constantIndex(h.getIndepConstant())});
+		}
+	}
+
+	template<typename PolynomialType, class strategy>
+	FlatHorner<PolynomialType, strategy>::FlatHorner(const PolynomialType& p)
+	{
+		compile(MultivariateHorner<PolynomialType, strategy>(p), 0);
+	}
+
+	template<typename PolynomialType, class strategy>
+	Interval<double> FlatHorner<PolynomialType, strategy>::evaluate(const std::vector<Interval<double>>& values) const
+	{
+		assert(values.size() == mVariables.size());
+		std::vector<Interval<double>> powers;
+		powers.reserve(mPowers.size());
+		for (const auto& p: mPowers) {
+			powers.push_back(p.second == 1 ? values[p.first] : values[p.first].pow(p.second));
+		}
+		std::vector<Interval<double>> stack;
+		stack.reserve(mStackSize);
+		for (const auto& i: mInstructions) {
+			switch (i.op) {
+				case Opcode::CONSTANT:
+					stack.push_back(mConstants[i.arg]);
+					break;
+				case Opcode::POWER:
+					stack.push_back(powers[i.arg]);
+					break;
+				case Opcode::MUL_POWER:
+					stack.back() *= powers[i.arg];
+					break;
+				case Opcode::ADD_CONSTANT:
+					stack.back() += mConstants[i.arg];
+					break;
+				case Opcode::ADD: {
+					Interval<double> top = std::move(stack.back());
+					stack.pop_back();
+					stack.back() += top;
+					break;
+				}
+			}
+		}
+		assert(stack.size() == 1);
+		return stack.back();
+	}
+
+	template<typename PolynomialType, class strategy>
+	Interval<double> FlatHorner<PolynomialType, strategy>::evaluate(const std::map<Variable, Interval<double>>& map) const
+	{
+		std::vector<Interval<double>> values;
+		values.reserve(mVariables.size());
+		for (Variable v: mVariables) {
+			assert(map.count(v) > 0);
+			values.push_back(map.find(v)->second);
+		}
+		return evaluate(values);
+	}
+
+	template<typename PolynomialType, class strategy>
+	void FlatHorner<PolynomialType, strategy>::evaluate(const IntervalBatch& values, std::vector<Interval<double>>& result) const
+	{
+		assert(values.variables() == mVariables.size());
+		// Number of boxes that are evaluated at once, such that the stack stays in the cache.
+		const std::size_t block = 256;
+		std::size_t n = values.size();
+		result.clear();
+		result.reserve(n);
+		// The bounds of every power and every stack entry are stored as block lower bounds followed by block upper bounds.
+		std::vector<double> powers(2 * mPowers.size() * block);
+		std::vector<double> stack(2 * mStackSize * block);
+		std::vector<const double*> powerLower(mPowers.size());
+		std::vector<const double*> powerUpper(mPowers.size());
+		auto lower = [block](std::vector<double>& v, std::size_t i) { return v.data() + 2 * i * block; };
+		auto upper = [block](std::vector<double>& v, std::size_t i) { return v.data() + (2 * i + 1) * block; };
+		for (std::size_t start = 0; start < n; start += block) {
+			std::size_t size = std::min(block, n - start);
+			for (std::size_t p = 0; p < mPowers.size(); p++) {
+				const double* l = values.lower(mPowers[p].first) + start;
+				const double* u = values.upper(mPowers[p].first) + start;
+				if (mPowers[p].second == 1) {
+					powerLower[p] = l;
+					powerUpper[p] = u;
+				} else {
+					IntervalBatchKernels::pow(size, l, u, mPowers[p].second, lower(powers, p), upper(powers, p));
+					powerLower[p] = lower(powers, p);
+					powerUpper[p] = upper(powers, p);
+				}
+			}
+			std::size_t top = 0;
+			for (const auto& i: mInstructions) {
+				switch (i.op) {
+					case Opcode::CONSTANT:
+						std::fill_n(lower(stack, top), size, mConstants[i.arg].lower());
+						std::fill_n(upper(stack, top), size, mConstants[i.arg].upper());
+						top++;
+						break;
+					case Opcode::POWER:
+						std::copy_n(powerLower[i.arg], size, lower(stack, top));
+						std::copy_n(powerUpper[i.arg], size, upper(stack, top));
+						top++;
+						break;
+					case Opcode::MUL_POWER:
+						IntervalBatchKernels::mul(size, lower(stack, top - 1), upper(stack, top - 1), powerLower[i.arg], powerUpper[i.arg], lower(stack, top - 1), upper(stack, top - 1));
+						break;
+					case Opcode::ADD_CONSTANT:
+						IntervalBatchKernels::addConstant(size, mConstants[i.arg].lower(), mConstants[i.arg].upper(), lower(stack, top - 1), upper(stack, top - 1));
+						break;
+					case Opcode::ADD:
+						IntervalBatchKernels::add(size, lower(stack, top - 2), upper(stack, top - 2), lower(stack, top - 1), upper(stack, top - 1), lower(stack, top - 2), upper(stack, top - 2));
+						top--;
+						break;
+				}
+			}
+			assert(top == 1);
+			for (std::size_t b = 0; b < size; b++) {
+				double l = lower(stack, 0)[b];
+				double u = upper(stack, 0)[b];
+				if (std::isfinite(l) && std::isfinite(u)) {
+					result.emplace_back(l, u);
+					continue;
+				}
+				// Infinite or empty intervals, or an overflow.
+				std::vector<Interval<double>> box;
+				box.reserve(mVariables.size());
+				for (std::size_t v = 0; v < mVariables.size(); v++) box.push_back(values.get(v, start + b));
+				result.push_back(evaluate(box));
+			}
+		}
+	}
+
+	template<typename P, class S>
+	std::ostream& operator<<(std::ostream& os, const FlatHorner<P, S>& fh)
+	{
+		for (const auto& i: fh.mInstructions) {
+			switch (i.op) {
+				case FlatHorner<P, S>::Opcode::CONSTANT: os << "push " << fh.mConstants[i.arg]; break;
+				case FlatHorner<P, S>::Opcode::POWER: os << "push " << fh.mVariables[fh.mPowers[i.arg].first] << "^" << fh.mPowers[i.arg].second; break;
+				case FlatHorner<P, S>::Opcode::MUL_POWER: os << "mul " << fh.mVariables[fh.mPowers[i.arg].first] << "^" << fh.mPowers[i.arg].second; break;
+				case FlatHorner<P, S>::Opcode::ADD_CONSTANT: os << "add " << fh.mConstants[i.arg]; break;
+				case FlatHorner<P, S>::Opcode::ADD: os << "add"; break;
+			}
+			os << "; ";
+		}
+		return os;
+	}
+}
@@ -7,6 +7,8 @@
 
 #include "../io/streamingOperators.h"
 
+#include <algorithm>
+
 namespace carl
 {
 #ifdef PRUNE_MONOMIAL_POOL
@@ -29,6 +31,12 @@ namespace carl
 			res->mId = mIDs.get();
 		} else {
 			res = iter.first->monomial.lock();
+			if (!res) {
+				// The monomial of this entry is being destroyed by another thread, which has not yet called free().
+				res = Monomial::Arg(new Monomial(iter.first->hash, iter.first->content));
+				iter.first->monomial = res;
+				res->mId = mIDs.get();
+			}
 		}
 		return res;
 	}
@@ -42,7 +50,13 @@ namespace carl
 			_monomial->mId = mIDs.get();
 			return _monomial;
 		} else {
-			return iter.first->monomial.lock();
+			Monomial::Arg res = iter.first->monomial.lock();
+			if (!res) {
+				iter.first->monomial = _monomial;
+				_monomial->mId = mIDs.get();
+				res = _monomial;
+			}
+			return res;
 		}
 	}
 #else
@@ -95,4 +109,23 @@ namespace carl
 	{
 		return add(std::move(_exponents));
 	}
+
+	std::vector<Monomial::Arg> MonomialPool::monomials() const
+	{
+		std::vector<Monomial::Arg> res;
+		{
+			MONOMIAL_POOL_LOCK_GUARD
+			res.reserve(mPool.size());
+			for (const auto& pe: mPool) {
+#ifdef PRUNE_MONOMIAL_POOL
+				Monomial::Arg m = pe.monomial.lock();
+#else
+				const Monomial::Arg& m = pe.monomial;
+#endif
+				if (m) res.push_back(m);
+			}
+		}
+		std::sort(res.begin(), res.end(), [](const Monomial::Arg& m1, const Monomial::Arg& m2){ return m1->id() < m2->id(); });
+		return res;
+	}
 } // end namespace carl
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 namespace carl{
 
@@ -130,15 +131,20 @@ namespace carl{
 				MONOMIAL_POOL_LOCK_GUARD;
 				PoolEntry pe(m->mHash, m->mExponents);
 				auto it = mPool.find(pe);
-				if (it != mPool.end()) {
-					mIDs.free(m->id());
+				// The entry may already refer to a new monomial, if it was requested while m was destroyed.
+				if (it != mPool.end() && it->monomial.expired()) {
 					mPool.erase(it);
 				}
+				mIDs.free(m->id());
 			}
 #endif
 			std::size_t size() const {
 				return mPool.size();
 			}
+			/**
+			 * @return All monomials currently in the pool, ordered by their ids.
+			 */
+			std::vector<Monomial::Arg> monomials() const;
 			std::size_t nextID() const {
 				return mIDs.nextID();
 			}
@@ -183,6 +183,12 @@ namespace carl
          */
         void setNewFactors( const FactorizedPolynomial<P>& _fpolyA, carl::exponent exponentA, const FactorizedPolynomial<P>& _fpolyB, carl::exponent exponentB ) const;
 
+        /**
+         * Set new factorization for polynomial.
+         * @param _factorization The factorization, whose product must be the polynomial.
+         */
+        void setNewFactors( Factorization<P>&& _factorization ) const;
+
         bool isIrreducible() const;
 
     public:
@@ -253,6 +259,20 @@ namespace carl
         template<typename P1>
         friend Factorization<P1> gcd( const PolynomialFactorizationPair<P1>& _pfPairA, const PolynomialFactorizationPair<P1>& _pfPairB, Factorization<P1>& _restA, Factorization<P1>& _restB, typename P1::CoeffType& _coeff, bool& _pfPairARefined, bool& _pfPairBRefined );
         
+        /**
+         * Refines the factorizations of the two given polynomial factorization pairs to factorizations over a common
+         * base of all their factors (see CoprimeBase), in which every factor of the one factorization is either equal
+         * or coprime to every factor of the other one, such that their gcd consists of the common factors.
+         * The factors that are split are refined as well.
+         * @param _pfPairA The first polynomial factorization pair to refine.
+         * @param _pfPairB The second polynomial factorization pair to refine.
+         * @param _threads The number of threads computing the gcds of the factors, 0 meaning one per hardware thread.
+         * @param _pfPairARefined A bool which is set to true, if the factorization of the first given polynomial factorization pair has been refined.
+         * @param _pfPairBRefined A bool which is set to true, if the factorization of the second given polynomial factorization pair has been refined.
+         */
+        template<typename P1>
+        friend void refine( const PolynomialFactorizationPair<P1>& _pfPairA, const PolynomialFactorizationPair<P1>& _pfPairB, std::size_t _threads, bool& _pfPairARefined, bool& _pfPairBRefined );
+        
         /**
          * @param _pfPair The polynomial to calculate the factorization for.
          * @return A factorization of this factorized polynomial. (probably finer than the one factorization() returns)
@@ -9,9 +9,12 @@
 
 #include "PolynomialFactorizationPair.h"
 
+#include "CoprimeBase.h"
 #include "FactorizedPolynomial.h"
 #include "logging.h"
 
+#include <algorithm>
+
 namespace carl
 {
     template <typename P>
@@ -150,8 +153,9 @@ namespace carl
         //TODO fix
         //if ( _polyFactA.mHash != _polyFactB.mHash )
         //    return false;
-        std::lock_guard<std::recursive_mutex> lockA( _polyFactA.mMutex );
-        std::lock_guard<std::recursive_mutex> lockB( _polyFactB.mMutex );
+        std::lock( _polyFactA.mMutex, _polyFactB.mMutex );
+        std::lock_guard<std::recursive_mutex> lockA( _polyFactA.mMutex, std::adopt_lock );
+        std::lock_guard<std::recursive_mutex> lockB( _polyFactB.mMutex, std::adopt_lock );
         if( _polyFactA.mpPolynomial != nullptr && _polyFactB.mpPolynomial != nullptr )
         {
             return *_polyFactA.mpPolynomial == *_polyFactB.mpPolynomial;
@@ -177,8 +181,9 @@ namespace carl
     {
         if( &_polyFactA == &_polyFactB )
             return false;
-        std::lock_guard<std::recursive_mutex> lockA( _polyFactA.mMutex );
-        std::lock_guard<std::recursive_mutex> lockB( _polyFactB.mMutex );
+        std::lock( _polyFactA.mMutex, _polyFactB.mMutex );
+        std::lock_guard<std::recursive_mutex> lockA( _polyFactA.mMutex, std::adopt_lock );
+        std::lock_guard<std::recursive_mutex> lockB( _polyFactB.mMutex, std::adopt_lock );
         if( _polyFactA.mpPolynomial != nullptr && _polyFactB.mpPolynomial != nullptr )
         {
             return *_polyFactA.mpPolynomial < *_polyFactB.mpPolynomial;
@@ -219,8 +224,9 @@ namespace carl
     {
         if( &_toUpdate == &_updateWith )
             return false;
-        std::lock_guard<std::recursive_mutex> lockA( _toUpdate.mMutex );
-        std::lock_guard<std::recursive_mutex> lockB( _updateWith.mMutex );
+        std::lock( _toUpdate.mMutex, _updateWith.mMutex );
+        std::lock_guard<std::recursive_mutex> lockA( _toUpdate.mMutex, std::adopt_lock );
+        std::lock_guard<std::recursive_mutex> lockB( _updateWith.mMutex, std::adopt_lock );
         assert( _toUpdate.getHash() == _updateWith.getHash() && _toUpdate == _updateWith );
         if( _toUpdate.mpPolynomial == nullptr && _updateWith.mpPolynomial != nullptr )
             return true;
@@ -234,8 +240,9 @@ namespace carl
         assert( canBeUpdated( _toUpdate, _updateWith ) ); // This assertion only ensures efficient use this method.
         assert( &_toUpdate != &_updateWith );
         assert( _toUpdate.mpPolynomial == nullptr || _updateWith.mpPolynomial == nullptr || *_toUpdate.mpPolynomial == *_updateWith.mpPolynomial );
-        std::lock_guard<std::recursive_mutex> lockA( _toUpdate.mMutex );
-        std::lock_guard<std::recursive_mutex> lockB( _updateWith.mMutex );
+        std::lock( _toUpdate.mMutex, _updateWith.mMutex );
+        std::lock_guard<std::recursive_mutex> lockA( _toUpdate.mMutex, std::adopt_lock );
+        std::lock_guard<std::recursive_mutex> lockB( _updateWith.mMutex, std::adopt_lock );
         if( _toUpdate.mpPolynomial == nullptr && _updateWith.mpPolynomial != nullptr )
             _toUpdate.mpPolynomial = _updateWith.mpPolynomial;
         // The factorization of the PolynomialFactorizationPair to update which can be empty, if constructed freshly by a polynomial.
@@ -368,6 +375,18 @@ namespace carl
         assert( assertFactorization() );
     }
     
+    template<typename P>
+    void PolynomialFactorizationPair<P>::setNewFactors( Factorization<P>&& _factorization ) const
+    {
+        std::lock_guard<std::recursive_mutex> lock( mMutex );
+        assert( factorizedTrivially() );
+        assert( !_factorization.empty() );
+        mFactorization = std::move( _factorization );
+        assert( mpPolynomial != nullptr );
+        assert( *mpPolynomial == computePolynomial( mFactorization ) );
+        assert( assertFactorization() );
+    }
+    
     template<typename P>
     Factorization<P> gcd( const PolynomialFactorizationPair<P>& _pfPairA, const PolynomialFactorizationPair<P>& _pfPairB, Factorization<P>& _restA, Factorization<P>& _restB, typename P::CoeffType& _coeff, bool& _pfPairARefined, bool& _pfPairBRefined )
     {
@@ -375,8 +394,9 @@ namespace carl
         CARL_LOG_DEBUG( "carl.core.factorizedpolynomial", "Compute GCD (internal) of " << _pfPairA << " and " << _pfPairB );
         if( &_pfPairA == &_pfPairB )
             return _pfPairA.factorization();
-        std::lock_guard<std::recursive_mutex> lockA( _pfPairA.mMutex );
-        std::lock_guard<std::recursive_mutex> lockB( _pfPairB.mMutex );
+        std::lock( _pfPairA.mMutex, _pfPairB.mMutex );
+        std::lock_guard<std::recursive_mutex> lockA( _pfPairA.mMutex, std::adopt_lock );
+        std::lock_guard<std::recursive_mutex> lockB( _pfPairB.mMutex, std::adopt_lock );
         _coeff = typename P::CoeffType( 1 );
         _pfPairARefined = false;
         _pfPairBRefined = false;
@@ -502,7 +522,7 @@ namespace carl
                         P remainA = polA.quotient( polGCD );
                         P remainB = polB.quotient( polGCD );
                         carl::exponent exponentCommon = exponentA < exponentB ? exponentA : exponentB;
-                        std::shared_ptr<Cache<PolynomialFactorizationPair<P>>> cache = factorA.pCache();
+                        std::shared_ptr<typename FactorizedPolynomial<P>::CACHE> cache = factorA.pCache();
                         //Set new part of GCD
                         FactorizedPolynomial<P> gcdResult( polGCD, cache );
                         result.insert( std::pair<FactorizedPolynomial<P>, carl::exponent>( gcdResult,  exponentCommon ) );
@@ -591,6 +611,84 @@ namespace carl
         return result;
     }
     
+    template<typename P>
+    void refine( const PolynomialFactorizationPair<P>& _pfPairA, const PolynomialFactorizationPair<P>& _pfPairB, std::size_t _threads, bool& _pfPairARefined, bool& _pfPairBRefined )
+    {
+        _pfPairARefined = false;
+        _pfPairBRefined = false;
+        if( &_pfPairA == &_pfPairB )
+            return;
+        std::lock( _pfPairA.mMutex, _pfPairB.mMutex );
+        std::lock_guard<std::recursive_mutex> lockA( _pfPairA.mMutex, std::adopt_lock );
+        std::lock_guard<std::recursive_mutex> lockB( _pfPairB.mMutex, std::adopt_lock );
+        typename P::CoeffType coeff( 1 );
+        // Flatten until all factors are factorized trivially
+        auto flatten = [&coeff]( const PolynomialFactorizationPair<P>& _pfPair, bool& _refined )
+        {
+            for( typename P::CoeffType c = _pfPair.flattenFactorization(); c != typename P::CoeffType( 0 ); c = _pfPair.flattenFactorization() )
+            {
+                _refined = true;
+                coeff *= c;
+            }
+        };
+        flatten( _pfPairA, _pfPairARefined );
+        flatten( _pfPairB, _pfPairBRefined );
+
+        // The factors of both factorizations, where the factors of each factorization form a group as
+        // only factors of different factorizations need to be coprime to cancel the gcd
+        std::vector<FactorizedPolynomial<P>> factors;
+        std::vector<typename CoprimeBase<P>::Groups> groups;
+        for( const auto& factor : _pfPairA.mFactorization )
+        {
+            factors.push_back( factor.first );
+            groups.push_back( 1 );
+        }
+        for( const auto& factor : _pfPairB.mFactorization )
+        {
+            auto pos = std::lower_bound( factors.begin(), factors.begin() + _pfPairA.mFactorization.size(), factor.first );
+            if( pos != factors.begin() + _pfPairA.mFactorization.size() && *pos == factor.first )
+            {
+                groups[std::size_t( pos - factors.begin() )] |= 2;
+                continue;
+            }
+            factors.push_back( factor.first );
+            groups.push_back( 2 );
+        }
+        CoprimeBase<P> base( _threads );
+        for( std::size_t i = 0; i < factors.size(); ++i )
+        {
+            assert( factors[i].content().factorizedTrivially() );
+            assert( factors[i].content().mpPolynomial != nullptr );
+            base.add( *factors[i].content().mpPolynomial, groups[i], factors[i].content().isIrreducible() );
+        }
+        base.compute();
+
+        std::shared_ptr<typename FactorizedPolynomial<P>::CACHE> cache = factors.front().pCache();
+        std::vector<FactorizedPolynomial<P>> baseFactors;
+        for( const auto& polynomial : base.base() )
+            baseFactors.emplace_back( polynomial, cache, true );
+        for( std::size_t i = 0; i < factors.size(); ++i )
+        {
+            const auto& decomposition = base.decomposition( i );
+            assert( !decomposition.empty() );
+            if( decomposition.size() == 1 && decomposition.front().second == 1 )
+                continue;
+            Factorization<P> factorization;
+            for( const auto& part : decomposition )
+                factorization.insert( std::pair<FactorizedPolynomial<P>, carl::exponent>( baseFactors[part.first], part.second ) );
+            CARL_LOG_DEBUG( "carl.core.factorizedpolynomial", "Refine " << factors[i] << " to " << factorization );
+            factors[i].content().setNewFactors( std::move( factorization ) );
+            _pfPairARefined = _pfPairARefined || ( groups[i] & 1 ) != 0;
+            _pfPairBRefined = _pfPairBRefined || ( groups[i] & 2 ) != 0;
+        }
+        flatten( _pfPairA, _pfPairARefined );
+        flatten( _pfPairB, _pfPairBRefined );
+        assert( carl::isOne( coeff ) );
+        assert( _pfPairA.assertFactorization() );
+        assert( _pfPairB.assertFactorization() );
+        CARL_LOG_DEBUG( "carl.core.factorizedpolynomial", "Refined to " << _pfPairA << " and " << _pfPairB << " with " << base.gcds() << " gcds in " << base.rounds() << " rounds" );
+    }
+    
     template<typename P>
     Factors<FactorizedPolynomial<P>> factor( const PolynomialFactorizationPair<P>& _pfPair, const typename P::CoeffType& _coeff )
     {
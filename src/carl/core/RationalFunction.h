@@ -349,6 +349,25 @@ namespace carl
          * @param _justNormalize
          */
         void eliminateCommonFactor( bool _justNormalize );
+
+        /**
+         * Refines the numerator and the denominator such that lazyDiv() cancels their gcd.
+         * Factorized polynomials are refined by refineFactorizations() if FactorizedPolynomial::refinementThreads is not one.
+         */
+        template<typename P = Pol, EnableIf<needs_cache<P>> = dummy>
+        void refineCommonFactor()
+        {
+            if( P::refinementThreads == 1 )
+                carl::gcd( nominatorAsPolynomial(), denominatorAsPolynomial() );
+            else
+                refineFactorizations( nominatorAsPolynomial(), denominatorAsPolynomial(), P::refinementThreads );
+        }
+
+        template<typename P = Pol, DisableIf<needs_cache<P>> = dummy>
+        void refineCommonFactor()
+        {
+            carl::gcd( nominatorAsPolynomial(), denominatorAsPolynomial() );
+        }
         
         template<bool byInverse = false>
         RationalFunction& add(const RationalFunction& rhs);
@@ -59,7 +59,7 @@ namespace carl
         CoeffType cpFactor( std::move( cpFactorDen/cpFactorNom ) );
         if(!_justNormalize && !denominatorAsPolynomial().isConstant())
         {
-            carl::gcd(nominatorAsPolynomial(), denominatorAsPolynomial());
+            refineCommonFactor();
             auto ret = carl::lazyDiv( nominatorAsPolynomial(), denominatorAsPolynomial() );
             mPolynomialQuotient->first = std::move( ret.first );
             mPolynomialQuotient->second = std::move( ret.second );
@@ -0,0 +1,149 @@
+/**
+ * @file RationalFunctionEvaluator.h
+ *
+ * A rational function compiled into a straight-line program for repeated evaluation.
+ */
+
+#pragma once
+
+#include "MultivariateHorner.h"
+#include "RationalFunction.h"
+#include "../interval/Interval.h"
+#include "../interval/IntervalBatch.h"
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace carl
+{
+	/**
+	 * Numerator and denominator of a rational function compiled into a single straight-line program.
+	 *
+	 * Both polynomials are transformed into Horner schemes, which are then translated into additions
+	 * and multiplications of registers. Equal subexpressions are computed only once, also if they occur
+	 * in both the numerator and the denominator, and powers are computed by repeated squaring from the
+	 * powers computed before. Registers are reused as soon as their value is no longer needed.
+	 *
+	 * The registers are numbered such that the variables come first, by their position in variables(),
+	 * followed by the constants and the temporary registers.
+	 *
+	 * The program can be evaluated exactly at single points, in double precision at batches of points,
+	 * where the operations are applied to blocks of points with the kernels of DoubleBatchKernels, and
+	 * with interval arithmetic at batches of boxes, which certifies the results and flags points at
+	 * which the denominator may vanish.
+	 */
+	template<typename Pol, class strategy = carl::strategy>
+	class RationalFunctionEvaluator
+	{
+	public:
+		using CoeffType = typename Pol::CoeffType;
+
+		enum class Opcode : unsigned char {
+			ADD,
+			MUL
+		};
+		/// Computes result = lhs op rhs, where all arguments are registers.
+		struct Instruction {
+			Opcode op;
+			std::size_t result;
+			std::size_t lhs;
+			std::size_t rhs;
+		};
+	private:
+		/// A node of the expression graph built during the compilation.
+		struct Node {
+			enum class Kind : unsigned char { VARIABLE, CONSTANT, ADD, MUL };
+			Kind kind;
+			std::size_t lhs;
+			std::size_t rhs;
+		};
+		/// The expression graph, where equal nodes are shared.
+		struct Graph {
+			std::vector<Node> nodes;
+			std::map<std::tuple<typename Node::Kind, std::size_t, std::size_t>, std::size_t> index;
+			std::map<std::pair<std::size_t, uint>, std::size_t> powers;
+			std::map<CoeffType, std::size_t> constants;
+		};
+
+		/// Variables, indexed by their position.
+		std::vector<Variable> mVariables;
+		std::vector<CoeffType> mConstants;
+		std::vector<double> mDoubleConstants;
+		std::vector<Interval<double>> mIntervalConstants;
+		std::vector<Instruction> mInstructions;
+		/// The total number of registers.
+		std::size_t mRegisters = 0;
+		/// The registers holding the numerator and the denominator after the evaluation.
+		std::size_t mNumerator = 0;
+		std::size_t mDenominator = 0;
+
+		std::size_t node(Graph& g, typename Node::Kind kind, std::size_t lhs, std::size_t rhs);
+		std::size_t variableNode(Graph& g, Variable::Arg v);
+		std::size_t constantNode(Graph& g, const CoeffType& c);
+		std::size_t powerNode(Graph& g, Variable::Arg v, uint exp);
+		std::size_t compile(Graph& g, const MultivariateHorner<Pol, strategy>& h);
+		std::size_t compile(Graph& g, const Pol& p);
+		/// Assigns registers to the nodes and emits the instructions.
+		void linearize(const Graph& g, std::size_t numerator, std::size_t denominator);
+
+		/**
+		 * Executes the program on single values.
+		 * @param registers Contains the values of the variables and the constants, and is extended by the temporary registers.
+		 */
+		template<typename T>
+		void execute(std::vector<T>& registers) const;
+	public:
+		RationalFunctionEvaluator(const Pol& numerator, const Pol& denominator);
+
+		template<bool AS>
+		explicit RationalFunctionEvaluator(const RationalFunction<Pol, AS>& rf):
+			RationalFunctionEvaluator(rf.isConstant() ? Pol(rf.nominatorAsNumber()) : rf.nominatorAsPolynomial(), rf.isConstant() ? Pol(rf.denominatorAsNumber()) : rf.denominatorAsPolynomial())
+		{}
+
+		const std::vector<Variable>& variables() const {
+			return mVariables;
+		}
+		const std::vector<Instruction>& instructions() const {
+			return mInstructions;
+		}
+		/// @return The number of registers, including those for the variables and the constants.
+		std::size_t registers() const {
+			return mRegisters;
+		}
+
+		/**
+		 * Evaluates the rational function exactly, where the variables are given by their position in variables().
+		 * The denominator must not vanish.
+		 */
+		CoeffType evaluate(const std::vector<CoeffType>& values) const;
+		/**
+		 * Evaluates the rational function exactly at the given point, which assigns all variables of the function.
+		 */
+		CoeffType evaluate(const std::map<Variable, CoeffType>& point) const;
+
+		/**
+		 * Evaluates the rational function in double precision at n points.
+		 * Points at which the denominator is zero yield an infinite value or NaN.
+		 * @param n The number of points.
+		 * @param values For every variable, by its position in variables(), an array of its values at all points.
+		 * @param result An array that is set to the values at all points.
+		 */
+		void evaluate(std::size_t n, const std::vector<const double*>& values, double* result) const;
+
+		/**
+		 * Evaluates the rational function with interval arithmetic for a batch of boxes, for example of
+		 * point intervals, where the variables are given by their position in variables().
+		 * @param values Intervals of the variables in all boxes.
+		 * @param result Is set to enclosures of the values of the rational function in all boxes.
+		 * @param nearPole Is set to true for boxes in which the enclosure of the denominator contains zero,
+		 * the result of such a box is unbounded.
+		 */
+		void evaluate(const IntervalBatch& values, std::vector<Interval<double>>& result, std::vector<bool>& nearPole) const;
+
+		template<typename P, class S>
+		friend std::ostream& operator<<(std::ostream& os, const RationalFunctionEvaluator<P, S>& rfe);
+	};
+}
+
+#include "RationalFunctionEvaluator.tpp"
@@ -0,0 +1,308 @@
+/**
+ * @file RationalFunctionEvaluator.tpp
+ */
+
+#pragma once
+
+#include "RationalFunctionEvaluator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace carl
+{
+	template<typename Pol, class strategy>
+	std::size_t RationalFunctionEvaluator<Pol, strategy>::node(Graph& g, typename Node::Kind kind, std::size_t lhs, std::size_t rhs)
+	{
+		// Both operations are commutative, hence the operands are ordered to find more common subexpressions.
+		if ((kind == Node::Kind::ADD || kind == Node::Kind::MUL) && rhs < lhs) std::swap(lhs, rhs);
+		auto it = g.index.find(std::make_tuple(kind, lhs, rhs));
+		if (it != g.index.end()) return it->second;
+		g.nodes.push_back({kind, lhs, rhs});
+		g.index.emplace(std::make_tuple(kind, lhs, rhs), g.nodes.size() - 1);
+		return g.nodes.size() - 1;
+	}
+
+	template<typename Pol, class strategy>
+	std::size_t RationalFunctionEvaluator<Pol, strategy>::variableNode(Graph& g, Variable::Arg v)
+	{
+		auto it = std::find(mVariables.begin(), mVariables.end(), v);
+		std::size_t index = std::size_t(it - mVariables.begin());
+		if (it == mVariables.end()) mVariables.push_back(v);
+		return node(g, Node::Kind::VARIABLE, index, 0);
+	}
+
+	template<typename Pol, class strategy>
+	std::size_t RationalFunctionEvaluator<Pol, strategy>::constantNode(Graph& g, const CoeffType& c)
+	{
+		auto it = g.constants.find(c);
+		if (it != g.constants.end()) return it->second;
+		mConstants.push_back(c);
+		mDoubleConstants.push_back(carl::toDouble(c));
+		mIntervalConstants.emplace_back(c);
+		std::size_t res = node(g, Node::Kind::CONSTANT, mConstants.size() - 1, 0);
+		g.constants.emplace(c, res);
+		return res;
+	}
+
+	template<typename Pol, class strategy>
+	std::size_t RationalFunctionEvaluator<Pol, strategy>::powerNode(Graph& g, Variable::Arg v, uint exp)
+	{
+		assert(exp > 0);
+		std::size_t var = variableNode(g, v);
+		if (exp == 1) return var;
+		// Squaring shares the smaller powers with all other powers of the variable.
+		std::size_t half = powerNode(g, v, exp / 2);
+		std::size_t res = node(g, Node::Kind::MUL, half, half);
+		if (exp % 2 == 1) res = node(g, Node::Kind::MUL, res, var);
+		return res;
+	}
+
+	template<typename Pol, class strategy>
+	std::size_t RationalFunctionEvaluator<Pol, strategy>::compile(Graph& g, const MultivariateHorner<Pol, strategy>& h)
+	{
+		// h = var^exp * dependent + independent, where both parts are either schemes or constants.
+		if (h.getVariable() == Variable::NO_VARIABLE) {
+			return constantNode(g, h.getIndepConstant());
+		}
+		std::size_t res = powerNode(g, h.getVariable(), h.getExponent());
+		if (h.getDependent()) {
+			res = node(g, Node::Kind::MUL, compile(g, *h.getDependent()), res);
+		} else if (!carl::isOne(h.getDepConstant())) {
+			res = node(g, Node::Kind::MUL, constantNode(g, h.getDepConstant()), res);
+		}
+		if (h.getIndependent()) {
+			res = node(g, Node::Kind::ADD, res, compile(g, *h.getIndependent()));
+		} else if (!carl::isZero(h.getIndepConstant())) {
+			res = node(g, Node::Kind::ADD, res, constantNode(g, h.getIndepConstant()));
+		}
+		return res;
+	}
+
+	template<typename Pol, class strategy>
+	std::size_t RationalFunctionEvaluator<Pol, strategy>::compile(Graph& g, const Pol& p)
+	{
+		if (p.isConstant()) return constantNode(g, p.constantPart());
+		return compile(g, MultivariateHorner<Pol, strategy>(p));
+	}
+
+	template<typename Pol, class strategy>
+	void RationalFunctionEvaluator<Pol, strategy>::linearize(const Graph& g, std::size_t numerator, std::size_t denominator)
+	{
+		auto isTemporary = [&g](std::size_t n) {
+			return g.nodes[n].kind == Node::Kind::ADD || g.nodes[n].kind == Node::Kind::MUL;
+		};
+		// The nodes are created after their operands, hence their order is a topological order.
+		std::vector<std::size_t> lastUse(g.nodes.size(), 0);
+		for (std::size_t n = 0; n < g.nodes.size(); n++) {
+			if (!isTemporary(n)) continue;
+			lastUse[g.nodes[n].lhs] = n;
+			lastUse[g.nodes[n].rhs] = n;
+		}
+		lastUse[numerator] = g.nodes.size();
+		lastUse[denominator] = g.nodes.size();
+
+		std::vector<std::size_t> registerOf(g.nodes.size());
+		std::vector<std::size_t> unused;
+		mRegisters = mVariables.size() + mConstants.size();
+		for (std::size_t n = 0; n < g.nodes.size(); n++) {
+			const Node& node = g.nodes[n];
+			if (node.kind == Node::Kind::VARIABLE) {
+				registerOf[n] = node.lhs;
+				continue;
+			}
+			if (node.kind == Node::Kind::CONSTANT) {
+				registerOf[n] = mVariables.size() + node.lhs;
+				continue;
+			}
+			// Operands are released first, as the result may overwrite an operand.
+			if (isTemporary(node.lhs) && lastUse[node.lhs] == n) unused.push_back(registerOf[node.lhs]);
+			if (node.rhs != node.lhs && isTemporary(node.rhs) && lastUse[node.rhs] == n) unused.push_back(registerOf[node.rhs]);
+			if (unused.empty()) {
+				registerOf[n] = mRegisters++;
+			} else {
+				registerOf[n] = unused.back();
+				unused.pop_back();
+			}
+			Opcode op = node.kind == Node::Kind::ADD ? Opcode::ADD : Opcode::MUL;
+			mInstructions.push_back({op, registerOf[n], registerOf[node.lhs], registerOf[node.rhs]});
+		}
+		mNumerator = registerOf[numerator];
+		mDenominator = registerOf[denominator];
+	}
+
+	template<typename Pol, class strategy>
+	RationalFunctionEvaluator<Pol, strategy>::RationalFunctionEvaluator(const Pol& numerator, const Pol& denominator)
+	{
+		assert(!denominator.isZero());
+		Graph g;
+		std::size_t num = compile(g, numerator);
+		std::size_t den = compile(g, denominator);
+		// The constants are numbered after the variables, which are only known now.
+		linearize(g, num, den);
+		CARL_LOG_DEBUG("carl.core.evaluator", "Compiled " << numerator << " / " << denominator << " into " << mInstructions.size() << " instructions on " << mRegisters << " registers");
+	}
+
+	template<typename Pol, class strategy>
+	template<typename T>
+	void RationalFunctionEvaluator<Pol, strategy>::execute(std::vector<T>& registers) const
+	{
+		assert(registers.size() == mVariables.size() + mConstants.size());
+		registers.resize(mRegisters);
+		for (const auto& i: mInstructions) {
+			switch (i.op) {
+				case Opcode::ADD:
+					registers[i.result] = registers[i.lhs] + registers[i.rhs];
+					break;
+				case Opcode::MUL:
+					registers[i.result] = registers[i.lhs] * registers[i.rhs];
+					break;
+			}
+		}
+	}
+
+	template<typename Pol, class strategy>
+	typename RationalFunctionEvaluator<Pol, strategy>::CoeffType RationalFunctionEvaluator<Pol, strategy>::evaluate(const std::vector<CoeffType>& values) const
+	{
+		assert(values.size() == mVariables.size());
+		std::vector<CoeffType> registers(values);
+		registers.insert(registers.end(), mConstants.begin(), mConstants.end());
+		execute(registers);
+		assert(!carl::isZero(registers[mDenominator]));
+		return registers[mNumerator] / registers[mDenominator];
+	}
+
+	template<typename Pol, class strategy>
+	typename RationalFunctionEvaluator<Pol, strategy>::CoeffType RationalFunctionEvaluator<Pol, strategy>::evaluate(const std::map<Variable, CoeffType>& point) const
+	{
+		std::vector<CoeffType> values;
+		values.reserve(mVariables.size());
+		for (Variable v: mVariables) {
+			assert(point.count(v) > 0);
+			values.push_back(point.find(v)->second);
+		}
+		return evaluate(values);
+	}
+
+	template<typename Pol, class strategy>
+	void RationalFunctionEvaluator<Pol, strategy>::evaluate(std::size_t n, const std::vector<const double*>& values, double* result) const
+	{
+		assert(values.size() == mVariables.size());
+		// Number of points that are evaluated at once, such that the registers stay in the cache.
+		const std::size_t block = 256;
+		std::size_t constants = mVariables.size();
+		std::size_t temporaries = constants + mConstants.size();
+		// Every register but those of the variables holds the values at a block of points.
+		std::vector<double> storage((mRegisters - constants) * block);
+		auto output = [&](std::size_t r) { return storage.data() + (r - constants) * block; };
+		std::vector<const double*> input(mRegisters);
+		for (std::size_t c = constants; c < temporaries; c++) {
+			std::fill_n(output(c), block, mDoubleConstants[c - constants]);
+			input[c] = output(c);
+		}
+		for (std::size_t r = temporaries; r < mRegisters; r++) input[r] = output(r);
+		for (std::size_t start = 0; start < n; start += block) {
+			std::size_t size = std::min(block, n - start);
+			for (std::size_t v = 0; v < constants; v++) input[v] = values[v] + start;
+			for (const auto& i: mInstructions) {
+				switch (i.op) {
+					case Opcode::ADD:
+						DoubleBatchKernels::add(size, input[i.lhs], input[i.rhs], output(i.result));
+						break;
+					case Opcode::MUL:
+						DoubleBatchKernels::mul(size, input[i.lhs], input[i.rhs], output(i.result));
+						break;
+				}
+			}
+			DoubleBatchKernels::div(size, input[mNumerator], input[mDenominator], result + start);
+		}
+	}
+
+	template<typename Pol, class strategy>
+	void RationalFunctionEvaluator<Pol, strategy>::evaluate(const IntervalBatch& values, std::vector<Interval<double>>& result, std::vector<bool>& nearPole) const
+	{
+		assert(values.variables() == mVariables.size());
+		const std::size_t block = 256;
+		std::size_t n = values.size();
+		std::size_t constants = mVariables.size();
+		std::size_t temporaries = constants + mConstants.size();
+		result.clear();
+		result.reserve(n);
+		nearPole.assign(n, false);
+		// The bounds of every register are stored as block lower bounds followed by block upper bounds.
+		std::vector<double> storage(2 * (mRegisters - constants) * block);
+		auto lower = [&](std::size_t r) { return storage.data() + 2 * (r - constants) * block; };
+		auto upper = [&](std::size_t r) { return storage.data() + (2 * (r - constants) + 1) * block; };
+		std::vector<const double*> inputLower(mRegisters);
+		std::vector<const double*> inputUpper(mRegisters);
+		for (std::size_t c = constants; c < temporaries; c++) {
+			std::fill_n(lower(c), block, mIntervalConstants[c - constants].lower());
+			std::fill_n(upper(c), block, mIntervalConstants[c - constants].upper());
+		}
+		for (std::size_t r = constants; r < mRegisters; r++) {
+			inputLower[r] = lower(r);
+			inputUpper[r] = upper(r);
+		}
+		for (std::size_t start = 0; start < n; start += block) {
+			std::size_t size = std::min(block, n - start);
+			for (std::size_t v = 0; v < constants; v++) {
+				inputLower[v] = values.lower(v) + start;
+				inputUpper[v] = values.upper(v) + start;
+			}
+			for (const auto& i: mInstructions) {
+				switch (i.op) {
+					case Opcode::ADD:
+						IntervalBatchKernels::add(size, inputLower[i.lhs], inputUpper[i.lhs], inputLower[i.rhs], inputUpper[i.rhs], lower(i.result), upper(i.result));
+						break;
+					case Opcode::MUL:
+						IntervalBatchKernels::mul(size, inputLower[i.lhs], inputUpper[i.lhs], inputLower[i.rhs], inputUpper[i.rhs], lower(i.result), upper(i.result));
+						break;
+				}
+			}
+			for (std::size_t b = 0; b < size; b++) {
+				Interval<double> num;
+				Interval<double> den;
+				double nl = inputLower[mNumerator][b];
+				double nu = inputUpper[mNumerator][b];
+				double dl = inputLower[mDenominator][b];
+				double du = inputUpper[mDenominator][b];
+				if (std::isfinite(nl) && std::isfinite(nu) && std::isfinite(dl) && std::isfinite(du)) {
+					num = Interval<double>(nl, nu);
+					den = Interval<double>(dl, du);
+				} else {
+					// Infinite or empty intervals, or an overflow.
+					std::vector<Interval<double>> registers;
+					registers.reserve(mRegisters);
+					for (std::size_t v = 0; v < constants; v++) registers.push_back(values.get(v, start + b));
+					registers.insert(registers.end(), mIntervalConstants.begin(), mIntervalConstants.end());
+					execute(registers);
+					num = registers[mNumerator];
+					den = registers[mDenominator];
+				}
+				if (den.contains(0.0)) {
+					nearPole[start + b] = true;
+					result.push_back(Interval<double>::unboundedInterval());
+				} else {
+					result.push_back(num.div(den));
+				}
+			}
+		}
+	}
+
+	template<typename P, class S>
+	std::ostream& operator<<(std::ostream& os, const RationalFunctionEvaluator<P, S>& rfe)
+	{
+		auto name = [&rfe](std::size_t r) {
+			std::stringstream ss;
+			if (r < rfe.mVariables.size()) ss << rfe.mVariables[r];
+			else if (r < rfe.mVariables.size() + rfe.mConstants.size()) ss << rfe.mConstants[r - rfe.mVariables.size()];
+			else ss << "r" << r;
+			return ss.str();
+		};
+		for (const auto& i: rfe.mInstructions) {
+			os << name(i.result) << " = " << name(i.lhs) << (i.op == RationalFunctionEvaluator<P, S>::Opcode::ADD ? " + " : " * ") << name(i.rhs) << "; ";
+		}
+		return os << "return " << name(rfe.mNumerator) << " / " << name(rfe.mDenominator);
+	}
+}
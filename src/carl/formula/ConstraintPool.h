@@ -12,8 +12,10 @@
 #include "../util/Singleton.h"
 #include "../util/Common.h"
 #include "Constraint.h"
+#include <algorithm>
 #include <limits>
 #include <mutex>
+#include <vector>
 
 namespace carl
 {
@@ -145,6 +147,21 @@ namespace carl
                 return result;
             }
             
+            /**
+             * Note: This method makes the other accesses to the constraint pool waiting.
+             * @return All constraints in this pool, ordered by their ids.
+             */
+            std::vector<Constraint<Pol>> constraints() const
+            {
+                std::vector<Constraint<Pol>> result;
+                CONSTRAINT_POOL_LOCK_GUARD
+                result.reserve( mConstraints.size() );
+                for( const ConstraintContent<Pol>* constraint: mConstraints )
+                    result.push_back( Constraint<Pol>( constraint ) );
+                std::sort( result.begin(), result.end() );
+                return result;
+            }
+            
             /**
              * @return true, the last constraint which has been tried to add to the pool, was already an element of it;
              *         false, otherwise.
@@ -152,15 +152,6 @@ class SortManager : public Singleton<SortManager> {
 			assert(sort.id() < mSorts.size());
 			return *mSorts.at(sort.id());
 		}
-		bool isSymbolFree(const std::string& name) const {
-			for (const auto& s: mSorts) {
-				if (s == nullptr) continue;
-				if (s->name == name) return false;
-			}
-			if (mDeclarations.find(name) != mDeclarations.end()) return false;
-			if (mDefinitions.find(name) != mDefinitions.end()) return false;
-			return true;
-		}
 		Sort getSort(SortContent* content, VariableType type) {
 			auto it = mSortMap.find(content);
 			if (it != mSortMap.end()) {
@@ -206,6 +197,20 @@ class SortManager : public Singleton<SortManager> {
 			mSortTypes.emplace_back(VariableType::VT_UNINTERPRETED);
 		}
 		
+		/**
+		 * @param name A name.
+		 * @return true, if no sort has been declared or defined with the given name.
+		 */
+		bool isSymbolFree(const std::string& name) const {
+			for (const auto& s: mSorts) {
+				if (s == nullptr) continue;
+				if (s->name == name) return false;
+			}
+			if (mDeclarations.find(name) != mDeclarations.end()) return false;
+			if (mDefinitions.find(name) != mDefinitions.end()) return false;
+			return true;
+		}
+
 		/**
 		 * @param sort A sort.
 		 * @return The name if the given sort.
@@ -0,0 +1,438 @@
+/**
+ * @file BVBitBlaster.cpp
+ */
+
+#include "BVBitBlaster.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace carl
+{
+	BVBitBlaster::BVBitBlaster():
+		mTrue(newVariable())
+	{
+		mClauses.add({mTrue});
+	}
+
+	const BVBitBlaster::Bits& BVBitBlaster::blast(const BVTerm& _term)
+	{
+		auto it = mTerms.find(_term);
+		if (it != mTerms.end()) return it->second;
+		Bits bits = blastTerm(_term);
+		assert(bits.size() == _term.width());
+		return mTerms.emplace(_term, std::move(bits)).first->second;
+	}
+
+	BVBitBlaster::Literal BVBitBlaster::blast(const BVConstraint& _constraint)
+	{
+		if (_constraint.isAlwaysConsistent()) return constant(true);
+		if (_constraint.isAlwaysInconsistent()) return constant(false);
+		auto it = mConstraints.find(_constraint);
+		if (it != mConstraints.end()) return it->second;
+
+		const Bits& lhs = blast(_constraint.lhs());
+		const Bits& rhs = blast(_constraint.rhs());
+		Literal res = 0;
+		switch (_constraint.relation()) {
+			case BVCompareRelation::EQ: res = equal(lhs, rhs); break;
+			case BVCompareRelation::NEQ: res = -equal(lhs, rhs); break;
+			case BVCompareRelation::ULT: res = lessUnsigned(lhs, rhs, false); break;
+			case BVCompareRelation::ULE: res = lessUnsigned(lhs, rhs, true); break;
+			case BVCompareRelation::UGT: res = lessUnsigned(rhs, lhs, false); break;
+			case BVCompareRelation::UGE: res = lessUnsigned(rhs, lhs, true); break;
+			case BVCompareRelation::SLT: res = lessSigned(lhs, rhs, false); break;
+			case BVCompareRelation::SLE: res = lessSigned(lhs, rhs, true); break;
+			case BVCompareRelation::SGT: res = lessSigned(rhs, lhs, false); break;
+			case BVCompareRelation::SGE: res = lessSigned(rhs, lhs, true); break;
+		}
+		mConstraints.emplace(_constraint, res);
+		return res;
+	}
+
+	BVBitBlaster::Literal BVBitBlaster::mkAnd(Literal _a, Literal _b)
+	{
+		if (_a == _b) return _a;
+		if (_a == -_b) return constant(false);
+		if (isFalse(_a) || isFalse(_b)) return constant(false);
+		if (isTrue(_a)) return _b;
+		if (isTrue(_b)) return _a;
+		auto key = std::make_pair(std::min(_a, _b), std::max(_a, _b));
+		auto it = mAndGates.find(key);
+		if (it != mAndGates.end()) return it->second;
+		Literal g = newVariable();
+		mClauses.add({-g, _a});
+		mClauses.add({-g, _b});
+		mClauses.add({g, -_a, -_b});
+		mAndGates.emplace(key, g);
+		return g;
+	}
+
+	BVBitBlaster::Literal BVBitBlaster::mkXor(Literal _a, Literal _b)
+	{
+		if (_a == _b) return constant(false);
+		if (_a == -_b) return constant(true);
+		if (isFalse(_a)) return _b;
+		if (isTrue(_a)) return -_b;
+		if (isFalse(_b)) return _a;
+		if (isTrue(_b)) return -_a;
+		// Normalize to positive inputs, the sign is moved to the output.
+		bool negated = (_a < 0) != (_b < 0);
+		_a = std::abs(_a);
+		_b = std::abs(_b);
+		auto key = std::make_pair(std::min(_a, _b), std::max(_a, _b));
+		auto it = mXorGates.find(key);
+		if (it != mXorGates.end()) return negated ? -it->second : it->second;
+		Literal g = newVariable();
+		mClauses.add({-g, _a, _b});
+		mClauses.add({-g, -_a, -_b});
+		mClauses.add({g, -_a, _b});
+		mClauses.add({g, _a, -_b});
+		mXorGates.emplace(key, g);
+		return negated ? -g : g;
+	}
+
+	BVBitBlaster::Literal BVBitBlaster::mkIte(Literal _cond, Literal _then, Literal _else)
+	{
+		if (isTrue(_cond)) return _then;
+		if (isFalse(_cond)) return _else;
+		if (_then == _else) return _then;
+		if (_then == -_else) return -mkXor(_cond, _then);
+		if (isTrue(_then) || _cond == _then) return mkOr(_cond, _else);
+		if (isFalse(_then) || _cond == -_then) return mkAnd(-_cond, _else);
+		if (isTrue(_else) || _cond == -_else) return mkOr(-_cond, _then);
+		if (isFalse(_else) || _cond == _else) return mkAnd(_cond, _then);
+		Literal g = newVariable();
+		mClauses.add({-_cond, -_then, g});
+		mClauses.add({-_cond, _then, -g});
+		mClauses.add({_cond, -_else, g});
+		mClauses.add({_cond, _else, -g});
+		// Redundant clauses that improve propagation
+		mClauses.add({-_then, -_else, g});
+		mClauses.add({_then, _else, -g});
+		return g;
+	}
+
+	BVBitBlaster::Literal BVBitBlaster::mkMajority(Literal _a, Literal _b, Literal _c)
+	{
+		if (isTrue(_a)) return mkOr(_b, _c);
+		if (isFalse(_a)) return mkAnd(_b, _c);
+		if (isTrue(_b)) return mkOr(_a, _c);
+		if (isFalse(_b)) return mkAnd(_a, _c);
+		if (isTrue(_c)) return mkOr(_a, _b);
+		if (isFalse(_c)) return mkAnd(_a, _b);
+		if (_a == _b || _a == _c) return _a;
+		if (_b == _c) return _b;
+		if (_a == -_b) return _c;
+		if (_a == -_c) return _b;
+		if (_b == -_c) return _a;
+		Literal g = newVariable();
+		mClauses.add({-_a, -_b, g});
+		mClauses.add({-_a, -_c, g});
+		mClauses.add({-_b, -_c, g});
+		mClauses.add({_a, _b, -g});
+		mClauses.add({_a, _c, -g});
+		mClauses.add({_b, _c, -g});
+		return g;
+	}
+
+	BVBitBlaster::Literal BVBitBlaster::mkAnd(const Bits& _bits)
+	{
+		Literal res = constant(true);
+		for (Literal l: _bits) {
+			res = mkAnd(res, l);
+		}
+		return res;
+	}
+
+	BVBitBlaster::Literal BVBitBlaster::mkOr(const Bits& _bits)
+	{
+		Literal res = constant(false);
+		for (Literal l: _bits) {
+			res = mkOr(res, l);
+		}
+		return res;
+	}
+
+	BVBitBlaster::Bits BVBitBlaster::bitwiseNot(const Bits& _a) const
+	{
+		Bits res(_a.size());
+		std::transform(_a.begin(), _a.end(), res.begin(), [](Literal l){ return -l; });
+		return res;
+	}
+
+	BVBitBlaster::Bits BVBitBlaster::ite(Literal _cond, const Bits& _then, const Bits& _else)
+	{
+		assert(_then.size() == _else.size());
+		Bits res(_then.size());
+		for (std::size_t i = 0; i < res.size(); i++) {
+			res[i] = mkIte(_cond, _then[i], _else[i]);
+		}
+		return res;
+	}
+
+	BVBitBlaster::Bits BVBitBlaster::add(const Bits& _a, const Bits& _b, Literal _carry, Literal* _carryOut)
+	{
+		assert(_a.size() == _b.size());
+		Bits res(_a.size());
+		for (std::size_t i = 0; i < res.size(); i++) {
+			res[i] = mkXor(mkXor(_a[i], _b[i]), _carry);
+			if (i + 1 < res.size() || _carryOut != nullptr) {
+				_carry = mkMajority(_a[i], _b[i], _carry);
+			}
+		}
+		if (_carryOut != nullptr) *_carryOut = _carry;
+		return res;
+	}
+
+	BVBitBlaster::Bits BVBitBlaster::negate(const Bits& _a)
+	{
+		return add(bitwiseNot(_a), Bits(_a.size(), constant(false)), constant(true));
+	}
+
+	BVBitBlaster::Bits BVBitBlaster::multiply(const Bits& _a, const Bits& _b)
+	{
+		assert(_a.size() == _b.size());
+		std::size_t width = _a.size();
+		// Partial products, sorted by their weight. Constant zeros are dropped.
+		std::vector<Bits> columns(width);
+		for (std::size_t i = 0; i < width; i++) {
+			if (isFalse(_b[i])) continue;
+			for (std::size_t j = 0; i + j < width; j++) {
+				Literal p = mkAnd(_a[j], _b[i]);
+				if (!isFalse(p)) columns[i + j].push_back(p);
+			}
+		}
+		// Reduce every column to at most two bits with carry-save adders.
+		while (std::any_of(columns.begin(), columns.end(), [](const Bits& c){ return c.size() > 2; })) {
+			std::vector<Bits> next(width);
+			for (std::size_t k = 0; k < width; k++) {
+				const Bits& column = columns[k];
+				std::size_t i = 0;
+				for (; i + 3 <= column.size(); i += 3) {
+					next[k].push_back(mkXor(mkXor(column[i], column[i+1]), column[i+2]));
+					if (k + 1 < width) {
+						next[k+1].push_back(mkMajority(column[i], column[i+1], column[i+2]));
+					}
+				}
+				next[k].insert(next[k].end(), column.begin() + long(i), column.end());
+			}
+			columns = std::move(next);
+		}
+		Bits first(width, constant(false));
+		Bits second(width, constant(false));
+		for (std::size_t k = 0; k < width; k++) {
+			if (columns[k].size() > 0) first[k] = columns[k][0];
+			if (columns[k].size() > 1) second[k] = columns[k][1];
+		}
+		return add(first, second, constant(false));
+	}
+
+	void BVBitBlaster::divide(const Bits& _a, const Bits& _b, Bits& _quotient, Bits& _remainder)
+	{
+		assert(_a.size() == _b.size());
+		std::size_t width = _a.size();
+		// Restoring division with a remainder of width + 1 bits.
+		Bits divisor(_b);
+		divisor.push_back(constant(false));
+		Bits negDivisor = bitwiseNot(divisor);
+		Bits remainder(width + 1, constant(false));
+		_quotient.assign(width, constant(false));
+		for (std::size_t i = width; i-- > 0;) {
+			remainder.pop_back();
+			remainder.insert(remainder.begin(), _a[i]);
+			Literal fits = 0;
+			Bits difference = add(remainder, negDivisor, constant(true), &fits);
+			_quotient[i] = fits;
+			remainder = ite(fits, difference, remainder);
+		}
+		remainder.pop_back();
+		_remainder = std::move(remainder);
+	}
+
+	BVBitBlaster::Bits BVBitBlaster::shift(const Bits& _a, const Bits& _b, bool _left, bool _arithmetic)
+	{
+		std::size_t width = _a.size();
+		Literal fill = _arithmetic ? _a.back() : constant(false);
+		Bits cur(_a);
+		Bits overflow;
+		for (std::size_t k = 0; k < _b.size(); k++) {
+			if (k >= sizeof(std::size_t) * 8 - 1 || (std::size_t(1) << k) >= width) {
+				overflow.push_back(_b[k]);
+				continue;
+			}
+			std::size_t by = std::size_t(1) << k;
+			Bits next(width);
+			for (std::size_t i = 0; i < width; i++) {
+				Literal shifted;
+				if (_left) shifted = (i >= by) ? cur[i - by] : constant(false);
+				else shifted = (i + by < width) ? cur[i + by] : fill;
+				next[i] = mkIte(_b[k], shifted, cur[i]);
+			}
+			cur = std::move(next);
+		}
+		return ite(mkOr(overflow), Bits(width, fill), cur);
+	}
+
+	BVBitBlaster::Literal BVBitBlaster::equal(const Bits& _a, const Bits& _b)
+	{
+		assert(_a.size() == _b.size());
+		Literal res = constant(true);
+		for (std::size_t i = 0; i < _a.size(); i++) {
+			res = mkAnd(res, -mkXor(_a[i], _b[i]));
+		}
+		return res;
+	}
+
+	BVBitBlaster::Literal BVBitBlaster::lessUnsigned(const Bits& _a, const Bits& _b, bool _orEqual)
+	{
+		assert(_a.size() == _b.size());
+		// The most significant differing bit decides.
+		Literal res = constant(_orEqual);
+		for (std::size_t i = 0; i < _a.size(); i++) {
+			res = mkIte(mkXor(_a[i], _b[i]), _b[i], res);
+		}
+		return res;
+	}
+
+	BVBitBlaster::Literal BVBitBlaster::lessSigned(const Bits& _a, const Bits& _b, bool _orEqual)
+	{
+		// Inverting the sign bits maps the signed order to the unsigned order.
+		Bits a(_a);
+		Bits b(_b);
+		a.back() = -a.back();
+		b.back() = -b.back();
+		return lessUnsigned(a, b, _orEqual);
+	}
+
+	BVBitBlaster::Bits BVBitBlaster::blastTerm(const BVTerm& _term)
+	{
+		switch (_term.type()) {
+			case BVTermType::CONSTANT: {
+				const BVValue& value = _term.value();
+				Bits res(value.width());
+				for (std::size_t i = 0; i < res.size(); i++) {
+					res[i] = constant(value[i]);
+				}
+				return res;
+			}
+			case BVTermType::VARIABLE: {
+				auto it = mVariables.find(_term.variable());
+				if (it == mVariables.end()) {
+					Bits bits(_term.width());
+					for (auto& b: bits) b = newVariable();
+					it = mVariables.emplace(_term.variable(), std::move(bits)).first;
+				}
+				return it->second;
+			}
+			case BVTermType::CONCAT: {
+				Bits res(blast(_term.second()));
+				const Bits& high = blast(_term.first());
+				res.insert(res.end(), high.begin(), high.end());
+				return res;
+			}
+			case BVTermType::EXTRACT: {
+				const Bits& op = blast(_term.operand());
+				return Bits(op.begin() + long(_term.lowest()), op.begin() + long(_term.highest()) + 1);
+			}
+			case BVTermType::NOT:
+				return bitwiseNot(blast(_term.operand()));
+			case BVTermType::NEG:
+				return negate(blast(_term.operand()));
+			case BVTermType::AND:
+			case BVTermType::OR:
+			case BVTermType::XOR:
+			case BVTermType::NAND:
+			case BVTermType::NOR:
+			case BVTermType::XNOR: {
+				const Bits& a = blast(_term.first());
+				const Bits& b = blast(_term.second());
+				Bits res(a.size());
+				for (std::size_t i = 0; i < res.size(); i++) {
+					switch (_term.type()) {
+						case BVTermType::AND: res[i] = mkAnd(a[i], b[i]); break;
+						case BVTermType::OR: res[i] = mkOr(a[i], b[i]); break;
+						case BVTermType::XOR: res[i] = mkXor(a[i], b[i]); break;
+						case BVTermType::NAND: res[i] = -mkAnd(a[i], b[i]); break;
+						case BVTermType::NOR: res[i] = -mkOr(a[i], b[i]); break;
+						default: res[i] = -mkXor(a[i], b[i]); break;
+					}
+				}
+				return res;
+			}
+			case BVTermType::ADD:
+				return add(blast(_term.first()), blast(_term.second()), constant(false));
+			case BVTermType::SUB:
+				return add(blast(_term.first()), bitwiseNot(blast(_term.second())), constant(true));
+			case BVTermType::MUL:
+				return multiply(blast(_term.first()), blast(_term.second()));
+			case BVTermType::DIV_U:
+			case BVTermType::MOD_U: {
+				Bits quotient, remainder;
+				divide(blast(_term.first()), blast(_term.second()), quotient, remainder);
+				return _term.type() == BVTermType::DIV_U ? quotient : remainder;
+			}
+			case BVTermType::DIV_S:
+			case BVTermType::MOD_S1:
+			case BVTermType::MOD_S2: {
+				const Bits& s = blast(_term.first());
+				const Bits& t = blast(_term.second());
+				Literal sNegative = s.back();
+				Literal tNegative = t.back();
+				Bits quotient, remainder;
+				divide(ite(sNegative, negate(s), s), ite(tNegative, negate(t), t), quotient, remainder);
+				if (_term.type() == BVTermType::DIV_S) {
+					return ite(mkXor(sNegative, tNegative), negate(quotient), quotient);
+				} else if (_term.type() == BVTermType::MOD_S1) {
+					return ite(sNegative, negate(remainder), remainder);
+				}
+				// bvsmod as defined by SMT-LIB: the sign follows the divisor.
+				Bits zero(remainder.size(), constant(false));
+				Bits negRemainder = negate(remainder);
+				Bits adjusted = ite(mkXor(sNegative, tNegative),
+					add(ite(sNegative, negRemainder, remainder), t, constant(false)),
+					ite(sNegative, negRemainder, remainder));
+				return ite(equal(remainder, zero), remainder, adjusted);
+			}
+			case BVTermType::EQ:
+				return Bits({equal(blast(_term.first()), blast(_term.second()))});
+			case BVTermType::LSHIFT:
+				return shift(blast(_term.first()), blast(_term.second()), true, false);
+			case BVTermType::RSHIFT_LOGIC:
+				return shift(blast(_term.first()), blast(_term.second()), false, false);
+			case BVTermType::RSHIFT_ARITH:
+				return shift(blast(_term.first()), blast(_term.second()), false, true);
+			case BVTermType::LROTATE:
+			case BVTermType::RROTATE: {
+				const Bits& op = blast(_term.operand());
+				std::size_t width = op.size();
+				std::size_t by = _term.index() % width;
+				Bits res(width);
+				for (std::size_t i = 0; i < width; i++) {
+					if (_term.type() == BVTermType::LROTATE) res[(i + by) % width] = op[i];
+					else res[i] = op[(i + by) % width];
+				}
+				return res;
+			}
+			case BVTermType::EXT_U:
+			case BVTermType::EXT_S: {
+				Bits res(blast(_term.operand()));
+				Literal fill = _term.type() == BVTermType::EXT_S ? res.back() : constant(false);
+				res.resize(res.size() + _term.index(), fill);
+				return res;
+			}
+			case BVTermType::REPEAT: {
+				const Bits& op = blast(_term.operand());
+				Bits res;
+				res.reserve(op.size() * _term.index());
+				for (std::size_t i = 0; i < _term.index(); i++) {
+					res.insert(res.end(), op.begin(), op.end());
+				}
+				return res;
+			}
+		}
+		CARL_LOG_ERROR("carl.bitvector", "Bit-blasting of " << _term.type() << " is not supported.");
+		assert(false);
+		return Bits();
+	}
+}
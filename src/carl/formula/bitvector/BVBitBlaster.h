@@ -0,0 +1,265 @@
+/**
+ * @file BVBitBlaster.h
+ *
+ * Translation of bit-vector terms and constraints to propositional logic.
+ */
+
+#pragma once
+
+#include "BVConstraint.h"
+#include "BVTerm.h"
+#include "../Formula.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace carl
+{
+	/**
+	 * A compact buffer of propositional clauses.
+	 * Literals are nonzero integers as in the DIMACS format, a negative literal
+	 * denotes the negation of the respective variable. All clauses are stored
+	 * consecutively in a single vector, each clause being terminated by a zero.
+	 */
+	class BVClauseBuffer
+	{
+	private:
+		std::vector<int> mLiterals;
+		std::size_t mClauses = 0;
+
+	public:
+		void add(std::initializer_list<int> _clause)
+		{
+			mLiterals.insert(mLiterals.end(), _clause.begin(), _clause.end());
+			mLiterals.push_back(0);
+			++mClauses;
+		}
+
+		void add(const std::vector<int>& _clause)
+		{
+			mLiterals.insert(mLiterals.end(), _clause.begin(), _clause.end());
+			mLiterals.push_back(0);
+			++mClauses;
+		}
+
+		/**
+		 * @return The number of clauses.
+		 */
+		std::size_t size() const
+		{
+			return mClauses;
+		}
+
+		/**
+		 * @return All literals, each clause being terminated by a zero.
+		 */
+		const std::vector<int>& literals() const
+		{
+			return mLiterals;
+		}
+
+		/**
+		 * Calls the given function for every clause with a pointer to its
+		 * first literal and a pointer past its last literal.
+		 */
+		template<typename F>
+		void forEachClause(F&& _f) const
+		{
+			const int* begin = mLiterals.data();
+			const int* end = begin + mLiterals.size();
+			while (begin != end) {
+				const int* cur = begin;
+				while (*cur != 0) ++cur;
+				_f(begin, cur);
+				begin = cur + 1;
+			}
+		}
+
+		void clear()
+		{
+			mLiterals.clear();
+			mClauses = 0;
+		}
+
+		friend std::ostream& operator<<(std::ostream& _out, const BVClauseBuffer& _buffer)
+		{
+			for (int lit: _buffer.mLiterals) {
+				_out << lit << (lit == 0 ? "\n" : " ");
+			}
+			return _out;
+		}
+	};
+
+	/**
+	 * Translates bit-vector terms and constraints to a set of clauses (bit-blasting).
+	 *
+	 * Every bit of a term is represented by a propositional literal, the least
+	 * significant bit coming first. Terms and constraints are cached by their
+	 * pool instances, such that shared subterms are only translated once. The gates
+	 * are additionally hashed structurally and simplified if an input is
+	 * constant, hence constant operands do not produce any clauses.
+	 *
+	 * Adders are encoded as ripple-carry adders with a dedicated majority
+	 * encoding for the carry, multipliers reduce the partial products with
+	 * carry-save adders (Wallace tree) before a final ripple-carry addition.
+	 * Division by zero follows the SMT-LIB semantics, i.e. bvudiv yields all
+	 * ones and bvurem yields the dividend.
+	 */
+	class BVBitBlaster
+	{
+	public:
+		using Literal = int;
+		/// Literals representing the bits of a term, least significant bit first.
+		using Bits = std::vector<Literal>;
+
+	private:
+		/// The next unused propositional variable.
+		int mNextVariable = 1;
+		/// Literal that is fixed to true.
+		Literal mTrue;
+		/// The generated clauses.
+		BVClauseBuffer mClauses;
+		/// Bits of all translated terms. Storing the terms keeps their pool ids from being reused.
+		std::unordered_map<BVTerm, Bits> mTerms;
+		/// Literals of all translated constraints.
+		std::unordered_map<BVConstraint, Literal> mConstraints;
+		/// Bits of all bit-vector variables.
+		std::map<BVVariable, Bits> mVariables;
+		/// Structural hashing of and gates.
+		std::map<std::pair<Literal,Literal>, Literal> mAndGates;
+		/// Structural hashing of xor gates.
+		std::map<std::pair<Literal,Literal>, Literal> mXorGates;
+
+	public:
+		BVBitBlaster();
+
+		/**
+		 * Translates the given term.
+		 * @param _term Bit-vector term.
+		 * @return The literals representing the bits of the term.
+		 */
+		const Bits& blast(const BVTerm& _term);
+
+		/**
+		 * Translates the given constraint.
+		 * @param _constraint Bit-vector constraint.
+		 * @return A literal that is equivalent to the constraint.
+		 */
+		Literal blast(const BVConstraint& _constraint);
+
+		/**
+		 * Translates the given constraint and adds a unit clause asserting it.
+		 */
+		void assertConstraint(const BVConstraint& _constraint)
+		{
+			mClauses.add({blast(_constraint)});
+		}
+
+		/**
+		 * @return The clauses generated so far.
+		 */
+		const BVClauseBuffer& clauses() const
+		{
+			return mClauses;
+		}
+
+		/**
+		 * @return The number of propositional variables used so far.
+		 */
+		std::size_t variables() const
+		{
+			return std::size_t(mNextVariable - 1);
+		}
+
+		/**
+		 * @return The literal that is fixed to true.
+		 */
+		Literal trueLiteral() const
+		{
+			return mTrue;
+		}
+
+		/**
+		 * @return The bits of all bit-vector variables translated so far.
+		 */
+		const std::map<BVVariable, Bits>& variableBits() const
+		{
+			return mVariables;
+		}
+
+	private:
+		Literal newVariable()
+		{
+			return mNextVariable++;
+		}
+		bool isTrue(Literal _l) const
+		{
+			return _l == mTrue;
+		}
+		bool isFalse(Literal _l) const
+		{
+			return _l == -mTrue;
+		}
+		bool isConstant(Literal _l) const
+		{
+			return isTrue(_l) || isFalse(_l);
+		}
+		Literal constant(bool _value) const
+		{
+			return _value ? mTrue : -mTrue;
+		}
+
+		Literal mkAnd(Literal _a, Literal _b);
+		Literal mkOr(Literal _a, Literal _b)
+		{
+			return -mkAnd(-_a, -_b);
+		}
+		Literal mkXor(Literal _a, Literal _b);
+		Literal mkIte(Literal _cond, Literal _then, Literal _else);
+		Literal mkMajority(Literal _a, Literal _b, Literal _c);
+		Literal mkAnd(const Bits& _bits);
+		Literal mkOr(const Bits& _bits);
+
+		Bits bitwiseNot(const Bits& _a) const;
+		Bits ite(Literal _cond, const Bits& _then, const Bits& _else);
+		Bits add(const Bits& _a, const Bits& _b, Literal _carry, Literal* _carryOut = nullptr);
+		Bits negate(const Bits& _a);
+		Bits multiply(const Bits& _a, const Bits& _b);
+		void divide(const Bits& _a, const Bits& _b, Bits& _quotient, Bits& _remainder);
+		Bits shift(const Bits& _a, const Bits& _b, bool _left, bool _arithmetic);
+		Literal equal(const Bits& _a, const Bits& _b);
+		Literal lessUnsigned(const Bits& _a, const Bits& _b, bool _orEqual);
+		Literal lessSigned(const Bits& _a, const Bits& _b, bool _orEqual);
+
+		Bits blastTerm(const BVTerm& _term);
+	};
+
+	/**
+	 * Converts the given clauses to a formula in conjunctive normal form.
+	 * @param _clauses The clauses.
+	 * @param _variables Boolean variables representing the propositional variables,
+	 *        the i'th entry representing the variable i+1. Fresh variables are added as needed.
+	 * @return The conjunction of all clauses.
+	 */
+	template<typename Pol>
+	Formula<Pol> toFormula(const BVClauseBuffer& _clauses, std::vector<Variable>& _variables)
+	{
+		Formulas<Pol> clauses;
+		clauses.reserve(_clauses.size());
+		_clauses.forEachClause([&](const int* _begin, const int* _end) {
+			Formulas<Pol> literals;
+			for (const int* lit = _begin; lit != _end; ++lit) {
+				std::size_t var = std::size_t(std::abs(*lit));
+				while (_variables.size() < var) {
+					_variables.push_back(freshBooleanVariable());
+				}
+				Formula<Pol> f(_variables[var - 1]);
+				if (*lit > 0) literals.push_back(f);
+				else literals.emplace_back(NOT, f);
+			}
+			clauses.emplace_back(OR, std::move(literals));
+		});
+		return Formula<Pol>(AND, std::move(clauses));
+	}
+}
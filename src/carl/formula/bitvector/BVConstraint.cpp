@@ -8,14 +8,82 @@
 
 namespace carl
 {
+    BVConstraint::BVConstraint(const BVConstraint& _constraint) :
+        mHash(_constraint.mHash), mId(_constraint.mId),
+        mpPooled(_constraint.pooled()),
+        mRelation(_constraint.mRelation), mLhs(_constraint.mLhs), mRhs(_constraint.mRhs)
+    {
+        if(mpPooled != nullptr) {
+            BVConstraintPool::getInstance().reg(mpPooled);
+        }
+    }
+
+    BVConstraint::BVConstraint(BVConstraint&& _constraint) noexcept :
+        mHash(_constraint.mHash), mId(_constraint.mId), mpPooled(_constraint.mpPooled),
+        mRelation(_constraint.mRelation), mLhs(std::move(_constraint.mLhs)), mRhs(std::move(_constraint.mRhs))
+    {
+        assert(_constraint.mpPooled != nullptr || _constraint.mId == 0);
+        _constraint.mpPooled = nullptr;
+        _constraint.mId = 0;
+    }
+
+    BVConstraint::~BVConstraint()
+    {
+        if(mpPooled != nullptr) {
+            BVConstraintPool::getInstance().free(mpPooled);
+        }
+    }
+
+    BVConstraint& BVConstraint::operator=(const BVConstraint& _constraint)
+    {
+        const BVConstraint* pooled = _constraint.pooled();
+        if(pooled != nullptr) {
+            BVConstraintPool::getInstance().reg(pooled);
+        }
+        if(mpPooled != nullptr) {
+            BVConstraintPool::getInstance().free(mpPooled);
+        }
+        mHash = _constraint.mHash;
+        mId = _constraint.mId;
+        mpPooled = pooled;
+        mRelation = _constraint.mRelation;
+        mLhs = _constraint.mLhs;
+        mRhs = _constraint.mRhs;
+        return *this;
+    }
+
+    BVConstraint& BVConstraint::operator=(BVConstraint&& _constraint) noexcept
+    {
+        assert(_constraint.mpPooled != nullptr || _constraint.mId == 0);
+        if(this == &_constraint) return *this;
+        if(mpPooled != nullptr) {
+            BVConstraintPool::getInstance().free(mpPooled);
+        }
+        mHash = _constraint.mHash;
+        mId = _constraint.mId;
+        mpPooled = _constraint.mpPooled;
+        mRelation = _constraint.mRelation;
+        mLhs = std::move(_constraint.mLhs);
+        mRhs = std::move(_constraint.mRhs);
+        _constraint.mpPooled = nullptr;
+        _constraint.mId = 0;
+        return *this;
+    }
+
     BVConstraint BVConstraint::create(bool _consistent)
     {
-        return *(BVConstraintPool::getInstance().create(_consistent));
+        const BVConstraint* pooled = BVConstraintPool::getInstance().create(_consistent);
+        BVConstraint result(*pooled);
+        BVConstraintPool::getInstance().free(pooled);
+        return result;
     }
 
     BVConstraint BVConstraint::create(const BVCompareRelation& _relation,
         const BVTerm& _lhs, const BVTerm& _rhs)
     {
-        return *(BVConstraintPool::getInstance().create(_relation, _lhs, _rhs));
+        const BVConstraint* pooled = BVConstraintPool::getInstance().create(_relation, _lhs, _rhs);
+        BVConstraint result(*pooled);
+        BVConstraintPool::getInstance().free(pooled);
+        return result;
     }
 } // namespace carl
@@ -14,15 +14,23 @@ namespace carl
 	// Forward declaration
 	class BVConstraintPool;
 
+	template<typename Element>
+	class Pool;
+
 	class BVConstraint
 	{
 		friend class BVConstraintPool;
+		friend class Pool<BVConstraint>;
 
 	private:
 		/// The hash value.
 		std::size_t mHash;
 		/// The unique id.
 		std::size_t mId;
+		/// The number of copies of this constraint, if it is the instance stored in the pool.
+		mutable std::atomic<std::size_t> mUsages{0};
+		/// The instance stored in the pool this constraint is a copy of, nullptr for the instance in the pool itself.
+		const BVConstraint* mpPooled = nullptr;
 
 		/// The relation for comparing left- and right-hand side.
 		BVCompareRelation mRelation;
@@ -51,8 +59,35 @@ namespace carl
 			assert(_lhs.width() == _rhs.width());
 		}
 
+		/**
+		 * @return The instance stored in the pool this constraint refers to, or nullptr if there is none.
+		 */
+		const BVConstraint* pooled() const
+		{
+			if(mpPooled != nullptr || mId == 0) return mpPooled;
+			// Only the instance in the pool has an id but no reference to the pool.
+			return this;
+		}
+
 	public:
 
+		/**
+		 * Copies the constraint and registers another usage of its instance in the pool.
+		 */
+		BVConstraint(const BVConstraint& _constraint);
+
+		/**
+		 * Takes over the usage of the instance in the pool from the given constraint.
+		 * The instance in the pool itself is never moved, as it is only accessible as const.
+		 */
+		BVConstraint(BVConstraint&& _constraint) noexcept;
+
+		~BVConstraint();
+
+		BVConstraint& operator=(const BVConstraint& _constraint);
+
+		BVConstraint& operator=(BVConstraint&& _constraint) noexcept;
+
 		static BVConstraint create(bool _consistent = true);
 
 		static BVConstraint create(const BVCompareRelation& _relation,
@@ -14,6 +14,11 @@ namespace carl
 	enum class BVCompareRelation : unsigned;
 	class BVTerm;
 
+	/**
+	 * The pool of all bit-vector constraints.
+	 * BVConstraint objects are copies of the instances stored in this pool and
+	 * keep them alive; create() returns an instance registered once for the caller.
+	 */
 	class BVConstraintPool : public Singleton<BVConstraintPool>, public Pool<BVConstraint>
 	{
 		friend Singleton<BVConstraintPool>;
@@ -38,6 +38,45 @@ namespace carl
     {
     }
 
+    BVTerm::BVTerm(const BVTerm& _term) :
+    mpContent(_term.mpContent)
+    {
+        if(mpContent != nullptr) {
+            BVTermPool::getInstance().reg(mpContent);
+        }
+    }
+
+    BVTerm::BVTerm(BVTerm&& _term) noexcept :
+    mpContent(_term.mpContent)
+    {
+        _term.mpContent = nullptr;
+    }
+
+    BVTerm::~BVTerm()
+    {
+        if(mpContent != nullptr) {
+            BVTermPool::getInstance().free(mpContent);
+        }
+    }
+
+    BVTerm& BVTerm::operator=(const BVTerm& _term)
+    {
+        if(_term.mpContent != nullptr) {
+            BVTermPool::getInstance().reg(_term.mpContent);
+        }
+        if(mpContent != nullptr) {
+            BVTermPool::getInstance().free(mpContent);
+        }
+        mpContent = _term.mpContent;
+        return *this;
+    }
+
+    BVTerm& BVTerm::operator=(BVTerm&& _term) noexcept
+    {
+        std::swap(mpContent, _term.mpContent);
+        return *this;
+    }
+
     std::string BVTerm::toString(const std::string _init, bool _oneline, bool _infix, bool _friendlyNames) const
     {
         return mpContent->toString(_init, _oneline, _infix, _friendlyNames);
@@ -48,6 +87,11 @@ namespace carl
         return mpContent->hash();
     }
 
+    std::size_t BVTerm::id() const
+    {
+        return mpContent->mId;
+    }
+
     std::size_t BVTerm::width() const
     {
         return mpContent->width();
@@ -8,6 +8,8 @@
 #include "BVVariable.h"
 #include "BVValue.h"
 
+#include <atomic>
+
 namespace carl
 {
 	enum class BVTermType : unsigned
@@ -81,6 +83,15 @@ namespace carl
 			);
 	}
 
+	inline bool typeIsCommutative(const BVTermType _type)
+	{
+		return(
+			_type == BVTermType::AND || _type == BVTermType::OR || _type == BVTermType::XOR
+			|| _type == BVTermType::NAND || _type == BVTermType::NOR || _type == BVTermType::XNOR
+			|| _type == BVTermType::ADD || _type == BVTermType::MUL || _type == BVTermType::EQ
+			);
+	}
+
 	inline bool typeIsBinary(const BVTermType _type)
 	{
 		return(
@@ -102,6 +113,8 @@ namespace carl
 
 	class BVTerm
 	{
+		friend class BVTermPool;
+
 	private:
 		const BVTermContent * mpContent;
 
@@ -119,6 +132,16 @@ namespace carl
 
 		BVTerm(BVTermType _type, const BVTerm& _operand, const size_t _first, const size_t _last);
 
+		BVTerm(const BVTerm& _term);
+
+		BVTerm(BVTerm&& _term) noexcept;
+
+		~BVTerm();
+
+		BVTerm& operator=(const BVTerm& _term);
+
+		BVTerm& operator=(BVTerm&& _term) noexcept;
+
 		std::string toString(const std::string _init = "", bool _oneline = true, bool _infix = false, bool _friendlyNames = true) const;
 
 		friend std::ostream& operator<<(std::ostream& _out, const BVTerm& _term)
@@ -128,6 +151,11 @@ namespace carl
 
 		std::size_t hash() const;
 
+		/**
+		 * @return The unique id of this term within the BVTermPool.
+		 */
+		std::size_t id() const;
+
 		std::size_t width() const;
 
 		BVTermType type() const;
@@ -238,10 +266,14 @@ namespace carl
 		}
 	};
 
+	template<typename Element>
+	class Pool;
+
 	class BVTermContent
 	{
 		friend class BVTermPool;
 		friend class BVTerm;
+		friend class Pool<BVTermContent>;
 
 	private:
 		BVTermType mType;
@@ -268,6 +300,8 @@ namespace carl
 		std::size_t mWidth;
 		std::size_t mId;
 		std::size_t mHash;
+		/// The number of BVTerms referring to this content.
+		mutable std::atomic<std::size_t> mUsages{0};
 
 	public:
 
@@ -384,6 +418,12 @@ namespace carl
 				mpVariableVS->~BVVariable();
 			} else if(mType == BVTermType::CONSTANT) {
 				mpValueVS->~BVValue();
+			} else if(mType == BVTermType::EXTRACT) {
+				delete mpExtractVS;
+			} else if(typeIsUnary(mType)) {
+				delete mpUnaryVS;
+			} else if(typeIsBinary(mType)) {
+				delete mpBinaryVS;
 			}
 #else
 			if (mType == BVTermType::VARIABLE) {
@@ -392,9 +432,26 @@ namespace carl
 			else if (mType == BVTermType::CONSTANT) {
 				mValue.~BVValue();
 			}
+			else if (mType == BVTermType::EXTRACT) {
+				mExtract.~BVExtractContent();
+			}
+			else if (typeIsUnary(mType)) {
+				mUnary.~BVUnaryContent();
+			}
+			else if (typeIsBinary(mType)) {
+				mBinary.~BVBinaryContent();
+			}
 #endif
 		}
 
+		/**
+		 * @return The unique id of this term within the BVTermPool.
+		 */
+		std::size_t id() const
+		{
+			return mId;
+		}
+
 		size_t width() const
 		{
 			return mWidth;
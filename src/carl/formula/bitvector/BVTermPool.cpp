@@ -7,6 +7,24 @@
 
 namespace carl
 {
+    namespace
+    {
+        bool isZero(const BVTerm& _term)
+        {
+            return _term.isConstant() && _term.value().isZero();
+        }
+
+        bool isOne(const BVTerm& _term)
+        {
+            return _term.isConstant() && _term.value() == BVValue(_term.width(), 1);
+        }
+
+        bool isOnes(const BVTerm& _term)
+        {
+            return _term.isConstant() && (~_term.value()).isZero();
+        }
+    }
+
     BVTermPool::BVTermPool():
 		Singleton<BVTermPool>(),
 		Pool<BVTermContent>(),
@@ -16,9 +34,16 @@ namespace carl
 
     BVTermPool::ConstTermPtr BVTermPool::create()
     {
+        reg(mpInvalid);
         return this->mpInvalid;
     }
 
+    BVTermPool::ConstTermPtr BVTermPool::share(const BVTerm& _term)
+    {
+        reg(_term.mpContent);
+        return _term.mpContent;
+    }
+
     BVTermPool::ConstTermPtr BVTermPool::create(BVTermType _type, const BVValue _value)
     {
         return this->add(new Term(_type, _value));
@@ -31,7 +56,7 @@ namespace carl
 
     BVTermPool::ConstTermPtr BVTermPool::create(BVTermType _type, const BVTerm& _operand, const size_t _index)
     {
-        if (_operand.isConstant()) {
+        if (mRewriting.constantFolding && _operand.isConstant()) {
             switch (_type) {
                 case BVTermType::NOT: {
                     return create(BVTermType::CONSTANT, ~_operand.value());
@@ -58,6 +83,10 @@ namespace carl
                     CARL_LOG_WARN("carl.bitvector", "No simplification for " << _type << " BVTerm.");
             }
         }
+        ConstTermPtr simplified = simplify(_type, _operand, _index);
+        if (simplified != nullptr) {
+            return simplified;
+        }
         return this->add(new Term(_type, _operand, _index));
     }
 
@@ -75,7 +104,7 @@ namespace carl
         }
 
         // Evaluate term if both terms arguments are constant
-        if (_first.isConstant() && _second.isConstant()) {
+        if (mRewriting.constantFolding && _first.isConstant() && _second.isConstant()) {
             switch (_type) {
                 case BVTermType::CONCAT: {
                     return create(BVTermType::CONSTANT, _first.value().concat(_second.value()));
@@ -141,21 +170,208 @@ namespace carl
             }
         }
 
+        ConstTermPtr simplified = simplify(_type, _first, _second);
+        if (simplified != nullptr) {
+            return simplified;
+        }
+        // Constants come last, other operands are ordered by their ids
+        if (mRewriting.commutativeOrdering && typeIsCommutative(_type)) {
+            bool swap = (_first.isConstant() == _second.isConstant()) ? (_second < _first) : _first.isConstant();
+            if (swap) {
+                return this->add(new Term(_type, _second, _first));
+            }
+        }
         return this->add(new Term(_type, _first, _second));
     }
 
     BVTermPool::ConstTermPtr BVTermPool::create(BVTermType _type, const BVTerm& _operand, const size_t _highest, const size_t _lowest)
     {
-        if(_operand.isConstant()) {
+        if(mRewriting.constantFolding && _operand.isConstant()) {
             if(_type == BVTermType::EXTRACT) {
                 return create(BVTermType::CONSTANT, _operand.value().extract(_highest, _lowest));
             } else {
                 CARL_LOG_WARN("carl.bitvector", "No simplification for " << _type << " BVTerm.");
             }
         }
+        if(_type == BVTermType::EXTRACT) {
+            ConstTermPtr simplified = simplify(_operand, _highest, _lowest);
+            if(simplified != nullptr) {
+                return simplified;
+            }
+        }
         return this->add(new Term(_type, _operand, _highest, _lowest));
     }
 
+    BVTermPool::ConstTermPtr BVTermPool::simplify(BVTermType _type, const BVTerm& _operand, const size_t _index)
+    {
+        if (!mRewriting.identities) {
+            return nullptr;
+        }
+        switch (_type) {
+            case BVTermType::NOT:
+            case BVTermType::NEG: {
+                // ~~x = x, -(-x) = x
+                if (_operand.type() == _type) {
+                    return share(_operand.operand());
+                }
+                break;
+            }
+            case BVTermType::LROTATE:
+            case BVTermType::RROTATE: {
+                if (_index % _operand.width() == 0) {
+                    return share(_operand);
+                }
+                break;
+            }
+            case BVTermType::EXT_U:
+            case BVTermType::EXT_S: {
+                if (_index == 0) {
+                    return share(_operand);
+                }
+                // Merge repeated extensions of the same kind
+                if (_operand.type() == _type) {
+                    return create(_type, _operand.operand(), _operand.index() + _index);
+                }
+                break;
+            }
+            case BVTermType::REPEAT: {
+                if (_index == 1) {
+                    return share(_operand);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        return nullptr;
+    }
+
+    BVTermPool::ConstTermPtr BVTermPool::simplify(BVTermType _type, const BVTerm& _first, const BVTerm& _second)
+    {
+        if (_type == BVTermType::CONCAT) {
+            // concat(x[h:m+1], x[m:l]) = x[h:l]
+            if (mRewriting.extractConcatFusion && _first.type() == BVTermType::EXTRACT && _second.type() == BVTermType::EXTRACT
+                    && _first.operand() == _second.operand() && _first.lowest() == _second.highest() + 1) {
+                return create(BVTermType::EXTRACT, _first.operand(), _first.highest(), _second.lowest());
+            }
+            return nullptr;
+        }
+        if (!mRewriting.identities) {
+            return nullptr;
+        }
+        std::size_t width = _first.width();
+        switch (_type) {
+            case BVTermType::AND: {
+                if (isZero(_first) || isOnes(_second) || _first == _second) return share(_first);
+                if (isZero(_second) || isOnes(_first)) return share(_second);
+                break;
+            }
+            case BVTermType::OR: {
+                if (isOnes(_first) || isZero(_second) || _first == _second) return share(_first);
+                if (isOnes(_second) || isZero(_first)) return share(_second);
+                break;
+            }
+            case BVTermType::XOR: {
+                if (isZero(_second)) return share(_first);
+                if (isZero(_first)) return share(_second);
+                if (_first == _second) return create(BVTermType::CONSTANT, BVValue(width, 0));
+                if (isOnes(_second)) return create(BVTermType::NOT, _first);
+                if (isOnes(_first)) return create(BVTermType::NOT, _second);
+                break;
+            }
+            case BVTermType::NAND:
+            case BVTermType::NOR: {
+                if (_first == _second) return create(BVTermType::NOT, _first);
+                break;
+            }
+            case BVTermType::XNOR: {
+                if (_first == _second) return create(BVTermType::CONSTANT, ~BVValue(width, 0));
+                break;
+            }
+            case BVTermType::ADD: {
+                if (isZero(_second)) return share(_first);
+                if (isZero(_first)) return share(_second);
+                break;
+            }
+            case BVTermType::SUB: {
+                if (isZero(_second)) return share(_first);
+                if (isZero(_first)) return create(BVTermType::NEG, _second);
+                if (_first == _second) return create(BVTermType::CONSTANT, BVValue(width, 0));
+                break;
+            }
+            case BVTermType::MUL: {
+                if (isZero(_first) || isOne(_second)) return share(_first);
+                if (isZero(_second) || isOne(_first)) return share(_second);
+                break;
+            }
+            case BVTermType::DIV_U:
+            case BVTermType::DIV_S: {
+                if (isOne(_second)) return share(_first);
+                break;
+            }
+            case BVTermType::MOD_U:
+            case BVTermType::MOD_S1:
+            case BVTermType::MOD_S2: {
+                if (isOne(_second)) return create(BVTermType::CONSTANT, BVValue(width, 0));
+                break;
+            }
+            case BVTermType::EQ: {
+                if (_first == _second) return create(BVTermType::CONSTANT, BVValue(1, 1));
+                break;
+            }
+            case BVTermType::LSHIFT:
+            case BVTermType::RSHIFT_LOGIC:
+            case BVTermType::RSHIFT_ARITH: {
+                if (isZero(_first) || isZero(_second)) return share(_first);
+                break;
+            }
+            default:
+                break;
+        }
+        return nullptr;
+    }
+
+    BVTermPool::ConstTermPtr BVTermPool::simplify(const BVTerm& _operand, const size_t _highest, const size_t _lowest)
+    {
+        if (!mRewriting.extractConcatFusion) {
+            return nullptr;
+        }
+        if (_lowest == 0 && _highest + 1 == _operand.width()) {
+            return share(_operand);
+        }
+        switch (_operand.type()) {
+            case BVTermType::EXTRACT: {
+                std::size_t offset = _operand.lowest();
+                return create(BVTermType::EXTRACT, _operand.operand(), _highest + offset, _lowest + offset);
+            }
+            case BVTermType::CONCAT: {
+                // Only select from one side of the concatenation, splitting would introduce new terms
+                std::size_t lowWidth = _operand.second().width();
+                if (_lowest >= lowWidth) {
+                    return create(BVTermType::EXTRACT, _operand.first(), _highest - lowWidth, _lowest - lowWidth);
+                }
+                if (_highest < lowWidth) {
+                    return create(BVTermType::EXTRACT, _operand.second(), _highest, _lowest);
+                }
+                break;
+            }
+            case BVTermType::EXT_U:
+            case BVTermType::EXT_S: {
+                std::size_t innerWidth = _operand.operand().width();
+                if (_highest < innerWidth) {
+                    return create(BVTermType::EXTRACT, _operand.operand(), _highest, _lowest);
+                }
+                if (_operand.type() == BVTermType::EXT_U && _lowest >= innerWidth) {
+                    return create(BVTermType::CONSTANT, BVValue(_highest - _lowest + 1, 0));
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        return nullptr;
+    }
+
     void BVTermPool::assignId(TermPtr _term, std::size_t _id)
     {
         _term->mId = _id;
@@ -10,6 +10,34 @@
 
 namespace carl
 {
+	/**
+	 * Selects the rewriting rules that BVTermPool applies whenever a term is created.
+	 */
+	struct BVTermRewriting
+	{
+		/// Evaluate operations whose operands are all constant.
+		bool constantFolding = true;
+		/// Apply algebraic identities like x+0 = x, x*1 = x, x^x = 0 or ~~x = x.
+		bool identities = true;
+		/// Fuse nested extracts, extracts of concatenations and concatenations of adjacent extracts.
+		bool extractConcatFusion = true;
+		/// Order the operands of commutative operations, constants coming last.
+		bool commutativeOrdering = true;
+
+		/**
+		 * @return Settings with all rewriting rules disabled.
+		 */
+		static BVTermRewriting none()
+		{
+			return BVTermRewriting{false, false, false, false};
+		}
+	};
+
+	/**
+	 * The pool of all bit-vector terms.
+	 * All create() methods return a term content that is already registered once for the caller,
+	 * which is the BVTerm that takes ownership of it.
+	 */
 	class BVTermPool : public Singleton<BVTermPool>, public Pool<BVTermContent>
 	{
 		friend Singleton<BVTermPool>;
@@ -21,6 +49,12 @@ namespace carl
 	private:
 
 		ConstTermPtr mpInvalid;
+		BVTermRewriting mRewriting;
+
+		ConstTermPtr share(const BVTerm& _term);
+		ConstTermPtr simplify(BVTermType _type, const BVTerm& _operand, const size_t _index);
+		ConstTermPtr simplify(BVTermType _type, const BVTerm& _first, const BVTerm& _second);
+		ConstTermPtr simplify(const BVTerm& _operand, const size_t _highest, const size_t _lowest);
 
 	public:
 
@@ -40,6 +74,23 @@ namespace carl
 
 		ConstTermPtr create(BVTermType _type, const BVTerm& _operand, const size_t _first, const size_t _last);
 
+		/**
+		 * @return The rewriting rules applied when creating terms.
+		 */
+		const BVTermRewriting& rewriting() const
+		{
+			return mRewriting;
+		}
+
+		/**
+		 * Changes the rewriting rules applied when creating terms.
+		 * Terms that have already been created are not affected.
+		 */
+		void setRewriting(const BVTermRewriting& _rewriting)
+		{
+			mRewriting = _rewriting;
+		}
+
 		void assignId(TermPtr _term, std::size_t _id) override;
 	};
 }
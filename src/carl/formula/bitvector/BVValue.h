@@ -6,6 +6,7 @@
 #pragma once
 
 #include "../../numbers/numbers.h"
+#include "../../util/hash.h"
 #include "../../util/platform.h"
 
 #include <boost/dynamic_bitset.hpp>
@@ -20,136 +21,381 @@
 #else
 #include <gmpxx.h>
 #endif
+#include <algorithm>
+#include <cassert>
+#include <iterator>
 #include <limits.h>
+#include <type_traits>
+#include <vector>
 
 namespace carl
 {
+    /**
+     * A fixed-width bit vector value.
+     *
+     * The value is stored as a sequence of machine words (GMP limbs), least
+     * significant limb first. Values of width up to one limb are stored inline,
+     * wider values in a heap-allocated limb array. All bits above the width
+     * are kept zero, such that comparisons and hashing can work on whole limbs.
+     * Arithmetic uses native word operations for inline values and the GMP
+     * mpn_* kernels for wide values.
+     */
     class BVValue
     {
 	public:
 		using Base = boost::dynamic_bitset<>;
+		using Limb = mp_limb_t;
+		static constexpr std::size_t LimbBits = GMP_NUMB_BITS;
+
+		/**
+		 * Proxy for a single, writable bit of a BVValue.
+		 */
+		class BitReference
+		{
+			friend class BVValue;
+			Limb& mLimb;
+			Limb mMask;
+
+			BitReference(Limb& _limb, std::size_t _bit): mLimb(_limb), mMask(Limb(1) << _bit)
+			{
+			}
+		public:
+			operator bool() const
+			{
+				return (mLimb & mMask) != 0;
+			}
+			BitReference& operator=(bool _value)
+			{
+				if(_value) mLimb |= mMask;
+				else mLimb &= ~mMask;
+				return *this;
+			}
+			BitReference& operator=(const BitReference& _other)
+			{
+				return *this = bool(_other);
+			}
+			BitReference& flip()
+			{
+				mLimb ^= mMask;
+				return *this;
+			}
+		};
+
     private:
-        Base mValue;
+        std::size_t mWidth;
+        union {
+            Limb mWord;
+            Limb* mLimbs;
+        };
+
+        static std::size_t limbCount(std::size_t _width)
+        {
+            return (_width + LimbBits - 1) / LimbBits;
+        }
+
+        bool isInline() const
+        {
+            return mWidth <= LimbBits;
+        }
+
+        std::size_t size() const
+        {
+            return limbCount(mWidth);
+        }
+
+        Limb* data()
+        {
+            return isInline() ? &mWord : mLimbs;
+        }
+
+        const Limb* data() const
+        {
+            return isInline() ? &mWord : mLimbs;
+        }
 
-        explicit BVValue(boost::dynamic_bitset<>&& value): mValue(std::move(value))
+        /// Mask of the valid bits in the most significant limb.
+        Limb topMask() const
         {
+            std::size_t rest = mWidth % LimbBits;
+            return rest == 0 ? ~Limb(0) : (Limb(1) << rest) - 1;
+        }
+
+        /// Clears all bits above the width.
+        void normalize()
+        {
+            if(mWidth > 0) {
+                data()[size()-1] &= topMask();
+            }
+        }
+
+        void allocate()
+        {
+            if(isInline()) {
+                mWord = 0;
+            } else {
+                mLimbs = new Limb[size()]();
+            }
+        }
+
+        void release()
+        {
+            if(!isInline()) {
+                delete[] mLimbs;
+            }
+        }
+
+        /// Returns LimbBits bits of _src starting at bit _pos, padded with zeros.
+        static Limb bitsAt(const Limb* _src, std::size_t _srcLimbs, std::size_t _pos)
+        {
+            std::size_t limb = _pos / LimbBits;
+            std::size_t bit = _pos % LimbBits;
+            if(limb >= _srcLimbs) return 0;
+            Limb res = _src[limb] >> bit;
+            if(bit != 0 && limb + 1 < _srcLimbs) {
+                res |= _src[limb+1] << (LimbBits - bit);
+            }
+            return res;
+        }
+
+        /// Ors _src, shifted left by _pos bits, into _dest. Bits beyond _destLimbs are dropped.
+        static void orShifted(Limb* _dest, std::size_t _destLimbs, const Limb* _src, std::size_t _srcLimbs, std::size_t _pos)
+        {
+            std::size_t limb = _pos / LimbBits;
+            std::size_t bit = _pos % LimbBits;
+            for(std::size_t i=0;i<_srcLimbs && limb+i<_destLimbs;++i) {
+                _dest[limb+i] |= _src[i] << bit;
+                if(bit != 0 && limb+i+1 < _destLimbs) {
+                    _dest[limb+i+1] |= _src[i] >> (LimbBits - bit);
+                }
+            }
+        }
+
+        /// Number of limbs without leading zero limbs.
+        static std::size_t significantLimbs(const Limb* _limbs, std::size_t _n)
+        {
+            while(_n > 0 && _limbs[_n-1] == 0) --_n;
+            return _n;
         }
 
     public:
-        BVValue() : mValue()
+        BVValue() : mWidth(0), mWord(0)
         {
         }
 
         explicit BVValue(std::size_t _width, uint _value = 0) :
-        	mValue(_width, _value)
+        	mWidth(_width)
         {
+            allocate();
+            if(mWidth > 0) {
+                data()[0] = Limb(_value);
+                normalize();
+            }
         }
 #ifdef USE_CLN_NUMBERS
         explicit BVValue(std::size_t _width, const cln::cl_I _value) :
-        	mValue(_width)
+        	mWidth(_width)
         {
+            allocate();
             for(std::size_t i=0;i<_width;++i) {
-                mValue[i] = cln::logbitp(i, _value);
+                (*this)[i] = cln::logbitp(i, _value);
             }
         }
 #endif
         BVValue(std::size_t _width, const mpz_class _value) :
-        	mValue()
-        {
-            // Obtain an mpz_t copy of _value
-            mpz_t value;
-            mpz_init(value);
-            mpz_set(value, _value.get_mpz_t());
-
-            // Remember whether the given value is negative.
-            // The conversion is based on the mpz_export function, which ignores
-            // the sign. Hence, we have to construct the two's complement
-            // ourselves in case of negative numbers.
-            bool valueNegative = (mpz_sgn(value) == -1);
+        	mWidth(_width)
+        {
+            allocate();
+            // Reducing modulo 2^width yields the two's complement representation
+            // for negative numbers as well.
+            mpz_class value;
+            mpz_fdiv_r_2exp(value.get_mpz_t(), _value.get_mpz_t(), _width);
+            std::size_t n = std::min(size(), std::size_t(mpz_size(value.get_mpz_t())));
+            Limb* limbs = data();
+            for(std::size_t i=0;i<n;++i) {
+                limbs[i] = mpz_getlimbn(value.get_mpz_t(), mp_size_t(i));
+            }
+        }
 
-            if(valueNegative) {
-                // If the value is negative, increase it by 1 before conversion.
-                // This way we only have to flip all bits afterwards.
-                mpz_add_ui(value, value, 1);
+        /**
+         * Constructs a value from a range of blocks, least significant block first.
+         * The width is the number of blocks times the number of bits per block.
+         */
+        template <typename BlockInputIterator, typename std::enable_if<!std::is_integral<BlockInputIterator>::value, int>::type = 0>
+        explicit BVValue(BlockInputIterator _first, BlockInputIterator _last) :
+        	mWidth(0), mWord(0)
+        {
+            using Block = typename std::iterator_traits<BlockInputIterator>::value_type;
+            constexpr std::size_t bitsPerBlock = sizeof(Block) * CHAR_BIT;
+            std::vector<Block> blocks(_first, _last);
+            BVValue res(blocks.size() * bitsPerBlock);
+            for(std::size_t b=0;b<blocks.size();++b) {
+                for(std::size_t i=0;i<bitsPerBlock;++i) {
+                    if((blocks[b] >> i) & 1) res[b*bitsPerBlock + i] = true;
+                }
             }
+            *this = std::move(res);
+        }
 
-            // We export into an array of boost::dynamic_bitset<>::block_type.
-            // Calculate the number of needed blocks upfront
-            std::size_t bitsPerBlock = sizeof(boost::dynamic_bitset<>::block_type) * CHAR_BIT;
-            std::size_t valueBits = mpz_sizeinbase(value, 2);
-            std::size_t blockCount = (valueBits + bitsPerBlock - 1) / bitsPerBlock;
+        /**
+         * Constructs a value of the given width from an integral value.
+         * Like boost::dynamic_bitset, a pair of integers of the same type is
+         * interpreted as width and value instead of a block range.
+         */
+        template <typename Integral, typename std::enable_if<std::is_integral<Integral>::value, int>::type = 0>
+        explicit BVValue(Integral _width, Integral _value) :
+        	mWidth(std::size_t(_width))
+        {
+            allocate();
+            unsigned long value = static_cast<unsigned long>(_value);
+            for(std::size_t i=0;i<size() && value != 0;++i) {
+                data()[i] = Limb(value);
+                // Two half-width shifts, as a single shift by LimbBits is undefined if a limb is as wide as the value.
+                value = (value >> (LimbBits / 2)) >> (LimbBits - LimbBits / 2);
+            }
+            normalize();
+        }
 
-            // The actual conversion from mpz_t to dynamic_bitset blocks
-            auto bits = new boost::dynamic_bitset<>::block_type[blockCount];
-            mpz_export(&bits[0], &blockCount, -1, sizeof(boost::dynamic_bitset<>::block_type), -1, 0, value);
+        /**
+         * Constructs a value from a string of zeros and ones, most significant bit first.
+         */
+        template<typename Char, typename Traits, typename Alloc>
+        explicit BVValue(const std::basic_string<Char,Traits,Alloc>& _s,
+                         typename std::basic_string<Char, Traits, Alloc>::size_type _pos = 0,
+                         typename std::basic_string<Char, Traits, Alloc>::size_type _n = std::basic_string<Char,Traits,Alloc>::npos) :
+        	mWidth(std::min(_n, _s.size() - _pos))
+        {
+            assert(_pos <= _s.size());
+            allocate();
+            for(std::size_t i=0;i<mWidth;++i) {
+                assert(_s[_pos + mWidth - 1 - i] == Char('0') || _s[_pos + mWidth - 1 - i] == Char('1'));
+                if(_s[_pos + mWidth - 1 - i] == Char('1')) (*this)[i] = true;
+            }
+        }
 
-            // Import the blocks into mValue, and resize it afterwards to the desired size
-            mValue.append(&bits[0], &bits[0] + blockCount);
-            mValue.resize(_width);
-            delete[] bits;
+        BVValue(const BVValue& _other) :
+        	mWidth(_other.mWidth)
+        {
+            if(isInline()) {
+                mWord = _other.mWord;
+            } else {
+                mLimbs = new Limb[size()];
+                std::copy(_other.mLimbs, _other.mLimbs + size(), mLimbs);
+            }
+        }
 
-            // If the value was negative, finalize the construction of the two's complement
-            // by inverting all bits
-            if(valueNegative) {
-                mValue.flip();
+        BVValue(BVValue&& _other) noexcept :
+        	mWidth(_other.mWidth)
+        {
+            if(isInline()) {
+                mWord = _other.mWord;
+            } else {
+                mLimbs = _other.mLimbs;
+                _other.mWidth = 0;
+                _other.mWord = 0;
             }
         }
 
-        template <typename BlockInputIterator>
-        explicit BVValue(BlockInputIterator _first, BlockInputIterator _last) :
-        	mValue(_first, _last)
+        ~BVValue()
         {
+            release();
         }
 
-        template<typename Char, typename Traits, typename Alloc>
-        explicit BVValue(const std::basic_string<Char,Traits,Alloc>& _s,
-                         typename std::basic_string<Char, Traits, Alloc>::size_type _pos = 0,
-                         typename std::basic_string<Char, Traits, Alloc>::size_type _n = std::basic_string<Char,Traits,Alloc>::npos) :
-        	mValue(_s, _pos, _n)
+        BVValue& operator=(const BVValue& _other)
         {
+            if(this != &_other) {
+                BVValue copy(_other);
+                *this = std::move(copy);
+            }
+            return *this;
         }
 
-        operator const Base&() const
+        BVValue& operator=(BVValue&& _other) noexcept
         {
-            return mValue;
+            if(this != &_other) {
+                release();
+                mWidth = _other.mWidth;
+                if(isInline()) {
+                    mWord = _other.mWord;
+                } else {
+                    mLimbs = _other.mLimbs;
+                    _other.mWidth = 0;
+                    _other.mWord = 0;
+                }
+            }
+            return *this;
+        }
+
+        operator Base() const
+        {
+            Base res(mWidth);
+            for(std::size_t i=0;i<mWidth;++i) {
+                if((*this)[i]) res.set(i);
+            }
+            return res;
         }
 
         std::size_t width() const
         {
-            return mValue.size();
+            return mWidth;
+        }
+
+        /// Number of limbs used to store this value.
+        std::size_t limbs() const
+        {
+            return size();
+        }
+
+        /// Returns the i'th limb, least significant limb first.
+        Limb limb(std::size_t _index) const
+        {
+            assert(_index < size());
+            return data()[_index];
         }
 
         std::string toString() const
         {
-            std::string output;
-            boost::to_string(mValue, output);
+            std::string output(mWidth, '0');
+            for(std::size_t i=0;i<mWidth;++i) {
+                if((*this)[i]) output[mWidth - 1 - i] = '1';
+            }
             return "#b" + output;
         }
 
         bool isZero() const
         {
-            return mValue.none();
+            const Limb* limbs = data();
+            return std::all_of(limbs, limbs + size(), [](Limb l){ return l == 0; });
         }
 
         BVValue operator-() const
         {
-            return ~(*this) + BVValue(width(), 1);
+            BVValue res(mWidth);
+            if(isInline()) {
+                res.mWord = Limb(0) - mWord;
+            } else {
+                mpn_neg(res.mLimbs, mLimbs, mp_size_t(size()));
+            }
+            res.normalize();
+            return res;
         }
 
         BVValue operator~() const
         {
-            return BVValue(~mValue);
+            BVValue res(mWidth);
+            const Limb* src = data();
+            Limb* dest = res.data();
+            for(std::size_t i=0;i<size();++i) {
+                dest[i] = ~src[i];
+            }
+            res.normalize();
+            return res;
         }
 
         BVValue rotateLeft(std::size_t _n) const
         {
-            boost::dynamic_bitset<> lowerPart(mValue);
-            boost::dynamic_bitset<> upperPart(mValue);
-
-            lowerPart <<= _n % width();
-            upperPart >>= width() - (_n % width());
-
-            return BVValue(lowerPart ^ upperPart);
+            std::size_t n = _n % width();
+            if(n == 0) return *this;
+            return shiftLeft(n) | shiftRight(width() - n);
         }
 
         BVValue rotateRight(std::size_t _n) const
@@ -162,24 +408,33 @@ namespace carl
             assert(_n > 0);
             BVValue repeated(_n * width());
 
-            for(std::size_t i=0;i<repeated.width();++i) {
-                repeated[i] = (*this)[i % width()];
+            for(std::size_t i=0;i<_n;++i) {
+                orShifted(repeated.data(), repeated.size(), data(), size(), i * width());
             }
             return repeated;
         }
 
         BVValue extendUnsignedBy(std::size_t _n) const
         {
-            boost::dynamic_bitset<> copy(mValue);
-            copy.resize(width() + _n);
-            return BVValue(std::move(copy));
+            BVValue extended(width() + _n);
+            std::copy(data(), data() + size(), extended.data());
+            return extended;
         }
 
         BVValue extendSignedBy(std::size_t _n) const
         {
-            boost::dynamic_bitset<> copy(mValue);
-            copy.resize(width() + _n, (*this)[width()-1]);
-            return BVValue(std::move(copy));
+            if(width() == 0 || !(*this)[width()-1]) {
+                return extendUnsignedBy(_n);
+            }
+            BVValue extended(width() + _n);
+            Limb* dest = extended.data();
+            std::fill(dest, dest + extended.size(), ~Limb(0));
+            std::copy(data(), data() + width() / LimbBits, dest);
+            if(width() % LimbBits != 0) {
+                dest[width() / LimbBits] = data()[width() / LimbBits] | (~Limb(0) << (width() % LimbBits));
+            }
+            extended.normalize();
+            return extended;
         }
 
         friend std::ostream& operator<<(std::ostream& _out, const BVValue& _value)
@@ -189,88 +444,120 @@ namespace carl
 
         bool operator==(const BVValue& _other) const
         {
-            return mValue == _other.mValue;
+            return mWidth == _other.mWidth && std::equal(data(), data() + size(), _other.data());
         }
 
+        /**
+         * Compares two values as unsigned numbers. Values of different width
+         * are compared lexicographically from the most significant bit on,
+         * where a proper prefix is smaller.
+         */
         bool operator<(const BVValue& _other) const
         {
-            return mValue < _other.mValue;
+            if(_other.width() == 0) {
+                return false;
+            } else if(width() == 0) {
+                return true;
+            } else if(width() == _other.width()) {
+                return mpn_cmp(data(), _other.data(), mp_size_t(size())) < 0;
+            }
+            std::size_t common = std::min(width(), _other.width());
+            for(std::size_t i=1;i<=common;++i) {
+                bool mine = (*this)[width()-i];
+                bool theirs = _other[_other.width()-i];
+                if(mine != theirs) return theirs;
+            }
+            return width() < _other.width();
         }
 
-        boost::dynamic_bitset<>::reference operator[](std::size_t _index)
+        BitReference operator[](std::size_t _index)
         {
             assert(_index < width());
-            return mValue[_index];
+            return BitReference(data()[_index / LimbBits], _index % LimbBits);
         }
 
         bool operator[](std::size_t _index) const
         {
             assert(_index < width());
-            return mValue[_index];
+            return ((data()[_index / LimbBits] >> (_index % LimbBits)) & 1) != 0;
         }
 
         BVValue operator+(const BVValue& _other) const
         {
             assert(_other.width() == width());
-
-            bool carry = false;
-            boost::dynamic_bitset<> sum(width());
-
-            for(std::size_t i=0;i<width();++i) {
-                sum[i] = ((*this)[i] != _other[i]) != carry;
-                carry = ((*this)[i] && _other[i]) || (carry && ((*this)[i] || _other[i]));
+            BVValue sum(width());
+            if(isInline()) {
+                sum.mWord = mWord + _other.mWord;
+            } else {
+                mpn_add_n(sum.mLimbs, mLimbs, _other.mLimbs, mp_size_t(size()));
             }
-
-            return BVValue(std::move(sum));
+            sum.normalize();
+            return sum;
         }
 
         BVValue operator-(const BVValue& _other) const
         {
             assert(_other.width() == width());
-            return (*this) + (-_other);
+            BVValue difference(width());
+            if(isInline()) {
+                difference.mWord = mWord - _other.mWord;
+            } else {
+                mpn_sub_n(difference.mLimbs, mLimbs, _other.mLimbs, mp_size_t(size()));
+            }
+            difference.normalize();
+            return difference;
         }
 
         BVValue operator&(const BVValue& _other) const
         {
             assert(_other.width() == width());
-            return BVValue(mValue & Base(_other));
+            BVValue res(width());
+            for(std::size_t i=0;i<size();++i) {
+                res.data()[i] = data()[i] & _other.data()[i];
+            }
+            return res;
         }
 
         BVValue operator|(const BVValue& _other) const
         {
             assert(_other.width() == width());
-            return BVValue(mValue | Base(_other));
+            BVValue res(width());
+            for(std::size_t i=0;i<size();++i) {
+                res.data()[i] = data()[i] | _other.data()[i];
+            }
+            return res;
         }
 
         BVValue operator^(const BVValue& _other) const
         {
             assert(_other.width() == width());
-            return BVValue(mValue ^ Base(_other));
+            BVValue res(width());
+            for(std::size_t i=0;i<size();++i) {
+                res.data()[i] = data()[i] ^ _other.data()[i];
+            }
+            return res;
         }
 
         BVValue concat(const BVValue& _other) const
         {
-            boost::dynamic_bitset<> concatenation(mValue);
-            concatenation.resize(width() + _other.width());
-            concatenation <<= _other.width();
-            boost::dynamic_bitset<> otherResized = _other;
-            otherResized.resize(concatenation.size());
-            concatenation |= otherResized;
-            return BVValue(std::move(concatenation));
+            BVValue concatenation(width() + _other.width());
+            orShifted(concatenation.data(), concatenation.size(), _other.data(), _other.size(), 0);
+            orShifted(concatenation.data(), concatenation.size(), data(), size(), _other.width());
+            return concatenation;
         }
 
         BVValue operator*(const BVValue& _other) const
         {
+            assert(_other.width() == width());
             BVValue product(width());
-            boost::dynamic_bitset<> summand(mValue);
-
-            for(std::size_t i=0;i<width();++i) {
-                if(_other[i]) {
-                    product = product + BVValue(boost::dynamic_bitset<>(summand));
-                }
-                summand <<= 1;
+            if(isInline()) {
+                product.mWord = mWord * _other.mWord;
+            } else {
+                std::vector<Limb> full(2 * size());
+                mpn_mul_n(full.data(), mLimbs, _other.mLimbs, mp_size_t(size()));
+                std::copy(full.begin(), full.begin() + std::ptrdiff_t(size()), product.mLimbs);
             }
-
+            product.normalize();
             return product;
         }
 
@@ -316,7 +603,7 @@ namespace carl
             } else if(! firstNegative && secondNegative) {
                 return (*this) % -_other;
             } else {
-                return -((*this) % -_other);
+                return -(-(*this) % -_other);
             }
         }
 
@@ -339,7 +626,7 @@ namespace carl
             } else if(firstNegative && ! secondNegative) {
                 return -u + _other;
             } else if(! firstNegative && secondNegative) {
-                return (*this) + _other;
+                return u + _other;
             } else {
                 return -u;
             }
@@ -365,82 +652,76 @@ namespace carl
             assert(_highest < width() && _highest >= _lowest);
             BVValue extraction(_highest - _lowest + 1);
 
-            for(std::size_t i=0;i<extraction.width();++i) {
-                extraction[i] = (*this)[_lowest + i];
+            for(std::size_t i=0;i<extraction.size();++i) {
+                extraction.data()[i] = bitsAt(data(), size(), _lowest + i * LimbBits);
             }
-
+            extraction.normalize();
             return extraction;
         }
 
     private:
-        BVValue shift(const BVValue& _other, bool _left, bool _arithmetic = false) const
+        /// Logical left shift by a plain amount, _n < width().
+        BVValue shiftLeft(std::size_t _n) const
         {
-            std::size_t firstSize = width() - 1;
-            std::size_t highestRelevantPos = 0;
-
-            bool fillWithOnes = !_left && _arithmetic && (*this)[width()-1];
-
-            while((firstSize >>= 1) != 0)
-                ++highestRelevantPos;
+            BVValue shifted(width());
+            orShifted(shifted.data(), shifted.size(), data(), size(), _n);
+            shifted.normalize();
+            return shifted;
+        }
 
-            for(std::size_t i=highestRelevantPos+1;i<_other.width();++i) {
-                if(_other[i]) {
-                    boost::dynamic_bitset<> allZero(width());
-                    return BVValue(fillWithOnes ? ~allZero : allZero);
-                }
+        /// Logical right shift by a plain amount, _n < width().
+        BVValue shiftRight(std::size_t _n) const
+        {
+            BVValue shifted(width());
+            for(std::size_t i=0;i<shifted.size();++i) {
+                shifted.data()[i] = bitsAt(data(), size(), _n + i * LimbBits);
             }
+            return shifted;
+        }
 
-            boost::dynamic_bitset<> shifted(fillWithOnes ? ~mValue : mValue);
-            std::size_t shiftBy = 1;
+        BVValue shift(const BVValue& _other, bool _left, bool _arithmetic = false) const
+        {
+            bool fillWithOnes = !_left && _arithmetic && (*this)[width()-1];
 
-            for(std::size_t i=0;i<=highestRelevantPos && i < _other.width();++i) {
-                if(_other[i]) {
-                    if(_left) {
-                        shifted <<= shiftBy;
-                    } else {
-                        shifted >>= shiftBy;
-                    }
-                }
-                shiftBy *= 2;
+            // Shifting by at least the width yields all zeros (or ones).
+            std::size_t significant = significantLimbs(_other.data(), _other.size());
+            if(significant > 1 || (significant == 1 && _other.data()[0] >= width())) {
+                BVValue allZero(width());
+                return fillWithOnes ? ~allZero : allZero;
             }
+            std::size_t shiftBy = significant == 0 ? 0 : std::size_t(_other.data()[0]);
 
-            return BVValue(fillWithOnes ? ~shifted : shifted);
+            if(_left) {
+                return shiftLeft(shiftBy);
+            } else if(fillWithOnes) {
+                return ~((~(*this)).shiftRight(shiftBy));
+            } else {
+                return shiftRight(shiftBy);
+            }
         }
 
         BVValue divideUnsigned(const BVValue& _other, bool _returnRemainder = false) const
         {
             assert(width() == _other.width());
-            assert(Base(_other) != boost::dynamic_bitset<>(_other.width(), 0));
-
-            boost::dynamic_bitset<> quotient(width());
-            std::size_t quotientIndex = 0;
-            boost::dynamic_bitset<> divisor = _other;
-            boost::dynamic_bitset<> remainder(mValue);
-
-            while(! divisor[divisor.size()-1] && remainder > divisor) {
-                ++quotientIndex;
-                divisor <<= 1;
-            }
-
-            while(true) {
-                if(remainder >= divisor) {
-                    quotient[quotientIndex] = true;
-                    // substract divisor from remainder
-                    bool carry = false;
-                    for(std::size_t i=divisor.find_first();i<remainder.size();++i) {
-                        bool newRemainderI = (remainder[i] != divisor[i]) != carry;
-                        carry = (remainder[i] && carry && divisor[i]) || (! remainder[i] && (carry || divisor[i]));
-                        remainder[i] = newRemainderI;
-                    }
-                }
-                if(quotientIndex == 0) {
-                    break;
-                }
-                divisor >>= 1;
-                --quotientIndex;
+            assert(!_other.isZero());
+
+            BVValue quotient(width());
+            BVValue remainder(width());
+
+            if(isInline()) {
+                quotient.mWord = mWord / _other.mWord;
+                remainder.mWord = mWord % _other.mWord;
+                return _returnRemainder ? remainder : quotient;
             }
 
-            return BVValue(_returnRemainder ? std::move(remainder) : std::move(quotient));
+            std::size_t dividendLimbs = significantLimbs(mLimbs, size());
+            std::size_t divisorLimbs = significantLimbs(_other.mLimbs, size());
+            if(dividendLimbs < divisorLimbs) {
+                return _returnRemainder ? *this : quotient;
+            }
+            mpn_tdiv_qr(quotient.mLimbs, remainder.mLimbs, 0,
+                        mLimbs, mp_size_t(dividendLimbs), _other.mLimbs, mp_size_t(divisorLimbs));
+            return _returnRemainder ? remainder : quotient;
         }
     };
 }
@@ -449,8 +730,6 @@ namespace std
 {
     /**
      * Implements std::hash for bit vector values.
-     * TODO: Make more efficient (currently uses dynamic_bitset<> conversion to string).
-     * See also: https://stackoverflow.com/q/3896357, https://svn.boost.org/trac/boost/ticket/2841
      */
     template <>
     struct hash<carl::BVValue>
@@ -463,7 +742,11 @@ namespace std
          */
         size_t operator()(const carl::BVValue& _value) const
         {
-            return std::hash<std::string>()(_value.toString());
+            std::size_t seed = _value.width();
+            for(std::size_t i=0;i<_value.limbs();++i) {
+                carl::hash_add(seed, std::size_t(_value.limb(i)));
+            }
+            return seed;
         }
     };
 }
@@ -10,11 +10,28 @@
 #include "../../util/Common.h"
 #include "../../util/Singleton.h"
 
+#include <array>
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace carl
 {
 
+	/**
+	 * A pool of unique, reference counted elements.
+	 *
+	 * The pool is split into several shards, each guarded by its own mutex,
+	 * such that concurrent insertions mostly do not contend. Every element
+	 * carries a counter `mUsages` of the handles referring to it. Elements
+	 * obtained by add() are already registered once for the caller, and the
+	 * handle calls free() when it does no longer refer to the element.
+	 * Unused elements are removed from the pool and deleted, and their ids
+	 * are reused for new elements.
+	 *
+	 * The element type must provide `hash()`, `id()` and a mutable atomic
+	 * counter `mUsages` that is accessible by the pool.
+	 */
 	template<typename Element>
 	class Pool
 	{
@@ -23,19 +40,55 @@ namespace carl
 		typedef Element* ElementPtr;
 		typedef const Element* ConstElementPtr;
 
+		/// Number of shards, must be a power of two.
+		static constexpr std::size_t SHARDS = 16;
+
+		struct Shard
+		{
+			/// The elements of this shard.
+			FastPointerSet<Element> mElements;
+			/// Mutex to avoid multiple access to this shard
+			mutable std::mutex mMutex;
+		};
+
 	private:
 
 		// Members:
-		/// id allocator
-		unsigned mIdAllocator;
-		/// The formula pool.
-		FastPointerSet<Element> mPool;
-		/// Mutex to avoid multiple access to the pool
-		mutable std::mutex mMutexPool;
+		/// The shards of the pool.
+		std::array<Shard, SHARDS> mShards;
+		/// Ids of deleted elements that can be reused.
+		std::vector<std::size_t> mFreeIds;
+		/// The smallest id that has never been used.
+		std::size_t mNextId;
+		/// Mutex for the id allocator.
+		std::mutex mMutexIds;
+		/// Set once the pool is destroyed, handles that survive the pool must not touch it anymore.
+		static std::atomic<bool> mDestroyed;
+
+#define POOL_LOCK_GUARD(shard) std::lock_guard<std::mutex> lock( (shard).mMutex );
+
+		Shard& shard(const Element& _element)
+		{
+			std::size_t h = _element.hash();
+			return mShards[(h ^ (h >> 16)) & (SHARDS - 1)];
+		}
+
+		std::size_t allocateId()
+		{
+			std::lock_guard<std::mutex> lock(mMutexIds);
+			if (mFreeIds.empty()) {
+				return mNextId++;
+			}
+			std::size_t id = mFreeIds.back();
+			mFreeIds.pop_back();
+			return id;
+		}
 
-#define POOL_LOCK_GUARD std::lock_guard<std::mutex> lock( mMutexPool );
-#define POOL_LOCK mMutexPool.lock();
-#define POOL_UNLOCK mMutexPool.unlock();
+		void releaseId(std::size_t _id)
+		{
+			std::lock_guard<std::mutex> lock(mMutexIds);
+			mFreeIds.push_back(_id);
+		}
 
 	protected:
 
@@ -44,20 +97,25 @@ namespace carl
 		 * @param _capacity Expected necessary capacity of the pool.
 		 */
 		explicit Pool(unsigned _capacity = 10000) :
-			mIdAllocator(1),
-			mPool(),
-			mMutexPool()
+			mShards(),
+			mFreeIds(),
+			mNextId(1),
+			mMutexIds()
 		{
-			mPool.reserve(_capacity);
-
+			for (auto& s: mShards) {
+				s.mElements.reserve(_capacity / SHARDS);
+			}
 		}
 
 		~Pool()
 		{
-			while(!mPool.empty()) {
-				ConstElementPtr element = *mPool.begin();
-				mPool.erase(mPool.begin());
-				delete element;
+			// Elements refer to each other, their handles must not free anything from now on.
+			mDestroyed = true;
+			for (auto& s: mShards) {
+				for (ConstElementPtr element: s.mElements) {
+					delete element;
+				}
+				s.mElements.clear();
 			}
 		}
 
@@ -76,47 +134,107 @@ namespace carl
 		void print() const
 		{
 			std::cout << "Pool contains:" << std::endl;
-			for(const auto& ele : mPool) {
-				std::cout << "- " << *ele << std::endl;
+			for (const auto& s: mShards) {
+				POOL_LOCK_GUARD(s)
+				for(const auto& ele : s.mElements) {
+					std::cout << "- " << *ele << " [usages=" << ele->mUsages << "]" << std::endl;
+				}
 			}
 			std::cout << std::endl;
 		}
 
+		/**
+		 * @return The number of elements currently stored in the pool.
+		 */
+		std::size_t size() const
+		{
+			std::size_t result = 0;
+			for (const auto& s: mShards) {
+				POOL_LOCK_GUARD(s)
+				result += s.mElements.size();
+			}
+			return result;
+		}
+
 		/**
 		 * Inserts the given element into the pool, if it does not yet occur in there.
+		 * The resulting element is registered once for the caller.
 		 * @param _element The element to add to the pool.
 		 * @param _assertFreshness When true, an assertion fails if the element is not fresh
 		 *                         (i.e., if it already occurs in the pool).
-		 * @return The position of the given element in the pool and true, if it did not yet occur in the pool;
-		 *         The position of the equivalent element in the pool and false, otherwise.
+		 * @return The given element and true, if it did not yet occur in the pool;
+		 *         The equivalent element already occurring in the pool and false, otherwise.
 		 */
-		std::pair<typename FastPointerSet<Element>::iterator, bool> insert(ElementPtr _element, bool _assertFreshness = false)
+		std::pair<ConstElementPtr, bool> insert(ElementPtr _element, bool _assertFreshness = false)
 		{
-			POOL_LOCK_GUARD
-			auto iterBoolPair = mPool.insert(_element);
-			assert(iterBoolPair.second || !_assertFreshness);
-
-			if(iterBoolPair.second) { // Element has just been inserted
-				// Assign a new id
-				assignId(_element, mIdAllocator++); // id should be set here to avoid conflicts when multi-threading
-			} else {
+			std::pair<ConstElementPtr, bool> result;
+			{
+				Shard& s = shard(*_element);
+				POOL_LOCK_GUARD(s)
+				auto iterBoolPair = s.mElements.insert(_element);
+				assert(iterBoolPair.second || !_assertFreshness);
+				if(iterBoolPair.second) { // Element has just been inserted
+					// Assign a new id
+					assignId(_element, allocateId()); // id should be set here to avoid conflicts when multi-threading
+				}
+				// Lookups are done under the lock, hence the element can not be deleted concurrently.
+				++(*iterBoolPair.first)->mUsages;
+				result = std::make_pair(*iterBoolPair.first, iterBoolPair.second);
+			}
+			if(!result.second) {
 				// The argument can be deleted, return the already existent instance
 				delete _element;
 			}
-
-			return iterBoolPair;
+			return result;
 		}
 
 		/**
 		 * Adds the given element to the pool, if it does not yet occur in there.
-		 * Note, that this method uses the allocator which is locked before calling.
+		 * The resulting element is registered once for the caller.
 		 * @param _element The element to add to the pool.
 		 * @return The given element, if it did not yet occur in the pool;
 		 *         The equivalent element already occurring in the pool, otherwise.
 		 */
 		ConstElementPtr add(ElementPtr _element)
 		{
-			return *(insert(_element).first);
+			return insert(_element).first;
+		}
+
+		/**
+		 * Registers another usage of the given element.
+		 * The caller must already hold a usage of this element.
+		 */
+		void reg(ConstElementPtr _element) const
+		{
+			assert(_element->mUsages > 0);
+			_element->mUsages.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Releases a usage of the given element and deletes it, if it is not used anymore.
+		 */
+		void free(ConstElementPtr _element)
+		{
+			if (mDestroyed) return;
+			std::size_t usages = _element->mUsages.load(std::memory_order_relaxed);
+			while (usages > 1) {
+				// Somebody else still uses the element, no need to lock.
+				if (_element->mUsages.compare_exchange_weak(usages, usages - 1, std::memory_order_acq_rel)) return;
+			}
+			{
+				Shard& s = shard(*_element);
+				POOL_LOCK_GUARD(s)
+				assert(_element->mUsages > 0);
+				// The element may have been found by insert() in the meantime.
+				if (--_element->mUsages > 0) return;
+				s.mElements.erase(_element);
+			}
+			releaseId(_element->id());
+			// Deleting the element may free further elements, hence no lock is held here.
+			delete _element;
 		}
 	};
+
+	template<typename Element>
+	std::atomic<bool> Pool<Element>::mDestroyed(false);
 } // namespace carl
@@ -0,0 +1,9 @@
+/**
+ * Auto generated file config.h from config.h.in.
+ */ 
+#pragma once
+
+/* #undef LOGGING */
+/* #undef LOGGING_DISABLE_INEFFICIENT */
+/* #undef VARIABLE_PASS_BY_VALUE */
+#define CARL_USE_FRIENDLY_VARNAMES
@@ -15,6 +15,7 @@
 
 #include "../../../core/MultivariatePolynomial.h"
 #include "../../../interval/IntervalEvaluation.h"
+#include "../../../interval/MpfrIntervalEvaluation.h"
 #include "../../../thom/ThomEvaluation.h"   
 #include "../../../util/SFINAE.h"
 
@@ -53,6 +54,26 @@ RealAlgebraicNumber<Number> evaluate(const MultivariatePolynomial<Number>& p, RA
 template<typename Number>
 RealAlgebraicNumber<Number> evaluateIR(const MultivariatePolynomial<Number>& p, RANMap<Number>& m);
 
+/**
+ * Tries to determine the sign of the given polynomial at the given point without computing its value as a real algebraic number.
+ * The polynomial is evaluated on the isolating intervals in interval arithmetic, first with doubles and then with MPFR numbers or exactly,
+ * where the precision is doubled and the intervals are refined in every round.
+ * The values are refined in place and may thereby become numeric.
+ * A nonzero sign is determined if the interval evaluation excludes zero, the sign zero only if p becomes a number after
+ * substituting the numeric values. Nothing is determined unless RealAlgebraicNumberSettings::ADAPTIVE_SIGN_EVALUATION is set.
+ *
+ * @param p Polynomial to be evaluated
+ * @param point Values for variables
+ * @param variables Variables to be assigned
+ * @param sign Sign of p at the point, if it could be determined
+ * @param maxPrecision Precision in bits of the last round, the values are not refined if it equals RealAlgebraicNumberSettings::ADAPTIVE_INITIAL_PRECISION
+ * @return true, if the sign was determined
+ */
+template<typename Number, typename Coeff>
+bool evaluateSign(const MultivariatePolynomial<Coeff>& p, const RealAlgebraicPoint<Number>& point, const std::vector<Variable>& variables, Sign& sign, std::size_t maxPrecision = RealAlgebraicNumberSettings::ADAPTIVE_MAX_PRECISION);
+template<typename Number>
+bool evaluateSign(const MultivariatePolynomial<Number>& p, const RANMap<Number>& m, Sign& sign, std::size_t maxPrecision = RealAlgebraicNumberSettings::ADAPTIVE_MAX_PRECISION);
+
 /**
  * Computes a univariate polynomial with rational coefficients that has the roots of p whose coefficient variables have been substituted by the roots given in m.
  * The map varToInterval gives back an assignment of variables to the isolating intervals of the roots for each variable.
@@ -151,6 +172,50 @@ RealAlgebraicNumber<Number> evaluate(const MultivariatePolynomial<Number>& p, RA
 }
 
 
+template<typename Number, typename Coeff>
+bool evaluateSign(const MultivariatePolynomial<Coeff>& p, const RealAlgebraicPoint<Number>& point, const std::vector<Variable>& variables, Sign& sign, std::size_t maxPrecision) {
+	assert(point.dim() == variables.size());
+	if (!RealAlgebraicNumberSettings::ADAPTIVE_SIGN_EVALUATION) return false;
+	RANMap<Number> RANs;
+	for (std::size_t i = 0; i < point.dim(); i++) {
+		if (p.has(variables[i])) RANs.emplace(variables[i], point[i]);
+	}
+	return evaluateSign(p, RANs, sign, maxPrecision);
+}
+
+template<typename Number>
+bool evaluateSign(const MultivariatePolynomial<Number>& p, const RANMap<Number>& m, Sign& sign, std::size_t maxPrecision) {
+	if (!RealAlgebraicNumberSettings::ADAPTIVE_SIGN_EVALUATION) return false;
+	for (const auto& r: m) {
+		if (r.second.isThom()) return false;
+	}
+	for (std::size_t precision = RealAlgebraicNumberSettings::ADAPTIVE_INITIAL_PRECISION; precision <= maxPrecision; precision *= 2) {
+		MultivariatePolynomial<Number> pol(p);
+		std::map<Variable, Interval<Number>> box;
+		for (const auto& r: m) {
+			if (r.second.isNumeric()) {
+				pol.substituteIn(r.first, MultivariatePolynomial<Number>(r.second.value()));
+			} else {
+				box.emplace(r.first, r.second.getInterval());
+			}
+		}
+		if (pol.isNumber()) {
+			sign = carl::sgn(pol.constantPart());
+			return true;
+		}
+		sign = adaptiveSign(pol, box, precision);
+		CARL_LOG_TRACE("carl.ran", "Sign of " << pol << " on " << box << " with precision " << precision << ": " << sign);
+		if (sign != Sign::ZERO) return true;
+		if (2 * precision > maxPrecision) break;
+		for (const auto& r: m) {
+			for (std::size_t i = 0; i < RealAlgebraicNumberSettings::ADAPTIVE_REFINEMENTS && !r.second.isNumeric(); i++) {
+				r.second.refine();
+			}
+		}
+	}
+	return false;
+}
+
 /**
  * Evaluates the given polynomial with the given values for the variables.
  * Asserts that all variables of p have an assignment in m and that m has no additional assignments.
@@ -164,8 +229,16 @@ RealAlgebraicNumber<Number> evaluateIR(const MultivariatePolynomial<Number>& p,
 	CARL_LOG_DEBUG("carl.ran", "Evaluating " << p << " on " << m);
 	assert(m.size() > 0);
 	auto poly = p.toUnivariatePolynomial(m.begin()->first);
-	if (m.size() == 1 && m.begin()->second.sgn(poly.toNumberCoefficients()) == Sign::ZERO) {
-		return RealAlgebraicNumber<Number>(poly.mainVar());
+	if (m.size() == 1) {
+		if (m.begin()->second.isNumeric()) return evaluate(p, m);
+		// Only check for a root exactly if the value might be zero.
+		// A single round without refinements keeps this filter cheap if the value is zero, as for samples on sections.
+		Sign sign;
+		bool nonzero = evaluateSign(p, m, sign, RealAlgebraicNumberSettings::ADAPTIVE_INITIAL_PRECISION) && sign != Sign::ZERO;
+		if (m.begin()->second.isNumeric()) return evaluate(p, m);
+		if (!nonzero && m.begin()->second.sgn(poly.toNumberCoefficients()) == Sign::ZERO) {
+			return RealAlgebraicNumber<Number>(poly.mainVar());
+		}
 	}
 	Variable v = freshRealVariable();
 	// compute the result polynomial and the initial result interval
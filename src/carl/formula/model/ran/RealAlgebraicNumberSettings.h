@@ -27,5 +27,14 @@ static const std::size_t MAX_FASTSAMPLE_BOUND = SHRT_MAX;
 /// Maximum denominator for the sample search is bounded to the square of the common denominator of the bounds; anything above that value is disregarded and a maybe non-optimal, intermediate value is returned instead
 static const bool MAX_SAMPLE_DENOMINATOR_BOUNDED = true;
 
+/// Determine signs of polynomials at real algebraic points by interval arithmetic on the isolating intervals before evaluating them exactly.
+static const bool ADAPTIVE_SIGN_EVALUATION = true;
+/// Precision in bits of the first interval evaluation, which uses doubles. It is doubled in every round, using MPFR if available and exact intervals otherwise.
+static const std::size_t ADAPTIVE_INITIAL_PRECISION = 53;
+/// Maximum precision in bits of the interval evaluation, exact evaluation is used afterwards.
+static const std::size_t ADAPTIVE_MAX_PRECISION = 1024;
+/// Number of refinements of the isolating intervals between two rounds of the interval evaluation.
+static const std::size_t ADAPTIVE_REFINEMENTS = 8;
+
 }
 }
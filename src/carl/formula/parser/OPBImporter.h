@@ -3,9 +3,11 @@
 #include "../../core/logging.h"
 #include "../../core/Relation.h"
 #include "../Formula.h"
+#include "OPBReader.h"
 
 #include <boost/optional.hpp>
 
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <tuple>
@@ -13,54 +15,51 @@
 
 namespace carl {
 
-using OPBPolynomial = std::vector<std::pair<int,carl::Variable>>;
-using OPBConstraint = std::tuple<OPBPolynomial, Relation, int>;
-
-struct OPBFile {
-	OPBPolynomial objective;
-	std::vector<OPBConstraint> constraints;
-	
-	OPBFile() = default;
-	explicit OPBFile(OPBPolynomial obj): objective(std::move(obj)) {}
-	OPBFile(OPBPolynomial obj, std::vector<OPBConstraint> cons): objective(std::move(obj)), constraints(std::move(cons)) {}
-};
-
 boost::optional<OPBFile> parseOPBFile(std::ifstream& in);
 
 template<typename Pol>
 class OPBImporter {
 private:
 	using Number = typename UnderlyingNumberType<Pol>::type;
-	std::ifstream mIn;
+	OPBReader mReader;
+
+	/**
+	 * Converts an integer read by the OPBReader to the coefficient type.
+	 * Goes through rationalize() as Number may be a CLN type that can not be constructed from mpz_class.
+	 */
+	static Number toNumber(const mpz_class& n) {
+		if (n.fits_slong_p()) return carl::rationalize<Number>(sint(n.get_si()));
+		return carl::rationalize<Number>(n.get_str());
+	}
 
-	std::vector<std::pair<Number,carl::Variable>> convert(const std::vector<std::pair<int,carl::Variable>>& poly) const {
+	std::vector<std::pair<Number,carl::Variable>> convert(const OPBPolynomial& poly) const {
 		std::vector<std::pair<Number,carl::Variable>> res;
 		for (const auto& term: poly) {
-			res.emplace_back(Number(term.first), term.second);
+			res.emplace_back(toNumber(term.first), term.second);
 		}
 		return res;
 	}
 
 public:
 	explicit OPBImporter(const std::string& filename):
-		mIn(filename)
+		mReader(filename)
 	{}
 	
 	boost::optional<std::pair<Formula<Pol>,Pol>> parse() {
-		auto file = parseOPBFile(mIn);
+		auto file = mReader.parse();
 		if (!file) return boost::none;
 		Formulas<Pol> constraints;
 		for (const auto& cons: file->constraints) {
 			auto pol = convert(std::get<0>(cons));
 			Relation rel = std::get<1>(cons);
-			Number rhs = std::get<2>(cons);
+			Number rhs = toNumber(std::get<2>(cons));
 			PBConstraint<Pol> pbc(pol, rel, rhs);
 			constraints.emplace_back(std::move(pbc));
 		}
 		Formula<Pol> resC(FormulaType::AND, std::move(constraints));
 		Pol objective;
 		for (const auto& term: file->objective) {
-			objective += Number(term.first) * carl::Variable(term.second.getId(), carl::VariableType::VT_INT);
+			objective += toNumber(term.first) * carl::Variable(term.second.getId(), carl::VariableType::VT_INT);
 		}
 		return std::make_pair(std::move(resC), std::move(objective));
 	}
@@ -0,0 +1,165 @@
+#include "OPBReader.h"
+
+#include "../../core/logging.h"
+#include "../../core/VariablePool.h"
+#include "../pseudoboolean/PBDatabase.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace carl {
+
+	OPBReader::OPBReader(const std::string& _filename):
+		mFile(_filename)
+	{
+		if (mFile.isOpen()) {
+			mBegin = mFile.begin();
+			mPos = mFile.begin();
+			mEnd = mFile.end();
+		}
+	}
+
+	bool OPBReader::error(const std::string& _expected) {
+#ifdef CARL_LOGGING_ENABLED
+		std::size_t line = std::size_t(std::count(mBegin, mPos, '\n')) + 1;
+		const char* lineEnd = std::find(mPos, mEnd, '\n');
+		CARL_LOG_ERROR("carl.parser", "Parsing OPB input failed in line " << line << ": expected " << _expected << " but got \"" << std::string(mPos, lineEnd) << "\"");
+#else
+		(void)_expected;
+#endif
+		return false;
+	}
+
+	void OPBReader::skip() {
+		while (mPos != mEnd) {
+			switch (*mPos) {
+				case ' ': case '\t': case '\n': case '\r':
+					mPos++;
+					break;
+				case '*':
+					mPos = std::find(mPos, mEnd, '\n');
+					break;
+				default:
+					return;
+			}
+		}
+	}
+
+	bool OPBReader::accept(const char* _token) {
+		skip();
+		std::size_t length = std::strlen(_token);
+		if (std::size_t(mEnd - mPos) < length || std::strncmp(mPos, _token, length) != 0) return false;
+		mPos += length;
+		return true;
+	}
+
+	bool OPBReader::parseInteger(mpz_class& _n) {
+		skip();
+		bool negative = false;
+		if (mPos != mEnd && (*mPos == '+' || *mPos == '-')) {
+			negative = (*mPos == '-');
+			mPos++;
+		}
+		const char* start = mPos;
+		while (mPos != mEnd && *mPos >= '0' && *mPos <= '9') mPos++;
+		if (start == mPos) return error("an integer");
+		if (mPos - start <= 9) {
+			// Fits into a long, avoid the detour over a string.
+			long value = 0;
+			for (const char* c = start; c != mPos; c++) value = value * 10 + (*c - '0');
+			_n = negative ? -value : value;
+		} else {
+			mBuffer.assign(start, mPos);
+			mpz_set_str(_n.get_mpz_t(), mBuffer.c_str(), 10);
+			if (negative) mpz_neg(_n.get_mpz_t(), _n.get_mpz_t());
+		}
+		return true;
+	}
+
+	bool OPBReader::parseVariable(Variable& _var) {
+		skip();
+		const char* start = mPos;
+		if (mPos == mEnd || !std::isalpha(static_cast<unsigned char>(*mPos))) return error("a variable");
+		while (mPos != mEnd && (std::isalnum(static_cast<unsigned char>(*mPos)) || *mPos == '_')) mPos++;
+		mBuffer.assign(start, mPos);
+		auto it = mVariables.find(mBuffer);
+		if (it == mVariables.end()) {
+			it = mVariables.emplace(mBuffer, freshBooleanVariable(mBuffer)).first;
+		}
+		_var = it->second;
+		return true;
+	}
+
+	bool OPBReader::parseRelation(Relation& _rel) {
+		if (accept(">=")) _rel = Relation::GEQ;
+		else if (accept("<=")) _rel = Relation::LEQ;
+		else if (accept("!=")) _rel = Relation::NEQ;
+		else if (accept("=")) _rel = Relation::EQ;
+		else if (accept(">")) _rel = Relation::GREATER;
+		else if (accept("<")) _rel = Relation::LESS;
+		else return error("a relation");
+		return true;
+	}
+
+	bool OPBReader::parsePolynomial(OPBPolynomial& _poly) {
+		while (true) {
+			skip();
+			if (mPos == mEnd) return true;
+			char c = *mPos;
+			if (c != '+' && c != '-' && (c < '0' || c > '9')) return true;
+			mpz_class coefficient;
+			Variable var;
+			if (!parseInteger(coefficient)) return false;
+			if (!parseVariable(var)) return false;
+			_poly.emplace_back(std::move(coefficient), var);
+		}
+	}
+
+	template<typename Callback>
+	bool OPBReader::read(OPBPolynomial& _objective, Callback&& _callback) {
+		if (!isOpen()) {
+			CARL_LOG_ERROR("carl.parser", "Could not open the OPB input.");
+			return false;
+		}
+		_objective.clear();
+		if (accept("min:")) {
+			if (!parsePolynomial(_objective)) return false;
+			if (!accept(";")) return error("\";\"");
+		}
+		OPBPolynomial lhs;
+		Relation rel = Relation::EQ;
+		mpz_class rhs;
+		while (!atEnd()) {
+			lhs.clear();
+			if (!parsePolynomial(lhs)) return false;
+			if (lhs.empty()) return error("a term");
+			if (!parseRelation(rel)) return false;
+			if (!parseInteger(rhs)) return false;
+			if (!accept(";")) return error("\";\"");
+			_callback(lhs, rel, rhs);
+		}
+		return true;
+	}
+
+	boost::optional<OPBFile> OPBReader::parse() {
+		OPBFile file;
+		bool success = read(file.objective, [&file](const OPBPolynomial& lhs, Relation rel, const mpz_class& rhs) {
+			file.constraints.emplace_back(lhs, rel, rhs);
+		});
+		if (!success) return boost::none;
+		return file;
+	}
+
+	bool OPBReader::parse(PBDatabase& _database, OPBPolynomial& _objective) {
+		return read(_objective, [&_database](const OPBPolynomial& lhs, Relation rel, const mpz_class& rhs) {
+			std::vector<PBDatabase::Term> terms;
+			terms.reserve(lhs.size());
+			for (const auto& term: lhs) {
+				terms.emplace_back(term.first, _database.literal(term.second));
+			}
+			_database.add(std::move(terms), rel, rhs);
+		});
+	}
+
+}
@@ -0,0 +1,106 @@
+/**
+ * @file OPBReader.h
+ */
+
+#pragma once
+
+#include "../../core/Relation.h"
+#include "../../core/Variable.h"
+#include "../../numbers/numbers.h"
+#include "../../util/MappedFile.h"
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace carl {
+
+class PBDatabase;
+
+using OPBPolynomial = std::vector<std::pair<mpz_class,carl::Variable>>;
+using OPBConstraint = std::tuple<OPBPolynomial, Relation, mpz_class>;
+
+struct OPBFile {
+	OPBPolynomial objective;
+	std::vector<OPBConstraint> constraints;
+
+	OPBFile() = default;
+	explicit OPBFile(OPBPolynomial obj): objective(std::move(obj)) {}
+	OPBFile(OPBPolynomial obj, std::vector<OPBConstraint> cons): objective(std::move(obj)), constraints(std::move(cons)) {}
+};
+
+/**
+ * Reads linear pseudo-Boolean problems in the OPB format.
+ *
+ * The file is mapped into memory and scanned directly, the constraints are either collected
+ * into an OPBFile or passed on one by one, for example into a PBDatabase.
+ * A fresh Boolean variable is created for every variable name.
+ */
+class OPBReader {
+private:
+	MappedFile mFile;
+	const char* mBegin = nullptr;
+	const char* mPos = nullptr;
+	const char* mEnd = nullptr;
+	std::unordered_map<std::string, Variable> mVariables;
+	/// Buffer for names and long numbers.
+	std::string mBuffer;
+
+	bool error(const std::string& _expected);
+	/// Skips whitespace and comments.
+	void skip();
+	bool atEnd()
+	{
+		skip();
+		return mPos == mEnd;
+	}
+	bool accept(const char* _token);
+	bool parseInteger(mpz_class& _n);
+	bool parseVariable(Variable& _var);
+	bool parseRelation(Relation& _rel);
+	/// Parses terms until a relation or a semicolon.
+	bool parsePolynomial(OPBPolynomial& _poly);
+
+	template<typename Callback>
+	bool read(OPBPolynomial& _objective, Callback&& _callback);
+
+public:
+	/**
+	 * Maps the given file.
+	 * @param _filename Name of the file.
+	 */
+	explicit OPBReader(const std::string& _filename);
+	/**
+	 * Reads from the given buffer, which must outlive the reader.
+	 */
+	OPBReader(const char* _begin, const char* _end):
+		mBegin(_begin), mPos(_begin), mEnd(_end)
+	{}
+
+	/**
+	 * @return true, if the input could be opened.
+	 */
+	bool isOpen() const
+	{
+		return mBegin != nullptr;
+	}
+
+	/**
+	 * Reads the objective and all constraints.
+	 * @return The contents of the input or boost::none, if parsing fails.
+	 */
+	boost::optional<OPBFile> parse();
+
+	/**
+	 * Reads all constraints into the given database.
+	 * @param _database The database to add the constraints to.
+	 * @param _objective Is set to the objective.
+	 * @return false, if parsing fails. Note that the database may be inconsistent anyway.
+	 */
+	bool parse(PBDatabase& _database, OPBPolynomial& _objective);
+};
+
+}
@@ -0,0 +1,194 @@
+/**
+ * @file SMTLIBReader.h
+ */
+
+#pragma once
+
+#include "../Formula.h"
+#include "../SortManager.h"
+#include "../bitvector/BVConstraint.h"
+#include "../bitvector/BVTerm.h"
+#include "../uninterpreted/UEquality.h"
+#include "../uninterpreted/UFInstanceManager.h"
+#include "../uninterpreted/UFManager.h"
+#include "../../core/logging.h"
+#include "../../core/VariablePool.h"
+#include "../../util/MappedFile.h"
+
+#include <boost/optional.hpp>
+#include <boost/variant.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Reads SMT-LIB 2 scripts for the quantifier-free fragments carl can represent,
+ * that is Boolean structure over arithmetic constraints, bit-vector constraints and
+ * equalities of uninterpreted terms.
+ *
+ * The input is mapped into memory and scanned without building an intermediate
+ * syntax tree: terms are evaluated bottom-up on an explicit stack, hence deeply nested
+ * inputs do not exhaust the call stack. Terms bound by `let` or `define-fun` are built
+ * once and shared by all their occurrences.
+ *
+ * Nested applications of uninterpreted functions are flattened, as UFInstance only
+ * takes variables as arguments: every nested instance is replaced by a fresh variable
+ * and the corresponding equality is asserted along with the formula.
+ */
+template<typename Pol>
+class SMTLIBReader {
+public:
+	/// The value of a term.
+	using Value = boost::variant<Formula<Pol>, Pol, BVTerm, UVariable, UFInstance>;
+
+private:
+	enum class TokenType { LPAR, RPAR, SYMBOL, KEYWORD, NUMERAL, DECIMAL, BINARY, HEXADECIMAL, STRING, END };
+	struct Token {
+		TokenType type;
+		const char* begin;
+		const char* end;
+	};
+
+	enum class Operator {
+		NOT, AND, OR, XOR, IMPLIES, ITE, EQ, DISTINCT,
+		PLUS, MINUS, TIMES, DIVIDE, LEQ, LESS, GEQ, GREATER, TO_REAL,
+		BV_TERM, BV_COMPARE, APPLY, LET, BINDING, ANNOTATION
+	};
+	struct Operation {
+		Operator op;
+		BVTermType bvType;
+		BVCompareRelation bvRelation;
+		/// Number of indices of an indexed bit-vector operation.
+		std::size_t indices;
+	};
+	/// An application whose arguments are being read.
+	struct Frame {
+		Operation operation;
+		/// Position of the first argument on the value stack.
+		std::size_t args;
+		std::size_t first = 0;
+		std::size_t last = 0;
+		UninterpretedFunction function;
+		/// Position of the first name bound by a let in mLetNames.
+		std::size_t names = 0;
+		/// Whether all bindings of a let have been read.
+		bool body = false;
+
+		Frame(const Operation& _operation, std::size_t _args): operation(_operation), args(_args) {}
+	};
+	/// The kinds of sorts of variables.
+	struct SortInfo {
+		VariableType type;
+		Sort sort;
+	};
+
+	MappedFile mFile;
+	const char* mBegin = nullptr;
+	const char* mPos = nullptr;
+	const char* mEnd = nullptr;
+	/// Buffer for symbols.
+	std::string mName;
+
+	std::unordered_map<std::string, Value> mSymbols;
+	std::unordered_map<std::string, UninterpretedFunction> mFunctions;
+	std::unordered_map<std::string, Sort> mSorts;
+	/// Symbols bound by let, innermost binding last.
+	std::unordered_map<std::string, std::vector<Value>> mBindings;
+	/// Symbols declared since the start, to be removed by pop.
+	std::vector<std::string> mDeclared;
+	/// Sizes of mDeclared when the assertion levels were opened.
+	std::vector<std::size_t> mScopes;
+
+	std::vector<Frame> mFrames;
+	std::vector<Value> mValues;
+	/// The binding stacks of the names bound by the open lets.
+	std::vector<std::vector<Value>*> mLetNames;
+
+	/// Fresh variables replacing nested instances of uninterpreted functions.
+	std::unordered_map<UFInstance, UVariable> mFlattened;
+	/// Equalities defining the fresh variables, asserted with the next assertion.
+	Formulas<Pol> mDefinitions;
+
+	static const std::unordered_map<std::string, Operation>& operations();
+
+	bool fail(const std::string& _message);
+	bool error(const std::string& _expected);
+	/// Skips whitespace and comments.
+	void skip();
+	Token next();
+	bool expect(TokenType _type, const std::string& _expected);
+	bool expectSymbol(const std::string& _expected);
+	bool expectIndex(std::size_t& _index);
+	/// Skips the remainder of a list whose opening parenthesis was already read.
+	bool skipList();
+
+	const std::string& name(const Token& _token)
+	{
+		mName.assign(_token.begin, _token.end);
+		return mName;
+	}
+
+	bool parseSort(SortInfo& _sort);
+	bool declare(const std::string& _name, Value&& _value);
+	Value variable(const std::string& _name, const SortInfo& _sort);
+
+	bool parseTerm(Value& _result);
+	bool parseFormula(Formula<Pol>& _result);
+	/// Handles the token after an opening parenthesis within a term.
+	bool open();
+	/// Pushes the value of a symbol or a constant.
+	bool atom(const Token& _token);
+	/// Replaces the arguments of the innermost application by its value.
+	bool close();
+	void closeLetBindings(Frame& _frame);
+	bool reduce(const Frame& _frame, Value* _args, std::size_t _count, Value& _result);
+	bool reduceEquality(const Frame& _frame, Value* _args, std::size_t _count, Value& _result);
+	bool reduceArithmetic(const Frame& _frame, Value* _args, std::size_t _count, Value& _result);
+	bool reduceBitvector(const Frame& _frame, Value* _args, std::size_t _count, Value& _result);
+	/// Replaces a nested instance of an uninterpreted function by a variable.
+	bool flatten(Value& _arg, UVariable& _result);
+
+public:
+	/**
+	 * Maps the given file.
+	 * @param _filename Name of the file.
+	 */
+	explicit SMTLIBReader(const std::string& _filename);
+	/**
+	 * Reads from the given buffer, which must outlive the reader.
+	 */
+	SMTLIBReader(const char* _begin, const char* _end);
+
+	/**
+	 * @return true, if the input could be opened.
+	 */
+	bool isOpen() const
+	{
+		return mBegin != nullptr;
+	}
+
+	/**
+	 * Reads all commands and passes them on to the given handler, which provides
+	 * - `add(Formulas<Pol>&&)` for consecutive assertions, which are passed on as one batch,
+	 * - `push(std::size_t)` and `pop(std::size_t)` for changes of the assertion levels and
+	 * - `checkSat()` for satisfiability checks.
+	 * Other commands that do not declare or define symbols are ignored.
+	 * @param _handler The handler.
+	 * @return false, if parsing fails.
+	 */
+	template<typename Handler>
+	bool read(Handler& _handler);
+
+	/**
+	 * Reads all commands.
+	 * @return The conjunction of the assertions that are active at the end of the input or boost::none, if parsing fails.
+	 */
+	boost::optional<Formula<Pol>> parse();
+};
+
+}
+
+#include "SMTLIBReader.tpp"
@@ -0,0 +1,955 @@
+/**
+ * @file SMTLIBReader.tpp
+ */
+
+#pragma once
+
+#include "SMTLIBReader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+namespace carl {
+
+namespace smtlib_detail {
+	/// Makes sure that the sort of bit-vectors is declared.
+	inline void declareBitvectorSort() {
+		SortManager& sm = SortManager::getInstance();
+		if (sm.isSymbolFree("BitVec")) {
+			Sort bvSort = sm.addSort("BitVec", VariableType::VT_UNINTERPRETED);
+			sm.makeSortIndexable(bvSort, 1, VariableType::VT_BITVECTOR);
+		}
+	}
+
+	inline bool isSymbolChar(char c) {
+		switch (c) {
+			case '(': case ')': case '|': case '"': case ';':
+				return false;
+			default:
+				return !std::isspace(static_cast<unsigned char>(c));
+		}
+	}
+
+	/// Appends the given decimal digits to n, nine digits at a time.
+	template<typename Number>
+	void appendDigits(Number& n, const char* begin, const char* end) {
+		while (begin != end) {
+			const char* chunkEnd = begin + std::min<std::ptrdiff_t>(end - begin, 9);
+			sint chunk = 0;
+			sint scale = 1;
+			for (; begin != chunkEnd; begin++) {
+				chunk = chunk * 10 + (*begin - '0');
+				scale *= 10;
+			}
+			n = n * Number(scale) + Number(chunk);
+		}
+	}
+}
+
+template<typename Pol>
+SMTLIBReader<Pol>::SMTLIBReader(const std::string& _filename):
+	mFile(_filename)
+{
+	if (mFile.isOpen()) {
+		mBegin = mFile.begin();
+		mPos = mFile.begin();
+		mEnd = mFile.end();
+	}
+	smtlib_detail::declareBitvectorSort();
+}
+
+template<typename Pol>
+SMTLIBReader<Pol>::SMTLIBReader(const char* _begin, const char* _end):
+	mBegin(_begin), mPos(_begin), mEnd(_end)
+{
+	smtlib_detail::declareBitvectorSort();
+}
+
+template<typename Pol>
+const std::unordered_map<std::string, typename SMTLIBReader<Pol>::Operation>& SMTLIBReader<Pol>::operations() {
+	auto op = [](Operator _op) {
+		return Operation{_op, BVTermType::CONSTANT, BVCompareRelation::EQ, 0};
+	};
+	auto bv = [](BVTermType _type, std::size_t _indices) {
+		return Operation{Operator::BV_TERM, _type, BVCompareRelation::EQ, _indices};
+	};
+	auto cmp = [](BVCompareRelation _relation) {
+		return Operation{Operator::BV_COMPARE, BVTermType::CONSTANT, _relation, 0};
+	};
+	static const std::unordered_map<std::string, Operation> ops = {
+		{"not", op(Operator::NOT)}, {"and", op(Operator::AND)}, {"or", op(Operator::OR)},
+		{"xor", op(Operator::XOR)}, {"=>", op(Operator::IMPLIES)}, {"ite", op(Operator::ITE)},
+		{"=", op(Operator::EQ)}, {"distinct", op(Operator::DISTINCT)},
+		{"+", op(Operator::PLUS)}, {"-", op(Operator::MINUS)}, {"*", op(Operator::TIMES)}, {"/", op(Operator::DIVIDE)},
+		{"<=", op(Operator::LEQ)}, {"<", op(Operator::LESS)}, {">=", op(Operator::GEQ)}, {">", op(Operator::GREATER)},
+		{"to_real", op(Operator::TO_REAL)},
+		{"concat", bv(BVTermType::CONCAT, 0)}, {"extract", bv(BVTermType::EXTRACT, 2)},
+		{"bvnot", bv(BVTermType::NOT, 0)}, {"bvneg", bv(BVTermType::NEG, 0)},
+		{"bvand", bv(BVTermType::AND, 0)}, {"bvor", bv(BVTermType::OR, 0)}, {"bvxor", bv(BVTermType::XOR, 0)},
+		{"bvnand", bv(BVTermType::NAND, 0)}, {"bvnor", bv(BVTermType::NOR, 0)}, {"bvxnor", bv(BVTermType::XNOR, 0)},
+		{"bvadd", bv(BVTermType::ADD, 0)}, {"bvsub", bv(BVTermType::SUB, 0)}, {"bvmul", bv(BVTermType::MUL, 0)},
+		{"bvudiv", bv(BVTermType::DIV_U, 0)}, {"bvsdiv", bv(BVTermType::DIV_S, 0)},
+		{"bvurem", bv(BVTermType::MOD_U, 0)}, {"bvsrem", bv(BVTermType::MOD_S1, 0)}, {"bvsmod", bv(BVTermType::MOD_S2, 0)},
+		{"bvcomp", bv(BVTermType::EQ, 0)},
+		{"bvshl", bv(BVTermType::LSHIFT, 0)}, {"bvlshr", bv(BVTermType::RSHIFT_LOGIC, 0)}, {"bvashr", bv(BVTermType::RSHIFT_ARITH, 0)},
+		{"rotate_left", bv(BVTermType::LROTATE, 1)}, {"rotate_right", bv(BVTermType::RROTATE, 1)},
+		{"zero_extend", bv(BVTermType::EXT_U, 1)}, {"sign_extend", bv(BVTermType::EXT_S, 1)}, {"repeat", bv(BVTermType::REPEAT, 1)},
+		{"bvult", cmp(BVCompareRelation::ULT)}, {"bvule", cmp(BVCompareRelation::ULE)},
+		{"bvugt", cmp(BVCompareRelation::UGT)}, {"bvuge", cmp(BVCompareRelation::UGE)},
+		{"bvslt", cmp(BVCompareRelation::SLT)}, {"bvsle", cmp(BVCompareRelation::SLE)},
+		{"bvsgt", cmp(BVCompareRelation::SGT)}, {"bvsge", cmp(BVCompareRelation::SGE)}
+	};
+	return ops;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::fail(const std::string& _message) {
+#ifdef CARL_LOGGING_ENABLED
+	std::size_t line = std::size_t(std::count(mBegin, mPos, '\n')) + 1;
+	CARL_LOG_ERROR("carl.parser", "Parsing SMT-LIB input failed in line " << line << ": " << _message);
+#else
+	(void)_message;
+#endif
+	return false;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::error(const std::string& _expected) {
+	const char* lineEnd = std::find(mPos, mEnd, '\n');
+	return fail("expected " + _expected + " but got \"" + std::string(mPos, lineEnd) + "\"");
+}
+
+template<typename Pol>
+void SMTLIBReader<Pol>::skip() {
+	while (mPos != mEnd) {
+		if (*mPos == ';') {
+			mPos = std::find(mPos, mEnd, '\n');
+		} else if (std::isspace(static_cast<unsigned char>(*mPos))) {
+			mPos++;
+		} else {
+			return;
+		}
+	}
+}
+
+template<typename Pol>
+typename SMTLIBReader<Pol>::Token SMTLIBReader<Pol>::next() {
+	skip();
+	const char* start = mPos;
+	if (mPos == mEnd) return Token{TokenType::END, start, start};
+	switch (*mPos) {
+		case '(':
+			mPos++;
+			return Token{TokenType::LPAR, start, mPos};
+		case ')':
+			mPos++;
+			return Token{TokenType::RPAR, start, mPos};
+		case '|': {
+			const char* end = std::find(start + 1, mEnd, '|');
+			if (end == mEnd) return Token{TokenType::END, start, start};
+			mPos = end + 1;
+			return Token{TokenType::SYMBOL, start + 1, end};
+		}
+		case '"': {
+			// Quotes within strings are escaped by doubling them.
+			do {
+				mPos = std::find(mPos + 1, mEnd, '"');
+				if (mPos == mEnd) return Token{TokenType::END, start, start};
+				mPos++;
+			} while (mPos != mEnd && *mPos == '"');
+			return Token{TokenType::STRING, start + 1, mPos - 1};
+		}
+		case '#': {
+			if (mEnd - mPos < 2) break;
+			if (mPos[1] == 'b') {
+				mPos += 2;
+				while (mPos != mEnd && (*mPos == '0' || *mPos == '1')) mPos++;
+				return Token{TokenType::BINARY, start + 2, mPos};
+			}
+			if (mPos[1] == 'x') {
+				mPos += 2;
+				while (mPos != mEnd && std::isxdigit(static_cast<unsigned char>(*mPos))) mPos++;
+				return Token{TokenType::HEXADECIMAL, start + 2, mPos};
+			}
+			break;
+		}
+		case ':': {
+			mPos++;
+			while (mPos != mEnd && smtlib_detail::isSymbolChar(*mPos)) mPos++;
+			return Token{TokenType::KEYWORD, start + 1, mPos};
+		}
+		default:
+			break;
+	}
+	if (std::isdigit(static_cast<unsigned char>(*mPos))) {
+		while (mPos != mEnd && std::isdigit(static_cast<unsigned char>(*mPos))) mPos++;
+		if (mPos == mEnd || *mPos != '.') return Token{TokenType::NUMERAL, start, mPos};
+		mPos++;
+		while (mPos != mEnd && std::isdigit(static_cast<unsigned char>(*mPos))) mPos++;
+		return Token{TokenType::DECIMAL, start, mPos};
+	}
+	while (mPos != mEnd && smtlib_detail::isSymbolChar(*mPos)) mPos++;
+	return Token{TokenType::SYMBOL, start, mPos};
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::expect(TokenType _type, const std::string& _expected) {
+	Token t = next();
+	if (t.type == _type) return true;
+	mPos = t.begin;
+	return error(_expected);
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::expectSymbol(const std::string& _expected) {
+	Token t = next();
+	if (t.type == TokenType::SYMBOL && std::equal(t.begin, t.end, _expected.begin(), _expected.end())) return true;
+	mPos = t.begin;
+	return error("\"" + _expected + "\"");
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::expectIndex(std::size_t& _index) {
+	Token t = next();
+	if (t.type != TokenType::NUMERAL) {
+		mPos = t.begin;
+		return error("a numeral");
+	}
+	_index = 0;
+	for (const char* c = t.begin; c != t.end; c++) _index = _index * 10 + std::size_t(*c - '0');
+	return true;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::skipList() {
+	std::size_t depth = 1;
+	while (depth > 0) {
+		Token t = next();
+		switch (t.type) {
+			case TokenType::LPAR: depth++; break;
+			case TokenType::RPAR: depth--; break;
+			case TokenType::END: return error("\")\"");
+			default: break;
+		}
+	}
+	return true;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::parseSort(SortInfo& _sort) {
+	Token t = next();
+	if (t.type == TokenType::LPAR) {
+		std::size_t width;
+		if (!expectSymbol("_") || !expectSymbol("BitVec") || !expectIndex(width)) return false;
+		if (!expect(TokenType::RPAR, "\")\"")) return false;
+		if (width == 0) return fail("bit-vectors must not be empty");
+		_sort.type = VariableType::VT_BITVECTOR;
+		_sort.sort = getSort("BitVec", std::vector<std::size_t>({width}));
+		return true;
+	}
+	if (t.type == TokenType::SYMBOL) {
+		const std::string& n = name(t);
+		if (n == "Bool") {
+			_sort.type = VariableType::VT_BOOL;
+			return true;
+		}
+		if (n == "Int") {
+			_sort.type = VariableType::VT_INT;
+			return true;
+		}
+		if (n == "Real") {
+			_sort.type = VariableType::VT_REAL;
+			return true;
+		}
+		auto it = mSorts.find(n);
+		if (it != mSorts.end()) {
+			_sort.type = VariableType::VT_UNINTERPRETED;
+			_sort.sort = it->second;
+			return true;
+		}
+	}
+	mPos = t.begin;
+	return error("a sort");
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::declare(const std::string& _name, Value&& _value) {
+	if (mFunctions.find(_name) != mFunctions.end() || !mSymbols.emplace(_name, std::move(_value)).second) {
+		return fail("the symbol " + _name + " is already declared");
+	}
+	mDeclared.push_back(_name);
+	return true;
+}
+
+template<typename Pol>
+typename SMTLIBReader<Pol>::Value SMTLIBReader<Pol>::variable(const std::string& _name, const SortInfo& _sort) {
+	switch (_sort.type) {
+		case VariableType::VT_BOOL:
+			return Formula<Pol>(freshBooleanVariable(_name));
+		case VariableType::VT_INT:
+			return Pol(freshIntegerVariable(_name));
+		case VariableType::VT_REAL:
+			return Pol(freshRealVariable(_name));
+		case VariableType::VT_BITVECTOR:
+			return BVTerm(BVTermType::VARIABLE, BVVariable(freshBitvectorVariable(_name), _sort.sort));
+		default:
+			return UVariable(freshUninterpretedVariable(_name), _sort.sort);
+	}
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::parseFormula(Formula<Pol>& _result) {
+	Value value;
+	if (!parseTerm(value)) return false;
+	const Formula<Pol>* f = boost::get<Formula<Pol>>(&value);
+	if (f == nullptr) return fail("expected a formula");
+	_result = *f;
+	return true;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::parseTerm(Value& _result) {
+	mFrames.clear();
+	mValues.clear();
+	for (auto* binding: mLetNames) binding->clear();
+	mLetNames.clear();
+	do {
+		Token t = next();
+		if (!mFrames.empty()) {
+			Frame& top = mFrames.back();
+			if (top.operation.op == Operator::LET && !top.body) {
+				// Reading the bindings of a let.
+				if (t.type == TokenType::RPAR) {
+					closeLetBindings(top);
+					continue;
+				}
+				if (t.type != TokenType::LPAR) {
+					mPos = t.begin;
+					return error("a binding");
+				}
+				Token var = next();
+				if (var.type != TokenType::SYMBOL) {
+					mPos = var.begin;
+					return error("a symbol");
+				}
+				mLetNames.push_back(&mBindings[name(var)]);
+				mFrames.emplace_back(Operation{Operator::BINDING, BVTermType::CONSTANT, BVCompareRelation::EQ, 0}, mValues.size());
+				continue;
+			}
+			if (top.operation.op == Operator::ANNOTATION && mValues.size() > top.args) {
+				// Reading the attributes of an annotated term.
+				if (t.type == TokenType::RPAR) {
+					if (!close()) return false;
+					continue;
+				}
+				if (t.type != TokenType::KEYWORD) {
+					mPos = t.begin;
+					return error("an attribute");
+				}
+				if (name(t) == "named") {
+					Token label = next();
+					if (label.type != TokenType::SYMBOL) {
+						mPos = label.begin;
+						return error("a symbol");
+					}
+					if (!declare(name(label), Value(mValues.back()))) return false;
+				} else {
+					const char* save = mPos;
+					Token value = next();
+					if (value.type == TokenType::LPAR) {
+						if (!skipList()) return false;
+					} else if (value.type == TokenType::KEYWORD || value.type == TokenType::RPAR) {
+						mPos = save;
+					}
+				}
+				continue;
+			}
+		}
+		switch (t.type) {
+			case TokenType::LPAR:
+				if (!open()) return false;
+				break;
+			case TokenType::RPAR:
+				if (mFrames.empty()) {
+					mPos = t.begin;
+					return error("a term");
+				}
+				if (!close()) return false;
+				break;
+			case TokenType::END:
+				return error("a term");
+			default:
+				if (!atom(t)) return false;
+		}
+	} while (!mFrames.empty());
+	assert(mValues.size() == 1);
+	_result = std::move(mValues.back());
+	mValues.clear();
+	return true;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::open() {
+	Token t = next();
+	if (t.type == TokenType::LPAR) {
+		// An indexed function symbol like (_ extract i j).
+		if (!expectSymbol("_")) return false;
+		Token f = next();
+		auto it = operations().end();
+		if (f.type == TokenType::SYMBOL) it = operations().find(name(f));
+		if (it == operations().end() || it->second.indices == 0) {
+			mPos = f.begin;
+			return error("an indexed function symbol");
+		}
+		Frame frame(it->second, mValues.size());
+		if (!expectIndex(frame.first)) return false;
+		if (it->second.indices > 1 && !expectIndex(frame.last)) return false;
+		if (!expect(TokenType::RPAR, "\")\"")) return false;
+		mFrames.push_back(std::move(frame));
+		return true;
+	}
+	if (t.type != TokenType::SYMBOL) {
+		mPos = t.begin;
+		return error("a function symbol");
+	}
+	const std::string& fun = name(t);
+	if (fun == "_") {
+		// A bit-vector constant (_ bvN w).
+		Token c = next();
+		if (c.type != TokenType::SYMBOL || c.end - c.begin < 3 || c.begin[0] != 'b' || c.begin[1] != 'v'
+				|| !std::all_of(c.begin + 2, c.end, [](char d){ return std::isdigit(static_cast<unsigned char>(d)); })) {
+			mPos = c.begin;
+			return error("a bit-vector constant");
+		}
+		mpz_class value;
+		smtlib_detail::appendDigits(value, c.begin + 2, c.end);
+		std::size_t width;
+		if (!expectIndex(width) || !expect(TokenType::RPAR, "\")\"")) return false;
+		if (width == 0) return fail("bit-vectors must not be empty");
+		mValues.emplace_back(BVTerm(BVTermType::CONSTANT, BVValue(width, value)));
+		return true;
+	}
+	if (fun == "let") {
+		if (!expect(TokenType::LPAR, "a list of bindings")) return false;
+		Frame frame(Operation{Operator::LET, BVTermType::CONSTANT, BVCompareRelation::EQ, 0}, mValues.size());
+		frame.names = mLetNames.size();
+		mFrames.push_back(std::move(frame));
+		return true;
+	}
+	if (fun == "!") {
+		mFrames.emplace_back(Operation{Operator::ANNOTATION, BVTermType::CONSTANT, BVCompareRelation::EQ, 0}, mValues.size());
+		return true;
+	}
+	auto it = operations().find(fun);
+	if (it != operations().end() && it->second.indices == 0) {
+		mFrames.emplace_back(it->second, mValues.size());
+		return true;
+	}
+	auto fit = mFunctions.find(fun);
+	if (fit != mFunctions.end()) {
+		Frame frame(Operation{Operator::APPLY, BVTermType::CONSTANT, BVCompareRelation::EQ, 0}, mValues.size());
+		frame.function = fit->second;
+		mFrames.push_back(std::move(frame));
+		return true;
+	}
+	mPos = t.begin;
+	return error("a supported function symbol");
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::atom(const Token& _token) {
+	using Coeff = typename Pol::CoeffType;
+	switch (_token.type) {
+		case TokenType::SYMBOL: {
+			const std::string& n = name(_token);
+			auto bit = mBindings.find(n);
+			if (bit != mBindings.end() && !bit->second.empty()) {
+				mValues.push_back(bit->second.back());
+				return true;
+			}
+			auto sit = mSymbols.find(n);
+			if (sit != mSymbols.end()) {
+				mValues.push_back(sit->second);
+				return true;
+			}
+			if (n == "true") {
+				mValues.emplace_back(Formula<Pol>(TRUE));
+				return true;
+			}
+			if (n == "false") {
+				mValues.emplace_back(Formula<Pol>(FALSE));
+				return true;
+			}
+			// Negative literals are not standard, but are written by SMTLIBStream.
+			if (n.size() > 1 && n[0] == '-' && std::isdigit(static_cast<unsigned char>(n[1]))) {
+				const char* point = std::find(_token.begin + 1, _token.end, '.');
+				auto isDigit = [](char d){ return std::isdigit(static_cast<unsigned char>(d)); };
+				if (!std::all_of(_token.begin + 1, point, isDigit)) break;
+				if (point != _token.end && (point + 1 == _token.end || !std::all_of(point + 1, _token.end, isDigit))) break;
+				if (!atom(Token{point == _token.end ? TokenType::NUMERAL : TokenType::DECIMAL, _token.begin + 1, _token.end})) return false;
+				mValues.back() = -boost::get<Pol>(mValues.back());
+				return true;
+			}
+			break;
+		}
+		case TokenType::NUMERAL: {
+			Coeff n = constant_zero<Coeff>::get();
+			smtlib_detail::appendDigits(n, _token.begin, _token.end);
+			mValues.emplace_back(Pol(n));
+			return true;
+		}
+		case TokenType::DECIMAL: {
+			const char* point = std::find(_token.begin, _token.end, '.');
+			Coeff n = constant_zero<Coeff>::get();
+			smtlib_detail::appendDigits(n, _token.begin, point);
+			smtlib_detail::appendDigits(n, point + 1, _token.end);
+			n /= carl::pow(Coeff(10), uint(_token.end - point - 1));
+			mValues.emplace_back(Pol(n));
+			return true;
+		}
+		case TokenType::BINARY:
+			if (_token.begin == _token.end) break;
+			mValues.emplace_back(BVTerm(BVTermType::CONSTANT, BVValue(std::string(_token.begin, _token.end))));
+			return true;
+		case TokenType::HEXADECIMAL: {
+			if (_token.begin == _token.end) break;
+			std::string bits;
+			bits.reserve(std::size_t(_token.end - _token.begin) * 4);
+			for (const char* c = _token.begin; c != _token.end; c++) {
+				int digit = std::isdigit(static_cast<unsigned char>(*c)) ? *c - '0' : std::tolower(static_cast<unsigned char>(*c)) - 'a' + 10;
+				for (int bit = 3; bit >= 0; bit--) bits.push_back(((digit >> bit) & 1) ? '1' : '0');
+			}
+			mValues.emplace_back(BVTerm(BVTermType::CONSTANT, BVValue(bits)));
+			return true;
+		}
+		default:
+			break;
+	}
+	mPos = _token.begin;
+	return error("a declared symbol or a constant");
+}
+
+template<typename Pol>
+void SMTLIBReader<Pol>::closeLetBindings(Frame& _frame) {
+	// All bindings of a let are evaluated before any of them is visible.
+	std::size_t count = mLetNames.size() - _frame.names;
+	assert(mValues.size() == _frame.args + count);
+	for (std::size_t i = 0; i < count; i++) {
+		mLetNames[_frame.names + i]->push_back(std::move(mValues[_frame.args + i]));
+	}
+	mValues.resize(_frame.args);
+	_frame.body = true;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::close() {
+	Frame frame = std::move(mFrames.back());
+	mFrames.pop_back();
+	std::size_t count = mValues.size() - frame.args;
+	switch (frame.operation.op) {
+		case Operator::BINDING:
+		case Operator::ANNOTATION:
+			if (count != 1) return fail("expected a single term");
+			return true;
+		case Operator::LET:
+			if (!frame.body || count != 1) return fail("expected a single term as body of let");
+			for (std::size_t i = frame.names; i < mLetNames.size(); i++) mLetNames[i]->pop_back();
+			mLetNames.resize(frame.names);
+			return true;
+		default:
+			break;
+	}
+	Value result;
+	if (!reduce(frame, &mValues[frame.args], count, result)) return false;
+	mValues.resize(frame.args);
+	mValues.push_back(std::move(result));
+	return true;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::reduce(const Frame& _frame, Value* _args, std::size_t _count, Value& _result) {
+	switch (_frame.operation.op) {
+		case Operator::NOT:
+		case Operator::AND:
+		case Operator::OR:
+		case Operator::XOR:
+		case Operator::IMPLIES: {
+			Formulas<Pol> subformulas;
+			subformulas.reserve(_count);
+			for (std::size_t i = 0; i < _count; i++) {
+				const Formula<Pol>* f = boost::get<Formula<Pol>>(&_args[i]);
+				if (f == nullptr) return fail("expected Boolean arguments");
+				subformulas.push_back(*f);
+			}
+			if (_frame.operation.op == Operator::NOT) {
+				if (_count != 1) return fail("not expects a single argument");
+				_result = Formula<Pol>(NOT, subformulas.front());
+				return true;
+			}
+			if (_count == 0 || (_frame.operation.op == Operator::IMPLIES && _count < 2)) return fail("missing arguments");
+			switch (_frame.operation.op) {
+				case Operator::AND: _result = Formula<Pol>(AND, std::move(subformulas)); break;
+				case Operator::OR: _result = Formula<Pol>(OR, std::move(subformulas)); break;
+				case Operator::XOR: _result = Formula<Pol>(XOR, std::move(subformulas)); break;
+				// The premises of an n-ary implication are conjoined.
+				default: _result = Formula<Pol>(IMPLIES, std::move(subformulas)); break;
+			}
+			return true;
+		}
+		case Operator::ITE: {
+			if (_count != 3) return fail("ite expects three arguments");
+			const Formula<Pol>* c = boost::get<Formula<Pol>>(&_args[0]);
+			const Formula<Pol>* t = boost::get<Formula<Pol>>(&_args[1]);
+			const Formula<Pol>* e = boost::get<Formula<Pol>>(&_args[2]);
+			if (c == nullptr) return fail("expected a Boolean condition");
+			if (t == nullptr || e == nullptr) return fail("ite is only supported on formulas");
+			_result = Formula<Pol>(ITE, *c, *t, *e);
+			return true;
+		}
+		case Operator::EQ:
+		case Operator::DISTINCT:
+			return reduceEquality(_frame, _args, _count, _result);
+		case Operator::BV_TERM:
+		case Operator::BV_COMPARE:
+			return reduceBitvector(_frame, _args, _count, _result);
+		case Operator::APPLY: {
+			const UninterpretedFunction& fun = _frame.function;
+			if (_count != fun.domain().size()) return fail("wrong number of arguments for " + fun.name());
+			std::vector<UVariable> args(_count);
+			for (std::size_t i = 0; i < _count; i++) {
+				if (!flatten(_args[i], args[i])) return false;
+				if (!(args[i].domain() == fun.domain()[i])) return fail("argument of wrong sort for " + fun.name());
+			}
+			_result = newUFInstance(fun, std::move(args));
+			return true;
+		}
+		default:
+			return reduceArithmetic(_frame, _args, _count, _result);
+	}
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::reduceEquality(const Frame& _frame, Value* _args, std::size_t _count, Value& _result) {
+	if (_count < 2) return fail("missing arguments");
+	// Uninterpreted variables and instances are compared with each other.
+	auto kind = [](const Value& v) { return std::min(v.which(), 3); };
+	for (std::size_t i = 1; i < _count; i++) {
+		if (kind(_args[i]) != kind(_args[0])) return fail("expected arguments of the same sort");
+	}
+	bool distinct = _frame.operation.op == Operator::DISTINCT;
+	if (kind(_args[0]) == 0) {
+		Formulas<Pol> subformulas;
+		for (std::size_t i = 0; i < _count; i++) subformulas.push_back(boost::get<Formula<Pol>>(_args[i]));
+		if (!distinct) {
+			_result = Formula<Pol>(IFF, std::move(subformulas));
+		} else if (_count == 2) {
+			_result = Formula<Pol>(XOR, std::move(subformulas));
+		} else {
+			// There are only two truth values.
+			_result = Formula<Pol>(FALSE);
+		}
+		return true;
+	}
+	// Equalities are chained, disequalities are pairwise.
+	Formulas<Pol> pairs;
+	for (std::size_t i = 0; i + 1 < _count; i++) {
+		for (std::size_t j = i + 1; j < (distinct ? _count : i + 2); j++) {
+			const Value& lhs = _args[i];
+			const Value& rhs = _args[j];
+			switch (kind(lhs)) {
+				case 1:
+					pairs.emplace_back(boost::get<Pol>(lhs) - boost::get<Pol>(rhs), distinct ? Relation::NEQ : Relation::EQ);
+					break;
+				case 2: {
+					const BVTerm& l = boost::get<BVTerm>(lhs);
+					const BVTerm& r = boost::get<BVTerm>(rhs);
+					if (l.width() != r.width()) return fail("expected bit-vectors of the same width");
+					pairs.emplace_back(BVConstraint::create(distinct ? BVCompareRelation::NEQ : BVCompareRelation::EQ, l, r));
+					break;
+				}
+				default: {
+					auto arg = [](const Value& v) {
+						const UVariable* var = boost::get<UVariable>(&v);
+						return var != nullptr ? UEquality::Arg(*var) : UEquality::Arg(boost::get<UFInstance>(v));
+					};
+					pairs.emplace_back(arg(lhs), arg(rhs), distinct);
+				}
+			}
+		}
+	}
+	_result = Formula<Pol>(AND, std::move(pairs));
+	return true;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::reduceArithmetic(const Frame& _frame, Value* _args, std::size_t _count, Value& _result) {
+	using Coeff = typename Pol::CoeffType;
+	if (_count == 0) return fail("missing arguments");
+	for (std::size_t i = 0; i < _count; i++) {
+		if (boost::get<Pol>(&_args[i]) == nullptr) return fail("expected arithmetic arguments");
+	}
+	auto arg = [&](std::size_t i) -> Pol& { return boost::get<Pol>(_args[i]); };
+	Relation relation = Relation::EQ;
+	switch (_frame.operation.op) {
+		case Operator::PLUS:
+		case Operator::MINUS: {
+			if (_frame.operation.op == Operator::MINUS && _count == 1) {
+				_result = -arg(0);
+				return true;
+			}
+			// All terms are collected and merged at once.
+			typename Pol::TermsType terms;
+			for (std::size_t i = 0; i < _count; i++) {
+				bool negate = i > 0 && _frame.operation.op == Operator::MINUS;
+				for (const auto& t: arg(i)) terms.push_back(negate ? -t : t);
+			}
+			_result = Pol(std::move(terms));
+			return true;
+		}
+		case Operator::TIMES: {
+			Pol res = std::move(arg(0));
+			for (std::size_t i = 1; i < _count; i++) res *= arg(i);
+			_result = std::move(res);
+			return true;
+		}
+		case Operator::DIVIDE: {
+			Pol res = std::move(arg(0));
+			for (std::size_t i = 1; i < _count; i++) {
+				if (!arg(i).isConstant() || carl::isZero(arg(i).constantPart())) return fail("only divisions by nonzero constants are supported");
+				res *= Coeff(1) / arg(i).constantPart();
+			}
+			_result = std::move(res);
+			return true;
+		}
+		case Operator::TO_REAL:
+			if (_count != 1) return fail("to_real expects a single argument");
+			_result = std::move(arg(0));
+			return true;
+		case Operator::LEQ: relation = Relation::LEQ; break;
+		case Operator::LESS: relation = Relation::LESS; break;
+		case Operator::GEQ: relation = Relation::GEQ; break;
+		case Operator::GREATER: relation = Relation::GREATER; break;
+		default:
+			assert(false);
+			return false;
+	}
+	if (_count < 2) return fail("missing arguments");
+	Formulas<Pol> constraints;
+	for (std::size_t i = 0; i + 1 < _count; i++) {
+		constraints.emplace_back(arg(i) - arg(i + 1), relation);
+	}
+	_result = Formula<Pol>(AND, std::move(constraints));
+	return true;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::reduceBitvector(const Frame& _frame, Value* _args, std::size_t _count, Value& _result) {
+	for (std::size_t i = 0; i < _count; i++) {
+		if (boost::get<BVTerm>(&_args[i]) == nullptr) return fail("expected bit-vector arguments");
+	}
+	auto arg = [&](std::size_t i) -> const BVTerm& { return boost::get<BVTerm>(_args[i]); };
+	const Operation& operation = _frame.operation;
+	if (operation.op == Operator::BV_COMPARE) {
+		if (_count != 2) return fail("bit-vector comparisons expect two arguments");
+		if (arg(0).width() != arg(1).width()) return fail("expected bit-vectors of the same width");
+		_result = Formula<Pol>(BVConstraint::create(operation.bvRelation, arg(0), arg(1)));
+		return true;
+	}
+	if (operation.indices > 0 || typeIsUnary(operation.bvType)) {
+		if (_count != 1) return fail("expected a single argument");
+		if (operation.bvType == BVTermType::EXTRACT) {
+			if (_frame.first < _frame.last || _frame.first >= arg(0).width()) return fail("invalid indices for extract");
+			_result = BVTerm(BVTermType::EXTRACT, arg(0), _frame.first, _frame.last);
+		} else {
+			_result = BVTerm(operation.bvType, arg(0), _frame.first);
+		}
+		return true;
+	}
+	if (_count < 2) return fail("missing arguments");
+	// Binary operations are left-associative.
+	BVTerm res = arg(0);
+	for (std::size_t i = 1; i < _count; i++) {
+		if (operation.bvType != BVTermType::CONCAT && res.width() != arg(i).width()) return fail("expected bit-vectors of the same width");
+		res = BVTerm(operation.bvType, res, arg(i));
+	}
+	_result = std::move(res);
+	return true;
+}
+
+template<typename Pol>
+bool SMTLIBReader<Pol>::flatten(Value& _arg, UVariable& _result) {
+	const UVariable* var = boost::get<UVariable>(&_arg);
+	if (var != nullptr) {
+		_result = *var;
+		return true;
+	}
+	const UFInstance* instance = boost::get<UFInstance>(&_arg);
+	if (instance == nullptr) return fail("expected uninterpreted arguments");
+	auto it = mFlattened.find(*instance);
+	if (it == mFlattened.end()) {
+		UVariable fresh(freshUninterpretedVariable(), instance->uninterpretedFunction().codomain());
+		it = mFlattened.emplace(*instance, fresh).first;
+		mDefinitions.emplace_back(UEquality::Arg(fresh), UEquality::Arg(*instance), false);
+	}
+	_result = it->second;
+	return true;
+}
+
+template<typename Pol>
+template<typename Handler>
+bool SMTLIBReader<Pol>::read(Handler& _handler) {
+	Formulas<Pol> batch;
+	auto flush = [&]() {
+		if (batch.empty()) return;
+		_handler.add(std::move(batch));
+		batch.clear();
+	};
+	while (true) {
+		Token t = next();
+		if (t.type == TokenType::END) break;
+		if (t.type != TokenType::LPAR) {
+			mPos = t.begin;
+			return error("\"(\"");
+		}
+		Token c = next();
+		if (c.type != TokenType::SYMBOL) {
+			mPos = c.begin;
+			return error("a command");
+		}
+		const std::string command = name(c);
+		if (command == "assert") {
+			Formula<Pol> f;
+			if (!parseFormula(f)) return false;
+			batch.insert(batch.end(), mDefinitions.begin(), mDefinitions.end());
+			mDefinitions.clear();
+			batch.push_back(std::move(f));
+		} else if (command == "push" || command == "pop") {
+			std::size_t n = 1;
+			const char* save = mPos;
+			if (next().type == TokenType::NUMERAL) {
+				mPos = save;
+				expectIndex(n);
+			} else {
+				mPos = save;
+			}
+			flush();
+			if (command == "push") {
+				for (std::size_t i = 0; i < n; i++) mScopes.push_back(mDeclared.size());
+				_handler.push(n);
+			} else {
+				if (n > mScopes.size()) return fail("cannot pop " + std::to_string(n) + " levels");
+				std::size_t mark = mScopes[mScopes.size() - n];
+				mScopes.resize(mScopes.size() - n);
+				for (std::size_t i = mark; i < mDeclared.size(); i++) {
+					mSymbols.erase(mDeclared[i]);
+					mFunctions.erase(mDeclared[i]);
+				}
+				mDeclared.resize(mark);
+				// Fresh variables of popped assertions must not be reused.
+				mFlattened.clear();
+				_handler.pop(n);
+			}
+		} else if (command == "check-sat") {
+			flush();
+			_handler.checkSat();
+		} else if (command == "declare-const" || command == "declare-fun") {
+			Token s = next();
+			if (s.type != TokenType::SYMBOL) {
+				mPos = s.begin;
+				return error("a symbol");
+			}
+			std::string symbol(s.begin, s.end);
+			std::vector<Sort> domain;
+			bool uninterpreted = true;
+			if (command == "declare-fun") {
+				if (!expect(TokenType::LPAR, "\"(\"")) return false;
+				while (true) {
+					const char* save = mPos;
+					if (next().type == TokenType::RPAR) break;
+					mPos = save;
+					SortInfo sort;
+					if (!parseSort(sort)) return false;
+					uninterpreted = uninterpreted && sort.type == VariableType::VT_UNINTERPRETED;
+					domain.push_back(sort.sort);
+				}
+			}
+			SortInfo codomain;
+			if (!parseSort(codomain)) return false;
+			if (domain.empty()) {
+				if (!declare(symbol, variable(symbol, codomain))) return false;
+			} else {
+				if (!uninterpreted || codomain.type != VariableType::VT_UNINTERPRETED) {
+					return fail("only functions over uninterpreted sorts are supported");
+				}
+				if (mSymbols.find(symbol) != mSymbols.end() || mFunctions.find(symbol) != mFunctions.end()) {
+					return fail("the symbol " + symbol + " is already declared");
+				}
+				mFunctions.emplace(symbol, newUninterpretedFunction(symbol, std::move(domain), codomain.sort));
+				mDeclared.push_back(symbol);
+			}
+		} else if (command == "define-fun") {
+			Token s = next();
+			if (s.type != TokenType::SYMBOL) {
+				mPos = s.begin;
+				return error("a symbol");
+			}
+			std::string symbol(s.begin, s.end);
+			if (!expect(TokenType::LPAR, "\"(\"")) return false;
+			if (!expect(TokenType::RPAR, "\")\", as functions with arguments are not supported")) return false;
+			SortInfo sort;
+			Value value;
+			if (!parseSort(sort) || !parseTerm(value)) return false;
+			if (!declare(symbol, std::move(value))) return false;
+		} else if (command == "declare-sort") {
+			Token s = next();
+			if (s.type != TokenType::SYMBOL) {
+				mPos = s.begin;
+				return error("a symbol");
+			}
+			std::string symbol(s.begin, s.end);
+			std::size_t arity = 0;
+			if (!expectIndex(arity)) return false;
+			if (arity != 0) return fail("only sorts without parameters are supported");
+			SortManager& sm = SortManager::getInstance();
+			sm.declare(symbol, 0);
+			mSorts[symbol] = sm.getSort(symbol);
+		} else if (command == "exit") {
+			break;
+		} else {
+			// Commands that do not change the assertions.
+			if (!skipList()) return false;
+			continue;
+		}
+		if (!expect(TokenType::RPAR, "\")\"")) return false;
+	}
+	flush();
+	return true;
+}
+
+template<typename Pol>
+boost::optional<Formula<Pol>> SMTLIBReader<Pol>::parse() {
+	struct Assertions {
+		std::vector<Formulas<Pol>> levels = std::vector<Formulas<Pol>>(1);
+		void add(Formulas<Pol>&& _batch) {
+			levels.back().insert(levels.back().end(), _batch.begin(), _batch.end());
+		}
+		void push(std::size_t _n) {
+			levels.resize(levels.size() + _n);
+		}
+		void pop(std::size_t _n) {
+			levels.resize(levels.size() - _n);
+		}
+		void checkSat() {}
+	};
+	Assertions assertions;
+	if (!read(assertions)) return boost::none;
+	Formulas<Pol> all;
+	for (auto& level: assertions.levels) {
+		std::move(level.begin(), level.end(), std::back_inserter(all));
+	}
+	if (all.empty()) return Formula<Pol>(TRUE);
+	return Formula<Pol>(AND, std::move(all));
+}
+
+}
@@ -2,6 +2,9 @@
 
 #include "../../core/Relation.h"
 #include "../../core/Variable.h"
+#include "../../core/VariablePool.h"
+#include "../../numbers/numbers.h"
+#include "../../util/Common.h"
 #include "../../util/hash.h"
 
 #include <utility>
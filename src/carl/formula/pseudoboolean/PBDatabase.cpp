@@ -0,0 +1,366 @@
+#include "PBDatabase.h"
+
+#include "../../core/logging.h"
+
+#include <algorithm>
+
+namespace carl
+{
+	namespace
+	{
+		void convert(const mpz_class& _from, std::int64_t& _to)
+		{
+			assert(sgn(_from) >= 0 && mpz_sizeinbase(_from.get_mpz_t(), 2) <= 62);
+			std::uint64_t result = 0;
+			mpz_export(&result, nullptr, -1, sizeof(result), 0, 0, _from.get_mpz_t());
+			_to = std::int64_t(result);
+		}
+		void convert(const mpz_class& _from, mpz_class& _to)
+		{
+			_to = _from;
+		}
+		mpz_class toMpz(std::int64_t _n)
+		{
+			assert(_n >= 0);
+			std::uint64_t abs = std::uint64_t(_n);
+			mpz_class result;
+			mpz_import(result.get_mpz_t(), 1, -1, sizeof(abs), 0, 0, &abs);
+			return result;
+		}
+	}
+
+	constexpr std::size_t PBDatabase::NONE;
+
+	PBDatabase::Literal PBDatabase::literal(Variable _var)
+	{
+		auto it = mVariableIndices.find(_var);
+		if (it != mVariableIndices.end()) return it->second;
+		Literal l = Literal(mVariables.size());
+		mVariableIndices.emplace(_var, l);
+		mVariables.push_back(_var);
+		mValues.push_back(0);
+		mReasons.push_back(NONE);
+		mWatches.resize(2 * mVariables.size());
+		mNativeOccurrences.resize(2 * mVariables.size());
+		mBigOccurrences.resize(2 * mVariables.size());
+		return l;
+	}
+
+	bool PBDatabase::add(std::vector<Term> _terms, Relation _relation, const mpz_class& _rhs)
+	{
+		assert(level() == 0);
+		if (!propagate()) return false;
+		auto negate = [](std::vector<Term>& terms) {
+			for (auto& t: terms) t.first = -t.first;
+		};
+		switch (_relation) {
+			case Relation::GEQ:
+				return addGreaterEqual(std::move(_terms), _rhs);
+			case Relation::GREATER:
+				return addGreaterEqual(std::move(_terms), _rhs + 1);
+			case Relation::LEQ:
+				negate(_terms);
+				return addGreaterEqual(std::move(_terms), -_rhs);
+			case Relation::LESS:
+				negate(_terms);
+				return addGreaterEqual(std::move(_terms), -_rhs + 1);
+			case Relation::EQ: {
+				std::vector<Term> negated(_terms);
+				negate(negated);
+				return addGreaterEqual(std::move(_terms), _rhs) && addGreaterEqual(std::move(negated), -_rhs);
+			}
+			case Relation::NEQ:
+				CARL_LOG_ERROR("carl.formula", "Pseudo-Boolean disequalities can not be stored in a PBDatabase.");
+				return consistent();
+		}
+		return consistent();
+	}
+
+	bool PBDatabase::normalize(std::vector<Term>& _terms, mpz_class& _degree) const
+	{
+		// Make all coefficients positive and remove fixed literals.
+		std::size_t j = 0;
+		for (std::size_t i = 0; i < _terms.size(); i++) {
+			Term& t = _terms[i];
+			if (sgn(t.first) < 0) {
+				// a*l = a + (-a)*(~l)
+				_degree -= t.first;
+				t.first = -t.first;
+				t.second = -t.second;
+			}
+			if (sgn(t.first) == 0) continue;
+			if (isAssigned(t.second)) {
+				if (isTrue(t.second)) _degree -= t.first;
+				continue;
+			}
+			if (i != j) std::swap(_terms[j], t);
+			j++;
+		}
+		_terms.resize(j);
+		// Merge terms over the same variable.
+		std::sort(_terms.begin(), _terms.end(), [](const Term& lhs, const Term& rhs){ return std::abs(lhs.second) < std::abs(rhs.second); });
+		j = 0;
+		for (std::size_t i = 0; i < _terms.size(); i++) {
+			if (j > 0 && std::abs(_terms[j-1].second) == std::abs(_terms[i].second)) {
+				Term& prev = _terms[j-1];
+				if (prev.second == _terms[i].second) {
+					prev.first += _terms[i].first;
+				} else if (prev.first < _terms[i].first) {
+					// a*l + b*(~l) = a + (b-a)*(~l)
+					_degree -= prev.first;
+					prev.first = _terms[i].first - prev.first;
+					prev.second = _terms[i].second;
+				} else {
+					_degree -= _terms[i].first;
+					prev.first -= _terms[i].first;
+				}
+			} else {
+				if (i != j) std::swap(_terms[j], _terms[i]);
+				j++;
+			}
+		}
+		_terms.resize(j);
+		_terms.erase(std::remove_if(_terms.begin(), _terms.end(), [](const Term& t){ return sgn(t.first) == 0; }), _terms.end());
+		if (sgn(_degree) <= 0) return false;
+		// Saturate and divide by the gcd of the coefficients.
+		mpz_class g = 0;
+		for (auto& t: _terms) {
+			if (t.first > _degree) t.first = _degree;
+			if (g != 1) g = carl::gcd(g, t.first);
+		}
+		if (g > 1) {
+			for (auto& t: _terms) {
+				mpz_divexact(t.first.get_mpz_t(), t.first.get_mpz_t(), g.get_mpz_t());
+			}
+			mpz_cdiv_q(_degree.get_mpz_t(), _degree.get_mpz_t(), g.get_mpz_t());
+		}
+		std::sort(_terms.begin(), _terms.end(), [](const Term& lhs, const Term& rhs){
+			if (lhs.first != rhs.first) return lhs.first > rhs.first;
+			return lhs.second < rhs.second;
+		});
+		return true;
+	}
+
+	bool PBDatabase::addGreaterEqual(std::vector<Term> _terms, mpz_class _degree)
+	{
+		if (!consistent()) return false;
+		if (!normalize(_terms, _degree)) return true;
+		store(_terms, _degree);
+		return propagate();
+	}
+
+	void PBDatabase::store(const std::vector<Term>& _terms, const mpz_class& _degree)
+	{
+		std::size_t id = mConstraints.size();
+		Header header{Kind::CARDINALITY, mLiterals.size(), _terms.size(), 0};
+		mpz_class sum = 0;
+		for (const auto& t: _terms) {
+			mLiterals.push_back(t.second);
+			sum += t.first;
+		}
+		if (_terms.empty() || _terms.front().first == 1) {
+			if (_degree > sum) {
+				header.mIndex = header.mSize + 1;
+				mConstraints.push_back(header);
+				mConflict = id;
+				return;
+			}
+			header.mIndex = _degree.get_ui();
+			mConstraints.push_back(header);
+			if (header.mIndex == header.mSize) {
+				// All literals are implied on the lowest level, the constraint never becomes relevant again.
+				for (const auto& t: _terms) enqueue(t.second, id);
+			} else {
+				for (std::size_t p = 0; p <= header.mIndex; p++) {
+					mWatches[index(_terms[p].second)].push_back(id);
+				}
+			}
+		} else if (mpz_sizeinbase(sum.get_mpz_t(), 2) <= 62 && _degree <= sum) {
+			header.mKind = Kind::NATIVE;
+			header.mIndex = mNative.mDegree.size();
+			mConstraints.push_back(header);
+			initialize(id, mNative, mNativeOccurrences, _terms, _degree);
+		} else {
+			header.mKind = Kind::BIG;
+			header.mIndex = mBig.mDegree.size();
+			mConstraints.push_back(header);
+			initialize(id, mBig, mBigOccurrences, _terms, _degree);
+		}
+	}
+
+	template<typename Integer>
+	void PBDatabase::initialize(std::size_t _id, Counters<Integer>& _counters, std::vector<std::vector<Occurrence>>& _occurrences, const std::vector<Term>& _terms, const mpz_class& _degree)
+	{
+		std::size_t begin = _counters.mCoefficients.size();
+		_counters.mBegin.push_back(begin);
+		Integer slack = 0;
+		for (std::size_t p = 0; p < _terms.size(); p++) {
+			Integer coefficient;
+			convert(_terms[p].first, coefficient);
+			slack += coefficient;
+			_counters.mCoefficients.push_back(coefficient);
+			_occurrences[index(_terms[p].second)].push_back(Occurrence{_id, p});
+		}
+		Integer degree;
+		convert(_degree, degree);
+		slack -= degree;
+		_counters.mDegree.push_back(degree);
+		_counters.mSlack.push_back(slack);
+		if (slack < 0) {
+			mConflict = _id;
+			return;
+		}
+		for (std::size_t p = 0; p < _terms.size() && _counters.mCoefficients[begin + p] > slack; p++) {
+			enqueue(_terms[p].second, _id);
+		}
+	}
+
+	void PBDatabase::enqueue(Literal _l, std::size_t _reason)
+	{
+		assert(!isAssigned(_l));
+		std::size_t var = std::size_t(std::abs(_l));
+		mValues[var] = _l > 0 ? 1 : -1;
+		mReasons[var] = _reason;
+		mTrail.push_back(_l);
+	}
+
+	template<typename Integer>
+	bool PBDatabase::decrease(const Occurrence& _occurrence, Counters<Integer>& _counters)
+	{
+		const Header& header = mConstraints[_occurrence.mConstraint];
+		std::size_t begin = _counters.mBegin[header.mIndex];
+		Integer& slack = _counters.mSlack[header.mIndex];
+		slack -= _counters.mCoefficients[begin + _occurrence.mPosition];
+		if (slack < 0) return false;
+		if (!consistent()) return true;
+		// Coefficients are sorted decreasingly, hence only a prefix of the literals is implied.
+		for (std::size_t p = 0; p < header.mSize && _counters.mCoefficients[begin + p] > slack; p++) {
+			Literal l = mLiterals[header.mBegin + p];
+			if (!isAssigned(l)) enqueue(l, _occurrence.mConstraint);
+		}
+		return true;
+	}
+
+	template<typename Integer>
+	void PBDatabase::increase(Literal _falsified, Counters<Integer>& _counters, const std::vector<std::vector<Occurrence>>& _occurrences)
+	{
+		for (const auto& occurrence: _occurrences[index(_falsified)]) {
+			std::size_t counter = mConstraints[occurrence.mConstraint].mIndex;
+			_counters.mSlack[counter] += _counters.mCoefficients[_counters.mBegin[counter] + occurrence.mPosition];
+		}
+	}
+
+	bool PBDatabase::propagateWatches(Literal _falsified)
+	{
+		std::vector<std::size_t>& watches = mWatches[index(_falsified)];
+		std::size_t j = 0;
+		for (std::size_t i = 0; i < watches.size(); i++) {
+			std::size_t id = watches[i];
+			if (!consistent()) {
+				watches[j++] = id;
+				continue;
+			}
+			const Header& header = mConstraints[id];
+			Literal* literals = mLiterals.data() + header.mBegin;
+			std::size_t degree = header.mIndex;
+			// The first degree+1 literals are watched.
+			std::size_t pos = 0;
+			while (literals[pos] != _falsified) pos++;
+			bool moved = false;
+			for (std::size_t q = degree + 1; q < header.mSize; q++) {
+				if (!isFalse(literals[q])) {
+					std::swap(literals[pos], literals[q]);
+					mWatches[index(literals[pos])].push_back(id);
+					moved = true;
+					break;
+				}
+			}
+			if (moved) continue;
+			// No replacement, all other watched literals must be true.
+			watches[j++] = id;
+			for (std::size_t r = 0; r <= degree; r++) {
+				if (r == pos) continue;
+				if (isFalse(literals[r])) {
+					mConflict = id;
+					break;
+				}
+				if (!isAssigned(literals[r])) enqueue(literals[r], id);
+			}
+		}
+		watches.resize(j);
+		return consistent();
+	}
+
+	bool PBDatabase::propagate()
+	{
+		while (consistent() && mPropagated < mTrail.size()) {
+			Literal falsified = -mTrail[mPropagated++];
+			// All counters are updated even after a conflict, such that backtrack() can restore them uniformly.
+			for (const auto& occurrence: mNativeOccurrences[index(falsified)]) {
+				if (!decrease(occurrence, mNative) && consistent()) mConflict = occurrence.mConstraint;
+			}
+			for (const auto& occurrence: mBigOccurrences[index(falsified)]) {
+				if (!decrease(occurrence, mBig) && consistent()) mConflict = occurrence.mConstraint;
+			}
+			if (!consistent()) break;
+			propagateWatches(falsified);
+		}
+		return consistent();
+	}
+
+	bool PBDatabase::assign(Literal _l)
+	{
+		assert(consistent());
+		mLevels.push_back(mTrail.size());
+		enqueue(_l, NONE);
+		return propagate();
+	}
+
+	void PBDatabase::backtrack(std::size_t _level)
+	{
+		assert(_level < mLevels.size());
+		std::size_t target = mLevels[_level];
+		mLevels.resize(_level);
+		while (mTrail.size() > target) {
+			Literal l = mTrail.back();
+			if (mTrail.size() <= mPropagated) {
+				increase(-l, mNative, mNativeOccurrences);
+				increase(-l, mBig, mBigOccurrences);
+			}
+			std::size_t var = std::size_t(std::abs(l));
+			mValues[var] = 0;
+			mReasons[var] = NONE;
+			mTrail.pop_back();
+		}
+		mPropagated = std::min(mPropagated, target);
+		mConflict = NONE;
+	}
+
+	mpz_class PBDatabase::constraint(std::size_t _id, std::vector<Term>& _terms) const
+	{
+		const Header& header = mConstraints[_id];
+		_terms.clear();
+		switch (header.mKind) {
+			case Kind::CARDINALITY:
+				for (std::size_t p = 0; p < header.mSize; p++) {
+					_terms.emplace_back(1, mLiterals[header.mBegin + p]);
+				}
+				return toMpz(std::int64_t(header.mIndex));
+			case Kind::NATIVE: {
+				std::size_t begin = mNative.mBegin[header.mIndex];
+				for (std::size_t p = 0; p < header.mSize; p++) {
+					_terms.emplace_back(toMpz(mNative.mCoefficients[begin + p]), mLiterals[header.mBegin + p]);
+				}
+				return toMpz(mNative.mDegree[header.mIndex]);
+			}
+			case Kind::BIG: {
+				std::size_t begin = mBig.mBegin[header.mIndex];
+				for (std::size_t p = 0; p < header.mSize; p++) {
+					_terms.emplace_back(mBig.mCoefficients[begin + p], mLiterals[header.mBegin + p]);
+				}
+				return mBig.mDegree[header.mIndex];
+			}
+		}
+		return 0;
+	}
+}
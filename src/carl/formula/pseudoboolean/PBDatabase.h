@@ -0,0 +1,293 @@
+/**
+ * @file PBDatabase.h
+ */
+
+#pragma once
+
+#include "PBConstraint.h"
+#include "../../core/Relation.h"
+#include "../../core/Variable.h"
+#include "../../numbers/numbers.h"
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace carl
+{
+	/**
+	 * Stores pseudo-Boolean constraints in a normalized form and propagates them.
+	 *
+	 * Every constraint is normalized to \f$\sum_i a_i l_i \geq d\f$ where the \f$l_i\f$ are literals over distinct
+	 * variables and \f$0 < a_i \leq d\f$. To this end, negative coefficients are turned into positive ones by negating
+	 * the literal, coefficients are saturated at the degree and all coefficients and the degree are divided by the
+	 * greatest common divisor of the coefficients. Literals fixed on the lowest level are removed.
+	 *
+	 * The normalized constraints are kept in one of three stores:
+	 * - Cardinality constraints, whose coefficients are all one, are propagated by watching \f$d+1\f$ of their literals.
+	 * - Other constraints whose coefficients sum up to less than \f$2^{62}\f$ store native 64 bit coefficients.
+	 * - All remaining constraints store arbitrary precision coefficients.
+	 * The latter two are propagated by maintaining the slack, that is the sum of the coefficients of all literals that
+	 * are not false minus the degree. A literal whose coefficient exceeds the slack is implied.
+	 *
+	 * Literals are nonzero integers as in the DIMACS format, a negative literal denotes the negation of a variable.
+	 */
+	class PBDatabase
+	{
+	public:
+		using Literal = int;
+		/// A term of a constraint that is added to the database.
+		using Term = std::pair<mpz_class, Literal>;
+		/// Denotes the absence of a constraint.
+		static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+	private:
+		enum class Kind : std::uint8_t { CARDINALITY, NATIVE, BIG };
+
+		struct Header
+		{
+			Kind mKind;
+			/// Position of the first literal in mLiterals.
+			std::size_t mBegin;
+			/// Number of literals.
+			std::size_t mSize;
+			/// The degree of a cardinality constraint, or the index in the counters of the other constraints.
+			std::size_t mIndex;
+		};
+
+		/// Coefficients, degrees and slacks of the constraints that are propagated by counters.
+		template<typename Integer>
+		struct Counters
+		{
+			/// Position of the first coefficient of every constraint in mCoefficients.
+			std::vector<std::size_t> mBegin;
+			/// The coefficients of all constraints, sorted decreasingly for every constraint.
+			std::vector<Integer> mCoefficients;
+			std::vector<Integer> mDegree;
+			std::vector<Integer> mSlack;
+		};
+
+		/// An occurrence of a literal in a constraint propagated by counters.
+		struct Occurrence
+		{
+			std::size_t mConstraint;
+			/// Position of the literal within the constraint.
+			std::size_t mPosition;
+		};
+
+		std::vector<Header> mConstraints;
+		/// The literals of all constraints.
+		std::vector<Literal> mLiterals;
+		Counters<std::int64_t> mNative;
+		Counters<mpz_class> mBig;
+
+		/// Maps variables to their index, starting from one.
+		std::unordered_map<Variable, Literal> mVariableIndices;
+		/// The variables by their index.
+		std::vector<Variable> mVariables;
+		/// Values of the variables: 1 if true, -1 if false, 0 if unassigned.
+		std::vector<signed char> mValues;
+		/// The constraint that implied a variable or NONE.
+		std::vector<std::size_t> mReasons;
+		/// Cardinality constraints watching a literal.
+		std::vector<std::vector<std::size_t>> mWatches;
+		/// Occurrences of a literal in constraints propagated by counters.
+		std::vector<std::vector<Occurrence>> mNativeOccurrences;
+		std::vector<std::vector<Occurrence>> mBigOccurrences;
+
+		/// The assigned literals in the order of assignment.
+		std::vector<Literal> mTrail;
+		/// Sizes of the trail when the levels were opened.
+		std::vector<std::size_t> mLevels;
+		/// Number of literals on the trail that have been propagated.
+		std::size_t mPropagated = 0;
+		/// A constraint that is violated or NONE.
+		std::size_t mConflict = NONE;
+
+		static std::size_t index(Literal _l)
+		{
+			return 2 * std::size_t(std::abs(_l)) + (_l < 0 ? 1 : 0);
+		}
+
+		/**
+		 * Normalizes the constraint given by its terms and degree.
+		 * @return false, if the constraint is trivially satisfied.
+		 */
+		bool normalize(std::vector<Term>& _terms, mpz_class& _degree) const;
+		bool addGreaterEqual(std::vector<Term> _terms, mpz_class _degree);
+		void store(const std::vector<Term>& _terms, const mpz_class& _degree);
+		template<typename Integer>
+		void initialize(std::size_t _id, Counters<Integer>& _counters, std::vector<std::vector<Occurrence>>& _occurrences, const std::vector<Term>& _terms, const mpz_class& _degree);
+		template<typename Integer>
+		bool decrease(const Occurrence& _occurrence, Counters<Integer>& _counters);
+		template<typename Integer>
+		void increase(Literal _falsified, Counters<Integer>& _counters, const std::vector<std::vector<Occurrence>>& _occurrences);
+		bool propagateWatches(Literal _falsified);
+		void enqueue(Literal _l, std::size_t _reason);
+
+	public:
+		PBDatabase():
+			mVariables(1),
+			mValues(1, 0),
+			mReasons(1, NONE),
+			mWatches(2),
+			mNativeOccurrences(2),
+			mBigOccurrences(2)
+		{}
+
+		/**
+		 * @return The literal representing the given Boolean variable.
+		 */
+		Literal literal(Variable _var);
+
+		/**
+		 * @return The variable of the given literal.
+		 */
+		Variable variable(Literal _l) const
+		{
+			return mVariables[std::size_t(std::abs(_l))];
+		}
+
+		/**
+		 * Adds the constraint \f$\sum terms \sim rhs\f$. Disequalities are not supported.
+		 * Constraints can only be added on the lowest level.
+		 * @param _terms The coefficients and literals of the left hand side.
+		 * @param _relation The relation.
+		 * @param _rhs The right hand side.
+		 * @return false, if the database became inconsistent.
+		 */
+		bool add(std::vector<Term> _terms, Relation _relation, const mpz_class& _rhs);
+
+		/**
+		 * Adds the given pseudo-Boolean constraint, whose coefficients must be integral.
+		 * @return false, if the database became inconsistent.
+		 */
+		template<typename Pol>
+		bool add(const PBConstraint<Pol>& _constraint)
+		{
+			std::vector<Term> terms;
+			terms.reserve(_constraint.getLHS().size());
+			for (const auto& term: _constraint.getLHS()) {
+				assert(carl::isInteger(term.first));
+				terms.emplace_back(mpz_class(carl::getNum(term.first)), literal(term.second));
+			}
+			assert(carl::isInteger(_constraint.getRHS()));
+			return add(std::move(terms), _constraint.getRelation(), mpz_class(carl::getNum(_constraint.getRHS())));
+		}
+
+		/**
+		 * Opens a new level and assigns the given literal to true.
+		 * @param _l An unassigned literal.
+		 * @return false, if a conflict was found by propagating.
+		 */
+		bool assign(Literal _l);
+
+		/**
+		 * Propagates all assigned literals.
+		 * @return false, if a conflict was found.
+		 */
+		bool propagate();
+
+		/**
+		 * Undoes all assignments made on levels above the given one.
+		 * @param _level The level to return to.
+		 */
+		void backtrack(std::size_t _level);
+
+		/**
+		 * @return The current level, that is the number of assignments made by assign().
+		 */
+		std::size_t level() const
+		{
+			return mLevels.size();
+		}
+
+		/**
+		 * @return true, if no conflict was found.
+		 */
+		bool consistent() const
+		{
+			return mConflict == NONE;
+		}
+
+		/**
+		 * @return The violated constraint or NONE.
+		 */
+		std::size_t conflict() const
+		{
+			return mConflict;
+		}
+
+		/**
+		 * @return The constraint that implied the given assigned literal or NONE, if it was assigned by assign().
+		 */
+		std::size_t reason(Literal _l) const
+		{
+			return mReasons[std::size_t(std::abs(_l))];
+		}
+
+		bool isTrue(Literal _l) const
+		{
+			signed char value = mValues[std::size_t(std::abs(_l))];
+			return _l > 0 ? value > 0 : value < 0;
+		}
+		bool isFalse(Literal _l) const
+		{
+			return isTrue(-_l);
+		}
+		bool isAssigned(Literal _l) const
+		{
+			return mValues[std::size_t(std::abs(_l))] != 0;
+		}
+
+		/**
+		 * @return The assigned literals in the order of assignment.
+		 */
+		const std::vector<Literal>& trail() const
+		{
+			return mTrail;
+		}
+
+		/**
+		 * @return The number of stored constraints.
+		 */
+		std::size_t size() const
+		{
+			return mConstraints.size();
+		}
+
+		/**
+		 * @return The number of variables.
+		 */
+		std::size_t variables() const
+		{
+			return mVariables.size() - 1;
+		}
+
+		/**
+		 * @return true, if the given constraint is a cardinality constraint.
+		 */
+		bool isCardinality(std::size_t _id) const
+		{
+			return mConstraints[_id].mKind == Kind::CARDINALITY;
+		}
+
+		/**
+		 * @return true, if the given constraint stores native coefficients.
+		 */
+		bool isNative(std::size_t _id) const
+		{
+			return mConstraints[_id].mKind != Kind::BIG;
+		}
+
+		/**
+		 * Retrieves the normalized form of a stored constraint.
+		 * @param _id The constraint.
+		 * @param _terms Is filled with the terms of the left hand side.
+		 * @return The degree.
+		 */
+		mpz_class constraint(std::size_t _id, std::vector<Term>& _terms) const;
+	};
+}
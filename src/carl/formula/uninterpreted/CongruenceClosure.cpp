@@ -0,0 +1,441 @@
+/**
+ * @file CongruenceClosure.cpp
+ */
+
+#include "CongruenceClosure.h"
+
+#include "../model/uninterpreted/SortValueManager.h"
+#include "../../util/hash.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace carl
+{
+    constexpr std::size_t CongruenceClosure::NONE;
+
+    std::size_t CongruenceClosure::SignatureHash::operator()(const std::vector<std::size_t>& _signature) const
+    {
+        std::size_t result = 0;
+        for (std::size_t n: _signature) {
+            carl::hash_add(result, n);
+        }
+        return result;
+    }
+
+    std::size_t CongruenceClosure::lookup(const Term& _term) const
+    {
+        if (UEquality::IsUVariable()(_term)) {
+            auto it = mVariables.find(boost::get<UVariable>(_term));
+            return it == mVariables.end() ? NONE : it->second;
+        }
+        const UFInstance& instance = boost::get<UFInstance>(_term);
+        auto it = mInstances.find(instance);
+        if (it != mInstances.end()) return it->second;
+        // An unknown instance may still be congruent to a known one.
+        std::vector<std::size_t> sig({instance.uninterpretedFunction().id()});
+        for (const auto& arg: instance.args()) {
+            auto argIt = mVariables.find(arg);
+            if (argIt == mVariables.end()) return NONE;
+            sig.push_back(mNodes[argIt->second].mFind);
+        }
+        auto sigIt = mSignatures.find(sig);
+        if (sigIt == mSignatures.end() || signature(sigIt->second) != sig) return NONE;
+        return sigIt->second;
+    }
+
+    std::size_t CongruenceClosure::node(const Term& _term)
+    {
+        std::size_t res = lookup(_term);
+        if (res != NONE && !(mNodes[res].mTerm == _term)) {
+            // Congruent to an existing node, but not the same instance.
+            res = NONE;
+        }
+        if (res == NONE) {
+            res = newNode(_term);
+        }
+        return res;
+    }
+
+    std::size_t CongruenceClosure::newNode(const Term& _term)
+    {
+        std::vector<std::size_t> args;
+        if (UEquality::IsUFInstance()(_term)) {
+            for (const auto& arg: boost::get<UFInstance>(_term).args()) {
+                args.push_back(node(arg));
+            }
+        }
+        std::size_t id = mNodes.size();
+        mNodes.emplace_back(_term, id);
+        if (UEquality::IsUVariable()(_term)) {
+            mVariables.emplace(boost::get<UVariable>(_term), id);
+        } else {
+            mInstances.emplace(boost::get<UFInstance>(_term), id);
+        }
+        TrailEntry entry;
+        entry.mType = TrailType::NODE;
+        entry.mNode = id;
+        mTrail.push_back(std::move(entry));
+
+        if (!args.empty()) {
+            mNodes[id].mArgs = args;
+            std::vector<std::size_t> reps;
+            for (std::size_t arg: args) {
+                reps.push_back(mNodes[arg].mFind);
+            }
+            std::sort(reps.begin(), reps.end());
+            reps.erase(std::unique(reps.begin(), reps.end()), reps.end());
+            for (std::size_t rep: reps) {
+                mNodes[rep].mUses.push_back(id);
+                TrailEntry use;
+                use.mType = TrailType::USE;
+                use.mNode = rep;
+                mTrail.push_back(std::move(use));
+            }
+            insertSignature(id);
+        }
+        return id;
+    }
+
+    std::vector<std::size_t> CongruenceClosure::signature(std::size_t _node) const
+    {
+        const Node& n = mNodes[_node];
+        std::vector<std::size_t> result;
+        result.reserve(n.mArgs.size() + 1);
+        result.push_back(boost::get<UFInstance>(n.mTerm).uninterpretedFunction().id());
+        for (std::size_t arg: n.mArgs) {
+            result.push_back(mNodes[arg].mFind);
+        }
+        return result;
+    }
+
+    void CongruenceClosure::insertSignature(std::size_t _node)
+    {
+        std::vector<std::size_t> sig = signature(_node);
+        auto it = mSignatures.find(sig);
+        std::size_t previous = NONE;
+        if (it != mSignatures.end()) {
+            std::size_t other = it->second;
+            if (other == _node) return;
+            // Entries of merged classes are not removed, hence check whether the entry is still valid.
+            if (signature(other) == sig) {
+                if (mNodes[other].mFind != mNodes[_node].mFind) {
+                    Reason reason;
+                    reason.mFirst = _node;
+                    reason.mSecond = other;
+                    mPending.push_back(Merge{_node, other, reason});
+                }
+                return;
+            }
+            previous = other;
+            it->second = _node;
+        } else {
+            mSignatures.emplace(sig, _node);
+        }
+        TrailEntry entry;
+        entry.mType = TrailType::SIGNATURE;
+        entry.mOther = previous;
+        entry.mSignature = std::move(sig);
+        mTrail.push_back(std::move(entry));
+    }
+
+    void CongruenceClosure::makeProofRoot(std::size_t _node)
+    {
+        std::size_t prev = NONE;
+        Reason prevReason;
+        std::size_t cur = _node;
+        while (cur != NONE) {
+            std::size_t next = mNodes[cur].mProofParent;
+            Reason nextReason = mNodes[cur].mProofReason;
+            mNodes[cur].mProofParent = prev;
+            mNodes[cur].mProofReason = prevReason;
+            prev = cur;
+            prevReason = nextReason;
+            cur = next;
+        }
+    }
+
+    void CongruenceClosure::merge(const Merge& _merge)
+    {
+        std::size_t a = _merge.mFirst;
+        std::size_t b = _merge.mSecond;
+        std::size_t ra = mNodes[a].mFind;
+        std::size_t rb = mNodes[b].mFind;
+        if (ra == rb) return;
+        // Merge the smaller class into the larger one
+        if (mNodes[ra].mSize < mNodes[rb].mSize) {
+            std::swap(a, b);
+            std::swap(ra, rb);
+        }
+        makeProofRoot(b);
+        mNodes[b].mProofParent = a;
+        mNodes[b].mProofReason = _merge.mReason;
+
+        TrailEntry entry;
+        entry.mType = TrailType::MERGE;
+        entry.mNode = ra;
+        entry.mOther = rb;
+        entry.mProofNode = b;
+        entry.mProofParent = a;
+        entry.mUsesSize = mNodes[ra].mUses.size();
+        entry.mDisequalitiesSize = mNodes[ra].mDisequalities.size();
+        mTrail.push_back(std::move(entry));
+
+        std::size_t n = rb;
+        do {
+            mNodes[n].mFind = ra;
+            n = mNodes[n].mNext;
+        } while (n != rb);
+        std::swap(mNodes[ra].mNext, mNodes[rb].mNext);
+        mNodes[ra].mSize += mNodes[rb].mSize;
+
+        for (std::size_t d: mNodes[rb].mDisequalities) {
+            const auto& nodes = mDisequalities[d].first;
+            mNodes[ra].mDisequalities.push_back(d);
+            if (mNodes[nodes.first].mFind == mNodes[nodes.second].mFind) {
+                mConflict = d;
+                TrailEntry conflict;
+                conflict.mType = TrailType::CONFLICT;
+                mTrail.push_back(std::move(conflict));
+                return;
+            }
+        }
+        for (std::size_t p: mNodes[rb].mUses) {
+            mNodes[ra].mUses.push_back(p);
+            insertSignature(p);
+        }
+    }
+
+    void CongruenceClosure::propagate()
+    {
+        while (!mPending.empty() && consistent()) {
+            Merge m = mPending.back();
+            mPending.pop_back();
+            merge(m);
+        }
+        mPending.clear();
+    }
+
+    bool CongruenceClosure::add(const UEquality& _equality)
+    {
+        if (!consistent()) return false;
+        std::size_t a = node(_equality.lhs());
+        std::size_t b = node(_equality.rhs());
+        propagate();
+        std::size_t index = mAssertions.size();
+        mAssertions.push_back(_equality);
+        TrailEntry entry;
+        entry.mType = TrailType::ASSERTION;
+        mTrail.push_back(std::move(entry));
+        if (_equality.negated()) {
+            std::size_t ra = mNodes[a].mFind;
+            std::size_t rb = mNodes[b].mFind;
+            std::size_t d = mDisequalities.size();
+            mDisequalities.emplace_back(std::make_pair(a, b), index);
+            mNodes[ra].mDisequalities.push_back(d);
+            if (rb != ra) mNodes[rb].mDisequalities.push_back(d);
+            TrailEntry diseq;
+            diseq.mType = TrailType::DISEQUALITY;
+            diseq.mNode = ra;
+            diseq.mOther = rb;
+            mTrail.push_back(std::move(diseq));
+            if (ra == rb) {
+                mConflict = d;
+                TrailEntry conflict;
+                conflict.mType = TrailType::CONFLICT;
+                mTrail.push_back(std::move(conflict));
+            }
+        } else {
+            Reason reason;
+            reason.mAssertion = index;
+            mPending.push_back(Merge{a, b, reason});
+            propagate();
+        }
+        return consistent();
+    }
+
+    bool CongruenceClosure::areEqual(const Term& _a, const Term& _b) const
+    {
+        if (_a == _b) return true;
+        std::size_t a = lookup(_a);
+        std::size_t b = lookup(_b);
+        if (a == NONE || b == NONE) return false;
+        return mNodes[a].mFind == mNodes[b].mFind;
+    }
+
+    void CongruenceClosure::explain(std::size_t _a, std::size_t _b, std::vector<std::size_t>& _assertions) const
+    {
+        std::vector<std::pair<std::size_t,std::size_t>> queue({{_a, _b}});
+        std::unordered_set<std::size_t> ancestors;
+        while (!queue.empty()) {
+            std::size_t a = queue.back().first;
+            std::size_t b = queue.back().second;
+            queue.pop_back();
+            if (a == b) continue;
+            assert(mNodes[a].mFind == mNodes[b].mFind);
+            // Find the nearest common ancestor in the proof forest
+            ancestors.clear();
+            for (std::size_t n = a; n != NONE; n = mNodes[n].mProofParent) {
+                ancestors.insert(n);
+            }
+            std::size_t common = b;
+            while (ancestors.count(common) == 0) {
+                common = mNodes[common].mProofParent;
+                assert(common != NONE);
+            }
+            for (std::size_t start: {a, b}) {
+                for (std::size_t n = start; n != common; n = mNodes[n].mProofParent) {
+                    const Reason& reason = mNodes[n].mProofReason;
+                    if (reason.mAssertion != NONE) {
+                        _assertions.push_back(reason.mAssertion);
+                    } else {
+                        const auto& first = mNodes[reason.mFirst].mArgs;
+                        const auto& second = mNodes[reason.mSecond].mArgs;
+                        for (std::size_t i = 0; i < first.size(); i++) {
+                            queue.emplace_back(first[i], second[i]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<UEquality> CongruenceClosure::explain(const Term& _a, const Term& _b) const
+    {
+        std::vector<UEquality> result;
+        if (_a == _b) return result;
+        std::size_t a = lookup(_a);
+        std::size_t b = lookup(_b);
+        assert(a != NONE && b != NONE && mNodes[a].mFind == mNodes[b].mFind);
+        std::vector<std::size_t> assertions;
+        explain(a, b, assertions);
+        std::sort(assertions.begin(), assertions.end());
+        assertions.erase(std::unique(assertions.begin(), assertions.end()), assertions.end());
+        for (std::size_t i: assertions) {
+            result.push_back(mAssertions[i]);
+        }
+        return result;
+    }
+
+    std::vector<UEquality> CongruenceClosure::conflict() const
+    {
+        std::vector<UEquality> result;
+        if (consistent()) return result;
+        const auto& diseq = mDisequalities[mConflict];
+        std::vector<std::size_t> assertions({diseq.second});
+        explain(diseq.first.first, diseq.first.second, assertions);
+        std::sort(assertions.begin(), assertions.end());
+        assertions.erase(std::unique(assertions.begin(), assertions.end()), assertions.end());
+        for (std::size_t i: assertions) {
+            result.push_back(mAssertions[i]);
+        }
+        return result;
+    }
+
+    void CongruenceClosure::push()
+    {
+        mLevels.push_back(mTrail.size());
+    }
+
+    void CongruenceClosure::pop()
+    {
+        assert(!mLevels.empty());
+        std::size_t size = mLevels.back();
+        mLevels.pop_back();
+        while (mTrail.size() > size) {
+            undo(mTrail.back());
+            mTrail.pop_back();
+        }
+        mPending.clear();
+    }
+
+    void CongruenceClosure::undo(const TrailEntry& _entry)
+    {
+        switch (_entry.mType) {
+            case TrailType::NODE: {
+                const Term& term = mNodes[_entry.mNode].mTerm;
+                if (UEquality::IsUVariable()(term)) {
+                    mVariables.erase(boost::get<UVariable>(term));
+                } else {
+                    mInstances.erase(boost::get<UFInstance>(term));
+                }
+                assert(_entry.mNode + 1 == mNodes.size());
+                mNodes.pop_back();
+                break;
+            }
+            case TrailType::USE:
+                mNodes[_entry.mNode].mUses.pop_back();
+                break;
+            case TrailType::SIGNATURE:
+                if (_entry.mOther == NONE) {
+                    mSignatures.erase(_entry.mSignature);
+                } else {
+                    mSignatures[_entry.mSignature] = _entry.mOther;
+                }
+                break;
+            case TrailType::MERGE: {
+                std::size_t ra = _entry.mNode;
+                std::size_t rb = _entry.mOther;
+                mNodes[ra].mUses.resize(_entry.mUsesSize);
+                mNodes[ra].mDisequalities.resize(_entry.mDisequalitiesSize);
+                mNodes[ra].mSize -= mNodes[rb].mSize;
+                std::swap(mNodes[ra].mNext, mNodes[rb].mNext);
+                std::size_t n = rb;
+                do {
+                    mNodes[n].mFind = rb;
+                    n = mNodes[n].mNext;
+                } while (n != rb);
+                // Later merges may have reversed the direction of the edge
+                std::size_t child = _entry.mProofNode;
+                if (mNodes[child].mProofParent != _entry.mProofParent) {
+                    child = _entry.mProofParent;
+                }
+                assert(mNodes[child].mProofParent == (child == _entry.mProofNode ? _entry.mProofParent : _entry.mProofNode));
+                mNodes[child].mProofParent = NONE;
+                mNodes[child].mProofReason = Reason();
+                break;
+            }
+            case TrailType::ASSERTION:
+                mAssertions.pop_back();
+                break;
+            case TrailType::DISEQUALITY:
+                mDisequalities.pop_back();
+                mNodes[_entry.mNode].mDisequalities.pop_back();
+                if (_entry.mOther != _entry.mNode) mNodes[_entry.mOther].mDisequalities.pop_back();
+                break;
+            case TrailType::CONFLICT:
+                mConflict = NONE;
+                break;
+        }
+    }
+
+    void CongruenceClosure::model(std::map<UVariable, SortValue>& _variables, std::map<UninterpretedFunction, UFModel>& _functions) const
+    {
+        assert(consistent());
+        std::map<std::size_t, SortValue> values;
+        for (std::size_t id = 0; id < mNodes.size(); id++) {
+            const Node& n = mNodes[id];
+            if (values.find(n.mFind) != values.end()) continue;
+            if (UEquality::IsUVariable()(n.mTerm)) {
+                values.emplace(n.mFind, newSortValue(boost::get<UVariable>(n.mTerm).domain()));
+            } else {
+                values.emplace(n.mFind, newSortValue(boost::get<UFInstance>(n.mTerm).uninterpretedFunction().codomain()));
+            }
+        }
+        for (const auto& var: mVariables) {
+            _variables[var.first] = values.at(mNodes[var.second].mFind);
+        }
+        for (const auto& inst: mInstances) {
+            const UninterpretedFunction& uf = inst.first.uninterpretedFunction();
+            auto it = _functions.find(uf);
+            if (it == _functions.end()) {
+                it = _functions.emplace(uf, UFModel(uf)).first;
+            }
+            std::vector<SortValue> args;
+            for (std::size_t arg: mNodes[inst.second].mArgs) {
+                args.push_back(values.at(mNodes[arg].mFind));
+            }
+            it->second.extend(args, values.at(mNodes[inst.second].mFind));
+        }
+    }
+}
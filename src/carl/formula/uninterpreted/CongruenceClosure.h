@@ -0,0 +1,202 @@
+/**
+ * @file CongruenceClosure.h
+ */
+
+#pragma once
+
+#include "UEquality.h"
+#include "UFInstance.h"
+#include "UninterpretedFunction.h"
+#include "UVariable.h"
+#include "../model/uninterpreted/SortValue.h"
+#include "../model/uninterpreted/UFModel.h"
+
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace carl
+{
+    /**
+     * Decides conjunctions of uninterpreted equalities and disequalities by congruence closure.
+     *
+     * Every uninterpreted variable and function instance is a node. The equivalence classes
+     * are maintained by a union-find structure that stores the representative of every node
+     * explicitly, that is with fully compressed paths, and merges the smaller into the larger
+     * class. Function instances are congruent if their arguments are pairwise equal, which is
+     * detected by a signature table mapping the function and the representatives of the
+     * arguments to a function instance.
+     *
+     * Every merge is recorded in a proof forest, which allows to explain why two nodes are
+     * equal and thereby to give the asserted equalities responsible for a conflict.
+     * All changes are recorded on a trail such that the state can be reset by push() and pop().
+     */
+    class CongruenceClosure
+    {
+        public:
+            /// Terms of the congruence closure, namely uninterpreted variables and function instances.
+            using Term = UEquality::Arg;
+
+        private:
+            static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+            /// The reason for an edge in the proof forest.
+            struct Reason
+            {
+                /// Index of the asserted equality or NONE, if the edge stems from a congruence.
+                std::size_t mAssertion = NONE;
+                /// The congruent function instances, if the edge stems from a congruence.
+                std::size_t mFirst = NONE;
+                std::size_t mSecond = NONE;
+            };
+
+            struct Node
+            {
+                Term mTerm;
+                /// The representative of the class of this node.
+                std::size_t mFind;
+                /// The next node of the same class, the members of a class form a cycle.
+                std::size_t mNext;
+                /// The size of the class, only valid for representatives.
+                std::size_t mSize = 1;
+                /// The argument nodes, if this node is a function instance.
+                std::vector<std::size_t> mArgs;
+                /// Function instances having a member of this class as argument, only valid for representatives.
+                std::vector<std::size_t> mUses;
+                /// Indices of the disequalities involving a member of this class, only valid for representatives.
+                std::vector<std::size_t> mDisequalities;
+                /// The parent in the proof forest.
+                std::size_t mProofParent = NONE;
+                /// The reason for the edge to the parent in the proof forest.
+                Reason mProofReason;
+
+                Node(const Term& _term, std::size_t _id): mTerm(_term), mFind(_id), mNext(_id) {}
+            };
+
+            struct SignatureHash
+            {
+                std::size_t operator()(const std::vector<std::size_t>& _signature) const;
+            };
+
+            enum class TrailType { NODE, USE, SIGNATURE, MERGE, ASSERTION, DISEQUALITY, CONFLICT };
+
+            struct TrailEntry
+            {
+                TrailType mType;
+                /// The node or class concerned.
+                std::size_t mNode = NONE;
+                /// The class merged into mNode or the previous entry of the signature table.
+                std::size_t mOther = NONE;
+                /// The endpoints of the new edge in the proof forest.
+                std::size_t mProofNode = NONE;
+                std::size_t mProofParent = NONE;
+                /// Sizes of the use list and the disequality list of mNode before merging.
+                std::size_t mUsesSize = 0;
+                std::size_t mDisequalitiesSize = 0;
+                /// The signature, if an entry of the signature table was set.
+                std::vector<std::size_t> mSignature;
+            };
+
+            struct Merge
+            {
+                std::size_t mFirst;
+                std::size_t mSecond;
+                Reason mReason;
+            };
+
+            /// All nodes.
+            std::vector<Node> mNodes;
+            /// The nodes of the uninterpreted variables.
+            std::unordered_map<UVariable, std::size_t> mVariables;
+            /// The nodes of the uninterpreted function instances.
+            std::unordered_map<UFInstance, std::size_t> mInstances;
+            /// Maps the function and the representatives of the arguments to a function instance.
+            std::unordered_map<std::vector<std::size_t>, std::size_t, SignatureHash> mSignatures;
+            /// All asserted equalities and disequalities.
+            std::vector<UEquality> mAssertions;
+            /// The disequalities as nodes and the index of the assertion.
+            std::vector<std::pair<std::pair<std::size_t,std::size_t>,std::size_t>> mDisequalities;
+            /// Merges that are yet to be done.
+            std::vector<Merge> mPending;
+            /// Changes that are undone by pop().
+            std::vector<TrailEntry> mTrail;
+            /// Sizes of the trail at the calls to push().
+            std::vector<std::size_t> mLevels;
+            /// The disequality that is violated, or NONE.
+            std::size_t mConflict = NONE;
+
+            std::size_t node(const Term& _term);
+            std::size_t newNode(const Term& _term);
+            std::vector<std::size_t> signature(std::size_t _node) const;
+            void insertSignature(std::size_t _node);
+            void propagate();
+            void merge(const Merge& _merge);
+            void makeProofRoot(std::size_t _node);
+            void undo(const TrailEntry& _entry);
+            std::size_t lookup(const Term& _term) const;
+            void explain(std::size_t _a, std::size_t _b, std::vector<std::size_t>& _assertions) const;
+
+        public:
+            /**
+             * Adds the given equality or disequality.
+             * @param _equality The uninterpreted equality to add.
+             * @return false, if the asserted equalities and disequalities are inconsistent.
+             */
+            bool add(const UEquality& _equality);
+
+            /**
+             * @return true, if the asserted equalities and disequalities are consistent.
+             */
+            bool consistent() const
+            {
+                return mConflict == NONE;
+            }
+
+            /**
+             * @param _a A term.
+             * @param _b A term.
+             * @return true, if the given terms are equal with respect to the asserted equalities.
+             */
+            bool areEqual(const Term& _a, const Term& _b) const;
+
+            /**
+             * Explains why the given terms are equal.
+             * @param _a A term.
+             * @param _b A term that is equal to _a.
+             * @return The asserted equalities that imply the equality of the given terms.
+             */
+            std::vector<UEquality> explain(const Term& _a, const Term& _b) const;
+
+            /**
+             * @return If inconsistent, the violated disequality together with the asserted equalities that contradict it.
+             */
+            std::vector<UEquality> conflict() const;
+
+            /**
+             * Creates a backtrack point.
+             */
+            void push();
+
+            /**
+             * Undoes all changes since the last call to push().
+             */
+            void pop();
+
+            /**
+             * @return The number of backtrack points.
+             */
+            std::size_t level() const
+            {
+                return mLevels.size();
+            }
+
+            /**
+             * Computes a model of the asserted equalities and disequalities.
+             * Every equivalence class is assigned a distinct value of its sort.
+             * @param _variables Is filled with the values of all uninterpreted variables.
+             * @param _functions Is filled with the models of all uninterpreted functions.
+             */
+            void model(std::map<UVariable, SortValue>& _variables, std::map<UninterpretedFunction, UFModel>& _functions) const;
+    };
+}
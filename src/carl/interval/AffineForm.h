@@ -0,0 +1,249 @@
+/**
+ * @file AffineForm.h
+ *
+ * Affine arithmetic over doubles.
+ */
+
+#pragma once
+
+#include "Interval.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace carl
+{
+	/**
+	 * An affine form `x_0 + x_1 e_1 + ... + x_n e_n + r e_*` that represents the set of values it
+	 * takes for all noise symbols `e_i` ranging over [-1,1].
+	 *
+	 * Noise symbols are shared between forms and hence record linear dependencies, for example
+	 * x - x is exactly zero. Nonlinear remainders and rounding errors are accumulated in the
+	 * radius r of an anonymous noise symbol e_* that is independent of all others.
+	 * Operations round to nearest and account for the rounding error in r, hence the represented
+	 * set always encloses the exact result.
+	 */
+	class AffineForm
+	{
+	public:
+		/// Pairs of noise symbol and coefficient, sorted by symbol.
+		using Terms = std::vector<std::pair<std::size_t, double>>;
+	private:
+		double mCenter = 0;
+		Terms mTerms;
+		double mError = 0;
+
+		/// @return An upper bound on the rounding error of a result of an operation rounded to nearest.
+		static double roundingError(double _result)
+		{
+			return std::abs(_result) * std::numeric_limits<double>::epsilon() + std::numeric_limits<double>::denorm_min();
+		}
+		/// @return An upper bound on the exact value of a sum of _n nonnegative numbers, computed as _sum by rounding to nearest.
+		static double sumBound(double _sum, std::size_t _n)
+		{
+			return std::nextafter(_sum + double(_n) * roundingError(_sum), std::numeric_limits<double>::infinity());
+		}
+		/// Adds a nonnegative amount to the error, rounding upward.
+		void addError(double _error)
+		{
+			mError = std::nextafter(mError + _error, std::numeric_limits<double>::infinity());
+		}
+
+		template<typename Combine>
+		static AffineForm merge(const AffineForm& _lhs, const AffineForm& _rhs, Combine&& _combine);
+
+	public:
+		AffineForm() = default;
+		/**
+		 * Constructs a constant form.
+		 */
+		explicit AffineForm(double _value):
+			mCenter(_value)
+		{}
+		/**
+		 * Constructs a form enclosing the given bounded interval by its center and the error.
+		 * This is used for values that do not depend on any noise symbol, like rounded constants.
+		 */
+		explicit AffineForm(const Interval<double>& _in);
+		/**
+		 * Constructs the form `_center + _radius e_symbol` enclosing the given bounded interval.
+		 * @param _in Interval.
+		 * @param _symbol Noise symbol to represent the interval.
+		 */
+		AffineForm(const Interval<double>& _in, std::size_t _symbol);
+
+		double center() const
+		{
+			return mCenter;
+		}
+		const Terms& terms() const
+		{
+			return mTerms;
+		}
+		double error() const
+		{
+			return mError;
+		}
+		/**
+		 * @return An upper bound on the sum of the absolute values of all coefficients.
+		 */
+		double radius() const;
+
+		/**
+		 * @return The range of this form.
+		 */
+		Interval<double> interval() const;
+
+		/**
+		 * Keeps the given number of terms with the largest coefficients and moves all others into the error.
+		 * @param _maxTerms Maximal number of terms.
+		 */
+		void condense(std::size_t _maxTerms);
+
+		AffineForm operator-() const;
+		AffineForm operator+(const AffineForm& _rhs) const;
+		AffineForm operator-(const AffineForm& _rhs) const;
+		AffineForm operator*(double _rhs) const;
+		AffineForm operator*(const AffineForm& _rhs) const;
+		AffineForm pow(uint _exp) const;
+	};
+
+	inline AffineForm::AffineForm(const Interval<double>& _in):
+		AffineForm(_in, 0)
+	{
+		if (!mTerms.empty()) {
+			mError = mTerms.front().second;
+			mTerms.clear();
+		}
+	}
+
+	inline AffineForm::AffineForm(const Interval<double>& _in, std::size_t _symbol)
+	{
+		assert(!_in.isUnbounded() && !_in.isEmpty());
+		mCenter = _in.lower() / 2 + _in.upper() / 2;
+		double radius = std::max(_in.upper() - mCenter, mCenter - _in.lower());
+		radius = std::nextafter(radius + roundingError(radius), std::numeric_limits<double>::infinity());
+		if (radius > 0) mTerms.emplace_back(_symbol, radius);
+	}
+
+	inline double AffineForm::radius() const
+	{
+		double res = mError;
+		for (const auto& t: mTerms) res += std::abs(t.second);
+		return sumBound(res, mTerms.size() + 1);
+	}
+
+	inline Interval<double> AffineForm::interval() const
+	{
+		double r = radius();
+		double inf = std::numeric_limits<double>::infinity();
+		return Interval<double>(std::nextafter(mCenter - r, -inf), std::nextafter(mCenter + r, inf));
+	}
+
+	inline void AffineForm::condense(std::size_t _maxTerms)
+	{
+		if (mTerms.size() <= _maxTerms) return;
+		std::vector<std::pair<std::size_t, double>> sorted(mTerms);
+		std::nth_element(sorted.begin(), sorted.begin() + long(_maxTerms), sorted.end(),
+			[](const std::pair<std::size_t, double>& a, const std::pair<std::size_t, double>& b){ return std::abs(a.second) > std::abs(b.second); }
+		);
+		double dropped = 0;
+		for (auto it = sorted.begin() + long(_maxTerms); it != sorted.end(); ++it) dropped += std::abs(it->second);
+		addError(sumBound(dropped, sorted.size() - _maxTerms));
+		sorted.resize(_maxTerms);
+		std::sort(sorted.begin(), sorted.end());
+		mTerms = std::move(sorted);
+	}
+
+	template<typename Combine>
+	inline AffineForm AffineForm::merge(const AffineForm& _lhs, const AffineForm& _rhs, Combine&& _combine)
+	{
+		AffineForm res;
+		res.mCenter = _combine(_lhs.mCenter, _rhs.mCenter);
+		double error = roundingError(res.mCenter) + _lhs.mError + _rhs.mError;
+		res.mTerms.reserve(_lhs.mTerms.size() + _rhs.mTerms.size());
+		auto l = _lhs.mTerms.begin();
+		auto r = _rhs.mTerms.begin();
+		while (l != _lhs.mTerms.end() || r != _rhs.mTerms.end()) {
+			if (r == _rhs.mTerms.end() || (l != _lhs.mTerms.end() && l->first < r->first)) {
+				res.mTerms.push_back(*l++);
+			} else if (l == _lhs.mTerms.end() || r->first < l->first) {
+				res.mTerms.emplace_back(r->first, _combine(0.0, r->second));
+				r++;
+			} else {
+				double c = _combine(l->second, r->second);
+				error += roundingError(c);
+				if (c != 0) res.mTerms.emplace_back(l->first, c);
+				l++;
+				r++;
+			}
+		}
+		res.addError(sumBound(error, res.mTerms.size() + 3));
+		return res;
+	}
+
+	inline AffineForm AffineForm::operator-() const
+	{
+		AffineForm res(*this);
+		res.mCenter = -res.mCenter;
+		for (auto& t: res.mTerms) t.second = -t.second;
+		return res;
+	}
+
+	inline AffineForm AffineForm::operator+(const AffineForm& _rhs) const
+	{
+		return merge(*this, _rhs, [](double a, double b){ return a + b; });
+	}
+
+	inline AffineForm AffineForm::operator-(const AffineForm& _rhs) const
+	{
+		return merge(*this, _rhs, [](double a, double b){ return a - b; });
+	}
+
+	inline AffineForm AffineForm::operator*(double _rhs) const
+	{
+		AffineForm res;
+		res.mCenter = mCenter * _rhs;
+		double error = roundingError(res.mCenter) + mError * std::abs(_rhs);
+		res.mTerms.reserve(mTerms.size());
+		for (const auto& t: mTerms) {
+			double c = t.second * _rhs;
+			error += roundingError(c);
+			if (c != 0) res.mTerms.emplace_back(t.first, c);
+		}
+		res.addError(sumBound(error, mTerms.size() + 2));
+		return res;
+	}
+
+	inline AffineForm AffineForm::operator*(const AffineForm& _rhs) const
+	{
+		// x * y = x0 y0 + sum (x0 y_i + y0 x_i) e_i + (sum x_i e_i) (sum y_i e_i), the last part is bounded by rad(x) rad(y).
+		AffineForm res = (*this * _rhs.mCenter) + (_rhs * mCenter);
+		res.mCenter = mCenter * _rhs.mCenter;
+		double nonlinear = radius() * _rhs.radius();
+		res.addError(sumBound(roundingError(res.mCenter) + nonlinear + roundingError(nonlinear), 3));
+		return res;
+	}
+
+	inline AffineForm AffineForm::pow(uint _exp) const
+	{
+		AffineForm res(1.0);
+		AffineForm base(*this);
+		while (_exp > 0) {
+			if (_exp % 2 == 1) res = res * base;
+			_exp /= 2;
+			if (_exp > 0) base = base * base;
+		}
+		return res;
+	}
+
+	inline std::ostream& operator<<(std::ostream& os, const AffineForm& _form)
+	{
+		os << _form.center();
+		for (const auto& t: _form.terms()) os << " + " << t.second << "*e" << t.first;
+		return os << " + " << _form.error() << "*e*";
+	}
+}
@@ -0,0 +1,152 @@
+/**
+ * @file BoxSolver.h
+ *
+ * Branch and prune search for solutions of systems of polynomial constraints.
+ */
+
+#pragma once
+
+#include "ICP.h"
+#include "Interval.h"
+#include "IntervalEvaluation.h"
+#include "../core/logging.h"
+#include "../formula/Constraint.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Heuristics to select the variable along which a box is bisected.
+ * Unbounded variables are always bisected first.
+ */
+enum class BoxSplitHeuristic {
+	/// The variable with the widest interval.
+	LARGEST_WIDTH,
+	/// The variable with the largest smear, that is the width of its interval times the magnitude
+	/// of the partial derivative over the box, maximized over all constraints.
+	SMEAR
+};
+
+/**
+ * Settings for BoxSolver.
+ */
+struct BoxSolverSettings {
+	BoxSplitHeuristic heuristic = BoxSplitHeuristic::LARGEST_WIDTH;
+	/// Boxes whose variables are all narrower than this are not bisected any further.
+	double minWidth = 1e-6;
+	/// Maximal number of boxes to process. Boxes beyond this limit are reported as boundary boxes.
+	std::size_t maxBoxes = 100000;
+	/// Maximal size of the work queue that is shared by the workers. If it is full, workers continue depth-first on their own boxes.
+	std::size_t maxQueueSize = 1024;
+	/// Number of worker threads, 0 meaning one per hardware thread.
+	std::size_t threads = 1;
+	/// Stop the search as soon as the first inner box is found.
+	bool stopAtInnerBox = false;
+	/// Settings of the contraction. ICPSettings::maxSplits is ignored.
+	ICPSettings icp;
+};
+
+enum class BoxSolverStatus {
+	/// A point satisfying all constraints was found.
+	SAT,
+	/// The initial box contains no solution.
+	UNSAT,
+	/// Neither of the above.
+	UNKNOWN
+};
+
+template<typename Pol>
+struct BoxSolverResult {
+	using Box = Interval<double>::evalintervalmap;
+	BoxSolverStatus status = BoxSolverStatus::UNKNOWN;
+	/// Boxes in which all constraints hold everywhere.
+	std::vector<Box> inner;
+	/// Boxes that could neither be refuted nor be shown to be inner boxes.
+	std::vector<Box> boundary;
+	/// A point that satisfies all constraints exactly, if the status is SAT.
+	EvaluationMap<typename Pol::NumberType> point;
+	/// The number of boxes processed.
+	std::size_t boxes = 0;
+};
+
+/**
+ * Branch and prune solver for conjunctions of polynomial constraints over a box.
+ *
+ * Every box is contracted by ICP and then checked with Constraint::consistentWith: boxes
+ * where some constraint is violated are discarded, boxes where all constraints hold are
+ * inner boxes. All other boxes are bisected along a variable selected by the heuristic until
+ * they are narrower than BoxSolverSettings::minWidth, in which case they are boundary boxes.
+ * Finally, the centers of the inner and boundary boxes are checked exactly for a solution.
+ *
+ * The boxes are explored by a number of workers that share a bounded work queue. Every worker
+ * owns its ICP engine, such that only read-only data is shared during the search. If the
+ * contraction uses interval Newton, the derivatives are computed on demand; this is only safe
+ * with multiple threads if carl is built with THREAD_SAFE, otherwise Newton is disabled.
+ * With multiple threads, the order of the resulting boxes is not deterministic.
+ */
+template<typename Pol>
+class BoxSolver {
+public:
+	using Box = Interval<double>::evalintervalmap;
+	using Result = BoxSolverResult<Pol>;
+private:
+	/// The state of a search that is shared by all workers.
+	struct Search {
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<Box> queue;
+		/// Number of workers that currently process boxes.
+		std::size_t active = 0;
+		std::atomic<std::size_t> processed;
+		std::atomic<bool> stop;
+		Result result;
+		Search(): processed(0), stop(false) {}
+	};
+
+	BoxSolverSettings mSettings;
+	std::vector<Constraint<Pol>> mConstraints;
+	/// Partial derivatives of the constraints by their variables, indexed like mConstraints.
+	std::vector<std::map<Variable, Pol>> mDerivatives;
+
+	/**
+	 * Checks the constraints on the box.
+	 * @return 0, if some constraint is violated; 1, if all constraints hold; 2, otherwise.
+	 */
+	unsigned check(const Box& _box) const;
+	/// @return The variable to bisect the box along, or _box.end() if it is narrow enough.
+	typename Box::const_iterator select(const Box& _box) const;
+	/// Bisects the box along the given variable into _box and _other.
+	static void bisect(Box& _box, Variable::Arg _var, Box& _other);
+	/// Processes boxes until the search is exhausted or stopped.
+	void work(ICP<Pol>& _icp, Search& _search) const;
+	/// Searches for a point among the boxes of the result that satisfies all constraints.
+	bool certify(Result& _result) const;
+public:
+	explicit BoxSolver(const BoxSolverSettings& _settings = BoxSolverSettings()):
+		mSettings(_settings)
+	{}
+
+	const BoxSolverSettings& settings() const {
+		return mSettings;
+	}
+
+	void addConstraint(const Constraint<Pol>& _constraint);
+
+	/**
+	 * Searches the given box for solutions of all constraints added so far.
+	 * Variables of the constraints that are missing in the box are added as unbounded.
+	 * @param _box The initial bounds.
+	 * @return The inner and boundary boxes, and a certified point if one was found.
+	 */
+	Result solve(const Box& _box) const;
+};
+
+}
+
+#include "BoxSolver.tpp"
@@ -0,0 +1,239 @@
+/**
+ * @file BoxSolver.tpp
+ */
+
+#pragma once
+
+#include "BoxSolver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace carl {
+
+template<typename Pol>
+void BoxSolver<Pol>::addConstraint(const Constraint<Pol>& _constraint) {
+	mConstraints.push_back(_constraint);
+	mDerivatives.emplace_back();
+	if (mSettings.heuristic == BoxSplitHeuristic::SMEAR) {
+		for (Variable v: _constraint.variables()) {
+			mDerivatives.back().emplace(v, _constraint.lhs().derivative(v));
+		}
+	}
+}
+
+template<typename Pol>
+unsigned BoxSolver<Pol>::check(const Box& _box) const {
+	unsigned res = 1;
+	for (const auto& c: mConstraints) {
+		switch (c.consistentWith(_box)) {
+			case 0: return 0;
+			case 1: break;
+			default: res = 2;
+		}
+	}
+	return res;
+}
+
+template<typename Pol>
+typename BoxSolver<Pol>::Box::const_iterator BoxSolver<Pol>::select(const Box& _box) const {
+	auto best = _box.end();
+	double bestScore = 0;
+	double bestWidth = 0;
+	for (auto it = _box.begin(); it != _box.end(); ++it) {
+		const Interval<double>& i = it->second;
+		if (i.isPointInterval()) continue;
+		if (i.isUnbounded()) {
+			if (best == _box.end() || !best->second.isUnbounded()) best = it;
+			continue;
+		}
+		double width = i.diameter();
+		if (it->first.getType() == VariableType::VT_INT ? width < 1 : width <= mSettings.minWidth) continue;
+		if (best != _box.end() && best->second.isUnbounded()) continue;
+		double score = width;
+		if (mSettings.heuristic == BoxSplitHeuristic::SMEAR) {
+			score = 0;
+			for (const auto& derivatives: mDerivatives) {
+				auto d = derivatives.find(it->first);
+				if (d == derivatives.end()) continue;
+				Interval<double> slope = IntervalEvaluation::evaluate(d->second, _box);
+				double magnitude = slope.isUnbounded() ? std::numeric_limits<double>::infinity() : std::max(std::abs(slope.lower()), std::abs(slope.upper()));
+				score = std::max(score, magnitude * width);
+			}
+		}
+		// Ties, for example a smear of zero for all variables, are broken by the width.
+		if (best == _box.end() || score > bestScore || (score == bestScore && width > bestWidth)) {
+			best = it;
+			bestScore = score;
+			bestWidth = width;
+		}
+	}
+	return best;
+}
+
+template<typename Pol>
+void BoxSolver<Pol>::bisect(Box& _box, Variable::Arg _var, Box& _other) {
+	Interval<double>& i = _box[_var];
+	double center = 0;
+	if (!i.isUnbounded()) {
+		center = i.center();
+	} else if (i.lowerBoundType() == BoundType::INFTY && i.upperBoundType() != BoundType::INFTY) {
+		center = i.upper() - std::max(1.0, std::abs(i.upper()));
+	} else if (i.upperBoundType() == BoundType::INFTY && i.lowerBoundType() != BoundType::INFTY) {
+		center = i.lower() + std::max(1.0, std::abs(i.lower()));
+	}
+	Interval<double> lower;
+	Interval<double> upper;
+	if (_var.getType() == VariableType::VT_INT) {
+		// Integral bounds are split such that the halves do not overlap.
+		center = std::floor(center);
+		if (i.upperBoundType() != BoundType::INFTY && center >= i.upper()) center = i.upper() - 1;
+		lower = i.intersect(Interval<double>(center, BoundType::INFTY, center, BoundType::WEAK));
+		upper = i.intersect(Interval<double>(center + 1, BoundType::WEAK, center + 1, BoundType::INFTY));
+	} else {
+		lower = i.intersect(Interval<double>(center, BoundType::INFTY, center, BoundType::WEAK));
+		upper = i.intersect(Interval<double>(center, BoundType::WEAK, center, BoundType::INFTY));
+	}
+	_other = _box;
+	i = upper;
+	_other[_var] = lower;
+}
+
+template<typename Pol>
+void BoxSolver<Pol>::work(ICP<Pol>& _icp, Search& _search) const {
+	std::vector<Box> local;
+	while (true) {
+		if (_search.stop) {
+			std::lock_guard<std::mutex> lock(_search.mutex);
+			for (auto& b: local) _search.result.boundary.push_back(std::move(b));
+			return;
+		}
+		if (local.empty()) {
+			std::unique_lock<std::mutex> lock(_search.mutex);
+			_search.active--;
+			if (_search.active == 0) _search.condition.notify_all();
+			_search.condition.wait(lock, [&_search](){ return _search.stop || !_search.queue.empty() || _search.active == 0; });
+			if (_search.stop || _search.queue.empty()) return;
+			_search.active++;
+			local.push_back(std::move(_search.queue.front()));
+			_search.queue.pop_front();
+		}
+		Box box = std::move(local.back());
+		local.pop_back();
+		if (++_search.processed > mSettings.maxBoxes) {
+			std::lock_guard<std::mutex> lock(_search.mutex);
+			_search.result.boundary.push_back(std::move(box));
+			continue;
+		}
+		if (!_icp.contract(box)) continue;
+		unsigned state = check(box);
+		if (state == 0) continue;
+		if (state == 1) {
+			std::lock_guard<std::mutex> lock(_search.mutex);
+			_search.result.inner.push_back(std::move(box));
+			if (mSettings.stopAtInnerBox) {
+				_search.stop = true;
+				_search.condition.notify_all();
+			}
+			continue;
+		}
+		auto var = select(box);
+		if (var == box.end()) {
+			std::lock_guard<std::mutex> lock(_search.mutex);
+			_search.result.boundary.push_back(std::move(box));
+			continue;
+		}
+		Box other;
+		bisect(box, var->first, other);
+		local.push_back(std::move(box));
+		if (mSettings.threads != 1) {
+			// Share one half if there is room in the queue.
+			std::lock_guard<std::mutex> lock(_search.mutex);
+			if (_search.queue.size() < mSettings.maxQueueSize) {
+				_search.queue.push_back(std::move(other));
+				_search.condition.notify_one();
+				continue;
+			}
+		}
+		local.push_back(std::move(other));
+	}
+}
+
+template<typename Pol>
+bool BoxSolver<Pol>::certify(Result& _result) const {
+	using Number = typename Pol::NumberType;
+	for (const auto* boxes: {&_result.inner, &_result.boundary}) {
+		for (const Box& box: *boxes) {
+			EvaluationMap<Number> point;
+			for (const auto& i: box) {
+				double value = 0;
+				if (!i.second.isUnbounded()) {
+					value = i.second.center();
+				} else if (i.second.lowerBoundType() != BoundType::INFTY) {
+					value = std::max(0.0, i.second.lower());
+				} else if (i.second.upperBoundType() != BoundType::INFTY) {
+					value = std::min(0.0, i.second.upper());
+				}
+				if (i.first.getType() == VariableType::VT_INT) {
+					value = std::ceil(value);
+					if (!i.second.contains(value)) value = std::floor(value);
+				}
+				point.emplace(i.first, carl::rationalize<Number>(value));
+			}
+			bool satisfied = std::all_of(mConstraints.begin(), mConstraints.end(), [&point](const Constraint<Pol>& c){ return c.satisfiedBy(point) == 1; });
+			if (satisfied) {
+				_result.point = std::move(point);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+template<typename Pol>
+typename BoxSolver<Pol>::Result BoxSolver<Pol>::solve(const Box& _box) const {
+	std::size_t threads = mSettings.threads;
+	if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+	ICPSettings icpSettings = mSettings.icp;
+#ifndef THREAD_SAFE
+	if (threads > 1 && icpSettings.useNewton) {
+		CARL_LOG_WARN("carl.interval.boxsolver", "Interval Newton is disabled for multiple threads, as carl is not thread safe.");
+		icpSettings.useNewton = false;
+	}
+#endif
+	// The engines are set up here, as adding constraints modifies the global pools.
+	std::vector<ICP<Pol>> engines;
+	engines.reserve(threads);
+	for (std::size_t t = 0; t < threads; t++) {
+		engines.emplace_back(icpSettings);
+		for (const auto& c: mConstraints) engines.back().addConstraint(c.lhs(), c.relation());
+	}
+
+	Search search;
+	search.queue.push_back(_box);
+	search.active = threads;
+	if (threads == 1) {
+		work(engines.front(), search);
+	} else {
+		std::vector<std::thread> workers;
+		for (std::size_t t = 0; t < threads; t++) {
+			workers.emplace_back([this, &engines, &search, t](){ work(engines[t], search); });
+		}
+		for (auto& w: workers) w.join();
+	}
+	Result& result = search.result;
+	// Boxes that are left after the search was stopped early were not refuted.
+	for (auto& b: search.queue) result.boundary.push_back(std::move(b));
+	result.boxes = std::min(search.processed.load(), mSettings.maxBoxes);
+	if (certify(result)) {
+		result.status = BoxSolverStatus::SAT;
+	} else if (result.inner.empty() && result.boundary.empty()) {
+		result.status = BoxSolverStatus::UNSAT;
+	}
+	CARL_LOG_DEBUG("carl.interval.boxsolver", "Processed " << result.boxes << " boxes: " << result.inner.size() << " inner, " << result.boundary.size() << " boundary");
+	return std::move(result);
+}
+
+}
@@ -8,12 +8,11 @@
 #pragma once
 #include "Interval.h"
 #include "../core/Sign.h"
-#include "../core/MultivariateHorner.h"
+#include "../core/FlatHorner.h"
 #include "IntervalEvaluation.h"
 #include <algorithm>
 
 //#define CONTRACTION_DEBUG
-//#define USE_HORNER
 
 namespace carl {
     
@@ -234,13 +233,13 @@ namespace carl {
         Polynomial mConstraint; // Todo: Should be a reference.
         Polynomial* mpOriginal;
         #ifdef USE_HORNER
-        MultivariateHorner<Polynomial, strategy> mHornerForm;
-        std::map<Variable, MultivariateHorner<Polynomial,strategy>> mDerivatives;
+        /// Horner schemes are shared with all other contractions through the FlatHornerPool.
+        std::shared_ptr<const FlatHorner<Polynomial, strategy>> mHornerForm;
+        std::map<Variable, std::shared_ptr<const FlatHorner<Polynomial, strategy>>> mDerivatives;
         #else
         std::map<Variable, Polynomial> mDerivatives;
         #endif
         std::map<Variable, VarSolutionFormula<Polynomial>> mVarSolutionFormulas;
-        std::map<Polynomial, MultivariateHorner<Polynomial,strategy>> mHornerSchemes;
 
     public:
         Contraction() = delete;
@@ -249,11 +248,10 @@ namespace carl {
             mConstraint(constraint),
             mpOriginal(nullptr),
             #ifdef USE_HORNER
-            mHornerForm(constraint),
+            mHornerForm(FlatHornerPool<Polynomial, strategy>::getInstance().get(constraint)),
             #endif
             mDerivatives(),
-            mVarSolutionFormulas(),
-			mHornerSchemes()
+            mVarSolutionFormulas()
         {}
 
         Contraction(const Polynomial& constraint, const Polynomial& _original ):
@@ -261,11 +259,10 @@ namespace carl {
             mConstraint(constraint),
             mpOriginal (_original.isLinear() ? nullptr : new Polynomial(_original)),
             #ifdef USE_HORNER
-            mHornerForm( mpOriginal == nullptr ? constraint :  _original ),
+            mHornerForm(FlatHornerPool<Polynomial, strategy>::getInstance().get(mpOriginal == nullptr ? constraint : _original)),
             #endif
             mDerivatives(),
-            mVarSolutionFormulas() ,
-			mHornerSchemes()
+            mVarSolutionFormulas()
         {}
         Contraction(const Contraction&) = delete;
         
@@ -277,8 +274,7 @@ namespace carl {
             mHornerForm(std::move(_contraction.mHornerForm)),
             #endif
             mDerivatives(std::move(_contraction.mDerivatives)),
-            mVarSolutionFormulas(std::move(_contraction.mVarSolutionFormulas)),
-			mHornerSchemes(std::move(_contraction.mHornerSchemes))
+            mVarSolutionFormulas(std::move(_contraction.mVarSolutionFormulas))
         {
             _contraction.mpOriginal = nullptr;
         }
@@ -303,7 +299,7 @@ namespace carl {
             if( !usePropagation || mpOriginal == nullptr || !mConstraint.isLinear() )
             {
                 #ifdef USE_HORNER
-                typename std::map<Variable, MultivariateHorner<Polynomial,strategy>>::const_iterator it = mDerivatives.find(variable);
+                auto it = mDerivatives.find(variable);
                 #else
                 typename std::map<Variable, Polynomial>::const_iterator it = mDerivatives.find(variable);
                 #endif
@@ -312,10 +308,11 @@ namespace carl {
                 {
                     #ifdef USE_HORNER
                     //Deriviate and convert to Horner
+                    auto& pool = FlatHornerPool<Polynomial, strategy>::getInstance();
                     if( mpOriginal == nullptr )
-                        it = mDerivatives.emplace(variable, std::move(MultivariateHorner<Polynomial, strategy>( mConstraint.derivative(variable)))).first;
+                        it = mDerivatives.emplace(variable, pool.get(mConstraint.derivative(variable))).first;
                     else
-                        it = mDerivatives.emplace(variable, std::move(MultivariateHorner<Polynomial, strategy>( mpOriginal->derivative(variable)))).first;
+                        it = mDerivatives.emplace(variable, pool.get(mpOriginal->derivative(variable))).first;
                     #else
                     if( mpOriginal == nullptr )
                         it = mDerivatives.emplace(variable, mConstraint.derivative(variable)).first;
@@ -329,7 +326,7 @@ namespace carl {
                 #endif
 
                 #ifdef USE_HORNER
-                splitOccurredInContraction = Operator<Polynomial>::contract(intervals, variable, mHornerForm, (*it).second, resA, resB, useNiceCenter);
+                splitOccurredInContraction = Operator<Polynomial>::contract(intervals, variable, *mHornerForm, *(*it).second, resA, resB, useNiceCenter);
                 #else
                 splitOccurredInContraction = Operator<Polynomial>::contract(intervals, variable, (mpOriginal == nullptr ? mConstraint : *mpOriginal), (*it).second, resA, resB, useNiceCenter);
                 #endif
@@ -0,0 +1,173 @@
+/**
+ * @file ICP.h
+ *
+ * Interval constraint propagation over a set of polynomial constraints.
+ */
+
+#pragma once
+
+#include "Contraction.h"
+#include "Interval.h"
+#include "../core/MultivariatePolynomial.h"
+#include "../core/Relation.h"
+#include "../core/logging.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Settings for ICP.
+ */
+struct ICPSettings {
+	/// A variable is considered to be contracted, if its width shrinks by more than this fraction.
+	double relativeWidth = 0.01;
+	/// Maximal number of constraint revisions per call to ICP::contract().
+	std::size_t maxRevisions = 10000;
+	/// Additionally apply interval Newton (SimpleNewton) to equations.
+	bool useNewton = false;
+	/// Maximal number of splits performed by ICP::split().
+	std::size_t maxSplits = 0;
+	/// Boxes whose variables are all narrower than this are not split any further.
+	double minWidth = 1e-6;
+};
+
+/**
+ * Interval constraint propagation engine.
+ *
+ * Every constraint `p ~ 0` is represented as an expression DAG of sums, products of powers and
+ * variables that is shared between all constraints. A constraint is revised by HC4Revise: its
+ * DAG is evaluated forward over the current box, the root is intersected with the set of
+ * values allowed by the relation and the result is projected backward onto the variables.
+ * Constraints are revised from a queue until no variable is contracted significantly anymore;
+ * contracting a variable enqueues all constraints it occurs in.
+ * Optionally, equations are additionally contracted by the interval Newton operator of
+ * Contraction, and the box is split to refine the result.
+ */
+template<typename Pol>
+class ICP {
+public:
+	using Box = Interval<double>::evalintervalmap;
+private:
+	enum class NodeType { VARIABLE, POWER, PRODUCT, SUM };
+
+	/// A node of the expression DAG. Children always have smaller indices than their parents.
+	struct Node {
+		NodeType type;
+		/// The variable of a VARIABLE node.
+		Variable var;
+		/// The exponent of a POWER node.
+		uint exponent = 1;
+		/// The constant part of a SUM node.
+		Interval<double> constant = Interval<double>(0);
+		/// The children of POWER, PRODUCT and SUM nodes.
+		std::vector<std::size_t> children;
+		/// The coefficients of the children of a SUM node.
+		std::vector<Interval<double>> coefficients;
+		/// The current value during a revision.
+		Interval<double> value;
+		Node(NodeType t): type(t) {}
+	};
+
+	struct ICPConstraint {
+		Pol polynomial;
+		Relation relation;
+		/// The root node of the DAG.
+		std::size_t root;
+		/// All nodes of the DAG of this constraint in topological order.
+		std::vector<std::size_t> nodes;
+		/// The variables of this constraint.
+		std::vector<Variable> variables;
+		/// Newton contraction for equations, if enabled.
+		std::unique_ptr<Contraction<SimpleNewton, Pol>> newton;
+	};
+
+	ICPSettings mSettings;
+	std::vector<Node> mNodes;
+	std::vector<ICPConstraint> mConstraints;
+	std::map<Variable, std::size_t> mVariableNodes;
+	std::map<std::pair<Variable, uint>, std::size_t> mPowerNodes;
+	std::unordered_map<Monomial::Arg, std::size_t> mMonomialNodes;
+	/// For each variable, the constraints it occurs in.
+	std::map<Variable, std::vector<std::size_t>> mOccurrences;
+	std::size_t mRevisions = 0;
+	std::size_t mSplits = 0;
+
+	std::size_t variableNode(Variable::Arg _var);
+	std::size_t powerNode(Variable::Arg _var, uint _exp);
+	std::size_t monomialNode(const Monomial::Arg& _monomial);
+	/// Collects the nodes reachable from the given node in topological order.
+	void collect(std::size_t _node, std::vector<bool>& _visited, std::vector<std::size_t>& _nodes) const;
+
+	/// @return The set of values a polynomial may take such that the relation holds.
+	static Interval<double> target(Relation _rel);
+	/// Intersects the given interval with a union of two intervals and returns the hull of the result.
+	static Interval<double> intersectHull(const Interval<double>& _in, const Interval<double>& _a, const Interval<double>& _b);
+	/// Checks whether the width of the variable shrinks significantly from _old to _new.
+	bool significant(const Interval<double>& _old, const Interval<double>& _new) const;
+
+	void forward(const ICPConstraint& _constraint, const Box& _box);
+	/// Projects the value of the given node onto its children. @return false, if a child becomes empty.
+	bool backward(const Node& _node);
+	/**
+	 * Revises the box by the given constraint.
+	 * @param _constraint The constraint.
+	 * @param _box The box.
+	 * @param _contracted Variables that were contracted significantly.
+	 * @return false, if the box was found to be empty.
+	 */
+	bool revise(ICPConstraint& _constraint, Box& _box, std::vector<Variable>& _contracted);
+	/// Intersects the domain of a variable with the given interval and records whether it shrinks.
+	bool narrow(Variable::Arg _var, Interval<double> _in, Box& _box, std::vector<Variable>& _contracted) const;
+
+public:
+	explicit ICP(const ICPSettings& _settings = ICPSettings()):
+		mSettings(_settings)
+	{}
+
+	const ICPSettings& settings() const {
+		return mSettings;
+	}
+
+	/**
+	 * Adds the constraint `_pol ~ 0`.
+	 * @param _pol Polynomial.
+	 * @param _rel Relation.
+	 */
+	void addConstraint(const Pol& _pol, Relation _rel);
+
+	/**
+	 * Contracts the box over all constraints until a fixpoint is reached.
+	 * Variables of the constraints that are missing in the box are added as unbounded.
+	 * @param _box The box to contract.
+	 * @return false, if the box contains no solution.
+	 */
+	bool contract(Box& _box);
+
+	/**
+	 * Contracts the box and splits it along its widest variable, searching depth-first for a box
+	 * that is narrower than ICPSettings::minWidth in every variable, until the number of splits
+	 * reaches ICPSettings::maxSplits.
+	 * @param _box The box to refine. Is set to the last box that could not be refuted.
+	 * @return false, if the box contains no solution.
+	 */
+	bool split(Box& _box);
+
+	/// @return The number of constraint revisions performed so far.
+	std::size_t revisions() const {
+		return mRevisions;
+	}
+	/// @return The number of splits performed so far.
+	std::size_t splits() const {
+		return mSplits;
+	}
+};
+
+}
+
+#include "ICP.tpp"
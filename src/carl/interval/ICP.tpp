@@ -0,0 +1,348 @@
+/**
+ * @file ICP.tpp
+ */
+
+#pragma once
+
+#include "ICP.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace carl {
+
+template<typename Pol>
+std::size_t ICP<Pol>::variableNode(Variable::Arg _var) {
+	auto it = mVariableNodes.find(_var);
+	if (it != mVariableNodes.end()) return it->second;
+	mNodes.emplace_back(NodeType::VARIABLE);
+	mNodes.back().var = _var;
+	return mVariableNodes.emplace(_var, mNodes.size() - 1).first->second;
+}
+
+template<typename Pol>
+std::size_t ICP<Pol>::powerNode(Variable::Arg _var, uint _exp) {
+	if (_exp == 1) return variableNode(_var);
+	auto key = std::make_pair(Variable(_var), _exp);
+	auto it = mPowerNodes.find(key);
+	if (it != mPowerNodes.end()) return it->second;
+	std::size_t child = variableNode(_var);
+	mNodes.emplace_back(NodeType::POWER);
+	mNodes.back().exponent = _exp;
+	mNodes.back().children.push_back(child);
+	return mPowerNodes.emplace(key, mNodes.size() - 1).first->second;
+}
+
+template<typename Pol>
+std::size_t ICP<Pol>::monomialNode(const Monomial::Arg& _monomial) {
+	assert(_monomial != nullptr);
+	if (_monomial->nrVariables() == 1) {
+		return powerNode(_monomial->begin()->first, _monomial->begin()->second);
+	}
+	auto it = mMonomialNodes.find(_monomial);
+	if (it != mMonomialNodes.end()) return it->second;
+	std::vector<std::size_t> children;
+	for (const auto& ve: *_monomial) children.push_back(powerNode(ve.first, ve.second));
+	mNodes.emplace_back(NodeType::PRODUCT);
+	mNodes.back().children = std::move(children);
+	return mMonomialNodes.emplace(_monomial, mNodes.size() - 1).first->second;
+}
+
+template<typename Pol>
+void ICP<Pol>::collect(std::size_t _node, std::vector<bool>& _visited, std::vector<std::size_t>& _nodes) const {
+	if (_visited[_node]) return;
+	_visited[_node] = true;
+	for (std::size_t child: mNodes[_node].children) collect(child, _visited, _nodes);
+	_nodes.push_back(_node);
+}
+
+template<typename Pol>
+Interval<double> ICP<Pol>::target(Relation _rel) {
+	// Strict relations are relaxed to their weak counterparts.
+	switch (_rel) {
+		case Relation::EQ:
+			return Interval<double>(0);
+		case Relation::LESS:
+		case Relation::LEQ:
+			return Interval<double>(0.0, BoundType::INFTY, 0.0, BoundType::WEAK);
+		case Relation::GREATER:
+		case Relation::GEQ:
+			return Interval<double>(0.0, BoundType::WEAK, 0.0, BoundType::INFTY);
+		default:
+			return Interval<double>::unboundedInterval();
+	}
+}
+
+template<typename Pol>
+Interval<double> ICP<Pol>::intersectHull(const Interval<double>& _in, const Interval<double>& _a, const Interval<double>& _b) {
+	Interval<double> a = _in.intersect(_a);
+	Interval<double> b = _in.intersect(_b);
+	if (a.isEmpty()) return b;
+	if (b.isEmpty()) return a;
+	return a.convexHull(b);
+}
+
+template<typename Pol>
+bool ICP<Pol>::significant(const Interval<double>& _old, const Interval<double>& _new) const {
+	if ((_old.lowerBoundType() == BoundType::INFTY) != (_new.lowerBoundType() == BoundType::INFTY)) return true;
+	if ((_old.upperBoundType() == BoundType::INFTY) != (_new.upperBoundType() == BoundType::INFTY)) return true;
+	if (_old.isInfinite()) return false;
+	if (_old.isHalfBounded()) {
+		// Without a width, compare the finite bound relative to its magnitude.
+		double o = _old.lowerBoundType() == BoundType::INFTY ? _old.upper() : _old.lower();
+		double n = _new.lowerBoundType() == BoundType::INFTY ? _new.upper() : _new.lower();
+		return std::abs(o - n) > mSettings.relativeWidth * std::max(1.0, std::abs(o));
+	}
+	return _old.diameter() - _new.diameter() > mSettings.relativeWidth * _old.diameter();
+}
+
+template<typename Pol>
+void ICP<Pol>::forward(const ICPConstraint& _constraint, const Box& _box) {
+	for (std::size_t id: _constraint.nodes) {
+		Node& node = mNodes[id];
+		switch (node.type) {
+			case NodeType::VARIABLE:
+				node.value = _box.at(node.var);
+				break;
+			case NodeType::POWER:
+				node.value = mNodes[node.children.front()].value.pow(node.exponent);
+				break;
+			case NodeType::PRODUCT:
+				node.value = mNodes[node.children.front()].value;
+				for (std::size_t i = 1; i < node.children.size(); i++) {
+					node.value = node.value * mNodes[node.children[i]].value;
+				}
+				break;
+			case NodeType::SUM:
+				node.value = node.constant;
+				for (std::size_t i = 0; i < node.children.size(); i++) {
+					node.value = node.value + node.coefficients[i] * mNodes[node.children[i]].value;
+				}
+				break;
+		}
+	}
+}
+
+template<typename Pol>
+bool ICP<Pol>::backward(const Node& _node) {
+	std::size_t size = _node.children.size();
+	switch (_node.type) {
+		case NodeType::VARIABLE:
+			return true;
+		case NodeType::POWER: {
+			Node& child = mNodes[_node.children.front()];
+			Interval<double> root = _node.value.root(int(_node.exponent));
+			if (_node.exponent % 2 == 0) {
+				if (root.isEmpty()) return false;
+				child.value = intersectHull(child.value, root, -root);
+			} else {
+				child.value = child.value.intersect(root);
+			}
+			return !child.value.isEmpty();
+		}
+		case NodeType::PRODUCT: {
+			// prefix[i] is the product of the first i children, suffix[i] of all children from i on.
+			std::vector<Interval<double>> prefix(size + 1, Interval<double>(1));
+			std::vector<Interval<double>> suffix(size + 1, Interval<double>(1));
+			for (std::size_t i = 0; i < size; i++) prefix[i + 1] = prefix[i] * mNodes[_node.children[i]].value;
+			for (std::size_t i = size; i > 0; i--) suffix[i - 1] = suffix[i] * mNodes[_node.children[i - 1]].value;
+			for (std::size_t i = 0; i < size; i++) {
+				Node& child = mNodes[_node.children[i]];
+				Interval<double> others = prefix[i] * suffix[i + 1];
+				if (others.isZero()) {
+					if (!_node.value.contains(0.0)) return false;
+					continue;
+				}
+				Interval<double> a;
+				Interval<double> b;
+				if (_node.value.div_ext(others, a, b)) {
+					child.value = intersectHull(child.value, a, b);
+				} else {
+					child.value = child.value.intersect(a);
+				}
+				if (child.value.isEmpty()) return false;
+			}
+			return true;
+		}
+		case NodeType::SUM: {
+			std::vector<Interval<double>> terms;
+			terms.reserve(size);
+			for (std::size_t i = 0; i < size; i++) terms.push_back(_node.coefficients[i] * mNodes[_node.children[i]].value);
+			std::vector<Interval<double>> prefix(size + 1, _node.constant);
+			std::vector<Interval<double>> suffix(size + 1, Interval<double>(0));
+			for (std::size_t i = 0; i < size; i++) prefix[i + 1] = prefix[i] + terms[i];
+			for (std::size_t i = size; i > 0; i--) suffix[i - 1] = suffix[i] + terms[i - 1];
+			for (std::size_t i = 0; i < size; i++) {
+				Node& child = mNodes[_node.children[i]];
+				Interval<double> rest = _node.value - (prefix[i] + suffix[i + 1]);
+				Interval<double> a;
+				Interval<double> b;
+				if (rest.div_ext(_node.coefficients[i], a, b)) {
+					child.value = intersectHull(child.value, a, b);
+				} else {
+					child.value = child.value.intersect(a);
+				}
+				if (child.value.isEmpty()) return false;
+			}
+			return true;
+		}
+	}
+	return true;
+}
+
+template<typename Pol>
+bool ICP<Pol>::narrow(Variable::Arg _var, Interval<double> _in, Box& _box, std::vector<Variable>& _contracted) const {
+	if (_var.getType() == VariableType::VT_INT) _in = _in.integralPart();
+	Interval<double>& domain = _box[_var];
+	Interval<double> narrowed = domain.intersect(_in);
+	if (narrowed.isEmpty()) {
+		domain = narrowed;
+		return false;
+	}
+	if (significant(domain, narrowed)) _contracted.push_back(_var);
+	domain = narrowed;
+	return true;
+}
+
+template<typename Pol>
+bool ICP<Pol>::revise(ICPConstraint& _constraint, Box& _box, std::vector<Variable>& _contracted) {
+	mRevisions++;
+	forward(_constraint, _box);
+	Node& root = mNodes[_constraint.root];
+	if (_constraint.relation == Relation::NEQ) {
+		return !root.value.isZero();
+	}
+	root.value = root.value.intersect(target(_constraint.relation));
+	if (root.value.isEmpty()) return false;
+	for (auto it = _constraint.nodes.rbegin(); it != _constraint.nodes.rend(); ++it) {
+		if (!backward(mNodes[*it])) return false;
+	}
+	for (std::size_t id: _constraint.nodes) {
+		const Node& node = mNodes[id];
+		if (node.type != NodeType::VARIABLE) continue;
+		if (!narrow(node.var, node.value, _box, _contracted)) return false;
+	}
+	if (_constraint.newton) {
+		for (Variable v: _constraint.variables) {
+			Interval<double> resA;
+			Interval<double> resB;
+			bool splitOccurred = (*_constraint.newton)(_box, v, resA, resB);
+			Interval<double> res = splitOccurred ? intersectHull(_box.at(v), resA, resB) : resA;
+			if (!narrow(v, res, _box, _contracted)) return false;
+		}
+	}
+	return true;
+}
+
+template<typename Pol>
+void ICP<Pol>::addConstraint(const Pol& _pol, Relation _rel) {
+	Node sum(NodeType::SUM);
+	for (const auto& t: _pol) {
+		if (t.isConstant()) {
+			sum.constant = sum.constant + Interval<double>(t.coeff());
+		} else {
+			sum.children.push_back(monomialNode(t.monomial()));
+			sum.coefficients.emplace_back(t.coeff());
+		}
+	}
+	mNodes.push_back(std::move(sum));
+
+	mConstraints.emplace_back();
+	ICPConstraint& c = mConstraints.back();
+	c.polynomial = _pol;
+	c.relation = _rel;
+	c.root = mNodes.size() - 1;
+	std::vector<bool> visited(mNodes.size(), false);
+	collect(c.root, visited, c.nodes);
+	for (std::size_t id: c.nodes) {
+		if (mNodes[id].type != NodeType::VARIABLE) continue;
+		c.variables.push_back(mNodes[id].var);
+		mOccurrences[mNodes[id].var].push_back(mConstraints.size() - 1);
+	}
+	if (mSettings.useNewton && _rel == Relation::EQ && !c.variables.empty()) {
+		c.newton.reset(new Contraction<SimpleNewton, Pol>(_pol));
+	}
+	CARL_LOG_DEBUG("carl.interval.icp", "Added " << _pol << " " << _rel << " 0 with " << c.nodes.size() << " nodes");
+}
+
+template<typename Pol>
+bool ICP<Pol>::contract(Box& _box) {
+	for (const auto& occ: mOccurrences) {
+		if (_box.find(occ.first) == _box.end()) _box.emplace(occ.first, Interval<double>::unboundedInterval());
+	}
+	for (const auto& i: _box) {
+		if (i.second.isEmpty()) return false;
+	}
+	std::deque<std::size_t> queue;
+	std::vector<bool> queued(mConstraints.size(), true);
+	for (std::size_t i = 0; i < mConstraints.size(); i++) queue.push_back(i);
+	std::vector<Variable> contracted;
+	std::size_t revisions = 0;
+	while (!queue.empty() && revisions < mSettings.maxRevisions) {
+		std::size_t c = queue.front();
+		queue.pop_front();
+		queued[c] = false;
+		revisions++;
+		contracted.clear();
+		if (!revise(mConstraints[c], _box, contracted)) {
+			CARL_LOG_DEBUG("carl.interval.icp", "Box is empty after " << revisions << " revisions");
+			return false;
+		}
+		for (Variable v: contracted) {
+			for (std::size_t o: mOccurrences[v]) {
+				if (queued[o]) continue;
+				queued[o] = true;
+				queue.push_back(o);
+			}
+		}
+	}
+	CARL_LOG_DEBUG("carl.interval.icp", "Fixpoint " << (queue.empty() ? "reached" : "not reached") << " after " << revisions << " revisions");
+	return true;
+}
+
+template<typename Pol>
+bool ICP<Pol>::split(Box& _box) {
+	std::vector<Box> stack({_box});
+	std::size_t splits = 0;
+	while (!stack.empty()) {
+		Box box = std::move(stack.back());
+		stack.pop_back();
+		if (!contract(box)) continue;
+		// Split unbounded variables first, then the widest one.
+		auto widest = box.end();
+		for (auto it = box.begin(); it != box.end(); ++it) {
+			const Interval<double>& i = it->second;
+			if (i.isPointInterval() || (!i.isUnbounded() && i.diameter() <= mSettings.minWidth)) continue;
+			if (widest == box.end()) {
+				widest = it;
+			} else if (!widest->second.isUnbounded() && (i.isUnbounded() || i.diameter() > widest->second.diameter())) {
+				widest = it;
+			}
+		}
+		if (widest == box.end() || splits == mSettings.maxSplits) {
+			_box = std::move(box);
+			return true;
+		}
+		splits++;
+		mSplits++;
+		const Interval<double>& i = widest->second;
+		double center = 0;
+		if (!i.isUnbounded()) {
+			center = i.center();
+		} else if (i.lowerBoundType() == BoundType::INFTY && i.upperBoundType() != BoundType::INFTY) {
+			center = i.upper() - std::max(1.0, std::abs(i.upper()));
+		} else if (i.upperBoundType() == BoundType::INFTY && i.lowerBoundType() != BoundType::INFTY) {
+			center = i.lower() + std::max(1.0, std::abs(i.lower()));
+		}
+		Interval<double> lower = widest->second.intersect(Interval<double>(center, BoundType::INFTY, center, BoundType::WEAK));
+		Interval<double> upper = widest->second.intersect(Interval<double>(center, BoundType::WEAK, center, BoundType::INFTY));
+		Box other = box;
+		widest->second = upper;
+		other[widest->first] = lower;
+		stack.push_back(std::move(box));
+		stack.push_back(std::move(other));
+	}
+	return false;
+}
+
+}
@@ -31,7 +31,9 @@
 #include "../util/SFINAE.h"
 #include "BoundType.h"
 #include "checking.h"
+#include "config.h"
 #include "rounding.h"
+#include "RoundingScope.h"
 
 CLANG_WARNING_DISABLE("-Wunused-parameter")
 CLANG_WARNING_DISABLE("-Wunused-local-typedef")
@@ -101,7 +103,12 @@ namespace carl
     template<>
     struct policies<double>
     {
+#ifdef SCOPED_INTERVAL_ROUNDING
+        /// Rounds upward with negated lower bounds, the rounding mode is set per operation or once per IntervalRoundingScope.
+        using roundingP = rounding_double;
+#else
         using roundingP = boost::numeric::interval_lib::save_state<boost::numeric::interval_lib::rounded_transc_std<double> >; // TODO: change it to boost::numeric::interval_lib::rounded_transc_opp, if new boost release patches the bug with clang
+#endif
         using checkingP = boost::numeric::interval_lib::checking_no_nan<double, boost::numeric::interval_lib::checking_no_nan<double> >;
     };
 
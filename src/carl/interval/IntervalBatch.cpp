@@ -0,0 +1,332 @@
+/**
+ * @file IntervalBatch.cpp
+ */
+
+#include "IntervalBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CARL_INTERVAL_BATCH_AVX2
+#include <immintrin.h>
+#endif
+
+namespace carl
+{
+	void IntervalBatch::set(std::size_t variable, std::size_t box, const Interval<double>& i)
+	{
+		assert(variable < mVariables && box < mSize);
+		std::size_t pos = variable * mSize + box;
+		if (i.isEmpty()) {
+			mLower[pos] = std::numeric_limits<double>::quiet_NaN();
+			mUpper[pos] = std::numeric_limits<double>::quiet_NaN();
+			return;
+		}
+		mLower[pos] = i.lowerBoundType() == BoundType::INFTY ? -std::numeric_limits<double>::infinity() : i.lower();
+		mUpper[pos] = i.upperBoundType() == BoundType::INFTY ? std::numeric_limits<double>::infinity() : i.upper();
+	}
+
+	Interval<double> IntervalBatch::get(std::size_t variable, std::size_t box) const
+	{
+		assert(variable < mVariables && box < mSize);
+		double l = mLower[variable * mSize + box];
+		double u = mUpper[variable * mSize + box];
+		if (std::isnan(l) || std::isnan(u)) return Interval<double>::emptyInterval();
+		BoundType lt = std::isinf(l) ? BoundType::INFTY : BoundType::WEAK;
+		BoundType ut = std::isinf(u) ? BoundType::INFTY : BoundType::WEAK;
+		return Interval<double>(lt == BoundType::INFTY ? 0.0 : l, lt, ut == BoundType::INFTY ? 0.0 : u, ut);
+	}
+
+	namespace
+	{
+		constexpr double EPSILON = std::numeric_limits<double>::epsilon();
+		constexpr double TINY = std::numeric_limits<double>::denorm_min();
+
+		// A rounded sum is off by less than an ulp of the result, which is at most |r| * EPSILON,
+		// and exact if the result is subnormal.
+		inline double sumDown(double r) { return r - std::abs(r) * EPSILON; }
+		inline double sumUp(double r) { return r + std::abs(r) * EPSILON; }
+		// A product of k roundings is off by less than |r| * k * EPSILON, or by TINY if it underflowed.
+		inline double productDown(double r, double rel) { return r - std::abs(r) * rel - TINY; }
+		inline double productUp(double r, double rel) { return r + std::abs(r) * rel + TINY; }
+
+		/// m ^ exp by repeated squaring, which takes less than exp roundings.
+		inline double power(double m, uint exp)
+		{
+			double r = 1;
+			while (true) {
+				if (exp & 1) r *= m;
+				exp >>= 1;
+				if (exp == 0) return r;
+				m *= m;
+			}
+		}
+
+		void addScalar(std::size_t n, const double* al, const double* au, const double* bl, const double* bu, double* rl, double* ru)
+		{
+			for (std::size_t i = 0; i < n; i++) {
+				double l = al[i] + bl[i];
+				double u = au[i] + bu[i];
+				rl[i] = sumDown(l);
+				ru[i] = sumUp(u);
+			}
+		}
+
+		void addConstantScalar(std::size_t n, double cl, double cu, double* rl, double* ru)
+		{
+			for (std::size_t i = 0; i < n; i++) {
+				rl[i] = sumDown(rl[i] + cl);
+				ru[i] = sumUp(ru[i] + cu);
+			}
+		}
+
+		void mulScalar(std::size_t n, const double* al, const double* au, const double* bl, const double* bu, double* rl, double* ru)
+		{
+			for (std::size_t i = 0; i < n; i++) {
+				double p1 = al[i] * bl[i];
+				double p2 = al[i] * bu[i];
+				double p3 = au[i] * bl[i];
+				double p4 = au[i] * bu[i];
+				// NaN if any product is not finite, as min and max may drop NaNs.
+				double poison = (p1 + p2 + p3 + p4) * 0.0;
+				rl[i] = productDown(std::min(std::min(p1, p2), std::min(p3, p4)), EPSILON) + poison;
+				ru[i] = productUp(std::max(std::max(p1, p2), std::max(p3, p4)), EPSILON) + poison;
+			}
+		}
+
+		void powScalar(std::size_t n, const double* al, const double* au, uint exp, double* rl, double* ru)
+		{
+			double rel = double(exp) * EPSILON;
+			for (std::size_t i = 0; i < n; i++) {
+				double l = al[i];
+				double u = au[i];
+				double pl = power(std::abs(l), exp);
+				double pu = power(std::abs(u), exp);
+				double poison = (pl + pu) * 0.0;
+				if (exp % 2 == 1) {
+					rl[i] = (l < 0 ? -productUp(pl, rel) : productDown(pl, rel)) + poison;
+					ru[i] = (u < 0 ? -productDown(pu, rel) : productUp(pu, rel)) + poison;
+				} else if (l >= 0) {
+					rl[i] = std::max(0.0, productDown(pl, rel)) + poison;
+					ru[i] = productUp(pu, rel) + poison;
+				} else if (u <= 0) {
+					rl[i] = std::max(0.0, productDown(pu, rel)) + poison;
+					ru[i] = productUp(pl, rel) + poison;
+				} else {
+					rl[i] = poison;
+					ru[i] = productUp(std::max(pl, pu), rel) + poison;
+				}
+			}
+		}
+
+		template<typename Operation>
+		void applyScalar(std::size_t n, const double* a, const double* b, double* r, Operation op)
+		{
+			for (std::size_t i = 0; i < n; i++) {
+				r[i] = op(a[i], b[i]);
+			}
+		}
+
+#ifdef CARL_INTERVAL_BATCH_AVX2
+		// The AVX2 kernels process four boxes at once and leave the remainder to the scalar kernels.
+		#define CARL_AVX2 __attribute__((target("avx2")))
+
+		CARL_AVX2 inline __m256d abs4(__m256d x) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x); }
+		CARL_AVX2 inline __m256d sumDown4(__m256d r) { return _mm256_sub_pd(r, _mm256_mul_pd(abs4(r), _mm256_set1_pd(EPSILON))); }
+		CARL_AVX2 inline __m256d sumUp4(__m256d r) { return _mm256_add_pd(r, _mm256_mul_pd(abs4(r), _mm256_set1_pd(EPSILON))); }
+		CARL_AVX2 inline __m256d productDown4(__m256d r, __m256d rel) {
+			return _mm256_sub_pd(_mm256_sub_pd(r, _mm256_mul_pd(abs4(r), rel)), _mm256_set1_pd(TINY));
+		}
+		CARL_AVX2 inline __m256d productUp4(__m256d r, __m256d rel) {
+			return _mm256_add_pd(_mm256_add_pd(r, _mm256_mul_pd(abs4(r), rel)), _mm256_set1_pd(TINY));
+		}
+		CARL_AVX2 inline __m256d power4(__m256d m, uint exp) {
+			__m256d r = _mm256_set1_pd(1.0);
+			while (true) {
+				if (exp & 1) r = _mm256_mul_pd(r, m);
+				exp >>= 1;
+				if (exp == 0) return r;
+				m = _mm256_mul_pd(m, m);
+			}
+		}
+
+		CARL_AVX2 void addAVX2(std::size_t n, const double* al, const double* au, const double* bl, const double* bu, double* rl, double* ru)
+		{
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				__m256d l = _mm256_add_pd(_mm256_loadu_pd(al + i), _mm256_loadu_pd(bl + i));
+				__m256d u = _mm256_add_pd(_mm256_loadu_pd(au + i), _mm256_loadu_pd(bu + i));
+				_mm256_storeu_pd(rl + i, sumDown4(l));
+				_mm256_storeu_pd(ru + i, sumUp4(u));
+			}
+			addScalar(n - i, al + i, au + i, bl + i, bu + i, rl + i, ru + i);
+		}
+
+		CARL_AVX2 void addConstantAVX2(std::size_t n, double cl, double cu, double* rl, double* ru)
+		{
+			__m256d l = _mm256_set1_pd(cl);
+			__m256d u = _mm256_set1_pd(cu);
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				_mm256_storeu_pd(rl + i, sumDown4(_mm256_add_pd(_mm256_loadu_pd(rl + i), l)));
+				_mm256_storeu_pd(ru + i, sumUp4(_mm256_add_pd(_mm256_loadu_pd(ru + i), u)));
+			}
+			addConstantScalar(n - i, cl, cu, rl + i, ru + i);
+		}
+
+		CARL_AVX2 void mulAVX2(std::size_t n, const double* al, const double* au, const double* bl, const double* bu, double* rl, double* ru)
+		{
+			__m256d rel = _mm256_set1_pd(EPSILON);
+			__m256d zero = _mm256_setzero_pd();
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				__m256d xl = _mm256_loadu_pd(al + i);
+				__m256d xu = _mm256_loadu_pd(au + i);
+				__m256d yl = _mm256_loadu_pd(bl + i);
+				__m256d yu = _mm256_loadu_pd(bu + i);
+				__m256d p1 = _mm256_mul_pd(xl, yl);
+				__m256d p2 = _mm256_mul_pd(xl, yu);
+				__m256d p3 = _mm256_mul_pd(xu, yl);
+				__m256d p4 = _mm256_mul_pd(xu, yu);
+				__m256d poison = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(p1, p2), _mm256_add_pd(p3, p4)), zero);
+				__m256d l = _mm256_min_pd(_mm256_min_pd(p1, p2), _mm256_min_pd(p3, p4));
+				__m256d u = _mm256_max_pd(_mm256_max_pd(p1, p2), _mm256_max_pd(p3, p4));
+				_mm256_storeu_pd(rl + i, _mm256_add_pd(productDown4(l, rel), poison));
+				_mm256_storeu_pd(ru + i, _mm256_add_pd(productUp4(u, rel), poison));
+			}
+			mulScalar(n - i, al + i, au + i, bl + i, bu + i, rl + i, ru + i);
+		}
+
+		CARL_AVX2 void powAVX2(std::size_t n, const double* al, const double* au, uint exp, double* rl, double* ru)
+		{
+			__m256d rel = _mm256_set1_pd(double(exp) * EPSILON);
+			__m256d zero = _mm256_setzero_pd();
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				__m256d l = _mm256_loadu_pd(al + i);
+				__m256d u = _mm256_loadu_pd(au + i);
+				__m256d pl = power4(abs4(l), exp);
+				__m256d pu = power4(abs4(u), exp);
+				__m256d poison = _mm256_mul_pd(_mm256_add_pd(pl, pu), zero);
+				__m256d lower;
+				__m256d upper;
+				if (exp % 2 == 1) {
+					// Odd powers are monotone, negative bounds are handled by their magnitudes.
+					__m256d lneg = _mm256_cmp_pd(l, zero, _CMP_LT_OQ);
+					__m256d uneg = _mm256_cmp_pd(u, zero, _CMP_LT_OQ);
+					lower = _mm256_blendv_pd(productDown4(pl, rel), _mm256_sub_pd(zero, productUp4(pl, rel)), lneg);
+					upper = _mm256_blendv_pd(productUp4(pu, rel), _mm256_sub_pd(zero, productDown4(pu, rel)), uneg);
+				} else {
+					__m256d nonneg = _mm256_cmp_pd(l, zero, _CMP_GE_OQ);
+					__m256d nonpos = _mm256_cmp_pd(u, zero, _CMP_LE_OQ);
+					__m256d small = _mm256_blendv_pd(_mm256_blendv_pd(zero, pu, nonpos), pl, nonneg);
+					__m256d large = _mm256_blendv_pd(_mm256_blendv_pd(_mm256_max_pd(pl, pu), pl, nonpos), pu, nonneg);
+					lower = _mm256_max_pd(zero, productDown4(small, rel));
+					upper = productUp4(large, rel);
+				}
+				_mm256_storeu_pd(rl + i, _mm256_add_pd(lower, poison));
+				_mm256_storeu_pd(ru + i, _mm256_add_pd(upper, poison));
+			}
+			powScalar(n - i, al + i, au + i, exp, rl + i, ru + i);
+		}
+
+		CARL_AVX2 void addDoubleAVX2(std::size_t n, const double* a, const double* b, double* r)
+		{
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				_mm256_storeu_pd(r + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+			}
+			applyScalar(n - i, a + i, b + i, r + i, std::plus<double>());
+		}
+
+		CARL_AVX2 void mulDoubleAVX2(std::size_t n, const double* a, const double* b, double* r)
+		{
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				_mm256_storeu_pd(r + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+			}
+			applyScalar(n - i, a + i, b + i, r + i, std::multiplies<double>());
+		}
+
+		CARL_AVX2 void divDoubleAVX2(std::size_t n, const double* a, const double* b, double* r)
+		{
+			std::size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				_mm256_storeu_pd(r + i, _mm256_div_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+			}
+			applyScalar(n - i, a + i, b + i, r + i, std::divides<double>());
+		}
+
+		#undef CARL_AVX2
+#endif
+	}
+
+	bool IntervalBatchKernels::avx2()
+	{
+#ifdef CARL_INTERVAL_BATCH_AVX2
+		static const bool supported = __builtin_cpu_supports("avx2");
+		return supported;
+#else
+		return false;
+#endif
+	}
+
+	void IntervalBatchKernels::add(std::size_t n, const double* al, const double* au, const double* bl, const double* bu, double* rl, double* ru)
+	{
+#ifdef CARL_INTERVAL_BATCH_AVX2
+		if (avx2()) return addAVX2(n, al, au, bl, bu, rl, ru);
+#endif
+		addScalar(n, al, au, bl, bu, rl, ru);
+	}
+
+	void IntervalBatchKernels::addConstant(std::size_t n, double cl, double cu, double* rl, double* ru)
+	{
+#ifdef CARL_INTERVAL_BATCH_AVX2
+		if (avx2()) return addConstantAVX2(n, cl, cu, rl, ru);
+#endif
+		addConstantScalar(n, cl, cu, rl, ru);
+	}
+
+	void IntervalBatchKernels::mul(std::size_t n, const double* al, const double* au, const double* bl, const double* bu, double* rl, double* ru)
+	{
+#ifdef CARL_INTERVAL_BATCH_AVX2
+		if (avx2()) return mulAVX2(n, al, au, bl, bu, rl, ru);
+#endif
+		mulScalar(n, al, au, bl, bu, rl, ru);
+	}
+
+	void IntervalBatchKernels::pow(std::size_t n, const double* al, const double* au, uint exp, double* rl, double* ru)
+	{
+#ifdef CARL_INTERVAL_BATCH_AVX2
+		if (avx2()) return powAVX2(n, al, au, exp, rl, ru);
+#endif
+		powScalar(n, al, au, exp, rl, ru);
+	}
+
+	void DoubleBatchKernels::add(std::size_t n, const double* a, const double* b, double* r)
+	{
+#ifdef CARL_INTERVAL_BATCH_AVX2
+		if (IntervalBatchKernels::avx2()) return addDoubleAVX2(n, a, b, r);
+#endif
+		applyScalar(n, a, b, r, std::plus<double>());
+	}
+
+	void DoubleBatchKernels::mul(std::size_t n, const double* a, const double* b, double* r)
+	{
+#ifdef CARL_INTERVAL_BATCH_AVX2
+		if (IntervalBatchKernels::avx2()) return mulDoubleAVX2(n, a, b, r);
+#endif
+		applyScalar(n, a, b, r, std::multiplies<double>());
+	}
+
+	void DoubleBatchKernels::div(std::size_t n, const double* a, const double* b, double* r)
+	{
+#ifdef CARL_INTERVAL_BATCH_AVX2
+		if (IntervalBatchKernels::avx2()) return divDoubleAVX2(n, a, b, r);
+#endif
+		applyScalar(n, a, b, r, std::divides<double>());
+	}
+}
@@ -0,0 +1,115 @@
+/**
+ * @file IntervalBatch.h
+ *
+ * Interval arithmetic on double intervals of many boxes at once.
+ */
+
+#pragma once
+
+#include "Interval.h"
+
+#include <vector>
+
+namespace carl
+{
+	/**
+	 * The intervals of some variables in a number of boxes, stored as a structure of arrays:
+	 * for every variable, the lower and the upper bounds of all boxes are stored contiguously.
+	 *
+	 * Bounds are closed, strict bounds are relaxed to weak ones. Infinite bounds are stored as
+	 * infinity and empty intervals as NaN.
+	 */
+	class IntervalBatch
+	{
+	private:
+		std::size_t mVariables;
+		std::size_t mSize;
+		std::vector<double> mLower;
+		std::vector<double> mUpper;
+	public:
+		/**
+		 * Creates a batch of the given number of boxes, where all intervals are zero.
+		 */
+		IntervalBatch(std::size_t variables, std::size_t size):
+			mVariables(variables),
+			mSize(size),
+			mLower(variables * size, 0.0),
+			mUpper(variables * size, 0.0)
+		{}
+
+		/// @return The number of variables.
+		std::size_t variables() const {
+			return mVariables;
+		}
+		/// @return The number of boxes.
+		std::size_t size() const {
+			return mSize;
+		}
+
+		/// @return The lower bounds of the given variable in all boxes.
+		double* lower(std::size_t variable) {
+			return mLower.data() + variable * mSize;
+		}
+		const double* lower(std::size_t variable) const {
+			return mLower.data() + variable * mSize;
+		}
+		/// @return The upper bounds of the given variable in all boxes.
+		double* upper(std::size_t variable) {
+			return mUpper.data() + variable * mSize;
+		}
+		const double* upper(std::size_t variable) const {
+			return mUpper.data() + variable * mSize;
+		}
+
+		/**
+		 * Sets the interval of the given variable in the given box.
+		 */
+		void set(std::size_t variable, std::size_t box, const Interval<double>& i);
+		/**
+		 * @return The interval of the given variable in the given box.
+		 */
+		Interval<double> get(std::size_t variable, std::size_t box) const;
+	};
+
+	/**
+	 * Kernels that apply an operation to the intervals of n boxes, given by arrays of their lower
+	 * and upper bounds. The results may alias the operands.
+	 *
+	 * The bounds are computed in the current rounding mode and then widened by an ulp, which
+	 * encloses the exact results in any rounding mode. This keeps the loops free of rounding mode
+	 * switches and branches, such that they can be vectorized. The results may hence be slightly
+	 * wider than those of the operations on Interval<double>.
+	 * If the CPU supports it, AVX2 is used, regardless of the compiler flags.
+	 *
+	 * Infinite bounds are not supported and may produce NaN or infinite results, which have to be
+	 * handled by the caller.
+	 */
+	struct IntervalBatchKernels
+	{
+		/// r = a + b
+		static void add(std::size_t n, const double* al, const double* au, const double* bl, const double* bu, double* rl, double* ru);
+		/// r = r + [cl, cu]
+		static void addConstant(std::size_t n, double cl, double cu, double* rl, double* ru);
+		/// r = a * b
+		static void mul(std::size_t n, const double* al, const double* au, const double* bl, const double* bu, double* rl, double* ru);
+		/// r = a ^ exp, which is tight for even exponents of intervals containing zero.
+		static void pow(std::size_t n, const double* al, const double* au, uint exp, double* rl, double* ru);
+		/// @return true, if AVX2 kernels are used.
+		static bool avx2();
+	};
+
+	/**
+	 * Kernels that apply an operation to n doubles, given by arrays. The results may alias the operands.
+	 * The results are rounded as by the scalar operations. As for IntervalBatchKernels, AVX2 is used if the
+	 * CPU supports it.
+	 */
+	struct DoubleBatchKernels
+	{
+		/// r = a + b
+		static void add(std::size_t n, const double* a, const double* b, double* r);
+		/// r = a * b
+		static void mul(std::size_t n, const double* a, const double* b, double* r);
+		/// r = a / b
+		static void div(std::size_t n, const double* a, const double* b, double* r);
+	};
+}
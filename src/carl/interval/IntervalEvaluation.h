@@ -8,7 +8,10 @@
 
 
 #pragma once
+#include "AffineForm.h"
 #include "Interval.h"
+#include "IntervalBatch.h"
+#include "MpqIntervalKernels.h"
 
 #include "../core/Monomial.h"
 #include "../core/Term.h"
@@ -23,6 +26,21 @@ namespace carl
 template<typename PolynomialType, class strategy  >
 class MultivariateHorner; 
 
+template<typename PolynomialType, class strategy>
+class FlatHorner;
+
+/**
+ * Strategies to evaluate polynomials over double intervals.
+ */
+enum class IntervalEvaluationStrategy {
+	/// Evaluate term by term in interval arithmetic.
+	NAIVE,
+	/// Evaluate in affine arithmetic, which keeps track of linear dependencies on the variables.
+	AFFINE,
+	/// Evaluate the mean value form `f(c) + sum_i df/dx_i(X) (X_i - c_i)` around the center c of the box.
+	MEAN_VALUE
+};
+
 class IntervalEvaluation
 {
 public:
@@ -37,7 +55,28 @@ public:
 
 	template<typename Coeff, typename Policy, typename Ordering, typename Numeric>
 	static Interval<Numeric> evaluate(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, Interval<Numeric>>&);
+
+	/**
+	 * Evaluates the polynomial over exact rational intervals with the MpqIntervalKernels, which
+	 * yields the same result as the generic evaluation with fewer allocations.
+	 */
+	template<typename Policy, typename Ordering>
+	static Interval<mpq_class> evaluate(const MultivariatePolynomial<mpq_class, Policy, Ordering>& p, const std::map<Variable, Interval<mpq_class>>& map)
+	{
+		static thread_local MpqIntervalKernels kernels;
+		Interval<mpq_class> result;
+		kernels.evaluate(p, map, result);
+		return result;
+	}
     
+	/**
+	 * Evaluates the polynomial over a box of double intervals with the given strategy.
+	 * The strategies AFFINE and MEAN_VALUE suffer less from dependencies between the terms, but
+	 * fall back to NAIVE if a variable of p is unbounded.
+	 */
+	template<typename Coeff, typename Policy, typename Ordering>
+	static Interval<double> evaluate(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, Interval<double>>& map, IntervalEvaluationStrategy strategy);
+
 	template<typename P, typename Numeric>
 	static Interval<Numeric> evaluate(const FactorizedPolynomial<P>& p, const std::map<Variable, Interval<Numeric>>&);
 
@@ -49,9 +88,28 @@ public:
 	
 	template<typename PolynomialType, typename Number, class strategy>
 	static Interval<Number> evaluate(const MultivariateHorner<PolynomialType, strategy>& mvH, const std::map<Variable, Interval<Number>>& map);
+
+	template<typename PolynomialType, class strategy>
+	static Interval<double> evaluate(const FlatHorner<PolynomialType, strategy>& fh, const std::map<Variable, Interval<double>>& map)
+	{
+		return fh.evaluate(map);
+	}
+
+	/**
+	 * Evaluates a flattened Horner scheme for many boxes at once, see FlatHorner::evaluate(const IntervalBatch&, std::vector<Interval<double>>&).
+	 */
+	template<typename PolynomialType, class strategy>
+	static void evaluate(const FlatHorner<PolynomialType, strategy>& fh, const IntervalBatch& batch, std::vector<Interval<double>>& result)
+	{
+		fh.evaluate(batch, result);
+	}
     
 private:
+	template<typename Coeff, typename Policy, typename Ordering>
+	static Interval<double> evaluateAffine(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, Interval<double>>& map, const Variables& vars);
 
+	template<typename Coeff, typename Policy, typename Ordering>
+	static Interval<double> evaluateMeanValue(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, Interval<double>>& map, const Variables& vars);
 };
 
 
@@ -108,6 +166,56 @@ inline Interval<Numeric> IntervalEvaluation::evaluate(const MultivariatePolynomi
 	}
 }
 
+template<typename Coeff, typename Policy, typename Ordering>
+inline Interval<double> IntervalEvaluation::evaluate(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, Interval<double>>& map, IntervalEvaluationStrategy strategy)
+{
+	if (strategy == IntervalEvaluationStrategy::NAIVE || p.isConstant()) return evaluate(p, map);
+	Variables vars;
+	p.gatherVariables(vars);
+	for (Variable v: vars) {
+		assert(map.count(v) > 0);
+		if (map.at(v).isUnbounded()) return evaluate(p, map);
+	}
+	if (strategy == IntervalEvaluationStrategy::AFFINE) return evaluateAffine(p, map, vars);
+	return evaluateMeanValue(p, map, vars);
+}
+
+template<typename Coeff, typename Policy, typename Ordering>
+inline Interval<double> IntervalEvaluation::evaluateAffine(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, Interval<double>>& map, const Variables& vars)
+{
+	// Every variable gets its own noise symbol, powers are computed once.
+	std::map<Variable, std::vector<AffineForm>> powers;
+	std::size_t symbol = 0;
+	for (Variable v: vars) {
+		powers[v].emplace_back(map.at(v), symbol++);
+	}
+	AffineForm result(0.0);
+	for (const auto& t: p) {
+		AffineForm term(Interval<double>(t.coeff()));
+		if (t.monomial()) {
+			for (const auto& ve: *t.monomial()) {
+				auto& pows = powers[ve.first];
+				while (pows.size() < ve.second) pows.push_back(pows.back() * pows.front());
+				term = term * pows[ve.second - 1];
+			}
+		}
+		result = result + term;
+	}
+	return result.interval();
+}
+
+template<typename Coeff, typename Policy, typename Ordering>
+inline Interval<double> IntervalEvaluation::evaluateMeanValue(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, Interval<double>>& map, const Variables& vars)
+{
+	std::map<Variable, Interval<double>> center;
+	for (Variable v: vars) center.emplace(v, Interval<double>(map.at(v).center()));
+	Interval<double> result = evaluate(p, center);
+	for (Variable v: vars) {
+		result += evaluate(p.derivative(v), map) * (map.at(v) - center.at(v));
+	}
+	return result;
+}
+
 template<typename P, typename Numeric>
 inline Interval<Numeric> IntervalEvaluation::evaluate(const FactorizedPolynomial<P>& p, const std::map<Variable, Interval<Numeric>>& map)
 {
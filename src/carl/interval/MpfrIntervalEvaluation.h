@@ -0,0 +1,228 @@
+/**
+ * @file MpfrIntervalEvaluation.h
+ *
+ * Sign determination of polynomials on rational boxes by interval arithmetic with double
+ * or MPFR numbers of a given precision.
+ */
+
+#pragma once
+
+#include "Interval.h"
+#include "IntervalEvaluation.h"
+#include "../core/MultivariatePolynomial.h"
+#include "../core/Sign.h"
+
+#include <limits>
+#include <map>
+#include <utility>
+
+namespace carl
+{
+	/// Precision in bits up to which adaptiveSign() uses double intervals.
+	constexpr std::size_t DOUBLE_INTERVAL_PRECISION = std::numeric_limits<double>::digits;
+
+	namespace adaptive_sign_detail
+	{
+		/// @return The sign of an interval, or Sign::ZERO if it contains zero.
+		template<typename Number>
+		Sign sign(const Interval<Number>& i)
+		{
+			if (i.isPositive()) return Sign::POSITIVE;
+			if (i.isNegative()) return Sign::NEGATIVE;
+			return Sign::ZERO;
+		}
+
+		/**
+		 * Evaluates p on the box in double interval arithmetic, where the bounds and coefficients are rounded outward.
+		 * @return The sign of p on the box, or Sign::ZERO if it could not be determined.
+		 */
+		template<typename Pol, typename Number>
+		Sign doubleSign(const Pol& p, const std::map<Variable, Interval<Number>>& box)
+		{
+			std::map<Variable, Interval<double>> values;
+			for (const auto& b: box) {
+				if (b.second.isUnbounded() || b.second.isEmpty()) return Sign::ZERO;
+				Interval<double> i(b.second.lower(), BoundType::WEAK, b.second.upper(), BoundType::WEAK);
+				if (i.isUnbounded()) return Sign::ZERO;
+				values.emplace(b.first, i);
+			}
+			Interval<double> sum(0.0);
+			for (const auto& t: p) {
+				Interval<double> term(t.coeff(), BoundType::WEAK, t.coeff(), BoundType::WEAK);
+				if (t.monomial()) {
+					for (const auto& ve: *t.monomial()) {
+						assert(values.find(ve.first) != values.end());
+						term *= values.find(ve.first)->second.pow(ve.second);
+					}
+				}
+				sum += term;
+				if (sum.isUnbounded()) return Sign::ZERO;
+			}
+			return sign(sum);
+		}
+
+		/**
+		 * Evaluates p on the box in exact interval arithmetic.
+		 * @return The sign of p on the box, or Sign::ZERO if it could not be determined.
+		 */
+		template<typename Pol, typename Number>
+		Sign exactSign(const Pol& p, const std::map<Variable, Interval<Number>>& box)
+		{
+			for (const auto& b: box) {
+				if (b.second.isUnbounded() || b.second.isEmpty()) return Sign::ZERO;
+			}
+			return sign(IntervalEvaluation::evaluate(p, box));
+		}
+	}
+
+	/**
+	 * Tries to determine the sign of p on the given box with interval arithmetic of the given precision.
+	 * Precisions up to DOUBLE_INTERVAL_PRECISION use double intervals. Higher precisions use MPFR intervals
+	 * for mpq_class if carl is built with USE_MPFR_FLOAT, and exact intervals otherwise.
+	 * @param p Polynomial.
+	 * @param box Intervals for all variables of p.
+	 * @param precision Precision of the floating point numbers in bits.
+	 * @return The sign of p on the box, or Sign::ZERO if it could not be determined.
+	 */
+	template<typename Pol, typename Number>
+	Sign adaptiveSign(const Pol& p, const std::map<Variable, Interval<Number>>& box, std::size_t precision)
+	{
+		if (precision <= DOUBLE_INTERVAL_PRECISION) return adaptive_sign_detail::doubleSign(p, box);
+		return adaptive_sign_detail::exactSign(p, box);
+	}
+
+#ifdef USE_MPFR_FLOAT
+	/**
+	 * Evaluates polynomials over boxes in interval arithmetic on MPFR numbers of a fixed precision.
+	 * Lower bounds are rounded downward and upper bounds upward, hence the result encloses the
+	 * exact range of the polynomial on the box.
+	 */
+	class MpfrIntervalEvaluation
+	{
+	private:
+		/// An interval of two MPFR numbers.
+		struct Bounds {
+			mpfr_t lower;
+			mpfr_t upper;
+			explicit Bounds(mpfr_prec_t precision)
+			{
+				mpfr_init2(lower, precision);
+				mpfr_init2(upper, precision);
+				mpfr_set_ui(lower, 0, MPFR_RNDD);
+				mpfr_set_ui(upper, 0, MPFR_RNDU);
+			}
+			Bounds(Bounds&& b)
+			{
+				mpfr_init2(lower, mpfr_get_prec(b.lower));
+				mpfr_init2(upper, mpfr_get_prec(b.upper));
+				mpfr_swap(lower, b.lower);
+				mpfr_swap(upper, b.upper);
+			}
+			Bounds(const Bounds&) = delete;
+			Bounds& operator=(const Bounds&) = delete;
+			~Bounds()
+			{
+				mpfr_clear(lower);
+				mpfr_clear(upper);
+			}
+			void set(const mpq_class& l, const mpq_class& u)
+			{
+				mpfr_set_q(lower, l.get_mpq_t(), MPFR_RNDD);
+				mpfr_set_q(upper, u.get_mpq_t(), MPFR_RNDU);
+			}
+		};
+
+		mpfr_prec_t mPrecision;
+		Bounds mSum;
+		Bounds mTerm;
+		Bounds mPower;
+		Bounds mProduct;
+		mpfr_t mTmp;
+
+		/// res = a ^ exp, which is tight even for even exponents of intervals containing zero.
+		void pow(const Bounds& a, unsigned long exp, Bounds& res)
+		{
+			if (exp % 2 == 1 || mpfr_sgn(a.lower) >= 0) {
+				mpfr_pow_ui(res.lower, a.lower, exp, MPFR_RNDD);
+				mpfr_pow_ui(res.upper, a.upper, exp, MPFR_RNDU);
+			} else if (mpfr_sgn(a.upper) <= 0) {
+				mpfr_pow_ui(res.lower, a.upper, exp, MPFR_RNDD);
+				mpfr_pow_ui(res.upper, a.lower, exp, MPFR_RNDU);
+			} else {
+				mpfr_neg(mTmp, a.lower, MPFR_RNDU);
+				mpfr_set_ui(res.lower, 0, MPFR_RNDD);
+				mpfr_pow_ui(res.upper, mpfr_cmp(mTmp, a.upper) > 0 ? mTmp : a.upper, exp, MPFR_RNDU);
+			}
+		}
+		/// res *= a, where res and a are distinct.
+		void mul(Bounds& res, const Bounds& a)
+		{
+			// The bounds of the product are among the four products of the bounds.
+			mpfr_srcptr xl = res.lower;
+			mpfr_srcptr xu = res.upper;
+			mpfr_mul(mProduct.lower, xl, a.lower, MPFR_RNDD);
+			mpfr_mul(mProduct.upper, xl, a.lower, MPFR_RNDU);
+			for (auto f: {std::make_pair(xl, a.upper), std::make_pair(xu, a.lower), std::make_pair(xu, a.upper)}) {
+				mpfr_mul(mTmp, f.first, f.second, MPFR_RNDD);
+				mpfr_min(mProduct.lower, mProduct.lower, mTmp, MPFR_RNDD);
+				mpfr_mul(mTmp, f.first, f.second, MPFR_RNDU);
+				mpfr_max(mProduct.upper, mProduct.upper, mTmp, MPFR_RNDU);
+			}
+			mpfr_swap(res.lower, mProduct.lower);
+			mpfr_swap(res.upper, mProduct.upper);
+		}
+	public:
+		explicit MpfrIntervalEvaluation(std::size_t precision):
+			mPrecision(mpfr_prec_t(precision)),
+			mSum(mPrecision),
+			mTerm(mPrecision),
+			mPower(mPrecision),
+			mProduct(mPrecision)
+		{
+			mpfr_init2(mTmp, mPrecision);
+		}
+		~MpfrIntervalEvaluation()
+		{
+			mpfr_clear(mTmp);
+		}
+
+		/**
+		 * Evaluates p on the box.
+		 * @return The sign of p on the box, or Sign::ZERO if the enclosure contains zero or the box is unbounded.
+		 */
+		template<typename Policy, typename Ordering>
+		Sign sign(const MultivariatePolynomial<mpq_class, Policy, Ordering>& p, const std::map<Variable, Interval<mpq_class>>& box)
+		{
+			std::map<Variable, Bounds> values;
+			for (const auto& b: box) {
+				if (b.second.isUnbounded() || b.second.isEmpty()) return Sign::ZERO;
+				values.emplace(b.first, Bounds(mPrecision)).first->second.set(b.second.lower(), b.second.upper());
+			}
+			mpfr_set_ui(mSum.lower, 0, MPFR_RNDD);
+			mpfr_set_ui(mSum.upper, 0, MPFR_RNDU);
+			for (const auto& t: p) {
+				mTerm.set(t.coeff(), t.coeff());
+				if (t.monomial()) {
+					for (const auto& ve: *t.monomial()) {
+						assert(values.find(ve.first) != values.end());
+						pow(values.find(ve.first)->second, ve.second, mPower);
+						mul(mTerm, mPower);
+					}
+				}
+				mpfr_add(mSum.lower, mSum.lower, mTerm.lower, MPFR_RNDD);
+				mpfr_add(mSum.upper, mSum.upper, mTerm.upper, MPFR_RNDU);
+			}
+			if (mpfr_sgn(mSum.lower) > 0) return Sign::POSITIVE;
+			if (mpfr_sgn(mSum.upper) < 0) return Sign::NEGATIVE;
+			return Sign::ZERO;
+		}
+	};
+
+	template<typename Policy, typename Ordering>
+	Sign adaptiveSign(const MultivariatePolynomial<mpq_class, Policy, Ordering>& p, const std::map<Variable, Interval<mpq_class>>& box, std::size_t precision)
+	{
+		if (precision <= DOUBLE_INTERVAL_PRECISION) return adaptive_sign_detail::doubleSign(p, box);
+		return MpfrIntervalEvaluation(precision).sign(p, box);
+	}
+#endif
+}
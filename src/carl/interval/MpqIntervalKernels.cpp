@@ -0,0 +1,177 @@
+#include "MpqIntervalKernels.h"
+
+namespace carl
+{
+	bool MpqIntervalKernels::containsZero(const MpqInterval& i)
+	{
+		int l = sgn(i.lower());
+		int u = sgn(i.upper());
+		return (l < 0 || (l == 0 && i.lowerBoundType() == BoundType::WEAK)) && (u > 0 || (u == 0 && i.upperBoundType() == BoundType::WEAK));
+	}
+
+	void MpqIntervalKernels::store(MpqInterval& res, BoundType lowerType, BoundType upperType) const
+	{
+		assert(lowerType != BoundType::INFTY && upperType != BoundType::INFTY);
+		assert(mLower <= mUpper);
+		// Assigning the bounds reuses the memory of the previous bounds.
+		res.rContent().assign(mLower, mUpper);
+		res.setLowerBoundType(lowerType);
+		res.setUpperBoundType(upperType);
+	}
+
+	void MpqIntervalKernels::copy(const MpqInterval& a, MpqInterval& res)
+	{
+		if (&a == &res) return;
+		if (a.isUnbounded()) {
+			res = a;
+			return;
+		}
+		res.rContent().assign(a.lower(), a.upper());
+		res.setLowerBoundType(a.lowerBoundType());
+		res.setUpperBoundType(a.upperBoundType());
+	}
+
+	void MpqIntervalKernels::add(const MpqInterval& a, const MpqInterval& b, MpqInterval& res)
+	{
+		if (!isRegular(a) || !isRegular(b)) {
+			res = a.add(b);
+			return;
+		}
+		mpq_add(mLower.get_mpq_t(), a.lower().get_mpq_t(), b.lower().get_mpq_t());
+		mpq_add(mUpper.get_mpq_t(), a.upper().get_mpq_t(), b.upper().get_mpq_t());
+		store(res, getStrictestBoundType(a.lowerBoundType(), b.lowerBoundType()), getStrictestBoundType(a.upperBoundType(), b.upperBoundType()));
+	}
+
+	void MpqIntervalKernels::addConstant(const mpq_class& c, MpqInterval& res)
+	{
+		if (!isRegular(res)) {
+			res = res.add(MpqInterval(c));
+			return;
+		}
+		mpq_add(mLower.get_mpq_t(), res.lower().get_mpq_t(), c.get_mpq_t());
+		mpq_add(mUpper.get_mpq_t(), res.upper().get_mpq_t(), c.get_mpq_t());
+		store(res, res.lowerBoundType(), res.upperBoundType());
+	}
+
+	void MpqIntervalKernels::mul(const MpqInterval& a, const MpqInterval& b, MpqInterval& res)
+	{
+		if (!isRegular(a) || !isRegular(b)) {
+			res = a.mul(b);
+			return;
+		}
+		// Classify both operands as mixed (M), negative (N), positive (P) or zero (Z) like Interval::mul.
+		// Only the M * M case needs all four endpoint products.
+		mpq_srcptr xl = a.lower().get_mpq_t();
+		mpq_srcptr xu = a.upper().get_mpq_t();
+		mpq_srcptr yl = b.lower().get_mpq_t();
+		mpq_srcptr yu = b.upper().get_mpq_t();
+		BoundType xlt = a.lowerBoundType();
+		BoundType xut = a.upperBoundType();
+		BoundType ylt = b.lowerBoundType();
+		BoundType yut = b.upperBoundType();
+		enum { M, N, P, Z };
+		int x = mpq_sgn(xl) < 0 ? (mpq_sgn(xu) > 0 ? M : N) : (mpq_sgn(xu) > 0 ? P : Z);
+		int y = mpq_sgn(yl) < 0 ? (mpq_sgn(yu) > 0 ? M : N) : (mpq_sgn(yu) > 0 ? P : Z);
+		BoundType lowerType;
+		BoundType upperType;
+		auto product = [](mpq_class& res, mpq_srcptr u, BoundType ut, mpq_srcptr v, BoundType vt, BoundType& type) {
+			mpq_mul(res.get_mpq_t(), u, v);
+			type = getStrictestBoundType(ut, vt);
+		};
+		if (x == Z) {
+			mLower = 0;
+			mUpper = 0;
+			lowerType = xlt;
+			upperType = xut;
+		} else if (y == Z) {
+			mLower = 0;
+			mUpper = 0;
+			lowerType = ylt;
+			upperType = yut;
+		} else if (x == M && y == M) {
+			product(mLower, xl, xlt, yu, yut, lowerType);
+			BoundType type;
+			product(mTmpA, xu, xut, yl, ylt, type);
+			if (mLower > mTmpA) {
+				mpq_swap(mLower.get_mpq_t(), mTmpA.get_mpq_t());
+				lowerType = type;
+			}
+			product(mUpper, xu, xut, yu, yut, upperType);
+			product(mTmpB, xl, xlt, yl, ylt, type);
+			if (mUpper <= mTmpB) {
+				mpq_swap(mUpper.get_mpq_t(), mTmpB.get_mpq_t());
+				upperType = type;
+			}
+		} else {
+			// Which bounds of x and y yield the bounds of the product, true meaning the lower bound.
+			bool xl4l, yl4l, xl4u, yl4u;
+			switch (3 * x + y) {
+				case 3 * M + N: xl4l = false; yl4l = true;  xl4u = true;  yl4u = true;  break;
+				case 3 * M + P: xl4l = true;  yl4l = false; xl4u = false; yl4u = false; break;
+				case 3 * N + M: xl4l = true;  yl4l = false; xl4u = true;  yl4u = true;  break;
+				case 3 * N + N: xl4l = false; yl4l = false; xl4u = true;  yl4u = true;  break;
+				case 3 * N + P: xl4l = true;  yl4l = false; xl4u = false; yl4u = true;  break;
+				case 3 * P + M: xl4l = false; yl4l = true;  xl4u = false; yl4u = false; break;
+				case 3 * P + N: xl4l = false; yl4l = true;  xl4u = true;  yl4u = false; break;
+				default:        xl4l = true;  yl4l = true;  xl4u = false; yl4u = false; break; // P * P
+			}
+			product(mLower, xl4l ? xl : xu, xl4l ? xlt : xut, yl4l ? yl : yu, yl4l ? ylt : yut, lowerType);
+			product(mUpper, xl4u ? xl : xu, xl4u ? xlt : xut, yl4u ? yl : yu, yl4u ? ylt : yut, upperType);
+		}
+		// A zero bound is weak if one of the factors contains zero.
+		if ((mpq_sgn(mLower.get_mpq_t()) == 0 || mpq_sgn(mUpper.get_mpq_t()) == 0) && (containsZero(a) || containsZero(b))) {
+			if (mpq_sgn(mLower.get_mpq_t()) == 0) lowerType = BoundType::WEAK;
+			if (mpq_sgn(mUpper.get_mpq_t()) == 0) upperType = BoundType::WEAK;
+		}
+		store(res, lowerType, upperType);
+	}
+
+	void MpqIntervalKernels::pow(const MpqInterval& a, uint exp, MpqInterval& res)
+	{
+		if (!isRegular(a) || exp == 0) {
+			res = a.pow(exp);
+			return;
+		}
+		if (exp == 1) {
+			copy(a, res);
+			return;
+		}
+		auto power = [exp](mpq_class& res, mpq_srcptr base) {
+			// Numerator and denominator are coprime, hence their powers are as well.
+			mpz_pow_ui(mpq_numref(res.get_mpq_t()), mpq_numref(base), exp);
+			mpz_pow_ui(mpq_denref(res.get_mpq_t()), mpq_denref(base), exp);
+		};
+		if (exp % 2 == 1 || mpq_sgn(a.lower().get_mpq_t()) >= 0) {
+			power(mLower, a.lower().get_mpq_t());
+			power(mUpper, a.upper().get_mpq_t());
+			store(res, a.lowerBoundType(), a.upperBoundType());
+		} else if (mpq_sgn(a.upper().get_mpq_t()) <= 0) {
+			power(mLower, a.upper().get_mpq_t());
+			power(mUpper, a.lower().get_mpq_t());
+			store(res, a.upperBoundType(), a.lowerBoundType());
+		} else {
+			// Even power of a mixed interval.
+			mpq_neg(mTmpA.get_mpq_t(), a.lower().get_mpq_t());
+			bool lowerDominates = mTmpA > a.upper();
+			mLower = 0;
+			power(mUpper, lowerDominates ? a.lower().get_mpq_t() : a.upper().get_mpq_t());
+			store(res, BoundType::WEAK, lowerDominates ? a.lowerBoundType() : a.upperBoundType());
+		}
+	}
+
+	void MpqIntervalKernels::horner(const UnivariatePolynomial<mpq_class>& p, const MpqInterval& x, MpqInterval& res)
+	{
+		const auto& coeffs = p.coefficients();
+		if (coeffs.empty()) {
+			res = MpqInterval(carl::constant_zero<mpq_class>::get());
+			return;
+		}
+		mLower = coeffs.back();
+		mUpper = coeffs.back();
+		store(res, BoundType::WEAK, BoundType::WEAK);
+		for (std::size_t i = coeffs.size() - 1; i > 0; i--) {
+			mul(res, x, res);
+			addConstant(coeffs[i - 1], res);
+		}
+	}
+}
@@ -0,0 +1,109 @@
+/**
+ * @file MpqIntervalKernels.h
+ *
+ * Arithmetic on exact rational intervals that reuses the memory of its operands.
+ */
+
+#pragma once
+
+#include "Interval.h"
+#include "../core/MultivariatePolynomial.h"
+#include "../core/UnivariatePolynomial.h"
+
+#include <map>
+
+namespace carl
+{
+	/**
+	 * Kernels for the arithmetic on intervals over mpq_class.
+	 *
+	 * The generic interval operations return new intervals and hence allocate new endpoints for
+	 * every single operation. These kernels compute the endpoints with in-place mpq operations
+	 * into scratch numbers owned by the kernel object and only copy them into the result, which
+	 * reuses the memory of the result in a sequence of operations.
+	 * All results are identical to the generic operations, bounds types included. Unbounded and
+	 * empty operands are passed on to the generic operations.
+	 *
+	 * A kernel object must not be used by multiple threads at once.
+	 */
+	class MpqIntervalKernels
+	{
+	public:
+		using MpqInterval = Interval<mpq_class>;
+	private:
+		mpq_class mLower;
+		mpq_class mUpper;
+		mpq_class mTmpA;
+		mpq_class mTmpB;
+		MpqInterval mMonomial;
+		MpqInterval mPower;
+		MpqInterval mTerm;
+
+		static bool isRegular(const MpqInterval& i)
+		{
+			return !i.isUnbounded() && !i.isEmpty();
+		}
+		static bool containsZero(const MpqInterval& i);
+		/// Sets res to [mLower, mUpper] with the given bound types, which are not INFTY.
+		void store(MpqInterval& res, BoundType lowerType, BoundType upperType) const;
+		/// Sets res to a.
+		static void copy(const MpqInterval& a, MpqInterval& res);
+		/// Evaluates the term into mTerm like IntervalEvaluation::evaluate.
+		template<typename Coeff>
+		void evaluateTerm(const Term<Coeff>& t, const std::map<Variable, MpqInterval>& map);
+	public:
+		/// res = a + b
+		void add(const MpqInterval& a, const MpqInterval& b, MpqInterval& res);
+		/// res += c
+		void addConstant(const mpq_class& c, MpqInterval& res);
+		/// res = a * b
+		void mul(const MpqInterval& a, const MpqInterval& b, MpqInterval& res);
+		/// res = a ^ exp
+		void pow(const MpqInterval& a, uint exp, MpqInterval& res);
+		/**
+		 * Evaluates p at x with Horner's scheme, fusing the multiplication and addition of every step.
+		 */
+		void horner(const UnivariatePolynomial<mpq_class>& p, const MpqInterval& x, MpqInterval& res);
+		/**
+		 * Evaluates p term by term, which yields the same result as IntervalEvaluation::evaluate.
+		 */
+		template<typename Policy, typename Ordering>
+		void evaluate(const MultivariatePolynomial<mpq_class, Policy, Ordering>& p, const std::map<Variable, MpqInterval>& map, MpqInterval& res);
+	};
+
+	template<typename Coeff>
+	void MpqIntervalKernels::evaluateTerm(const Term<Coeff>& t, const std::map<Variable, MpqInterval>& map)
+	{
+		mLower = t.coeff();
+		mUpper = t.coeff();
+		store(mTerm, BoundType::WEAK, BoundType::WEAK);
+		if (!t.monomial()) return;
+		mLower = carl::constant_one<mpq_class>::get();
+		mUpper = carl::constant_one<mpq_class>::get();
+		store(mMonomial, BoundType::WEAK, BoundType::WEAK);
+		for (const auto& ve: *t.monomial()) {
+			assert(map.count(ve.first) > 0);
+			pow(map.find(ve.first)->second, ve.second, mPower);
+			mul(mMonomial, mPower, mMonomial);
+			if (mMonomial.isZero()) break;
+		}
+		mul(mTerm, mMonomial, mTerm);
+	}
+
+	template<typename Policy, typename Ordering>
+	void MpqIntervalKernels::evaluate(const MultivariatePolynomial<mpq_class, Policy, Ordering>& p, const std::map<Variable, MpqInterval>& map, MpqInterval& res)
+	{
+		if (p.isZero()) {
+			res = MpqInterval(carl::constant_zero<mpq_class>::get());
+			return;
+		}
+		auto it = p.begin();
+		evaluateTerm(*it, map);
+		copy(mTerm, res);
+		for (++it; it != p.end(); ++it) {
+			if (res.isInfinite()) return;
+			evaluateTerm(*it, map);
+			add(res, mTerm, res);
+		}
+	}
+}
@@ -0,0 +1,11 @@
+/**
+ * @file RoundingScope.cpp
+ */
+
+#include "RoundingScope.h"
+
+namespace carl
+{
+	thread_local std::size_t IntervalRoundingScope::mDepth = 0;
+	thread_local IntervalRoundingScope::Control::rounding_mode IntervalRoundingScope::mMode;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file RoundingScope.h
+ *
+ * Rounding policy for double intervals that switches the rounding mode once per scope
+ * instead of once per operation.
+ */
+
+#pragma once
+
+#include "../util/platform.h"
+
+CLANG_WARNING_DISABLE("-Wunused-parameter")
+#include <boost/numeric/interval.hpp>
+CLANG_WARNING_RESET
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace carl
+{
+	/**
+	 * Sets the floating point rounding mode to upward for the lifetime of this object.
+	 *
+	 * Operations on double intervals within such a scope do not save, set and restore the
+	 * rounding mode themselves, which otherwise dominates the cost of cheap operations like
+	 * addition and multiplication. Scopes may be nested, only the outermost one changes the
+	 * rounding mode. Scopes are local to a thread.
+	 *
+	 * Note that all other floating point computations within the scope are rounded upward as well.
+	 * Interval<double> only relies on the scope if carl is built with SCOPED_INTERVAL_ROUNDING,
+	 * otherwise every operation still sets the rounding mode itself.
+	 */
+	class IntervalRoundingScope
+	{
+	private:
+		using Control = boost::numeric::interval_lib::rounding_control<double>;
+		/// Number of active scopes of this thread.
+		static thread_local std::size_t mDepth;
+		/// Rounding mode before the outermost scope.
+		static thread_local Control::rounding_mode mMode;
+	public:
+		IntervalRoundingScope()
+		{
+			if (mDepth++ == 0) {
+				Control::get_rounding_mode(mMode);
+				Control::upward();
+			}
+		}
+		IntervalRoundingScope(const IntervalRoundingScope&) = delete;
+		IntervalRoundingScope& operator=(const IntervalRoundingScope&) = delete;
+		~IntervalRoundingScope()
+		{
+			if (--mDepth == 0) Control::set_rounding_mode(mMode);
+		}
+
+		/**
+		 * @return true, if a scope is active in this thread.
+		 */
+		static bool active()
+		{
+			return mDepth != 0;
+		}
+	};
+
+	/**
+	 * Arithmetic of boost::numeric::interval_lib::rounded_arith_opp, which computes all bounds in
+	 * upward rounding and obtains lower bounds by negation.
+	 * The negated operands are passed through volatile variables, such that the compiler cannot
+	 * fold the negations, which is only valid when rounding to nearest.
+	 */
+	struct rounded_arith_upward: boost::numeric::interval_lib::rounded_arith_opp<double>
+	{
+	private:
+		/// Integers may overflow when negated, hence the upward conversion is decreased if it is not exact.
+		template<class U>
+		double conv_down(const U& v, std::true_type /* integral */)
+		{
+			double d = conv_up(v);
+			if (d >= std::ldexp(1.0, std::numeric_limits<U>::digits) || U(d) != v) {
+				d = std::nextafter(d, -std::numeric_limits<double>::infinity());
+			}
+			return d;
+		}
+		template<class U>
+		double conv_down(const U& v, std::false_type /* integral */)
+		{
+			volatile U n = -v;
+			return -this->force_rounding(double(n));
+		}
+	public:
+		/// The value is passed through a volatile variable, such that the conversion of constants is not folded.
+		template<class U>
+		double conv_up(const U& v)
+		{
+			volatile U n = v;
+			return this->force_rounding(double(n));
+		}
+		template<class U>
+		double conv_down(const U& v)
+		{
+			return conv_down(v, std::is_integral<U>());
+		}
+		double add_down(const double& x, const double& y)
+		{
+			volatile double n = -x;
+			return -this->force_rounding(n - y);
+		}
+		double sub_down(const double& x, const double& y)
+		{
+			volatile double n = -x;
+			return -this->force_rounding(y + n);
+		}
+		double mul_down(const double& x, const double& y)
+		{
+			volatile double n = -y;
+			return -this->force_rounding(x * n);
+		}
+		double div_down(const double& x, const double& y)
+		{
+			volatile double n = -y;
+			return -this->force_rounding(x / n);
+		}
+	};
+
+	/**
+	 * Rounding policy for double intervals, used by Interval<double> if carl is built with SCOPED_INTERVAL_ROUNDING.
+	 *
+	 * Outside of an IntervalRoundingScope, it behaves like boost::numeric::interval_lib::save_state
+	 * and sets upward rounding for every single operation. Within a scope, the rounding mode is
+	 * already set and left untouched.
+	 */
+	template<typename Rounding>
+	struct scoped_save_state: Rounding
+	{
+		typename Rounding::rounding_mode mode;
+		bool saved;
+		scoped_save_state(): saved(!IntervalRoundingScope::active())
+		{
+			if (saved) {
+				this->get_rounding_mode(mode);
+				this->init();
+			}
+		}
+		~scoped_save_state()
+		{
+			if (saved) this->set_rounding_mode(mode);
+		}
+		using unprotected_rounding = boost::numeric::interval_lib::detail::save_state_unprotected<Rounding>;
+	};
+
+	using rounding_double = scoped_save_state<boost::numeric::interval_lib::rounded_transc_opp<double, rounded_arith_upward>>;
+}
@@ -0,0 +1,3 @@
+/* #undef USE_MPFR_FLOAT */
+/* #undef SCOPED_INTERVAL_ROUNDING */
+/* #undef USE_HORNER */
@@ -0,0 +1,608 @@
+/**
+ * @file BinarySerialization.h
+ *
+ * A compact binary format for variables, monomials, polynomials, constraints and formulas.
+ *
+ * A serialized stream starts with the magic bytes "CARL" and a format version. It is followed
+ * by a sequence of records. Definition records introduce variables, monomials, constraints and
+ * formulas and assign them consecutive indices per kind, such that every object is stored only
+ * once and later records refer to it by index. Root records mark the objects that were written
+ * explicitly and are returned by the reader in the same order.
+ *
+ * All unsigned numbers are stored as LEB128 varints, integers as their sign and length followed
+ * by their magnitude in little-endian byte order.
+ */
+
+#pragma once
+
+#include "../core/logging.h"
+#include "../core/Monomial.h"
+#include "../core/MonomialPool.h"
+#include "../core/MultivariatePolynomial.h"
+#include "../core/Term.h"
+#include "../core/Variable.h"
+#include "../core/VariablePool.h"
+#include "../formula/Constraint.h"
+#include "../formula/Formula.h"
+#include "../numbers/numbers.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace carl {
+
+namespace binary_detail {
+	/// The version of the format, to be increased on every incompatible change.
+	constexpr std::uint64_t VERSION = 1;
+
+	enum class Record: unsigned char {
+		VARIABLE, MONOMIAL, CONSTRAINT, FORMULA,
+		ROOT_VARIABLE, ROOT_MONOMIAL, ROOT_POLYNOMIAL, ROOT_CONSTRAINT, ROOT_FORMULA
+	};
+
+	inline void writeVarint(std::string& _out, std::uint64_t _n) {
+		while (_n >= 0x80) {
+			_out.push_back(char((_n & 0x7f) | 0x80));
+			_n >>= 7;
+		}
+		_out.push_back(char(_n));
+	}
+
+	inline bool readVarint(const char*& _pos, const char* _end, std::uint64_t& _n) {
+		_n = 0;
+		for (unsigned shift = 0; _pos != _end && shift < 64; shift += 7) {
+			auto byte = static_cast<unsigned char>(*_pos++);
+			_n |= std::uint64_t(byte & 0x7f) << shift;
+			if ((byte & 0x80) == 0) return true;
+		}
+		return false;
+	}
+
+	inline void writeInteger(std::string& _out, const mpz_class& _n) {
+		std::size_t bytes = (mpz_sizeinbase(_n.get_mpz_t(), 2) + 7) / 8;
+		if (sgn(_n) == 0) bytes = 0;
+		writeVarint(_out, (std::uint64_t(bytes) << 1) | (sgn(_n) < 0 ? 1 : 0));
+		std::size_t offset = _out.size();
+		_out.resize(offset + bytes);
+		if (bytes > 0) mpz_export(&_out[offset], nullptr, -1, 1, -1, 0, _n.get_mpz_t());
+	}
+
+	inline bool readInteger(const char*& _pos, const char* _end, mpz_class& _n) {
+		std::uint64_t header;
+		if (!readVarint(_pos, _end, header)) return false;
+		std::uint64_t bytes = header >> 1;
+		if (std::uint64_t(_end - _pos) < bytes) return false;
+		if (bytes == 0) {
+			_n = 0;
+		} else {
+			mpz_import(_n.get_mpz_t(), std::size_t(bytes), -1, 1, -1, 0, _pos);
+			if (header & 1) _n = -_n;
+		}
+		_pos += bytes;
+		return true;
+	}
+
+#ifdef USE_CLN_NUMBERS
+	inline void writeInteger(std::string& _out, const cln::cl_I& _n) {
+		writeInteger(_out, mpz_class(carl::toString(_n)));
+	}
+
+	inline bool readInteger(const char*& _pos, const char* _end, cln::cl_I& _n) {
+		mpz_class n;
+		if (!readInteger(_pos, _end, n)) return false;
+		_n = carl::parse<cln::cl_I>(n.get_str());
+		return true;
+	}
+#endif
+}
+
+/**
+ * Serializes objects into the binary format described in BinarySerialization.h.
+ *
+ * Every object is defined at most once per writer, hence objects that are shared within or
+ * between the written objects, for example subformulas of a formula DAG, are stored only once.
+ */
+template<typename Pol>
+class BinaryWriter {
+private:
+	using Coeff = typename Pol::CoeffType;
+	using Record = binary_detail::Record;
+
+	std::string mData;
+	std::unordered_map<Variable, std::size_t> mVariables;
+	std::unordered_map<Monomial::Arg, std::size_t> mMonomials;
+	std::unordered_map<Constraint<Pol>, std::size_t> mConstraints;
+	std::unordered_map<Formula<Pol>, std::size_t> mFormulas;
+
+	void tag(Record _record) {
+		mData.push_back(char(_record));
+	}
+	void number(std::uint64_t _n) {
+		binary_detail::writeVarint(mData, _n);
+	}
+	void coefficient(const Coeff& _c) {
+		binary_detail::writeInteger(mData, carl::getNum(_c));
+		binary_detail::writeInteger(mData, carl::getDenom(_c));
+	}
+
+	std::size_t define(Variable _var) {
+		auto it = mVariables.find(_var);
+		if (it != mVariables.end()) return it->second;
+		std::string name = _var.getName();
+		tag(Record::VARIABLE);
+		number(std::uint64_t(_var.getType()));
+		number(name.size());
+		mData.append(name);
+		return mVariables.emplace(_var, mVariables.size()).first->second;
+	}
+
+	std::size_t define(const Monomial::Arg& _monomial) {
+		auto it = mMonomials.find(_monomial);
+		if (it != mMonomials.end()) return it->second;
+		std::vector<std::size_t> vars;
+		vars.reserve(_monomial->exponents().size());
+		for (const auto& ve: _monomial->exponents()) vars.push_back(define(ve.first));
+		tag(Record::MONOMIAL);
+		number(vars.size());
+		for (std::size_t i = 0; i < vars.size(); i++) {
+			number(vars[i]);
+			number(_monomial->exponents()[i].second);
+		}
+		return mMonomials.emplace(_monomial, mMonomials.size()).first->second;
+	}
+
+	/// Defines all monomials of the polynomial.
+	void defineMonomials(const Pol& _pol) {
+		for (const auto& term: _pol) {
+			if (term.monomial()) define(term.monomial());
+		}
+	}
+	/// Writes the terms of a polynomial whose monomials are defined.
+	void polynomial(const Pol& _pol) {
+		number(_pol.nrTerms());
+		for (const auto& term: _pol) {
+			// Zero refers to the constant monomial.
+			number(term.monomial() ? mMonomials.at(term.monomial()) + 1 : 0);
+			coefficient(term.coeff());
+		}
+	}
+
+	std::size_t define(const Constraint<Pol>& _constraint) {
+		auto it = mConstraints.find(_constraint);
+		if (it != mConstraints.end()) return it->second;
+		defineMonomials(_constraint.lhs());
+		tag(Record::CONSTRAINT);
+		number(std::uint64_t(_constraint.relation()));
+		polynomial(_constraint.lhs());
+		return mConstraints.emplace(_constraint, mConstraints.size()).first->second;
+	}
+
+	/// Defines the formula after all its subformulas, without recursion.
+	bool define(const Formula<Pol>& _formula, std::size_t& _index);
+
+public:
+	BinaryWriter() {
+		mData.append("CARL");
+		number(binary_detail::VERSION);
+	}
+
+	/**
+	 * @return The serialized data.
+	 */
+	const std::string& data() const {
+		return mData;
+	}
+
+	void write(Variable _var) {
+		std::size_t id = define(_var);
+		tag(Record::ROOT_VARIABLE);
+		number(id);
+	}
+
+	/**
+	 * Writes a monomial, which may be nullptr for the constant monomial.
+	 */
+	void write(const Monomial::Arg& _monomial) {
+		std::size_t id = _monomial ? define(_monomial) + 1 : 0;
+		tag(Record::ROOT_MONOMIAL);
+		number(id);
+	}
+
+	void write(const Pol& _pol) {
+		defineMonomials(_pol);
+		tag(Record::ROOT_POLYNOMIAL);
+		polynomial(_pol);
+	}
+
+	void write(const Constraint<Pol>& _constraint) {
+		std::size_t id = define(_constraint);
+		tag(Record::ROOT_CONSTRAINT);
+		number(id);
+	}
+
+	/**
+	 * Writes a formula over Boolean variables and arithmetic constraints.
+	 * @return false, if the formula contains other theories, which are not supported.
+	 */
+	bool write(const Formula<Pol>& _formula) {
+		std::size_t id;
+		if (!define(_formula, id)) return false;
+		tag(Record::ROOT_FORMULA);
+		number(id);
+		return true;
+	}
+};
+
+/**
+ * Deserializes objects written by a BinaryWriter in the same order.
+ *
+ * Variables are created freshly with their name and type, unless a variable of the same name
+ * and type was registered by addVariable(). All other objects are rebuilt through their pools
+ * exactly once, in the order of their definitions.
+ */
+template<typename Pol>
+class BinaryReader {
+private:
+	using Coeff = typename Pol::CoeffType;
+	using Integer = typename IntegralType<Coeff>::type;
+	using Record = binary_detail::Record;
+
+	const char* mPos;
+	const char* mEnd;
+	bool mValid = true;
+	std::unordered_map<std::string, Variable> mKnownVariables;
+	std::vector<Variable> mVariables;
+	std::vector<Monomial::Arg> mMonomials;
+	std::vector<Constraint<Pol>> mConstraints;
+	std::vector<Formula<Pol>> mFormulas;
+
+	bool fail(const std::string& _message) {
+		(void)_message;
+		CARL_LOG_ERROR("carl.io", "Reading binary data failed: " << _message);
+		mValid = false;
+		return false;
+	}
+	bool number(std::uint64_t& _n) {
+		return binary_detail::readVarint(mPos, mEnd, _n) || fail("unexpected end of data");
+	}
+	/// Reads an index into a table of the given size.
+	bool index(std::size_t _size, std::size_t& _index) {
+		std::uint64_t n;
+		if (!number(n)) return false;
+		if (n >= _size) return fail("invalid reference");
+		_index = std::size_t(n);
+		return true;
+	}
+	bool coefficient(Coeff& _c) {
+		Integer num;
+		Integer denom;
+		if (!binary_detail::readInteger(mPos, mEnd, num) || !binary_detail::readInteger(mPos, mEnd, denom)) return fail("unexpected end of data");
+		if (carl::isZero(denom)) return fail("zero denominator");
+		_c = Coeff(num) / Coeff(denom);
+		return true;
+	}
+
+	bool readVariable();
+	bool readMonomial();
+	bool polynomial(Pol& _pol);
+	bool readConstraint();
+	bool readFormula();
+	/// Reads definitions up to the next root record.
+	bool root(Record _expected);
+
+public:
+	/**
+	 * Reads from the given buffer, which must outlive the reader.
+	 */
+	BinaryReader(const char* _begin, const char* _end):
+		mPos(_begin), mEnd(_end)
+	{
+		std::uint64_t version;
+		if (mEnd - mPos < 4 || std::memcmp(mPos, "CARL", 4) != 0) {
+			fail("missing header");
+			return;
+		}
+		mPos += 4;
+		if (number(version) && version != binary_detail::VERSION) {
+			fail("unsupported version " + std::to_string(version));
+		}
+	}
+	explicit BinaryReader(const std::string& _data):
+		BinaryReader(_data.data(), _data.data() + _data.size())
+	{}
+
+	/**
+	 * @return false, if the data was malformed so far.
+	 */
+	bool isValid() const {
+		return mValid;
+	}
+
+	/**
+	 * @return true, if all data has been read.
+	 */
+	bool atEnd() const {
+		return mPos == mEnd;
+	}
+
+	/**
+	 * Makes the reader use the given variable for variables of the same name and type.
+	 */
+	void addVariable(Variable _var) {
+		mKnownVariables[_var.getName()] = _var;
+	}
+
+	bool read(Variable& _var) {
+		std::size_t id;
+		if (!root(Record::ROOT_VARIABLE) || !index(mVariables.size(), id)) return false;
+		_var = mVariables[id];
+		return true;
+	}
+
+	bool read(Monomial::Arg& _monomial) {
+		std::size_t id;
+		if (!root(Record::ROOT_MONOMIAL) || !index(mMonomials.size() + 1, id)) return false;
+		_monomial = id == 0 ? nullptr : mMonomials[id - 1];
+		return true;
+	}
+
+	bool read(Pol& _pol) {
+		return root(Record::ROOT_POLYNOMIAL) && polynomial(_pol);
+	}
+
+	bool read(Constraint<Pol>& _constraint) {
+		std::size_t id;
+		if (!root(Record::ROOT_CONSTRAINT) || !index(mConstraints.size(), id)) return false;
+		_constraint = mConstraints[id];
+		return true;
+	}
+
+	bool read(Formula<Pol>& _formula) {
+		std::size_t id;
+		if (!root(Record::ROOT_FORMULA) || !index(mFormulas.size(), id)) return false;
+		_formula = mFormulas[id];
+		return true;
+	}
+};
+
+template<typename Pol>
+bool BinaryWriter<Pol>::define(const Formula<Pol>& _formula, std::size_t& _index) {
+	std::vector<std::pair<Formula<Pol>, bool>> stack;
+	stack.emplace_back(_formula, false);
+	std::vector<std::size_t> subformulas;
+	while (!stack.empty()) {
+		if (mFormulas.find(stack.back().first) != mFormulas.end()) {
+			stack.pop_back();
+			continue;
+		}
+		Formula<Pol> cur = stack.back().first;
+		if (!stack.back().second) {
+			// Schedule the subformulas first.
+			stack.back().second = true;
+			switch (cur.getType()) {
+				case TRUE: case FALSE: case BOOL: case CONSTRAINT:
+					break;
+				case NOT:
+					stack.emplace_back(cur.subformula(), false);
+					break;
+				case EXISTS: case FORALL:
+					stack.emplace_back(cur.quantifiedFormula(), false);
+					break;
+				case ITE: case IMPLIES: case AND: case OR: case XOR: case IFF:
+					for (const auto& sub: cur.subformulas()) stack.emplace_back(sub, false);
+					break;
+				default:
+					CARL_LOG_ERROR("carl.io", "Binary serialization of formulas of type " << cur.getType() << " is not supported.");
+					return false;
+			}
+			continue;
+		}
+		stack.pop_back();
+		subformulas.clear();
+		std::size_t payload = 0;
+		switch (cur.getType()) {
+			case BOOL:
+				payload = define(cur.boolean());
+				break;
+			case CONSTRAINT:
+				payload = define(cur.constraint());
+				break;
+			case NOT:
+				subformulas.push_back(mFormulas.at(cur.subformula()));
+				break;
+			case EXISTS: case FORALL:
+				for (Variable v: cur.quantifiedVariables()) subformulas.push_back(define(v));
+				subformulas.push_back(mFormulas.at(cur.quantifiedFormula()));
+				break;
+			case ITE: case IMPLIES: case AND: case OR: case XOR: case IFF:
+				for (const auto& sub: cur.subformulas()) subformulas.push_back(mFormulas.at(sub));
+				break;
+			default:
+				break;
+		}
+		tag(Record::FORMULA);
+		number(std::uint64_t(cur.getType()));
+		switch (cur.getType()) {
+			case TRUE: case FALSE:
+				break;
+			case BOOL: case CONSTRAINT:
+				number(payload);
+				break;
+			case NOT:
+				number(subformulas.front());
+				break;
+			default:
+				// The number of subformulas, or of the quantified variables.
+				number(cur.getType() == EXISTS || cur.getType() == FORALL ? subformulas.size() - 1 : subformulas.size());
+				for (std::size_t id: subformulas) number(id);
+		}
+		mFormulas.emplace(cur, mFormulas.size());
+	}
+	_index = mFormulas.at(_formula);
+	return true;
+}
+
+template<typename Pol>
+bool BinaryReader<Pol>::readVariable() {
+	std::uint64_t type;
+	std::uint64_t length;
+	if (!number(type) || !number(length)) return false;
+	if (type > std::uint64_t(VariableType::MAX_TYPE)) return fail("invalid variable type");
+	if (std::uint64_t(mEnd - mPos) < length) return fail("unexpected end of data");
+	std::string name(mPos, std::size_t(length));
+	mPos += length;
+	auto it = mKnownVariables.find(name);
+	if (it != mKnownVariables.end() && it->second.getType() == VariableType(type)) {
+		mVariables.push_back(it->second);
+	} else {
+		mVariables.push_back(freshVariable(name, VariableType(type)));
+	}
+	return true;
+}
+
+template<typename Pol>
+bool BinaryReader<Pol>::readMonomial() {
+	std::uint64_t size;
+	if (!number(size)) return false;
+	if (size == 0 || size > std::uint64_t(mEnd - mPos)) return fail("invalid monomial");
+	Monomial::Content exponents;
+	exponents.reserve(std::size_t(size));
+	exponent tdeg = 0;
+	for (std::uint64_t i = 0; i < size; i++) {
+		std::size_t var;
+		std::uint64_t exp;
+		if (!index(mVariables.size(), var) || !number(exp)) return false;
+		if (exp == 0) return fail("invalid monomial");
+		exponents.emplace_back(mVariables[var], exponent(exp));
+		tdeg += exponent(exp);
+	}
+	// The order of the variables may differ from the one they were written in.
+	std::sort(exponents.begin(), exponents.end(), [](const std::pair<Variable, exponent>& a, const std::pair<Variable, exponent>& b){ return a.first < b.first; });
+	for (std::size_t i = 1; i < exponents.size(); i++) {
+		if (exponents[i - 1].first == exponents[i].first) return fail("invalid monomial");
+	}
+	mMonomials.push_back(createMonomial(std::move(exponents), tdeg));
+	return true;
+}
+
+template<typename Pol>
+bool BinaryReader<Pol>::polynomial(Pol& _pol) {
+	std::uint64_t size;
+	if (!number(size)) return false;
+	if (size > std::uint64_t(mEnd - mPos)) return fail("invalid polynomial");
+	typename Pol::TermsType terms;
+	terms.reserve(std::size_t(size));
+	for (std::uint64_t i = 0; i < size; i++) {
+		std::size_t monomial;
+		Coeff c;
+		if (!index(mMonomials.size() + 1, monomial) || !coefficient(c)) return false;
+		terms.emplace_back(std::move(c), monomial == 0 ? nullptr : mMonomials[monomial - 1]);
+	}
+	// Terms are unique, but may have to be reordered.
+	_pol = Pol(std::move(terms), false, false);
+	return true;
+}
+
+template<typename Pol>
+bool BinaryReader<Pol>::readConstraint() {
+	std::uint64_t relation;
+	Pol lhs;
+	if (!number(relation)) return false;
+	if (relation > std::uint64_t(Relation::GEQ)) return fail("invalid relation");
+	if (!polynomial(lhs)) return false;
+	mConstraints.emplace_back(std::move(lhs), Relation(relation));
+	return true;
+}
+
+template<typename Pol>
+bool BinaryReader<Pol>::readFormula() {
+	std::uint64_t type;
+	std::size_t id;
+	if (!number(type)) return false;
+	switch (FormulaType(type)) {
+		case TRUE:
+		case FALSE:
+			mFormulas.emplace_back(FormulaType(type));
+			return true;
+		case BOOL:
+			if (!index(mVariables.size(), id)) return false;
+			mFormulas.emplace_back(mVariables[id]);
+			return true;
+		case CONSTRAINT:
+			if (!index(mConstraints.size(), id)) return false;
+			mFormulas.emplace_back(mConstraints[id]);
+			return true;
+		case NOT:
+			if (!index(mFormulas.size(), id)) return false;
+			mFormulas.emplace_back(NOT, Formula<Pol>(mFormulas[id]));
+			return true;
+		case EXISTS:
+		case FORALL: {
+			std::uint64_t size;
+			if (!number(size)) return false;
+			if (size > std::uint64_t(mEnd - mPos)) return fail("invalid formula");
+			std::vector<Variable> vars;
+			for (std::uint64_t i = 0; i < size; i++) {
+				if (!index(mVariables.size(), id)) return false;
+				vars.push_back(mVariables[id]);
+			}
+			if (!index(mFormulas.size(), id)) return false;
+			mFormulas.emplace_back(FormulaType(type), std::move(vars), Formula<Pol>(mFormulas[id]));
+			return true;
+		}
+		case ITE:
+		case IMPLIES:
+		case AND:
+		case OR:
+		case XOR:
+		case IFF: {
+			std::uint64_t size;
+			if (!number(size)) return false;
+			if (size > std::uint64_t(mEnd - mPos)) return fail("invalid formula");
+			Formulas<Pol> subformulas;
+			subformulas.reserve(std::size_t(size));
+			for (std::uint64_t i = 0; i < size; i++) {
+				if (!index(mFormulas.size(), id)) return false;
+				subformulas.push_back(mFormulas[id]);
+			}
+			if ((FormulaType(type) == ITE && size != 3) || (FormulaType(type) == IMPLIES && size != 2)) return fail("invalid formula");
+			mFormulas.emplace_back(FormulaType(type), std::move(subformulas));
+			return true;
+		}
+		default:
+			return fail("unsupported formula type");
+	}
+}
+
+template<typename Pol>
+bool BinaryReader<Pol>::root(Record _expected) {
+	while (mValid) {
+		if (mPos == mEnd) return fail("unexpected end of data");
+		auto record = Record(*mPos++);
+		switch (record) {
+			case Record::VARIABLE:
+				readVariable();
+				break;
+			case Record::MONOMIAL:
+				readMonomial();
+				break;
+			case Record::CONSTRAINT:
+				readConstraint();
+				break;
+			case Record::FORMULA:
+				readFormula();
+				break;
+			default:
+				if (record != _expected) return fail("unexpected kind of object");
+				return true;
+		}
+	}
+	return false;
+}
+
+}
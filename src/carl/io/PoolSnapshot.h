@@ -0,0 +1,221 @@
+/**
+ * @file PoolSnapshot.h
+ *
+ * A snapshot consists of the magic string "CARLPOOL", followed by
+ * - for each variable type, the number of variables and a list of the named ones as pairs of id and name,
+ * - the number of monomials and the number of constraints,
+ * - a stream of a BinaryWriter containing all variables, monomials and constraints, each ordered by id.
+ *
+ * All numbers are unsigned LEB128 varints. The file contains no addresses and can be used by
+ * every process, regardless of where it is mapped.
+ */
+
+#pragma once
+
+#include "../core/MonomialPool.h"
+#include "../core/VariablePool.h"
+#include "../formula/Constraint.h"
+#include "../util/MappedFile.h"
+#include "BinarySerialization.h"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Snapshot of the contents of the VariablePool, MonomialPool and ConstraintPool.
+ *
+ * Loading a snapshot recreates all variables with their original ids and names and rebuilds
+ * all monomials and constraints in the order of their ids, such that objects constructed
+ * afterwards are found in the pools instead of being created again. Only variables keep their
+ * ids: monomials and constraints are identified by their contents and obtain the ids the
+ * loading pools assign, which differ from the original ones if the writer had freed ids.
+ * The loaded monomials and constraints are kept alive by the snapshot object.
+ */
+template<typename Pol>
+class PoolSnapshot {
+private:
+	static constexpr const char* MAGIC = "CARLPOOL";
+	static constexpr std::size_t MAGIC_SIZE = 8;
+
+	std::vector<Monomial::Arg> mMonomials;
+	std::vector<Constraint<Pol>> mConstraints;
+
+	static bool fail(const std::string& _message) {
+		(void)_message;
+		CARL_LOG_ERROR("carl.io", "Loading pool snapshot failed: " << _message);
+		return false;
+	}
+
+	/// Checks whether the variable has a name set via VariablePool::setName().
+	static bool hasName(Variable _var) {
+		const VariablePool& pool = VariablePool::getInstance();
+		return pool.getName(_var, true) != pool.getName(_var, false);
+	}
+
+	bool restoreVariables(const char*& _pos, const char* _end, std::vector<Variable>& _vars);
+
+public:
+	/**
+	 * Serializes the current contents of the pools.
+	 * @return The snapshot.
+	 */
+	static std::string serialize();
+
+	/**
+	 * Writes a snapshot of the current contents of the pools to the given file.
+	 * @param _filename Name of the file.
+	 * @return true, if the file could be written.
+	 */
+	static bool write(const std::string& _filename) {
+		std::ofstream out(_filename, std::ios::binary | std::ios::trunc);
+		if (!out) return fail("could not open " + _filename);
+		std::string data = serialize();
+		out.write(data.data(), std::streamsize(data.size()));
+		return bool(out);
+	}
+
+	/**
+	 * Restores the snapshot contained in the given buffer.
+	 * Variables that already exist in the pool are reused, if they have the same name.
+	 * @param _begin Start of the buffer.
+	 * @param _end End of the buffer.
+	 * @return true, if the snapshot was valid and consistent with the current pools.
+	 */
+	bool restore(const char* _begin, const char* _end);
+
+	/**
+	 * Maps the given file read-only and restores the snapshot it contains.
+	 * @param _filename Name of the file.
+	 * @return true, if the snapshot was loaded.
+	 */
+	bool load(const std::string& _filename) {
+		MappedFile file;
+		if (!file.open(_filename)) return fail("could not open " + _filename);
+		return restore(file.begin(), file.end());
+	}
+
+	/**
+	 * @return The restored monomials, ordered by id.
+	 */
+	const std::vector<Monomial::Arg>& monomials() const {
+		return mMonomials;
+	}
+	/**
+	 * @return The restored constraints, ordered by id.
+	 */
+	const std::vector<Constraint<Pol>>& constraints() const {
+		return mConstraints;
+	}
+};
+
+template<typename Pol>
+constexpr const char* PoolSnapshot<Pol>::MAGIC;
+template<typename Pol>
+constexpr std::size_t PoolSnapshot<Pol>::MAGIC_SIZE;
+
+template<typename Pol>
+std::string PoolSnapshot<Pol>::serialize() {
+	std::string res(MAGIC, MAGIC_SIZE);
+	std::vector<Variable> vars;
+	for (std::size_t t = 0; t < std::size_t(VariableType::TYPE_SIZE); t++) {
+		VariableType type = VariableType(t);
+		std::size_t count = VariablePool::getInstance().nrVariables(type);
+		std::vector<Variable> named;
+		for (std::size_t id = 1; id <= count; id++) {
+			vars.emplace_back(id, type);
+			if (hasName(vars.back())) named.push_back(vars.back());
+		}
+		binary_detail::writeVarint(res, count);
+		binary_detail::writeVarint(res, named.size());
+		for (Variable v: named) {
+			std::string name = v.getName();
+			binary_detail::writeVarint(res, v.getId());
+			binary_detail::writeVarint(res, name.size());
+			res += name;
+		}
+	}
+	auto monomials = MonomialPool::getInstance().monomials();
+	auto constraints = ConstraintPool<Pol>::getInstance().constraints();
+	binary_detail::writeVarint(res, monomials.size());
+	binary_detail::writeVarint(res, constraints.size());
+
+	BinaryWriter<Pol> writer;
+	for (Variable v: vars) writer.write(v);
+	for (const auto& m: monomials) writer.write(m);
+	for (const auto& c: constraints) writer.write(c);
+	return res + writer.data();
+}
+
+template<typename Pol>
+bool PoolSnapshot<Pol>::restoreVariables(const char*& _pos, const char* _end, std::vector<Variable>& _vars) {
+	VariablePool& pool = VariablePool::getInstance();
+	for (std::size_t t = 0; t < std::size_t(VariableType::TYPE_SIZE); t++) {
+		VariableType type = VariableType(t);
+		std::uint64_t count;
+		std::uint64_t named;
+		if (!binary_detail::readVarint(_pos, _end, count) || !binary_detail::readVarint(_pos, _end, named)) return fail("unexpected end of data");
+		if (named > count) return fail("invalid variable table");
+		while (pool.nrVariables(type) < count) freshVariable(type);
+		for (std::uint64_t i = 0; i < named; i++) {
+			std::uint64_t id;
+			std::uint64_t length;
+			if (!binary_detail::readVarint(_pos, _end, id) || !binary_detail::readVarint(_pos, _end, length)) return fail("unexpected end of data");
+			if (id == 0 || id > count) return fail("invalid variable id");
+			if (std::uint64_t(_end - _pos) < length) return fail("unexpected end of data");
+			std::string name(_pos, std::size_t(length));
+			_pos += length;
+			Variable v(std::size_t(id), type);
+			if (!hasName(v)) {
+				pool.setName(v, name);
+			} else if (v.getName() != name) {
+				return fail("variable " + name + " is already named " + v.getName());
+			}
+		}
+		for (std::size_t id = 1; id <= count; id++) _vars.emplace_back(id, type);
+	}
+	return true;
+}
+
+template<typename Pol>
+bool PoolSnapshot<Pol>::restore(const char* _begin, const char* _end) {
+	const char* pos = _begin;
+	if (std::size_t(_end - pos) < MAGIC_SIZE || std::memcmp(pos, MAGIC, MAGIC_SIZE) != 0) return fail("missing header");
+	pos += MAGIC_SIZE;
+	std::vector<Variable> vars;
+	if (!restoreVariables(pos, _end, vars)) return false;
+	std::uint64_t monomials;
+	std::uint64_t constraints;
+	if (!binary_detail::readVarint(pos, _end, monomials) || !binary_detail::readVarint(pos, _end, constraints)) return fail("unexpected end of data");
+
+	BinaryReader<Pol> reader(pos, _end);
+	for (Variable v: vars) {
+		// Each variable is defined by its own root, hence variables of the same name are told apart.
+		reader.addVariable(v);
+		Variable w;
+		if (!reader.read(w)) return fail("invalid variable");
+		if (w != v) return fail("variable " + w.getName() + " does not match its id");
+	}
+	std::vector<Monomial::Arg> ms;
+	std::vector<Constraint<Pol>> cs;
+	ms.reserve(std::size_t(std::min(monomials, std::uint64_t(_end - pos))));
+	cs.reserve(std::size_t(std::min(constraints, std::uint64_t(_end - pos))));
+	for (std::uint64_t i = 0; i < monomials; i++) {
+		ms.emplace_back();
+		if (!reader.read(ms.back())) return fail("invalid monomial");
+	}
+	for (std::uint64_t i = 0; i < constraints; i++) {
+		cs.emplace_back();
+		if (!reader.read(cs.back())) return fail("invalid constraint");
+	}
+	if (!reader.atEnd()) return fail("trailing data");
+	mMonomials.insert(mMonomials.end(), ms.begin(), ms.end());
+	mConstraints.insert(mConstraints.end(), cs.begin(), cs.end());
+	return true;
+}
+
+}
@@ -10,9 +10,9 @@
 #include "../../core/MultivariatePolynomial.h"
 #include "../TarskiQuery/TarskiQueryManager.h"
 #include "SignCondition.h"
+#include "SparseSignMatrix.h"
 
-#include <eigen3/Eigen/Dense>
-#include <cmath>
+#include <cstdlib>
 #include <iterator>
 #include <list>
 #include <queue>
@@ -30,6 +30,7 @@ private:
 	// an alpha is a mapping from a set of polynomials to the set
 	// {0,1,2} in order to perform sign determination
 	using Alpha = std::list<uint>;
+	using Matrix = SparseSignMatrix<Number>;
 	
 	std::list<Polynomial> mP;
 	TarskiQueryManager<Number> mTaQ;
@@ -37,7 +38,7 @@ private:
 	std::list<Polynomial> mProducts;
 	std::list<Alpha> mAda;
 	std::list<uint> mAdaHelper;
-	Eigen::MatrixXf mMatrix;
+	Matrix mMatrix;
 	bool mNeedsUpdate;
 	
 	
@@ -103,47 +104,19 @@ private:
 		}
 		return res;
 	}       
-	static Eigen::MatrixXf adaptedMat(const std::list<Alpha>& ada, const std::list<SignCondition>& signs) {
-		Eigen::MatrixXf res(ada.size(), signs.size());
-		long i = 0;
-		long j = 0;
+	static Matrix adaptedMat(const std::list<Alpha>& ada, const std::list<SignCondition>& signs) {
+		Matrix res(signs.size());
 		for (const auto& alpha : ada) {
+			typename Matrix::Row row;
+			std::size_t j = 0;
 			for (const auto& sigma : signs) {
-				res(i, j) = float(sigmaToTheAlpha(alpha, sigma));
+				int entry = sigmaToTheAlpha(alpha, sigma);
+				if (entry != 0) row.emplace_back(j, Number(entry));
 				j++;
 			}
-			j = 0;
-			i++;
+			res.addRow(std::move(row));
 		}
 		return res;
-	} 
-	static Eigen::MatrixXf kroneckerProduct(const Eigen::MatrixXf& m1, const Eigen::MatrixXf& m2) {
-		Eigen::MatrixXf m3(m1.rows() * m2.rows(), m1.cols() * m2.cols());
-		for(int i = 0; i < m1.cols(); i++) {
-			for(int j = 0; j < m1.rows(); j++) {
-				m3.block(i * m2.rows(), j * m2.cols(), m2.rows(), m2.cols()) =  m1(i, j) * m2;
-			}
-		}
-		return m3;
-	}
-	static void removeColumn(Eigen::MatrixXf& matrix, long colToRemove) {
-		long numRows = matrix.rows();
-		long numCols = matrix.cols()-1;
-
-		if (colToRemove < numCols) {
-			matrix.block(0, colToRemove, numRows, numCols - colToRemove) = matrix.block(0, colToRemove + 1 ,numRows, numCols - colToRemove);
-		}
-		matrix.conservativeResize(numRows, numCols);
-	} 
-	static void removeRow(Eigen::MatrixXf& matrix, long rowToRemove) {
-		long numRows = matrix.rows()-1;
-		long numCols = matrix.cols();
-
-		if (rowToRemove < numRows) {
-			matrix.block(rowToRemove,0,numRows-rowToRemove,numCols) = matrix.block(rowToRemove+1,0,numRows-rowToRemove,numCols);
-		}
-
-		matrix.conservativeResize(numRows,numCols);
 	}
 	
 	std::list<Polynomial> computeProducts(const Polynomial& p, const std::list<Alpha>& currAda) const {
@@ -167,41 +140,25 @@ private:
 		return result;
 	}
 	
+	/*
+	 * Selects the first n linearly independent rows of mat, which is the first subset of n
+	 * rows of full rank in lexicographic order. The rows are selected greedily by incremental
+	 * Gaussian elimination.
+	 */
 	std::list<Alpha> firstNLines(
 			const uint n,
-			const Eigen::MatrixXf& mat,
+			const Matrix& mat,
 			const std::vector<Alpha>& ada,
 			std::vector<Polynomial>& products,
 			const uint q) const {
 		CARL_LOG_ASSERT("carl.thom.sign", n > 0, "");
-		std::vector<uint> lines(ada.size(), 0);
 		assert(n <= ada.size());
-		assert((uint)mat.rows() == ada.size());
-		for (std::size_t i = 0; i < n; i++) {
-			lines[i] = 1;
-		}
-
-		do {
-			Eigen::MatrixXf linesMat(n, mat.cols());
-			long row = 0;
-			for(std::size_t i = 0; i < lines.size(); i++) {
-				if (lines[i] == 0) continue;
-				for (long j = 0; j < mat.cols(); j++) {
-					linesMat(row, j) = mat(long(i), j);
-				}
-				row++;
-			}
-			Eigen::FullPivLU<Eigen::MatrixXf> dec(linesMat);
-			if (dec.rank() == int(n)) break;
-
-		}
-		while(std::prev_permutation(lines.begin(), lines.end()));
-
-
+		assert(mat.rows() == ada.size());
+		SparseRankTracker<Number> tracker;
 		std::list<Alpha> res;
 		std::vector<Polynomial> newProducts;
-		for(uint i = 0; i < lines.size(); i++) {
-			if(lines[i] == 1) {
+		for (std::size_t i = 0; i < mat.rows() && tracker.rank() < n; i++) {
+			if (tracker.add(mat.row(i))) {
 				res.push_back(ada[i]);
 				newProducts.push_back(products[q*ada.size() + i]);
 			}
@@ -210,6 +167,19 @@ private:
 		products = newProducts;
 		return res;
 	}
+	
+	/*
+	 * Selects the columns of mMatrix that correspond to sign conditions that are realized with at least the given multiplicity.
+	 */
+	Matrix columnsWithMultiplicity(uint multiplicity, uint& count) const {
+		std::vector<bool> keep;
+		count = 0;
+		for (const auto& n : mAdaHelper) {
+			keep.push_back(n >= multiplicity);
+			if (n >= multiplicity) count++;
+		}
+		return mMatrix.selectColumns(keep);
+	}
        
 	void update() {
 		std::list<Alpha> newAda = mAda;
@@ -219,18 +189,8 @@ private:
 		uint r1 = mAda.size();
 		if(mSigns.size() != r1) {
 			CARL_LOG_TRACE("carl.thom.sign", "need to compute r2");
-			Eigen::MatrixXf m2 = mMatrix;
 			uint r2 = 0;
-			long index = 0;
-			for(const auto& n : mAdaHelper) {
-				if(n >= 2) {
-					r2++;
-					index++;
-				}
-				else {
-					removeColumn(m2, index);
-				}    
-			}
+			Matrix m2 = columnsWithMultiplicity(2, r2);
 			std::vector<Polynomial> products(mProducts.begin(), mProducts.end());
 			std::list<Alpha> A_2 = firstNLines(
 				r2, 
@@ -247,18 +207,8 @@ private:
 			}
 			if(mSigns.size() != r1 + r2) {
 				CARL_LOG_TRACE("carl.thom.sign", "need to compute r3");
-				Eigen::MatrixXf m3 = mMatrix;
 				uint r3 = 0;
-				index = 0;
-				for(const auto& n : mAdaHelper) {
-					if(n >= 3) {
-						r3++;
-						index++;
-					}
-					else {
-						removeColumn(m3, index);
-					}      
-				}
+				Matrix m3 = columnsWithMultiplicity(3, r3);
 				products = std::vector<Polynomial>(mProducts.begin(), mProducts.end());
 				std::list<Alpha> A_3 = firstNLines(
 					r3,
@@ -277,7 +227,7 @@ private:
 		}
 		mAda = newAda;
 		mMatrix = adaptedMat(mAda, mSigns);
-		CARL_LOG_ASSERT("carl.thom.sign", Eigen::FullPivLU<Eigen::MatrixXf>(mMatrix).rank() == mMatrix.cols(), "mMatrix must be invertible!");
+		CARL_LOG_ASSERT("carl.thom.sign", mMatrix.rows() == mMatrix.cols() && mMatrix.rank() == mMatrix.cols(), "mMatrix must be invertible!");
 		mProducts = adaptedProducts;
 		mNeedsUpdate = false;
 		CARL_LOG_DEBUG("carl.thom.sign", *this);
@@ -288,7 +238,7 @@ private:
 			std::list<Polynomial>& products,
 			std::list<Alpha>& ada,
 			std::list<uint>& adaHelper,
-			Eigen::MatrixXf& matrix
+			Matrix& matrix
 	) {
 		if(mNeedsUpdate) this->update();
 		
@@ -321,7 +271,7 @@ private:
 		currAda = {{0}, {1}, {2}};
 		currAda.resize(currSigns.size());
 		currProducts.resize(currSigns.size());     
-		Eigen::MatrixXf currM = adaptedMat(currAda, currSigns);
+		Matrix currM = adaptedMat(currAda, currSigns);
 		// means that p is the first polynomial ever processed in this sign determination
 		if(mP.empty()) {
 			products = currProducts;
@@ -334,26 +284,33 @@ private:
 		// (2)
 		products = this->computeProducts(p, currAda);
 		
-		Eigen::VectorXf dprime(long(products.size()));
-		long index = 0;
+		// Solve (currM x mMatrix) * c = d', where x is the Kronecker product.
+		// With c and d' as matrices C and D of size |currSigns| x |mSigns|, this is
+		// currM * C * mMatrix^T = D, which is solved without forming the Kronecker product:
+		// first mMatrix * Z = D^T, then currM * C = Z^T.
+		std::size_t rows = currSigns.size();
+		std::size_t cols = mSigns.size();
+		CARL_LOG_ASSERT("carl.thom.sign", products.size() == rows * cols, "failure in sign determination");
+		std::vector<std::vector<Number>> z(cols, std::vector<Number>(rows));
+		std::size_t index = 0;
 		for (const auto& prod : products) {
-			dprime(index) = float(mTaQ(prod));
+			z[index % cols][index / cols] = Number(mTaQ(prod));
 			index++;
 		}
-		
-		Eigen::MatrixXf M_prime = kroneckerProduct(currM, mMatrix);
-		CARL_LOG_ASSERT("carl.thom.sign", Eigen::FullPivLU<Eigen::MatrixXf>(M_prime).rank() == M_prime.cols(), "M_prime must be invertible!");
-		Eigen::PartialPivLU<Eigen::MatrixXf> dec(M_prime);
-		Eigen::VectorXf c = dec.solve(dprime);
-		CARL_LOG_ASSERT("carl.thom.sign", (uint)c.size() == currSigns.size() * mSigns.size(), "failure in sign determination");
+		mMatrix.solve(z);
+		std::vector<std::vector<Number>> c(rows, std::vector<Number>(cols));
+		for (std::size_t i = 0; i < rows; i++) {
+			for (std::size_t j = 0; j < cols; j++) c[i][j] = std::move(z[j][i]);
+		}
+		currM.solve(c);
 		
 		std::list<SignCondition> newSigns;
 		adaHelper = std::list<uint>(mSigns.size(), 0);
-		long k = 0;
-		for(long i = 0; i < long(currSigns.size()); i++) {
+		for(std::size_t i = 0; i < rows; i++) {
 			auto helper_it = adaHelper.begin();
+			std::size_t j = 0;
 			for(const auto& sigma : mSigns) {
-				if ((std::round(c(k))) != 0) {
+				if (!carl::isZero(c[i][j])) {
 					uint tmp = *helper_it;
 					helper_it = adaHelper.erase(helper_it);
 					helper_it = adaHelper.insert(helper_it, ++tmp);
@@ -364,7 +321,7 @@ private:
 					newSigns.push_back(newCond);
 				}
 				helper_it++;
-				k++;
+				j++;
 			}
 			helper_it = adaHelper.begin();
 		}
@@ -382,7 +339,7 @@ public:
 		std::list<Polynomial> dummyProducts;
 		std::list<Alpha> dummyAda;
 		std::list<uint> dummyHelper;
-		Eigen::MatrixXf dummyMatrix;
+		Matrix dummyMatrix;
 		std::list<SignCondition> newSigns = getSigns(p, dummyProducts, dummyAda, dummyHelper, dummyMatrix);
 		return newSigns;
 	}
@@ -391,7 +348,7 @@ public:
 		std::list<Polynomial> newProducts;
 		std::list<Alpha> newAda;
 		std::list<uint> newHelper;
-		Eigen::MatrixXf newMatrix;
+		Matrix newMatrix;
 		std::list<SignCondition> newSigns = getSigns(p, newProducts, newAda, newHelper, newMatrix);
 		mNeedsUpdate = true;
 		if(mP.empty()) {
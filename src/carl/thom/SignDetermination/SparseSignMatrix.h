@@ -0,0 +1,207 @@
+/**
+ * @file SparseSignMatrix.h
+ *
+ * Exact sparse linear algebra for the matrices of sign determination.
+ */
+
+#pragma once
+
+#include "../../core/logging.h"
+#include "../../numbers/numbers.h"
+
+#include <cassert>
+#include <map>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Sparse matrix with exact entries, stored row by row.
+ * Every row is a list of columns and values, ordered by column and without zero values.
+ * The adapted matrices of sign determination only have entries -1, 0 and 1, and stay sparse
+ * as most sign conditions contain zeros.
+ */
+template<typename Number>
+class SparseSignMatrix {
+public:
+	using Row = std::vector<std::pair<std::size_t, Number>>;
+private:
+	std::size_t mCols;
+	std::vector<Row> mRows;
+
+public:
+	explicit SparseSignMatrix(std::size_t cols = 0): mCols(cols), mRows() {}
+
+	std::size_t rows() const { return mRows.size(); }
+	std::size_t cols() const { return mCols; }
+	const Row& row(std::size_t i) const {
+		assert(i < mRows.size());
+		return mRows[i];
+	}
+
+	/**
+	 * Appends a row, given as ordered nonzero entries.
+	 */
+	void addRow(Row row) {
+		assert(row.empty() || row.back().first < mCols);
+		mRows.push_back(std::move(row));
+	}
+
+	/// @return The value in the given column of the row.
+	static Number entry(const Row& row, std::size_t col) {
+		for (const auto& e: row) {
+			if (e.first == col) return e.second;
+			if (e.first > col) break;
+		}
+		return Number(0);
+	}
+	Number operator()(std::size_t i, std::size_t j) const {
+		return entry(row(i), j);
+	}
+
+	/**
+	 * Computes row := row + factor * other.
+	 */
+	static void addMultiple(Row& row, const Number& factor, const Row& other) {
+		Row res;
+		res.reserve(row.size() + other.size());
+		auto r = row.begin();
+		auto o = other.begin();
+		while (r != row.end() || o != other.end()) {
+			if (o == other.end() || (r != row.end() && r->first < o->first)) {
+				res.push_back(std::move(*r++));
+			} else if (r == row.end() || o->first < r->first) {
+				res.emplace_back(o->first, factor * o->second);
+				++o;
+			} else {
+				Number sum = r->second + factor * o->second;
+				if (!carl::isZero(sum)) res.emplace_back(r->first, std::move(sum));
+				++r;
+				++o;
+			}
+		}
+		row = std::move(res);
+	}
+
+	/**
+	 * @return The matrix consisting of the columns j where keep[j] is true.
+	 */
+	SparseSignMatrix selectColumns(const std::vector<bool>& keep) const {
+		assert(keep.size() == mCols);
+		std::vector<std::size_t> index(mCols, 0);
+		std::size_t cols = 0;
+		for (std::size_t j = 0; j < mCols; j++) {
+			if (keep[j]) index[j] = cols++;
+		}
+		SparseSignMatrix res(cols);
+		for (const auto& r: mRows) {
+			Row row;
+			for (const auto& e: r) {
+				if (keep[e.first]) row.emplace_back(index[e.first], e.second);
+			}
+			res.addRow(std::move(row));
+		}
+		return res;
+	}
+
+	/// @return The rank of the matrix.
+	std::size_t rank() const;
+
+	/**
+	 * Solves this * X = B for a square invertible matrix by sparse Gauss-Jordan elimination.
+	 * Pivots are chosen among the rows with the fewest entries to reduce the fill-in.
+	 * @param rhs The rows of B, which are replaced by the rows of X.
+	 */
+	void solve(std::vector<std::vector<Number>>& rhs) const;
+};
+
+/**
+ * Incremental Gaussian elimination that tracks the rank of a growing set of rows.
+ * The rows added so far are kept in echelon form, indexed by the column of their first entry.
+ */
+template<typename Number>
+class SparseRankTracker {
+	using Row = typename SparseSignMatrix<Number>::Row;
+	std::map<std::size_t, Row> mBasis;
+public:
+	/**
+	 * Adds a row if it is linearly independent of the rows added so far.
+	 * @return true, if the rank increased.
+	 */
+	bool add(Row row) {
+		while (!row.empty()) {
+			auto it = mBasis.find(row.front().first);
+			if (it == mBasis.end()) {
+				std::size_t pivot = row.front().first;
+				mBasis.emplace(pivot, std::move(row));
+				return true;
+			}
+			Number factor = -row.front().second / it->second.front().second;
+			SparseSignMatrix<Number>::addMultiple(row, factor, it->second);
+		}
+		return false;
+	}
+	std::size_t rank() const {
+		return mBasis.size();
+	}
+};
+
+template<typename Number>
+std::size_t SparseSignMatrix<Number>::rank() const {
+	SparseRankTracker<Number> tracker;
+	for (const auto& r: mRows) tracker.add(r);
+	return tracker.rank();
+}
+
+template<typename Number>
+void SparseSignMatrix<Number>::solve(std::vector<std::vector<Number>>& rhs) const {
+	assert(rows() == cols() && rhs.size() == rows());
+	std::size_t n = rows();
+	std::vector<Row> m(mRows);
+	std::vector<bool> used(n, false);
+	std::vector<std::size_t> pivots(n);
+	for (std::size_t k = 0; k < n; k++) {
+		std::size_t p = n;
+		for (std::size_t i = 0; i < n; i++) {
+			if (used[i] || carl::isZero(entry(m[i], k))) continue;
+			if (p == n || m[i].size() < m[p].size()) p = i;
+		}
+		CARL_LOG_ASSERT("carl.thom.sign", p < n, "matrix is singular");
+		used[p] = true;
+		pivots[k] = p;
+		Number pivot = entry(m[p], k);
+		for (std::size_t i = 0; i < n; i++) {
+			if (i == p) continue;
+			Number e = entry(m[i], k);
+			if (carl::isZero(e)) continue;
+			Number factor = -e / pivot;
+			addMultiple(m[i], factor, m[p]);
+			for (std::size_t c = 0; c < rhs[i].size(); c++) {
+				rhs[i][c] += factor * rhs[p][c];
+			}
+		}
+	}
+	// Every pivot row now only contains its pivot.
+	std::vector<std::vector<Number>> res(n);
+	for (std::size_t k = 0; k < n; k++) {
+		Number pivot = entry(m[pivots[k]], k);
+		res[k] = std::move(rhs[pivots[k]]);
+		for (auto& v: res[k]) v /= pivot;
+	}
+	rhs = std::move(res);
+}
+
+template<typename Number>
+std::ostream& operator<<(std::ostream& os, const SparseSignMatrix<Number>& m) {
+	for (std::size_t i = 0; i < m.rows(); i++) {
+		for (std::size_t j = 0; j < m.cols(); j++) {
+			os << (j == 0 ? "" : " ") << m(i, j);
+		}
+		os << std::endl;
+	}
+	return os;
+}
+
+} // namespace carl
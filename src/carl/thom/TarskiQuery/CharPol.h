@@ -8,6 +8,7 @@
 #pragma once
 
 #include <eigen3/Eigen/Dense>
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -91,4 +92,59 @@ std::vector<Coeff> charPol(const CoeffMatrix<Coeff>& m) {
 	return res;
 }
 
+/*
+ * computes the characteristic polynomial with the division free algorithm of Berkowitz.
+ * The characteristic polynomial of the trailing principal submatrices is extended by one row and
+ * column at a time, by multiplying it with a Toeplitz matrix of the entries -R * M^i * C, where M is
+ * the previous submatrix and R and C are the new row and column.
+ * This needs O(n^4) ring operations, but in contrast to elimination based methods the intermediate
+ * values are polynomials in the entries of m and do not grow beyond the coefficients of the result.
+ * The coefficients are returned in increasing order of the degree, as by charPol.
+ */
+template<typename Coeff>
+std::vector<Coeff> charPolBerkowitz(const CoeffMatrix<Coeff>& m) {
+	CARL_LOG_FUNC("carl.thom.tarski", "");
+	long n = m.cols();
+	CARL_LOG_ASSERT("carl.thom.tarski", n == m.rows(), "can only compute characteristic polynomial of square matrix");
+	CARL_LOG_INFO("carl.thom.tarski", "input has size " << n << "x" << n);
+	// the characteristic polynomial of the trailing submatrix, the leading coefficient first
+	std::vector<Coeff> p = {Coeff(1)};
+	std::vector<Coeff> t;
+	std::vector<Coeff> v;
+	std::vector<Coeff> w;
+	std::vector<Coeff> next;
+	for(long k = n - 1; k >= 0; k--) {
+		// the trailing submatrix M consists of the rows and columns k+1, ..., n-1
+		std::size_t size = std::size_t(n - 1 - k);
+		t.assign(size + 2, Coeff(0));
+		t[0] = Coeff(1);
+		t[1] = -m(k, k);
+		v.resize(size);
+		for(std::size_t l = 0; l < size; l++) v[l] = m(k + 1 + long(l), k);
+		for(std::size_t i = 2; i < size + 2; i++) {
+			Coeff d(0);
+			for(std::size_t l = 0; l < size; l++) d += m(k, k + 1 + long(l)) * v[l];
+			t[i] = -d;
+			if(i + 1 == size + 2) break;
+			w.assign(size, Coeff(0));
+			for(std::size_t r = 0; r < size; r++) {
+				for(std::size_t l = 0; l < size; l++) {
+					w[r] += m(k + 1 + long(r), k + 1 + long(l)) * v[l];
+				}
+			}
+			std::swap(v, w);
+		}
+		next.assign(size + 2, Coeff(0));
+		for(std::size_t i = 0; i < size + 2; i++) {
+			for(std::size_t j = 0; j <= std::min(i, size); j++) {
+				next[i] += t[i - j] * p[j];
+			}
+		}
+		std::swap(p, next);
+	}
+	std::reverse(p.begin(), p.end());
+	CARL_LOG_INFO("carl.thom.tarski", "done computing the char pol ... ");
+	return p;
+}
+
 } // namespace carl
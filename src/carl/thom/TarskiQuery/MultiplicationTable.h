@@ -9,6 +9,10 @@
 
 #include "GroebnerBase.h"
 
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
 namespace carl {
 	
 	
@@ -74,13 +78,27 @@ private:
 	// the groebner base object is used to compute reductions
 	GroebnerBase<Number> mGb;
 	
+	// the base representations of all products of two base elements in compressed sparse row format,
+	// the entries of row r are mColumns[k] and mValues[k] for mRowStart[r] <= k < mRowStart[r+1]
+	std::vector<std::size_t> mRowStart;
+	std::vector<uint> mColumns;
+	std::vector<Number> mValues;
+	
+	// the row of the product of the i-th and the j-th base element is mProductRow[i * base size + j]
+	std::vector<std::size_t> mProductRow;
+	
+	// the traces of the multiplication by each base element and by the product of each row
+	std::vector<Number> mTraces;
+	std::vector<Number> mRowTraces;
+	
 public:
 	
-	MultiplicationTable() : mTable(), mBase(), mGb() {}
+	MultiplicationTable() : mTable(), mBase(), mGb(), mRowStart(), mColumns(), mValues(), mProductRow(), mTraces(), mRowTraces() {}
 	
 	explicit MultiplicationTable(const GroebnerBase<Number>& gb) : mGb(gb){
 		CARL_LOG_ASSERT("carl.thom.tarski.table", gb.hasFiniteMon(), "tried to set up a multiplication table on infinite basis");
 		init(gb);
+		initSparse();
 		CARL_LOG_TRACE("carl.thom.tarski.table", "done setting up multiplication table:\n" << *this);
 	}
 	
@@ -117,32 +135,78 @@ public:
 	}
 	
 	BaseRepresentation<Number> multiply(const BaseRepresentation<Number>& f, const BaseRepresentation<Number>& g) const {
-		BaseRepresentation<Number> res;
-		for(const auto& entry : this->mTable) {
-			if(entry.second.br.isZero()) continue;
-			for(const auto& index_coeff : entry.second.br) {
-				Number newCoeff(0);
-				for(const auto& pair : entry.second.pairs) {
-					newCoeff += f.get(pair.first) * g.get(pair.second);
-				}
-				if(newCoeff != 0) {
-					res[index_coeff.first] += newCoeff * index_coeff.second;
+		std::vector<Number> res(mBase.size(), Number(0));
+		for(const auto& fi : f) {
+			for(const auto& gj : g) {
+				Number coeff = fi.second * gj.second;
+				std::size_t row = productRow(fi.first, gj.first);
+				for(std::size_t k = mRowStart[row]; k < mRowStart[row + 1]; k++) {
+					res[mColumns[k]] += coeff * mValues[k];
 				}
 			}
 		}
-		return res;
+		BaseRepresentation<Number> result;
+		for(uint i = 0; i < res.size(); i++) {
+			if(res[i] != 0) result.emplace_hint(result.end(), i, res[i]);
+		}
+		return result;
 	}
 	
-	
+	/*
+	 * the trace of the multiplication by f, which is linear in f
+	 */
 	Number trace(const BaseRepresentation<Number>& f) const {
 		Number res(0);
 		for(const auto& index_coeff : f) {
-			for(uint i = 0; i < mBase.size(); i++) {
-				Monomial prod = mBase[index_coeff.first] * mBase[i];
-				BaseRepresentation<Number> prod_br = this->getEntry(prod).br;
-				res += index_coeff.second * prod_br.get(i);
-			}		   
+			res += index_coeff.second * mTraces[index_coeff.first];
+		}
+		return res;
+	}
+	
+	/*
+	 * computes the matrix m with m(i,j) = trace(q * b_i * b_j) for the base elements b_i, b_j.
+	 * With w_k = trace(q * b_k) and b_i * b_j = sum_k c_k * b_k we have trace(q * b_i * b_j) = sum_k c_k * w_k,
+	 * so every row of the table is evaluated only once.
+	 */
+	template<typename Matrix>
+	void traceMatrix(const BaseRepresentation<Number>& q, Matrix& m) const {
+		std::size_t n = mBase.size();
+		std::vector<Number> w(n, Number(0));
+		for(const auto& index_coeff : q) {
+			for(std::size_t k = 0; k < n; k++) {
+				w[k] += index_coeff.second * mRowTraces[productRow(index_coeff.first, k)];
+			}
+		}
+		std::vector<Number> rowValues(mRowStart.size() - 1, Number(0));
+		for(std::size_t row = 0; row + 1 < mRowStart.size(); row++) {
+			for(std::size_t k = mRowStart[row]; k < mRowStart[row + 1]; k++) {
+				rowValues[row] += mValues[k] * w[mColumns[k]];
+			}
+		}
+		for(std::size_t i = 0; i < n; i++) {
+			for(std::size_t j = 0; j < n; j++) {
+				m(long(i), long(j)) = rowValues[productRow(i, j)];
+			}
 		}
+	}
+	
+	/*
+	 * an estimate of the memory used by the table in bytes, not accounting for the memory of big numbers
+	 */
+	std::size_t memory() const {
+		std::size_t res = sizeof(*this);
+		for(const auto& entry : mTable) {
+			std::size_t pairs = std::size_t(std::distance(entry.second.pairs.begin(), entry.second.pairs.end()));
+			res += sizeof(entry) + 2 * sizeof(void*);
+			res += entry.second.br.size() * (sizeof(std::pair<uint, Number>) + 4 * sizeof(void*));
+			res += pairs * (sizeof(std::pair<uint, uint>) + sizeof(void*));
+		}
+		for(const auto& g : mGb.get()) {
+			res += sizeof(g) + g.size() * sizeof(Term<Number>);
+		}
+		res += mBase.size() * sizeof(Monomial);
+		res += mRowStart.size() * sizeof(std::size_t) + mColumns.size() * sizeof(uint) + mValues.size() * sizeof(Number);
+		res += mProductRow.size() * sizeof(std::size_t) + (mTraces.size() + mRowTraces.size()) * sizeof(Number);
 		return res;
 	}
 	
@@ -151,6 +215,10 @@ public:
 	
 private:
 	
+	std::size_t productRow(std::size_t i, std::size_t j) const {
+		return mProductRow[i * mBase.size() + j];
+	}
+	
 	// returns a list of all pairs of indicdes (i,j) such that base_i * base_j == c
 	IndexPairs indexPairs(const Monomial& c) const {
 		IndexPairs res;
@@ -291,6 +359,46 @@ private:
 			}
 		}
 	}
+	
+	// sets up the compressed sparse rows and the traces from the table
+	void initSparse() {
+		std::size_t n = mBase.size();
+		std::unordered_map<Monomial, std::size_t> rows;
+		mRowStart.assign(1, 0);
+		mProductRow.resize(n * n);
+		for(std::size_t i = 0; i < n; i++) {
+			for(std::size_t j = i; j < n; j++) {
+				Monomial prod = mBase[i] * mBase[j];
+				auto it = rows.find(prod);
+				if(it == rows.end()) {
+					it = rows.emplace(prod, mRowStart.size() - 1).first;
+					for(const auto& index_coeff : getEntry(prod).br) {
+						mColumns.push_back(index_coeff.first);
+						mValues.push_back(index_coeff.second);
+					}
+					mRowStart.push_back(mColumns.size());
+				}
+				mProductRow[i * n + j] = it->second;
+				mProductRow[j * n + i] = it->second;
+			}
+		}
+		// the trace of the multiplication by b_k is the sum of the coefficients of b_i in b_k * b_i
+		mTraces.assign(n, Number(0));
+		for(std::size_t k = 0; k < n; k++) {
+			for(std::size_t i = 0; i < n; i++) {
+				std::size_t row = productRow(k, i);
+				for(std::size_t e = mRowStart[row]; e < mRowStart[row + 1]; e++) {
+					if(mColumns[e] == i) mTraces[k] += mValues[e];
+				}
+			}
+		}
+		mRowTraces.assign(mRowStart.size() - 1, Number(0));
+		for(std::size_t row = 0; row + 1 < mRowStart.size(); row++) {
+			for(std::size_t e = mRowStart[row]; e < mRowStart[row + 1]; e++) {
+				mRowTraces[row] += mValues[e] * mTraces[mColumns[e]];
+			}
+		}
+	}
 };
 
 template<typename C>
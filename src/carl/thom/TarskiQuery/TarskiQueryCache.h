@@ -0,0 +1,288 @@
+/**
+ * @file TarskiQueryCache.h
+ *
+ * Process-wide cache of the data needed for Tarski queries on a zero set.
+ */
+
+#pragma once
+
+#include "../../core/logging.h"
+#include "../../core/MultivariatePolynomial.h"
+#include "../../core/UnivariatePolynomial.h"
+#include "../../util/Singleton.h"
+#include "GroebnerBase.h"
+#include "MultiplicationTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Everything that is computed once for a zero set and used by all Tarski queries on it:
+ * the polynomial and its derivative for a univariate zero set, the multiplication table of the
+ * factor ring otherwise, and the results of all queries so far.
+ *
+ * The results are stored for normalized polynomials, as the query of c*p is sgn(c) times the
+ * query of p. The data is shared by all Tarski query managers on the same zero set.
+ */
+template<typename Number>
+class TarskiQueryData {
+public:
+	using Polynomial = MultivariatePolynomial<Number>;
+	using QueryResultType = int;
+private:
+	// for the univariate case
+	UnivariatePolynomial<Number> mZ;
+	UnivariatePolynomial<Number> mDer;
+	// for the multivariate case
+	MultiplicationTable<Number> mTab;
+	bool mTrivialGb;
+
+	std::map<Polynomial, QueryResultType> mResults;
+	std::size_t mTableMemory;
+	std::atomic<std::size_t> mResultMemory;
+	mutable std::mutex mMutex;
+
+	static std::size_t memory(const Polynomial& p) {
+		return sizeof(Polynomial) + p.size() * (sizeof(Term<Number>) + sizeof(Number));
+	}
+public:
+	/**
+	 * Sets up the data for the zero set of the given polynomials.
+	 * @param system Normalized polynomials.
+	 * @throws std::invalid_argument if the zero set is not zero-dimensional.
+	 */
+	explicit TarskiQueryData(const std::vector<Polynomial>& system):
+		mZ(Variable::NO_VARIABLE), mDer(Variable::NO_VARIABLE), mTab(), mTrivialGb(false), mResults(), mTableMemory(0), mResultMemory(0)
+	{
+		if (system.size() == 1 && system.front().isUnivariate()) {
+			CARL_LOG_TRACE("carl.thom.tarski.cache", "as a UNIVARIATE zero set");
+			mZ = system.front().toUnivariatePolynomial();
+			CARL_LOG_ASSERT("carl.thom.tarski.cache", !mZ.isZero(), "");
+			mDer = mZ.derivative();
+			mTableMemory = memory(system.front()) * 2;
+		} else {
+			CARL_LOG_TRACE("carl.thom.tarski.cache", "as a MULTIVARIATE zero set");
+			GroebnerBase<Number> gb(system.begin(), system.end());
+			if (gb.isTrivialBase()) {
+				mTrivialGb = true;
+			} else {
+				if (!gb.hasFiniteMon()) {
+					CARL_LOG_ERROR("carl.thom.tarski.cache", "Tarski query data on the non zero-dimensional zero set " << system);
+					throw std::invalid_argument("Tarski queries need a zero-dimensional zero set");
+				}
+				mTab = MultiplicationTable<Number>(gb);
+				mTableMemory = mTab.memory();
+			}
+		}
+	}
+
+	bool isUnivariate() const {
+		return !mZ.isZero();
+	}
+	bool isTrivial() const {
+		return mTrivialGb;
+	}
+	const UnivariatePolynomial<Number>& polynomial() const {
+		return mZ;
+	}
+	const UnivariatePolynomial<Number>& derivative() const {
+		return mDer;
+	}
+	const MultiplicationTable<Number>& table() const {
+		return mTab;
+	}
+
+	/**
+	 * Looks up the query result for the normalization n of a polynomial.
+	 * @return true, if the result was found.
+	 */
+	bool lookup(const Polynomial& n, QueryResultType& res) const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto it = mResults.find(n);
+		if (it == mResults.end()) return false;
+		res = it->second;
+		return true;
+	}
+	/**
+	 * Stores the query result for the normalization n of a polynomial.
+	 */
+	void store(const Polynomial& n, QueryResultType res) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mResults.emplace(n, res).second) {
+			mResultMemory += memory(n) + sizeof(QueryResultType) + 4 * sizeof(void*);
+		}
+	}
+	/// @return The number of stored query results.
+	std::size_t results() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mResults.size();
+	}
+	/**
+	 * @return An estimate of the memory used by this object in bytes.
+	 * It accounts for the polynomials and numbers, but not for the memory of big numbers.
+	 */
+	std::size_t memory() const {
+		return sizeof(*this) + mTableMemory + mResultMemory;
+	}
+};
+
+/**
+ * Process-wide cache of the Tarski query data of zero sets.
+ *
+ * Zero sets are identified by their defining system, where the polynomials are normalized,
+ * sorted and duplicates are removed. Thus all ThomEncodings and sign determinations on the same
+ * zero set share one multiplication table and all query results.
+ *
+ * The cache keeps the memory of its entries below a limit by evicting the least recently used
+ * ones, where the memory of an entry is accounted as of its last lookup. Evicted data stays valid
+ * for the managers that still use it.
+ */
+template<typename Number>
+class TarskiQueryCache: public Singleton<TarskiQueryCache<Number>> {
+	friend Singleton<TarskiQueryCache>;
+public:
+	using Polynomial = MultivariatePolynomial<Number>;
+	using Data = TarskiQueryData<Number>;
+	using Key = std::vector<Polynomial>;
+private:
+	struct Entry {
+		Key key;
+		std::shared_ptr<Data> data;
+		/// The memory of the data when it was last used, as accounted in mMemory.
+		std::size_t memory;
+	};
+	/// Entries, the most recently used first.
+	std::list<Entry> mEntries;
+	std::map<Key, typename std::list<Entry>::iterator> mIndex;
+	/// The sum of the memory of all entries when they were last used.
+	std::size_t mMemory;
+	std::size_t mLimit;
+	std::atomic<std::size_t> mHits;
+	std::atomic<std::size_t> mMisses;
+	mutable std::mutex mMutex;
+
+	/// Updates the accounted memory of the first entry to its current memory.
+	void touch() {
+		Entry& first = mEntries.front();
+		mMemory -= first.memory;
+		first.memory = first.data->memory();
+		mMemory += first.memory;
+	}
+	/// Evicts least recently used entries, but never the first one, until the limit is met.
+	void evict() {
+		while (mMemory > mLimit && mEntries.size() > 1) {
+			const Entry& last = mEntries.back();
+			CARL_LOG_DEBUG("carl.thom.tarski.cache", "Evicting " << last.key << " with " << last.memory << " bytes");
+			mMemory -= last.memory;
+			mIndex.erase(last.key);
+			mEntries.pop_back();
+		}
+	}
+protected:
+	TarskiQueryCache(): mEntries(), mIndex(), mMemory(0), mLimit(std::size_t(64) << 20), mHits(0), mMisses(0) {}
+public:
+	/**
+	 * @return The normalized defining system of the zero set of the given polynomials.
+	 */
+	template<typename InputIt>
+	static Key normalize(InputIt first, InputIt last) {
+		Key res;
+		for (; first != last; ++first) {
+			res.push_back(first->normalize());
+		}
+		std::sort(res.begin(), res.end());
+		res.erase(std::unique(res.begin(), res.end()), res.end());
+		return res;
+	}
+
+	/**
+	 * @return The data for the zero set of the given polynomials, which is set up if it is not yet in the cache.
+	 * The data is set up without holding the lock, such that other zero sets can be looked up meanwhile.
+	 * @throws std::invalid_argument if the zero set is not zero-dimensional.
+	 */
+	template<typename InputIt>
+	std::shared_ptr<Data> get(InputIt first, InputIt last) {
+		Key key = normalize(first, last);
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			auto it = mIndex.find(key);
+			if (it != mIndex.end()) {
+				mHits++;
+				mEntries.splice(mEntries.begin(), mEntries, it->second);
+				touch();
+				evict();
+				return mEntries.front().data;
+			}
+		}
+		mMisses++;
+		CARL_LOG_TRACE("carl.thom.tarski.cache", "setting up tarski query data on " << key);
+		auto data = std::make_shared<Data>(key);
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto it = mIndex.find(key);
+		if (it != mIndex.end()) {
+			// Another thread has set up the same zero set meanwhile, which is shared instead.
+			mEntries.splice(mEntries.begin(), mEntries, it->second);
+		} else {
+			mEntries.push_front(Entry{key, data, 0});
+			mIndex.emplace(std::move(key), mEntries.begin());
+		}
+		touch();
+		evict();
+		return mEntries.front().data;
+	}
+
+	/// @return The number of cached zero sets.
+	std::size_t size() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mEntries.size();
+	}
+	/// @return An estimate of the current memory of all cached zero sets in bytes.
+	std::size_t memory() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		std::size_t total = 0;
+		for (const auto& e: mEntries) total += e.data->memory();
+		return total;
+	}
+	/// @return The number of lookups that found a cached zero set.
+	std::size_t hits() const {
+		return mHits;
+	}
+	/// @return The number of lookups that had to set up a zero set.
+	std::size_t misses() const {
+		return mMisses;
+	}
+	/// @return The memory limit in bytes.
+	std::size_t limit() const {
+		return mLimit;
+	}
+	/**
+	 * Sets the memory limit in bytes and evicts entries accordingly.
+	 * The most recently used entry is always kept.
+	 */
+	void setLimit(std::size_t limit) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mLimit = limit;
+		evict();
+	}
+	/**
+	 * Removes all entries from the cache. Data that is still in use stays valid.
+	 */
+	void clear() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mEntries.clear();
+		mIndex.clear();
+		mMemory = 0;
+		mHits = 0;
+		mMisses = 0;
+	}
+};
+
+} // namespace carl
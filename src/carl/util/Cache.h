@@ -162,6 +162,19 @@ namespace carl
          */
         std::pair<Ref,bool> cache( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ) = &returnFalse<T>, void (*_update)( const T&, const T& ) = &doNothing<T> );
         
+        /**
+         * Caches the given object and registers the entry, which is the same as cache() followed by reg().
+         * In contrast to the latter, the entry can not be removed in between by another thread.
+         * @return The reference of the entry and whether it has been created.
+         */
+        std::pair<Ref,bool> cacheAndReg( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ) = &returnFalse<T>, void (*_update)( const T&, const T& ) = &doNothing<T> )
+        {
+            std::lock_guard<std::recursive_mutex> lock( mMutex );
+            auto ret = cache( _toCache, _canBeUpdated, _update );
+            reg( ret.first );
+            return ret;
+        }
+        
         /**
          * Registers the entry to the given reference. It mainly increases the usage counter of this entry in the cache.
          * @param _refStoragePos The reference of the entry to register.
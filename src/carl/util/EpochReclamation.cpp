@@ -0,0 +1,63 @@
+#include "EpochReclamation.h"
+
+#include "../core/logging.h"
+
+#include <cassert>
+
+namespace carl
+{
+	/**
+	 * Owns the record of a thread and releases it when the thread terminates.
+	 */
+	struct EpochRecordHolder {
+		std::size_t index;
+		explicit EpochRecordHolder(std::size_t i): index(i) {}
+		~EpochRecordHolder() {
+			EpochDomain::getInstance().release(index);
+		}
+	};
+
+	EpochDomain::Record& EpochDomain::record() {
+		static thread_local EpochRecordHolder holder([this](){
+			for (std::size_t i = 0; i < MAX_THREADS; i++) {
+				bool expected = false;
+				if (mRecords[i].used.compare_exchange_strong(expected, true)) {
+					std::size_t count = mRecordCount.load();
+					while (count < i + 1 && !mRecordCount.compare_exchange_weak(count, i + 1)) {}
+					return i;
+				}
+			}
+			CARL_LOG_ERROR("carl.util.epoch", "More than " << MAX_THREADS << " threads use the epoch domain.");
+			assert(false);
+			return MAX_THREADS - 1;
+		}());
+		return mRecords[holder.index];
+	}
+
+	void EpochDomain::release(std::size_t index) {
+		assert(mRecords[index].depth == 0);
+		mRecords[index].epoch.store(0);
+		mRecords[index].used.store(false);
+	}
+
+	void EpochDomain::enter() {
+		Record& r = record();
+		if (r.depth++ > 0) return;
+		r.epoch.store(mEpoch.load());
+	}
+
+	void EpochDomain::leave() {
+		Record& r = record();
+		assert(r.depth > 0);
+		if (--r.depth == 0) r.epoch.store(0);
+	}
+
+	bool EpochDomain::isSafe(std::uint64_t retired) const {
+		std::size_t count = mRecordCount.load();
+		for (std::size_t i = 0; i < count; i++) {
+			std::uint64_t e = mRecords[i].epoch.load();
+			if (e != 0 && e <= retired) return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,91 @@
+/**
+ * @file EpochReclamation.h
+ *
+ * Epoch based reclamation of memory that is read by multiple threads without locks.
+ */
+
+#pragma once
+
+#include "Singleton.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace carl
+{
+	/**
+	 * Process-wide epoch domain.
+	 *
+	 * A thread that reads shared objects without holding a lock does so in a critical section
+	 * (see EpochGuard), in which it announces the epoch in which it entered. An object that is
+	 * unlinked from the shared structures is retired in the current epoch and may only be freed
+	 * once every thread in a critical section has entered in a later epoch.
+	 */
+	class EpochDomain: public Singleton<EpochDomain>
+	{
+		friend Singleton<EpochDomain>;
+	public:
+		/// The maximum number of threads that are in the domain at the same time.
+		static constexpr std::size_t MAX_THREADS = 512;
+	private:
+		struct alignas(64) Record {
+			/// The epoch in which the thread entered its critical section, or zero.
+			std::atomic<std::uint64_t> epoch;
+			std::atomic<bool> used;
+			/// The nesting depth of critical sections, only accessed by the owning thread.
+			std::size_t depth;
+			Record(): epoch(0), used(false), depth(0) {}
+		};
+		std::array<Record, MAX_THREADS> mRecords;
+		/// One past the largest index of a record that was ever used.
+		std::atomic<std::size_t> mRecordCount;
+		std::atomic<std::uint64_t> mEpoch;
+
+		EpochDomain(): mRecords(), mRecordCount(0), mEpoch(1) {}
+
+		/// @return The record of the calling thread, which is claimed on the first call.
+		Record& record();
+		/// Releases the record of a thread that terminates.
+		void release(std::size_t index);
+		friend struct EpochRecordHolder;
+	public:
+		/// Enters a critical section.
+		void enter();
+		/// Leaves a critical section.
+		void leave();
+
+		/// @return The current epoch.
+		std::uint64_t epoch() const {
+			return mEpoch.load();
+		}
+		/**
+		 * Starts a new epoch.
+		 * @return The epoch that has ended, which is the epoch to retire objects in.
+		 */
+		std::uint64_t advance() {
+			return mEpoch.fetch_add(1);
+		}
+		/**
+		 * @return true, if objects retired in the given epoch may be freed, that is no thread is in a
+		 * critical section that it entered in this epoch or before.
+		 */
+		bool isSafe(std::uint64_t retired) const;
+	};
+
+	/**
+	 * Critical section of the epoch domain for the lifetime of this object.
+	 */
+	class EpochGuard
+	{
+	public:
+		EpochGuard() {
+			EpochDomain::getInstance().enter();
+		}
+		~EpochGuard() {
+			EpochDomain::getInstance().leave();
+		}
+		EpochGuard(const EpochGuard&) = delete;
+		EpochGuard& operator=(const EpochGuard&) = delete;
+	};
+}
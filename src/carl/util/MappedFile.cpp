@@ -0,0 +1,93 @@
+#include "MappedFile.h"
+
+#include "platform.h"
+
+#include <fstream>
+#include <utility>
+
+#ifndef __WIN
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace carl
+{
+	MappedFile::MappedFile(MappedFile&& _file) noexcept:
+		mData(_file.mData),
+		mSize(_file.mSize),
+		mMapped(_file.mMapped)
+	{
+		_file.mData = nullptr;
+		_file.mSize = 0;
+		_file.mMapped = false;
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& _file) noexcept
+	{
+		if (this != &_file) {
+			release();
+			std::swap(mData, _file.mData);
+			std::swap(mSize, _file.mSize);
+			std::swap(mMapped, _file.mMapped);
+		}
+		return *this;
+	}
+
+	void MappedFile::release()
+	{
+		if (mData == nullptr) return;
+#ifndef __WIN
+		if (mMapped) {
+			munmap(const_cast<char*>(mData), mSize);
+		} else
+#endif
+		if (mSize > 0) {
+			delete[] mData;
+		}
+		mData = nullptr;
+		mSize = 0;
+		mMapped = false;
+	}
+
+	bool MappedFile::open(const std::string& _filename)
+	{
+		release();
+#ifndef __WIN
+		int fd = ::open(_filename.c_str(), O_RDONLY);
+		if (fd < 0) return false;
+		struct stat info;
+		if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+			if (info.st_size == 0) {
+				::close(fd);
+				mData = "";
+				return true;
+			}
+			void* data = mmap(nullptr, std::size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED) {
+				::close(fd);
+				madvise(data, std::size_t(info.st_size), MADV_SEQUENTIAL);
+				mData = static_cast<const char*>(data);
+				mSize = std::size_t(info.st_size);
+				mMapped = true;
+				return true;
+			}
+		}
+		::close(fd);
+#endif
+		// Fall back to reading the whole file.
+		std::ifstream in(_filename, std::ios::binary);
+		if (!in) return false;
+		std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		mSize = contents.size();
+		if (mSize == 0) {
+			mData = "";
+			return true;
+		}
+		char* buffer = new char[mSize];
+		contents.copy(buffer, mSize);
+		mData = buffer;
+		return true;
+	}
+}
@@ -0,0 +1,81 @@
+/**
+ * @file MappedFile.h
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace carl
+{
+	/**
+	 * Read-only view of the contents of a file.
+	 *
+	 * The file is mapped into memory where this is supported, such that reading
+	 * it does not copy its contents. Otherwise, the contents are read into a buffer.
+	 */
+	class MappedFile
+	{
+	private:
+		/// The contents of the file.
+		const char* mData = nullptr;
+		/// The size of the file.
+		std::size_t mSize = 0;
+		/// Whether mData is mapped or has been allocated.
+		bool mMapped = false;
+
+		void release();
+
+	public:
+		MappedFile() = default;
+		/**
+		 * Maps the given file.
+		 * @param _filename Name of the file.
+		 */
+		explicit MappedFile(const std::string& _filename)
+		{
+			open(_filename);
+		}
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&& _file) noexcept;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&& _file) noexcept;
+		~MappedFile()
+		{
+			release();
+		}
+
+		/**
+		 * Maps the given file, any previously mapped file is released.
+		 * @param _filename Name of the file.
+		 * @return true, if the file could be opened.
+		 */
+		bool open(const std::string& _filename);
+
+		/**
+		 * @return true, if a file is mapped.
+		 */
+		bool isOpen() const
+		{
+			return mData != nullptr;
+		}
+
+		const char* data() const
+		{
+			return mData;
+		}
+		const char* begin() const
+		{
+			return mData;
+		}
+		const char* end() const
+		{
+			return mData + mSize;
+		}
+		std::size_t size() const
+		{
+			return mSize;
+		}
+	};
+}
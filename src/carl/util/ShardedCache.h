@@ -0,0 +1,365 @@
+/**
+ * @file ShardedCache.h
+ *
+ * A variant of Cache for concurrent use.
+ */
+
+#pragma once
+
+#include "Cache.h"
+#include "EpochReclamation.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stack>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+namespace carl
+{
+    /**
+     * A cache with the interface of Cache, which can be used by multiple threads at once.
+     *
+     * The entries are distributed over a number of shards by their hash, each of which has its own
+     * mutex. Usage counters and activities are atomics, such that registering, deregistering and
+     * accessing an entry via its reference, which happens whenever a FactorizedPolynomial is
+     * copied or destroyed, do not lock anything.
+     *
+     * Caching an object compares it to the entries with the same hash without holding the lock of
+     * the shard, as comparing objects may lock them, and objects may cache further objects while
+     * they are locked. Hence removed entries are retired and only freed once no thread can still
+     * compare them (see EpochDomain).
+     *
+     * Entries are removed by cleaning a shard, either incrementally when an object is cached into a
+     * full shard or by a background thread (see startCleaner()). Only entries which are not used
+     * are removed, hence an object obtained by get() stays valid as long as its entry is registered.
+     * In contrast to Cache, an entry that becomes equal to another entry by a rehash is not merged
+     * into it, as other threads may access it, but kept as a duplicate until it is no longer used.
+     *
+     * Objects that are cached but not yet registered may be removed by a concurrent cleaning, hence
+     * cacheAndReg() should be used instead of cache() followed by reg().
+     */
+    template<typename T>
+    class ShardedCache {
+
+    public:
+        // The type of the reference of an entry in the cache.
+        using Ref = std::size_t;
+
+        struct Info {
+            /**
+             * Store the number of usages of the entry in the cache for which this information hold by external objects.
+             */
+            std::atomic<std::size_t> usageCount;
+
+            /**
+             * Stores the reference of the entry in the cache for which this information hold.
+             */
+            Ref refStoragePosition;
+
+            /**
+             * Stores the activity of the entry in the cache for which this information hold. The activity states how often the entry
+             * is involved in computations in the recent past. Concurrent increments may get lost, which is fine for a heuristic.
+             */
+            std::atomic<double> activity;
+
+            /**
+             * The shard containing the entry.
+             */
+            std::atomic<std::size_t> shard;
+
+            /**
+             * The hash of the object, which is stored such that the shards never access objects that are rehashed by another thread.
+             */
+            std::atomic<std::size_t> hash;
+
+            /**
+             * The epoch in which the entry was removed from the cache.
+             */
+            std::uint64_t retired;
+
+            explicit Info( double _activity ):
+                usageCount(0),
+                refStoragePosition(0),
+                activity(_activity),
+                shard(0),
+                hash(0),
+                retired(0)
+            {}
+        };
+
+        using Entry = TypeInfoPair<T,Info>;
+
+        /// Hashes an entry by the stored hash of its object.
+        struct EntryHash {
+            std::size_t operator()( const Entry* _entry ) const
+            {
+                return _entry->second.hash;
+            }
+        };
+        /// Entries are compared by their addresses, such that the shards never compare objects.
+        using Container = std::unordered_set<Entry*, EntryHash>;
+
+    private:
+        struct Shard {
+            std::mutex mutex;
+            /// The entries, of which no two contain equal objects.
+            Container entries;
+            /// Entries that became equal to one of the entries by a rehash.
+            std::vector<Entry*> duplicates;
+            /// Entries that have been removed, but may still be accessed by other threads.
+            std::vector<Entry*> retired;
+            /// The number of insertions into the shard so far.
+            std::size_t version = 0;
+        };
+
+        /// The number of references in a segment of the reference table.
+        static constexpr std::size_t SEGMENT_SIZE = 4096;
+        /// The maximum number of segments of the reference table.
+        static constexpr std::size_t MAX_SEGMENTS = 16384;
+
+        // Members
+
+        /**
+         * The threshold for the cache's size which should not be exceeded, except more of the cache entries are still in use.
+         */
+        std::size_t mMaxCacheSize;
+
+        /**
+         * The threshold for the size of a single shard.
+         */
+        std::size_t mMaxShardSize;
+
+        /**
+         * The percentage of the cache, which shall be removed at best, if the cache size exceeds the threshold.
+         */
+        double mCacheReductionAmount;
+
+        /**
+         * The threshold for the maximum activity. In case it is exceeded, all activities are rescaled.
+         */
+        std::atomic<double> mMaxActivity;
+
+        /**
+         * The reciprocal of the factor to multiply an activity with in order to increase it.
+         */
+        std::atomic<double> mActivityIncrement;
+
+        /**
+         * The decay (between 0.9 and 1.0) of the given increments on activities.
+         */
+        double mDecay;
+
+        /**
+         * The threshold limiting the maximum activity. If this threshold is exceeded, all activities are rescaled.
+         */
+        double mActivityThreshold;
+
+        /**
+         * The factor multiplied to all activities in order to rescale (decrease) them.
+         */
+        double mActivityDecrementFactor;
+
+        /**
+         * The shards, whose number is a power of two.
+         */
+        std::vector<std::unique_ptr<Shard>> mShards;
+
+        /**
+         * The table mapping references to entries, which is allocated in segments that are never moved.
+         */
+        std::unique_ptr<std::atomic<std::atomic<Entry*>*>[]> mSegments;
+
+        /**
+         * A mutex for the allocation of references.
+         */
+        std::mutex mRefMutex;
+        /// A mutex ensuring that only one thread rescales the activities.
+        std::mutex mRescaleMutex;
+        /// The smallest reference that has never been used.
+        Ref mNextRef;
+        /// A stack containing free references, which have been used before but freed now.
+        std::stack<Ref> mUnusedRefs;
+
+        /// The background cleaning thread and its synchronization.
+        std::thread mCleaner;
+        bool mStopCleaner;
+        std::mutex mCleanerMutex;
+        std::condition_variable mCleanerCondition;
+
+    public:
+
+        static const Ref NO_REF;
+
+        /**
+         * @param _maxCacheSize The number of entries of the cache, above which unused entries are removed.
+         * @param _cacheReductionAmount The percentage of a shard, which shall be removed at best when it is cleaned.
+         * @param _decay The decay of the activities.
+         * @param _shards The number of shards, which is rounded up to a power of two.
+         */
+        explicit ShardedCache( std::size_t _maxCacheSize = 10000, double _cacheReductionAmount = 0.2, double _decay = 0.98, std::size_t _shards = 64 );
+        ShardedCache( const ShardedCache& ) = delete; // no implementation
+        ShardedCache& operator=( const ShardedCache& ) = delete; // no implementation
+
+        ~ShardedCache();
+
+        /**
+         * Caches the given object, see Cache::cache().
+         * The entry is not registered and may hence be removed by a concurrent cleaning before it is registered.
+         */
+        std::pair<Ref,bool> cache( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ) = &returnFalse<T>, void (*_update)( const T&, const T& ) = &doNothing<T> )
+        {
+            return insert( _toCache, _canBeUpdated, _update, false );
+        }
+
+        /**
+         * Caches the given object and registers the entry, see Cache::cacheAndReg().
+         */
+        std::pair<Ref,bool> cacheAndReg( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ) = &returnFalse<T>, void (*_update)( const T&, const T& ) = &doNothing<T> )
+        {
+            return insert( _toCache, _canBeUpdated, _update, true );
+        }
+
+        /**
+         * Registers the entry to the given reference. It mainly increases the usage counter of this entry in the cache.
+         * The entry must already be in use, for example by the object that is copied, such that it cannot be removed concurrently.
+         * @param _refStoragePos The reference of the entry to register.
+         */
+        void reg( Ref _refStoragePos );
+
+        /**
+         * Deregisters the entry to the given reference. It mainly decreases the usage counter of this entry in the cache.
+         * Unused entries are not removed immediately, but when the shard is cleaned.
+         * @param _refStoragePos The reference of the entry to deregister.
+         */
+        void dereg( Ref _refStoragePos );
+
+        /**
+         * Removes and reinserts the entry with the given reference, after its hash value is recalculated.
+         * If the cache already contains an equal object, the entry is kept as a duplicate until it is no longer used.
+         * @param _refStoragePos The reference of the entry to rehash.
+         */
+        void rehash( Ref _refStoragePos );
+
+        /**
+         * Decays all activities by increasing the activity increment.
+         */
+        void decayActivity();
+
+        /**
+         * Strenghtens the activity of the entry in the cache with the given reference, by increasing its activity.
+         * @param _refStoragePos The reference of the entry in the cache to strengthen its activity.
+         */
+        void strengthenActivity( Ref _refStoragePos );
+
+        /**
+         * Cleans all shards that exceed their size or contain unused duplicates and frees the retired entries that are no longer accessed.
+         */
+        void clean();
+
+        /**
+         * Starts a thread that calls clean() periodically, until stopCleaner() is called or the cache is destroyed.
+         * As the cached objects are destroyed by this thread, they must support this, for example carl must be built
+         * with THREAD_SAFE for polynomials.
+         * @param _interval The time between two cleanings.
+         */
+        void startCleaner( std::chrono::milliseconds _interval );
+
+        /**
+         * Stops the cleaning thread.
+         */
+        void stopCleaner();
+
+        /**
+         * @return The number of entries in the cache, not counting duplicates.
+         */
+        std::size_t size() const;
+
+        /**
+         * @return An estimate of the memory used by the cache and the cached objects in bytes, not accounting for memory
+         * that is allocated by the cached objects themselves.
+         */
+        std::size_t memory() const;
+
+        /**
+         * Prints all information stored in this cache to std::cout.
+         * @param _out The stream to print on.
+         */
+        void print( std::ostream& _out = std::cout ) const;
+
+        /**
+         * @param _refStoragePos The reference of the entry to obtain the object from.
+         * @return The object in the entry with the given reference.
+         */
+        const T& get( Ref _refStoragePos ) const
+        {
+            const Entry* entry = slot( _refStoragePos ).load();
+            assert( entry != nullptr );
+            assert( entry->second.usageCount > 0 );
+            return *entry->first;
+        }
+
+    private:
+
+        std::atomic<Entry*>& slot( Ref _ref ) const
+        {
+            assert( _ref != NO_REF && _ref / SEGMENT_SIZE < MAX_SEGMENTS );
+            std::atomic<Entry*>* segment = mSegments[_ref / SEGMENT_SIZE].load();
+            assert( segment != nullptr );
+            return segment[_ref % SEGMENT_SIZE];
+        }
+
+        std::size_t shardIndex( const T& _t ) const
+        {
+            return _t.getHash() & (mShards.size() - 1);
+        }
+
+        std::pair<Ref,bool> insert( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ), void (*_update)( const T&, const T& ), bool _reg );
+
+        /**
+         * @return A new reference pointing to the given entry.
+         */
+        Ref allocateRef( Entry* _entry );
+
+        /**
+         * Searches the shard for an entry whose object is equal to the object of the given entry, and inserts the given entry
+         * if there is none. The objects are compared without holding the lock of the shard, hence this must be called within a
+         * critical section of the epoch domain.
+         * @param _index The index of the shard.
+         * @param _entry The entry to insert, which is not contained in any shard.
+         * @param _reg Whether the resulting entry shall be registered.
+         * @return The entry in the shard, which is the given entry if it has been inserted.
+         */
+        Entry* findOrInsert( std::size_t _index, Entry* _entry, bool _reg );
+
+        /**
+         * Removes a certain amount of unused entries and all unused duplicates from the shard, which must be locked.
+         * @param _onlyDuplicates true, if only the unused duplicates shall be removed.
+         */
+        void cleanShard( Shard& _shard, bool _onlyDuplicates = false );
+
+        /**
+         * Removes the given entry, which must be unused and must not be contained in the shard anymore.
+         */
+        void retire( Shard& _shard, Entry* _entry, std::uint64_t _epoch, std::vector<Ref>& _freed );
+
+        /**
+         * Frees the retired entries of the shard that are no longer accessed.
+         */
+        void reclaim( Shard& _shard );
+
+        /**
+         * Rescales all activities.
+         */
+        void rescaleActivities();
+    };
+
+} // namespace carl
+
+
+#include "ShardedCache.tpp"
@@ -0,0 +1,464 @@
+/**
+ * @file ShardedCache.tpp
+ */
+
+#pragma once
+
+#include "ShardedCache.h"
+
+#include <algorithm>
+
+namespace carl
+{
+    template<typename T>
+    const typename ShardedCache<T>::Ref ShardedCache<T>::NO_REF = 0;
+
+    template<typename T>
+    ShardedCache<T>::ShardedCache( std::size_t _maxCacheSize, double _cacheReductionAmount, double _decay, std::size_t _shards ):
+        mMaxCacheSize( _maxCacheSize ),
+        mMaxShardSize( 0 ),
+        mCacheReductionAmount( _cacheReductionAmount ),
+        mMaxActivity( 0.0 ),
+        mActivityIncrement( 1.0 ),
+        mDecay( _decay ),
+        mActivityThreshold( 1e100 ),
+        mActivityDecrementFactor( 1e-100 ),
+        mShards(),
+        mSegments( new std::atomic<std::atomic<Entry*>*>[MAX_SEGMENTS] ),
+        mRefMutex(),
+        mNextRef( 1 ), // reserve the first entry with index 0 as default
+        mUnusedRefs(),
+        mCleaner(),
+        mStopCleaner( false ),
+        mCleanerMutex(),
+        mCleanerCondition()
+    {
+        assert( _decay >= 0.9 && _decay <= 1.0 );
+        std::size_t shards = 1;
+        while( shards < _shards ) shards *= 2;
+        for( std::size_t i = 0; i < shards; ++i )
+            mShards.emplace_back( new Shard() );
+        mMaxShardSize = std::max( std::size_t(1), _maxCacheSize / shards );
+        for( std::size_t i = 0; i < MAX_SEGMENTS; ++i )
+            mSegments[i].store( nullptr );
+    }
+
+    template<typename T>
+    ShardedCache<T>::~ShardedCache()
+    {
+        stopCleaner();
+        for( auto& shard : mShards )
+        {
+            for( Entry* entry : shard->retired )
+            {
+                delete entry->first;
+                delete entry;
+            }
+            shard->retired.clear();
+            for( Entry* entry : shard->duplicates )
+            {
+                delete entry->first;
+                delete entry;
+            }
+            shard->duplicates.clear();
+            while( !shard->entries.empty() )
+            {
+                Entry* entry = *shard->entries.begin();
+                shard->entries.erase( shard->entries.begin() );
+                delete entry->first;
+                delete entry;
+            }
+        }
+        for( std::size_t i = 0; i < MAX_SEGMENTS; ++i )
+            delete[] mSegments[i].load();
+    }
+
+    template<typename T>
+    typename ShardedCache<T>::Ref ShardedCache<T>::allocateRef( Entry* _entry )
+    {
+        std::lock_guard<std::mutex> lock( mRefMutex );
+        Ref ref;
+        if( mUnusedRefs.empty() ) // Get a brand new reference.
+        {
+            ref = mNextRef++;
+            std::size_t segment = ref / SEGMENT_SIZE;
+            assert( segment < MAX_SEGMENTS );
+            if( mSegments[segment].load() == nullptr )
+            {
+                std::atomic<Entry*>* newSegment = new std::atomic<Entry*>[SEGMENT_SIZE]();
+                for( std::size_t i = 0; i < SEGMENT_SIZE; ++i )
+                    newSegment[i].store( nullptr );
+                mSegments[segment].store( newSegment );
+            }
+        }
+        else // Take the reference from the stack of old ones.
+        {
+            ref = mUnusedRefs.top();
+            mUnusedRefs.pop();
+        }
+        slot( ref ).store( _entry );
+        return ref;
+    }
+
+    template<typename T>
+    typename ShardedCache<T>::Entry* ShardedCache<T>::findOrInsert( std::size_t _index, Entry* _entry, bool _reg )
+    {
+        Shard& shard = *mShards[_index];
+        std::size_t hash = _entry->first->getHash();
+        _entry->second.hash = hash;
+        std::vector<Entry*> candidates;
+        std::vector<Entry*> compared;
+        std::unique_lock<std::mutex> lock( shard.mutex );
+        while( true )
+        {
+            // Collect the entries with the same hash, which have not been compared yet.
+            candidates.clear();
+            std::size_t bucket = shard.entries.bucket( _entry );
+            for( auto iter = shard.entries.begin( bucket ); iter != shard.entries.end( bucket ); ++iter )
+            {
+                if( (*iter)->second.hash == hash && std::find( compared.begin(), compared.end(), *iter ) == compared.end() )
+                    candidates.push_back( *iter );
+            }
+            std::size_t version = shard.version;
+            lock.unlock();
+            Entry* equal = nullptr;
+            for( Entry* candidate : candidates )
+            {
+                compared.push_back( candidate );
+                if( candidate == _entry || *candidate->first == *_entry->first )
+                {
+                    equal = candidate;
+                    break;
+                }
+            }
+            lock.lock();
+            if( equal != nullptr )
+            {
+                // The equal entry may have been removed in the meantime.
+                if( shard.entries.count( equal ) > 0 )
+                {
+                    if( _reg )
+                        ++equal->second.usageCount;
+                    return equal;
+                }
+            }
+            else if( shard.version == version ) // No entry has been inserted in the meantime.
+            {
+                shard.entries.insert( _entry );
+                ++shard.version;
+                _entry->second.shard = _index;
+                if( _entry->second.refStoragePosition == NO_REF )
+                    _entry->second.refStoragePosition = allocateRef( _entry );
+                if( _reg )
+                    ++_entry->second.usageCount;
+                return _entry;
+            }
+        }
+    }
+
+    template<typename T>
+    std::pair<typename ShardedCache<T>::Ref,bool> ShardedCache<T>::insert( T* _toCache, bool (*_canBeUpdated)( const T&, const T& ), void (*_update)( const T&, const T& ), bool _reg )
+    {
+        std::pair<Ref,bool> result;
+        bool updated = false;
+        std::size_t index = shardIndex( *_toCache );
+        Shard& shard = *mShards[index];
+        {
+            std::lock_guard<std::mutex> lock( shard.mutex );
+            if( shard.entries.size() >= mMaxShardSize ) // Clean, if the number of elements in the shard exceeds the threshold.
+            {
+                cleanShard( shard );
+            }
+        }
+        {
+            EpochGuard guard;
+            auto newElement = new Entry( std::piecewise_construct, std::forward_as_tuple( _toCache ), std::forward_as_tuple( mMaxActivity.load() ) );
+            Entry* element = findOrInsert( index, newElement, _reg );
+            if( element != newElement ) // There is already an equal object in the cache.
+            {
+                delete newElement;
+                // Try to update the entry in the cache by the information in the given object.
+                if( (*_canBeUpdated)( *element->first, *_toCache ) )
+                {
+                    (*_update)( *element->first, *_toCache );
+                    updated = true;
+                }
+            }
+            result = std::make_pair( element->second.refStoragePosition, element == newElement );
+        }
+        if( updated )
+        {
+            // The entry is reinserted after it has been rehashed.
+            rehash( result.first );
+        }
+        reclaim( shard );
+        return result;
+    }
+
+    template<typename T>
+    void ShardedCache<T>::reg( Ref _refStoragePos )
+    {
+        Entry* entry = slot( _refStoragePos ).load();
+        assert( entry != nullptr );
+        assert( entry->second.usageCount > 0 );
+        ++entry->second.usageCount;
+    }
+
+    template<typename T>
+    void ShardedCache<T>::dereg( Ref _refStoragePos )
+    {
+        Entry* entry = slot( _refStoragePos ).load();
+        assert( entry != nullptr );
+        assert( entry->second.usageCount > 0 );
+        --entry->second.usageCount;
+    }
+
+    template<typename T>
+    void ShardedCache<T>::rehash( Ref _refStoragePos )
+    {
+        EpochGuard guard;
+        Entry* entry = slot( _refStoragePos ).load();
+        if( entry == nullptr ) // The entry has been removed, as it was not registered.
+            return;
+        {
+            Shard& shard = *mShards[entry->second.shard];
+            std::lock_guard<std::mutex> lock( shard.mutex );
+            if( shard.entries.erase( entry ) == 0 )
+            {
+                auto iter = std::find( shard.duplicates.begin(), shard.duplicates.end(), entry );
+                // If the entry is not found, it has been removed or another thread is rehashing it.
+                if( iter == shard.duplicates.end() )
+                    return;
+                shard.duplicates.erase( iter );
+            }
+        }
+        // The entry is not contained in any shard now, hence it is not removed by other threads.
+        entry->first->rehash();
+        std::size_t index = shardIndex( *entry->first );
+        if( findOrInsert( index, entry, false ) != entry )
+        {
+            // There is an equal entry in the cache, which is used for further objects from now on.
+            Shard& shard = *mShards[index];
+            std::lock_guard<std::mutex> lock( shard.mutex );
+            entry->second.shard = index;
+            shard.duplicates.push_back( entry );
+        }
+    }
+
+    template<typename T>
+    void ShardedCache<T>::cleanShard( Shard& _shard, bool _onlyDuplicates )
+    {
+        CARL_LOG_TRACE( "carl.util.cache", "Cleaning shard..." );
+        std::vector<Ref> freed;
+        std::uint64_t epoch = EpochDomain::getInstance().advance();
+        auto unused = std::partition( _shard.duplicates.begin(), _shard.duplicates.end(), []( const Entry* e ){ return e->second.usageCount > 0; } );
+        for( auto iter = unused; iter != _shard.duplicates.end(); ++iter )
+            retire( _shard, *iter, epoch, freed );
+        _shard.duplicates.erase( unused, _shard.duplicates.end() );
+        if( !_onlyDuplicates )
+        {
+            std::vector<typename Container::iterator> noUsageEntries;
+            double limit = 0.0;
+            for( auto iter = _shard.entries.begin(); iter != _shard.entries.end(); ++iter )
+            {
+                if( (*iter)->second.usageCount == 0 )
+                {
+                    noUsageEntries.push_back( iter );
+                    limit += (*iter)->second.activity;
+                }
+            }
+            if( double(noUsageEntries.size()) < (double(_shard.entries.size()) * mCacheReductionAmount) )
+            {
+                // There are less entries we can delete than we want to delete: just delete them all
+                limit = std::numeric_limits<double>::infinity();
+            }
+            else
+            {
+                // Remove all entries with no usage, which have an activity below the average.
+                limit = limit / double(noUsageEntries.size());
+            }
+            for( auto iter : noUsageEntries )
+            {
+                Entry* entry = *iter;
+                if( entry->second.activity > limit ) continue;
+                _shard.entries.erase( iter );
+                retire( _shard, entry, epoch, freed );
+            }
+        }
+        if( freed.empty() ) return;
+        std::lock_guard<std::mutex> lock( mRefMutex );
+        for( const Ref& ref : freed )
+            mUnusedRefs.push( ref );
+    }
+
+    template<typename T>
+    void ShardedCache<T>::retire( Shard& _shard, Entry* _entry, std::uint64_t _epoch, std::vector<Ref>& _freed )
+    {
+        // Unused entries are only registered via findOrInsert() with the shard being locked.
+        assert( _entry->second.usageCount == 0 );
+        slot( _entry->second.refStoragePosition ).store( nullptr );
+        _freed.push_back( _entry->second.refStoragePosition );
+        _entry->second.retired = _epoch;
+        _shard.retired.push_back( _entry );
+    }
+
+    template<typename T>
+    void ShardedCache<T>::reclaim( Shard& _shard )
+    {
+        std::vector<Entry*> toFree;
+        {
+            std::lock_guard<std::mutex> lock( _shard.mutex );
+            if( _shard.retired.empty() ) return;
+            auto& domain = EpochDomain::getInstance();
+            auto safe = std::partition( _shard.retired.begin(), _shard.retired.end(), [&domain]( const Entry* e ){ return !domain.isSafe( e->second.retired ); } );
+            toFree.assign( safe, _shard.retired.end() );
+            _shard.retired.erase( safe, _shard.retired.end() );
+        }
+        // Destroying the objects may deregister other entries of this cache, hence no shard is locked.
+        for( Entry* entry : toFree )
+        {
+            delete entry->first;
+            delete entry;
+        }
+    }
+
+    template<typename T>
+    void ShardedCache<T>::clean()
+    {
+        for( auto& shard : mShards )
+        {
+            {
+                std::lock_guard<std::mutex> lock( shard->mutex );
+                if( shard->entries.size() >= mMaxShardSize )
+                    cleanShard( *shard );
+                else if( !shard->duplicates.empty() )
+                    cleanShard( *shard, true );
+            }
+            reclaim( *shard );
+        }
+    }
+
+    template<typename T>
+    void ShardedCache<T>::startCleaner( std::chrono::milliseconds _interval )
+    {
+        stopCleaner();
+        mStopCleaner = false;
+        mCleaner = std::thread( [this, _interval]()
+        {
+            std::unique_lock<std::mutex> lock( mCleanerMutex );
+            while( !mCleanerCondition.wait_for( lock, _interval, [this](){ return mStopCleaner; } ) )
+            {
+                lock.unlock();
+                clean();
+                lock.lock();
+            }
+        } );
+    }
+
+    template<typename T>
+    void ShardedCache<T>::stopCleaner()
+    {
+        if( !mCleaner.joinable() ) return;
+        {
+            std::lock_guard<std::mutex> lock( mCleanerMutex );
+            mStopCleaner = true;
+        }
+        mCleanerCondition.notify_all();
+        mCleaner.join();
+    }
+
+    template<typename T>
+    std::size_t ShardedCache<T>::size() const
+    {
+        std::size_t result = 0;
+        for( const auto& shard : mShards )
+        {
+            std::lock_guard<std::mutex> lock( shard->mutex );
+            result += shard->entries.size();
+        }
+        return result;
+    }
+
+    template<typename T>
+    std::size_t ShardedCache<T>::memory() const
+    {
+        std::size_t entries = 0;
+        for( const auto& shard : mShards )
+        {
+            std::lock_guard<std::mutex> lock( shard->mutex );
+            entries += shard->entries.size() + shard->duplicates.size() + shard->retired.size();
+        }
+        std::size_t segments = 0;
+        for( std::size_t i = 0; i < MAX_SEGMENTS && mSegments[i].load() != nullptr; ++i )
+            ++segments;
+        return sizeof( *this ) + MAX_SEGMENTS * sizeof( void* ) + segments * SEGMENT_SIZE * sizeof( Entry* )
+            + mShards.size() * sizeof( Shard ) + entries * ( sizeof( T ) + sizeof( Entry ) + sizeof( Ref ) + 3 * sizeof( void* ) );
+    }
+
+    template<typename T>
+    void ShardedCache<T>::rescaleActivities()
+    {
+        std::lock_guard<std::mutex> rescaleLock( mRescaleMutex );
+        if( mMaxActivity <= mActivityThreshold ) return; // Another thread has rescaled in the meantime.
+        for( auto& shard : mShards )
+        {
+            std::lock_guard<std::mutex> lock( shard->mutex );
+            for( Entry* entry : shard->entries )
+                entry->second.activity = entry->second.activity * mActivityDecrementFactor;
+        }
+        mActivityIncrement = mActivityIncrement * mActivityDecrementFactor;
+        mMaxActivity = mMaxActivity * mActivityDecrementFactor;
+    }
+
+    template<typename T>
+    void ShardedCache<T>::decayActivity()
+    {
+        double increment = mActivityIncrement.load();
+        while( !mActivityIncrement.compare_exchange_weak( increment, increment * (1 / mDecay) ) ) {}
+    }
+
+    template<typename T>
+    void ShardedCache<T>::strengthenActivity( Ref _refStoragePos )
+    {
+        Entry* entry = slot( _refStoragePos ).load();
+        assert( entry != nullptr );
+        // update the activity of the cache entry at the given position
+        double activity = entry->second.activity + mActivityIncrement;
+        entry->second.activity = activity;
+        // update the maximum activity
+        double max = mMaxActivity.load();
+        while( max < activity && !mMaxActivity.compare_exchange_weak( max, activity ) ) {}
+        // rescale if the threshold for the maximum activity has been exceeded
+        if( activity > mActivityThreshold )
+            rescaleActivities();
+    }
+
+    template<typename T>
+    void ShardedCache<T>::print( std::ostream& _out ) const
+    {
+        _out << "General cache information:" << std::endl;
+        _out << "   desired maximum cache size                                 : "  << mMaxCacheSize << std::endl;
+        _out << "   number of shards                                           : "  << mShards.size() << std::endl;
+        _out << "   desired reduction amount when cleaning the cache           : "  << mCacheReductionAmount << std::endl;
+        _out << "   maximum of all activities                                  : "  << mMaxActivity << std::endl;
+        _out << "   the current value of the activity increment                : "  << mActivityIncrement << std::endl;
+        _out << "   decay factor for the given activities                      : "  << mDecay << std::endl;
+        _out << "   upper bound of the activities                              : "  << mActivityThreshold << std::endl;
+        _out << "   scaling factor of the activities                           : "  << mActivityDecrementFactor << std::endl;
+        _out << "   current size of the cache                                  : "  << size() << std::endl;
+        _out << "Cache contains:" << std::endl;
+        for( const auto& shard : mShards )
+        {
+            std::lock_guard<std::mutex> lock( shard->mutex );
+            for( const Entry* entry : shard->entries )
+            {
+                assert( entry->first != nullptr );
+                _out << "   " << *entry->first << std::endl;
+                _out << "                       usage count: " << entry->second.usageCount << std::endl;
+                _out << "         reference storage position: " << entry->second.refStoragePosition << std::endl;
+                _out << "                          activity: " << entry->second.activity << std::endl;
+            }
+        }
+    }
+
+} // namespace carl
@@ -0,0 +1,421 @@
+/**
+ * @file RecursiveDescentParser.h
+ */
+
+#pragma once
+
+#include "../../core/logging.h"
+#include "../../core/MonomialPool.h"
+#include "../../core/MultivariatePolynomial.h"
+#include "../../core/RationalFunction.h"
+#include "../../core/Variable.h"
+#include "../../core/VariablePool.h"
+#include "../../formula/Formula.h"
+#include "../../numbers/numbers.h"
+
+#include <boost/optional.hpp>
+#include <boost/utility/string_ref.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace carl {
+namespace parser {
+
+/**
+ * Parses polynomials, rational functions and formulas in a single pass without backtracking.
+ *
+ * It accepts the same language as Parser, namely
+ * - polynomials built from decimal numbers and variables using `+`, `-`, `*`, `^` with natural
+ *   exponents and parentheses, where a number may directly precede a variable as in `2 x`,
+ * - rational functions `p` or `p / q` for polynomials `p` and `q`,
+ * - formulas over Boolean variables like `(a IMPLIES (b AND (NOT c)))`,
+ * but uses the usual precedences of `*` over `+` and `-`. Names of variables in polynomials may not
+ * contain `^` or `/`, as these are operators. Unknown variable names create fresh variables of the
+ * respective type.
+ *
+ * Inputs are given as string views and are scanned in place. The terms of a sum are collected in a
+ * single vector, from which the polynomial is built at once; only products with parenthesized
+ * sums use polynomial multiplication.
+ */
+template<typename Pol>
+class RecursiveDescentParser {
+public:
+	using StringView = boost::string_ref;
+	using Coeff = typename Pol::CoeffType;
+	using TermsType = std::vector<Term<Coeff>>;
+private:
+	/// Known variables of polynomials, by name.
+	std::unordered_map<std::string, Variable> mVariables;
+	/// Known Boolean variables, by name.
+	std::unordered_map<std::string, Variable> mBooleanVariables;
+	/// The input and the current position.
+	const char* mBegin = nullptr;
+	const char* mPos = nullptr;
+	const char* mEnd = nullptr;
+	/// Set if a syntax error was found.
+	bool mFailed = false;
+	/// Buffer for variable names.
+	std::string mName;
+
+	/// Names of polynomial variables, without the operators "^" and "/".
+	static bool isPolynomialNameChar(char c, bool first) {
+		if (std::isalpha(static_cast<unsigned char>(c))) return true;
+		if (!first && std::isdigit(static_cast<unsigned char>(c))) return true;
+		return c != '\0' && std::strchr("~!@$%&_=<>.?", c) != nullptr;
+	}
+	static bool isFormulaNameChar(char c, bool first) {
+		if (std::isalpha(static_cast<unsigned char>(c))) return true;
+		if (!first && std::isdigit(static_cast<unsigned char>(c))) return true;
+		return c != '\0' && std::strchr("~!@$%^&*_+=<>.?/-", c) != nullptr;
+	}
+
+	void reset(StringView s) {
+		mBegin = s.data();
+		mPos = s.data();
+		mEnd = s.data() + s.size();
+		mFailed = false;
+	}
+	bool fail(const char* expected) {
+		(void)expected;
+		if (!mFailed) {
+			CARL_LOG_ERROR("carl.parser", "Expected " << expected << " at position " << (mPos - mBegin) << " of \"" << std::string(mBegin, mEnd) << "\".");
+		}
+		mFailed = true;
+		return false;
+	}
+	void skip() {
+		while (mPos != mEnd && std::isspace(static_cast<unsigned char>(*mPos))) mPos++;
+	}
+	/// Returns the next character without consuming it, or zero at the end.
+	char peek() {
+		skip();
+		return mPos == mEnd ? '\0' : *mPos;
+	}
+	bool accept(char c) {
+		if (peek() != c) return false;
+		mPos++;
+		return true;
+	}
+	/// Accepts a keyword that is not immediately followed by further characters of a name.
+	bool acceptKeyword(const char* keyword) {
+		skip();
+		std::size_t length = std::strlen(keyword);
+		if (std::size_t(mEnd - mPos) < length || std::strncmp(mPos, keyword, length) != 0) return false;
+		if (mPos + length != mEnd && isFormulaNameChar(mPos[length], false)) return false;
+		mPos += length;
+		return true;
+	}
+	bool finish() {
+		if (mFailed) return false;
+		if (peek() != '\0') return fail("end of input");
+		return true;
+	}
+
+	/// Reads a name whose characters are given by the predicate into mName.
+	template<typename Pred>
+	bool readName(Pred&& isNameChar) {
+		skip();
+		const char* start = mPos;
+		if (mPos == mEnd || !isNameChar(*mPos, true)) return false;
+		while (mPos != mEnd && isNameChar(*mPos, false)) mPos++;
+		mName.assign(start, mPos);
+		return true;
+	}
+	Variable polynomialVariable() {
+		auto it = mVariables.find(mName);
+		if (it == mVariables.end()) {
+			it = mVariables.emplace(mName, freshRealVariable(mName)).first;
+		}
+		return it->second;
+	}
+	Variable booleanVariable() {
+		auto it = mBooleanVariables.find(mName);
+		if (it == mBooleanVariables.end()) {
+			it = mBooleanVariables.emplace(mName, freshBooleanVariable(mName)).first;
+		}
+		return it->second;
+	}
+
+	bool startsNumber() {
+		char c = peek();
+		if (std::isdigit(static_cast<unsigned char>(c))) return true;
+		return c == '.' && mPos + 1 != mEnd && std::isdigit(static_cast<unsigned char>(mPos[1]));
+	}
+	/// Adds the digits in [begin, end) to n, in chunks that fit into a machine integer.
+	static void appendDigits(Coeff& n, const char* begin, const char* end) {
+		while (begin != end) {
+			const char* chunkEnd = begin + std::min<std::ptrdiff_t>(end - begin, 9);
+			sint chunk = 0;
+			sint scale = 1;
+			for (; begin != chunkEnd; begin++) {
+				chunk = chunk * 10 + (*begin - '0');
+				scale *= 10;
+			}
+			n = n * Coeff(scale) + Coeff(chunk);
+		}
+	}
+	/// Parses an unsigned decimal number with optional fractional part and exponent.
+	bool parseNumber(Coeff& res) {
+		skip();
+		const char* intBegin = mPos;
+		while (mPos != mEnd && std::isdigit(static_cast<unsigned char>(*mPos))) mPos++;
+		const char* intEnd = mPos;
+		const char* fracBegin = mPos;
+		const char* fracEnd = mPos;
+		if (mPos != mEnd && *mPos == '.') {
+			fracBegin = ++mPos;
+			while (mPos != mEnd && std::isdigit(static_cast<unsigned char>(*mPos))) mPos++;
+			fracEnd = mPos;
+		}
+		if (intBegin == intEnd && fracBegin == fracEnd) return fail("a number");
+		long exp = -long(fracEnd - fracBegin);
+		if (mPos != mEnd && (*mPos == 'e' || *mPos == 'E')) {
+			const char* save = mPos++;
+			bool negative = false;
+			if (mPos != mEnd && (*mPos == '+' || *mPos == '-')) negative = (*mPos++ == '-');
+			const char* expBegin = mPos;
+			long e = 0;
+			while (mPos != mEnd && std::isdigit(static_cast<unsigned char>(*mPos))) e = e * 10 + (*mPos++ - '0');
+			if (expBegin == mPos) {
+				// Not an exponent, e.g. the variable e in "2e".
+				mPos = save;
+			} else {
+				exp += negative ? -e : e;
+			}
+		}
+		res = constant_zero<Coeff>::get();
+		appendDigits(res, intBegin, intEnd);
+		appendDigits(res, fracBegin, fracEnd);
+		if (exp > 0) res *= carl::pow(Coeff(10), uint(exp));
+		else if (exp < 0) res /= carl::pow(Coeff(10), uint(-exp));
+		return true;
+	}
+	bool parseExponent(uint& res) {
+		skip();
+		const char* begin = mPos;
+		res = 0;
+		while (mPos != mEnd && std::isdigit(static_cast<unsigned char>(*mPos))) res = res * 10 + uint(*mPos++ - '0');
+		if (begin == mPos) return fail("an exponent");
+		return true;
+	}
+
+	/// Parses a sum and appends its terms to the given vector.
+	bool parseSum(TermsType& terms) {
+		if (!parseProduct(terms)) return false;
+		while (true) {
+			char c = peek();
+			if (c != '+' && c != '-') return true;
+			mPos++;
+			if (!parseProduct(terms, c == '-')) return false;
+		}
+	}
+	/**
+	 * Parses a product and appends its terms to the given vector.
+	 * Numbers and powers of variables are multiplied into a single term, only parenthesized sums
+	 * are multiplied as polynomials.
+	 */
+	bool parseProduct(TermsType& terms, bool negate = false) {
+		Coeff coeff = negate ? Coeff(-1) : Coeff(1);
+		std::vector<std::pair<Variable, exponent>> powers;
+		boost::optional<Pol> poly;
+		do {
+			// Signs may precede every factor.
+			while (true) {
+				char c = peek();
+				if (c == '-') coeff = -coeff;
+				else if (c != '+') break;
+				mPos++;
+			}
+			if (accept('(')) {
+				TermsType subterms;
+				if (!parseSum(subterms)) return false;
+				if (!accept(')')) return fail("\")\"");
+				Pol p(std::move(subterms));
+				if (poly) *poly *= p;
+				else poly = std::move(p);
+			} else if (startsNumber()) {
+				Coeff n;
+				if (!parseNumber(n)) return false;
+				coeff *= n;
+				// A fraction of numbers, as printed for rational coefficients.
+				if (peek() == '/' && mEnd - mPos > 1 && std::isdigit(static_cast<unsigned char>(mPos[1]))) {
+					mPos++;
+					if (!parseNumber(n)) return false;
+					if (carl::isZero(n)) return fail("a nonzero denominator");
+					coeff /= n;
+				}
+				// A variable may follow a number without "*".
+				if (isPolynomialNameChar(peek(), true) && !parsePower(powers)) return false;
+			} else if (!parsePower(powers)) {
+				return fail("a number, a variable or \"(\"");
+			}
+		} while (accept('*'));
+		if (carl::isZero(coeff)) return true;
+		Term<Coeff> term(std::move(coeff), monomial(powers));
+		if (poly) {
+			*poly *= term;
+			terms.insert(terms.end(), poly->begin(), poly->end());
+		} else {
+			terms.push_back(std::move(term));
+		}
+		return true;
+	}
+	/// Parses a variable with an optional exponent.
+	bool parsePower(std::vector<std::pair<Variable, exponent>>& powers) {
+		if (!readName(isPolynomialNameChar)) return false;
+		Variable v = polynomialVariable();
+		uint e = 1;
+		if (accept('^') && !parseExponent(e)) return false;
+		if (e > 0) powers.emplace_back(v, e);
+		return true;
+	}
+	static Monomial::Arg monomial(std::vector<std::pair<Variable, exponent>>& powers) {
+		if (powers.empty()) return nullptr;
+		std::sort(powers.begin(), powers.end(), [](const std::pair<Variable, exponent>& lhs, const std::pair<Variable, exponent>& rhs){ return lhs.first < rhs.first; });
+		exponent total = 0;
+		std::size_t j = 0;
+		for (std::size_t i = 0; i < powers.size(); i++) {
+			total += powers[i].second;
+			if (j > 0 && powers[j-1].first == powers[i].first) powers[j-1].second += powers[i].second;
+			else powers[j++] = powers[i];
+		}
+		powers.resize(j);
+		return createMonomial(std::move(powers), total);
+	}
+
+	bool parsePolynomial(Pol& res) {
+		TermsType terms;
+		if (!parseSum(terms) || !finish()) return false;
+		res = Pol(std::move(terms));
+		return true;
+	}
+
+	bool parseFormula(Formula<Pol>& res) {
+		if (accept('(')) {
+			if (!parseFormulaOperation(res)) return false;
+			if (!accept(')')) return fail("\")\"");
+			return true;
+		}
+		if (!readName(isFormulaNameChar)) return fail("a Boolean variable or \"(\"");
+		res = Formula<Pol>(booleanVariable());
+		return true;
+	}
+	bool parseFormulaOperation(Formula<Pol>& res) {
+		if (acceptKeyword("not") || acceptKeyword("NOT")) {
+			Formula<Pol> sub;
+			if (!parseFormula(sub)) return false;
+			res = Formula<Pol>(FormulaType::NOT, sub);
+			return true;
+		}
+		Formula<Pol> first;
+		if (!parseFormula(first)) return false;
+		FormulaType binary;
+		if (acceptKeyword("IMPLIES")) binary = FormulaType::IMPLIES;
+		else if (acceptKeyword("iff")) binary = FormulaType::IFF;
+		else if (acceptKeyword("xor")) binary = FormulaType::XOR;
+		else {
+			for (FormulaType nary: {FormulaType::AND, FormulaType::OR}) {
+				const char* keyword = nary == FormulaType::AND ? "AND" : "OR";
+				if (!acceptKeyword(keyword)) continue;
+				Formulas<Pol> subformulas({first});
+				do {
+					subformulas.emplace_back();
+					if (!parseFormula(subformulas.back())) return false;
+				} while (acceptKeyword(keyword));
+				res = createNary(nary, std::move(subformulas));
+				return true;
+			}
+			res = first;
+			return true;
+		}
+		Formula<Pol> second;
+		if (!parseFormula(second)) return false;
+		res = Formula<Pol>(binary, {first, second});
+		return true;
+	}
+	static Formula<Pol> createNary(FormulaType op, Formulas<Pol>&& subformulas) {
+		FormulaType absorbing = op == FormulaType::AND ? FormulaType::FALSE : FormulaType::TRUE;
+		for (const auto& f: subformulas) {
+			if (f.getType() == absorbing) return Formula<Pol>(absorbing);
+		}
+		return Formula<Pol>(op, std::move(subformulas));
+	}
+
+public:
+	/**
+	 * Parses a polynomial.
+	 * @param s The input.
+	 * @param res Is set to the polynomial.
+	 * @return true, if the whole input was parsed successfully.
+	 */
+	bool polynomial(StringView s, Pol& res) {
+		reset(s);
+		return parsePolynomial(res);
+	}
+	Pol polynomial(StringView s) {
+		Pol res;
+		polynomial(s, res);
+		return res;
+	}
+
+	/**
+	 * Parses a rational function.
+	 * @param s The input.
+	 * @param res Is set to the rational function.
+	 * @return true, if the whole input was parsed successfully.
+	 */
+	bool rationalFunction(StringView s, RationalFunction<Pol>& res) {
+		reset(s);
+		TermsType numerator;
+		if (!parseSum(numerator)) return false;
+		if (accept('/')) {
+			TermsType denominator;
+			if (!parseSum(denominator) || !finish()) return false;
+			res = RationalFunction<Pol>(Pol(std::move(numerator)), Pol(std::move(denominator)));
+			return true;
+		}
+		if (!finish()) return false;
+		res = RationalFunction<Pol>(Pol(std::move(numerator)));
+		return true;
+	}
+	RationalFunction<Pol> rationalFunction(StringView s) {
+		RationalFunction<Pol> res;
+		rationalFunction(s, res);
+		return res;
+	}
+
+	/**
+	 * Parses a formula over Boolean variables.
+	 * @param s The input.
+	 * @param res Is set to the formula.
+	 * @return true, if the whole input was parsed successfully.
+	 */
+	bool formula(StringView s, Formula<Pol>& res) {
+		reset(s);
+		return parseFormula(res) && finish();
+	}
+	Formula<Pol> formula(StringView s) {
+		Formula<Pol> res;
+		formula(s, res);
+		return res;
+	}
+
+	/**
+	 * Makes the given variable known by its name.
+	 * Boolean variables are used in formulas, all others in polynomials.
+	 */
+	void addVariable(Variable::Arg v) {
+		if (v.getType() == VariableType::VT_BOOL) {
+			mBooleanVariables[VariablePool::getInstance().getName(v)] = v;
+		} else {
+			mVariables[VariablePool::getInstance().getName(v)] = v;
+		}
+	}
+};
+
+}
+}
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <random>
+#include <set>
+
+#include "carl/formula/bitvector/BVTermPool.h"
+
+using namespace carl;
+
+namespace {
+	/// Counts the distinct subterms of the given terms.
+	void collectSubterms(const BVTerm& term, std::set<std::size_t>& ids) {
+		if (!ids.insert(term.id()).second) return;
+		if (term.type() == BVTermType::EXTRACT || typeIsUnary(term.type())) {
+			collectSubterms(term.operand(), ids);
+		} else if (typeIsBinary(term.type())) {
+			collectSubterms(term.first(), ids);
+			collectSubterms(term.second(), ids);
+		}
+	}
+
+	/**
+	 * Generates terms in the style of the QF_BV benchmarks produced by
+	 * software verifiers: words are split into bytes and reassembled,
+	 * values are zero-extended repeatedly and address computations add
+	 * or multiply with (often neutral) constants.
+	 */
+	std::vector<BVTerm> generateSample(std::size_t count, const std::vector<BVTerm>& words) {
+		std::mt19937 rand(4711);
+		std::vector<BVTerm> pool(words);
+		std::vector<BVTerm> result;
+		auto pick = [&]() { return pool[rand() % pool.size()]; };
+		auto constant = [&](std::size_t width) { return BVTerm(BVTermType::CONSTANT, BVValue(width, carl::uint(rand() % 3))); };
+		for (std::size_t i = 0; i < count; i++) {
+			BVTerm t = pick();
+			switch (rand() % 6) {
+				case 0: {
+					// Reassemble a word from its bytes
+					BVTerm hi(BVTermType::CONCAT, BVTerm(BVTermType::EXTRACT, t, 31, 24), BVTerm(BVTermType::EXTRACT, t, 23, 16));
+					BVTerm lo(BVTermType::CONCAT, BVTerm(BVTermType::EXTRACT, t, 15, 8), BVTerm(BVTermType::EXTRACT, t, 7, 0));
+					t = BVTerm(BVTermType::CONCAT, hi, lo);
+					break;
+				}
+				case 1: {
+					// Load a byte and widen it in two steps
+					BVTerm byte(BVTermType::EXTRACT, t, 7, 0);
+					t = BVTerm(BVTermType::EXTRACT, BVTerm(BVTermType::EXT_U, BVTerm(BVTermType::EXT_U, byte, 8), 16), 31, 0);
+					break;
+				}
+				case 2:
+					t = BVTerm(BVTermType::ADD, BVTerm(BVTermType::MUL, t, constant(32)), BVTerm(BVTermType::ADD, constant(32), constant(32)));
+					break;
+				case 3:
+					t = BVTerm(BVTermType::XOR, BVTerm(BVTermType::ADD, t, pick()), BVTerm(BVTermType::ADD, pick(), t));
+					break;
+				case 4:
+					t = BVTerm(BVTermType::EXTRACT, BVTerm(BVTermType::CONCAT, pick(), t), 31, 0);
+					break;
+				default:
+					t = BVTerm(BVTermType::AND, BVTerm(BVTermType::NOT, BVTerm(BVTermType::NOT, t)), BVTerm(BVTermType::OR, pick(), constant(32)));
+			}
+			pool.push_back(t);
+			result.push_back(t);
+		}
+		return result;
+	}
+}
+
+/**
+ * Measures the reduction of the number of distinct terms due to the
+ * rewriting rules of BVTermPool.
+ */
+TEST(BVRewriting, TermCountReduction)
+{
+	SortManager& sm = SortManager::getInstance();
+	sm.clear();
+	Sort bvSort = sm.addSort("BitVec", VariableType::VT_UNINTERPRETED);
+	sm.makeSortIndexable(bvSort, 1, VariableType::VT_BITVECTOR);
+	Sort sort = getSort("BitVec", std::vector<std::size_t>({32}));
+	std::vector<BVTerm> words;
+	for (std::size_t i = 0; i < 8; i++) {
+		words.emplace_back(BVTermType::VARIABLE, BVVariable(freshBitvectorVariable(), sort));
+	}
+
+	BVTermPool& pool = BVTermPool::getInstance();
+	BVTermRewriting rewriting = pool.rewriting();
+	std::set<std::size_t> plain;
+	pool.setRewriting(BVTermRewriting::none());
+	for (const auto& t: generateSample(2000, words)) collectSubterms(t, plain);
+	std::set<std::size_t> rewritten;
+	pool.setRewriting(rewriting);
+	for (const auto& t: generateSample(2000, words)) collectSubterms(t, rewritten);
+
+	std::cout << "Distinct terms without rewriting: " << plain.size() << ", with rewriting: " << rewritten.size()
+		<< " (" << (100 * (plain.size() - rewritten.size()) / plain.size()) << "% reduction)" << std::endl;
+	EXPECT_LT(rewritten.size(), plain.size());
+}
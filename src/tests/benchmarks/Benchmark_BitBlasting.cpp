@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+
+#include "carl/formula/bitvector/BVBitBlaster.h"
+#include "carl/formula/bitvector/BVTermPool.h"
+#include "carl/util/Timer.h"
+
+using namespace carl;
+
+/**
+ * Measures the throughput of bit-blasting wide multiplications.
+ * Every product uses fresh operands, hence no term is shared.
+ */
+TEST(BitBlasting, WideMultiplication)
+{
+	SortManager& sm = SortManager::getInstance();
+	sm.clear();
+	Sort bvSort = sm.addSort("BitVec", VariableType::VT_UNINTERPRETED);
+	sm.makeSortIndexable(bvSort, 1, VariableType::VT_BITVECTOR);
+	for (std::size_t width: {32, 64, 128, 256}) {
+		Sort sort = getSort("BitVec", std::vector<std::size_t>({width}));
+		std::size_t products = 4096 / width;
+		Timer timer;
+		BVBitBlaster bb;
+		for (std::size_t i = 0; i < products; i++) {
+			BVTerm a(BVTermType::VARIABLE, BVVariable(freshBitvectorVariable(), sort));
+			BVTerm b(BVTermType::VARIABLE, BVVariable(freshBitvectorVariable(), sort));
+			bb.blast(BVTerm(BVTermType::MUL, a, b));
+		}
+		std::size_t time = timer.passed();
+		std::cout << "bvmul width " << width << ": " << products << " products, "
+			<< bb.variables() << " variables, " << bb.clauses().size() << " clauses in "
+			<< time << " ms" << std::endl;
+		EXPECT_GT(bb.clauses().size(), products * width);
+	}
+}
@@ -0,0 +1,47 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+
+#include "carl/formula/SortManager.h"
+#include "carl/formula/uninterpreted/CongruenceClosure.h"
+#include "carl/formula/uninterpreted/UFInstanceManager.h"
+#include "carl/formula/uninterpreted/UFManager.h"
+#include "carl/util/Timer.h"
+
+using namespace carl;
+
+/**
+ * Measures the congruence closure on chains x_{i+1} = f(x_i) of nested
+ * function applications. Equating the first element with a later one makes
+ * the chain collapse through congruences, which is then undone again.
+ */
+TEST(CongruenceClosure, NestedChains)
+{
+	SortManager& sm = SortManager::getInstance();
+	sm.clear();
+	Sort sort = sm.addSort("S", VariableType::VT_UNINTERPRETED);
+	UninterpretedFunction f = newUninterpretedFunction("f", {sort}, sort);
+	for (std::size_t length: {1000, 10000, 100000}) {
+		std::vector<UVariable> chain({UVariable(freshUninterpretedVariable(), sort)});
+		std::vector<UEquality> equalities;
+		for (std::size_t i = 0; i < length; i++) {
+			chain.emplace_back(freshUninterpretedVariable(), sort);
+			equalities.emplace_back(chain.back(), newUFInstance(f, std::vector<UVariable>({chain[i]})), false);
+		}
+		Timer timer;
+		CongruenceClosure cc;
+		for (const auto& eq: equalities) cc.add(eq);
+		std::size_t build = timer.passed();
+		timer.reset();
+		// x = f^period(x) makes the chain periodic, all of it is merged into period many classes.
+		for (std::size_t period: {length / 2, std::size_t(1)}) {
+			cc.push();
+			cc.add(UEquality(chain[0], chain[period], false));
+			EXPECT_TRUE(cc.areEqual(chain[0], chain[length]));
+			cc.pop();
+		}
+		std::size_t collapse = timer.passed();
+		std::cout << "Chain of length " << length << ": " << build << " ms to build, "
+			<< collapse << " ms to collapse and backtrack" << std::endl;
+	}
+}
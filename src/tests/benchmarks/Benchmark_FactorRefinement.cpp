@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/FactorizedPolynomial.h"
+#include "carl/util/Timer.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef FactorizedPolynomial<Pol> FPol;
+
+namespace {
+
+/**
+ * Two products of many factors, where every factor is the product of two out of a set of linear polynomials,
+ * such that the factors share divisors that are not visible in the factorizations.
+ */
+struct Products {
+	std::vector<Pol> linear;
+	std::vector<Pol> factorsA;
+	std::vector<Pol> factorsB;
+
+	Products(std::size_t factors) {
+		Variable x = freshRealVariable("x");
+		Variable y = freshRealVariable("y");
+		Variable z = freshRealVariable("z");
+		std::mt19937 rand(42);
+		std::uniform_int_distribution<int> coeff(1, 9);
+		for (std::size_t i = 0; i < 2 * factors; i++) {
+			linear.push_back(Pol(x) * Rational(coeff(rand)) + Pol(y) * Rational(coeff(rand)) + Pol(z) * Rational(coeff(rand)) + Rational(coeff(rand)));
+		}
+		std::uniform_int_distribution<std::size_t> pick(0, linear.size() - 1);
+		for (std::size_t i = 0; i < factors; i++) {
+			factorsA.push_back(linear[pick(rand)] * linear[pick(rand)]);
+			factorsB.push_back(linear[pick(rand)] * linear[pick(rand)]);
+		}
+	}
+
+	std::pair<FPol, FPol> create(const std::shared_ptr<FPol::CACHE>& cache) const {
+		FPol a(Rational(1));
+		FPol b(Rational(1));
+		for (const auto& f: factorsA) a *= FPol(f, cache);
+		for (const auto& f: factorsB) b *= FPol(f, cache);
+		return std::make_pair(a, b);
+	}
+};
+
+}
+
+/**
+ * Compares cancelling the gcd of two products of many factors by gcd() and by refineFactorizations() followed by lazyDiv().
+ */
+TEST(FactorRefinementBenchmark, ManyFactors)
+{
+	for (std::size_t factors: {12, 24, 48}) {
+		Products products(factors);
+		Timer timer;
+		std::shared_ptr<FPol::CACHE> gcdCache(new FPol::CACHE);
+		auto gcdPair = products.create(gcdCache);
+		FPol restA, restB;
+		gcd(gcdPair.first, gcdPair.second, restA, restB);
+		std::cout << factors << " factors: " << timer.passed() << " ms gcd";
+
+		std::vector<Pol> results;
+		for (std::size_t threads: {1, 4}) {
+			timer.reset();
+			std::shared_ptr<FPol::CACHE> cache(new FPol::CACHE);
+			auto pair = products.create(cache);
+			refineFactorizations(pair.first, pair.second, threads);
+			auto quotient = lazyDiv(pair.first, pair.second);
+			std::cout << ", " << timer.passed() << " ms refinement with " << threads << " threads";
+			results.push_back(computePolynomial(quotient.second));
+		}
+		EXPECT_EQ(results.front(), results.back());
+		std::cout << std::endl;
+	}
+}
@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "carl/config.h"
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/FactorizedPolynomial.h"
+#include "carl/util/Cache.h"
+#include "carl/util/ShardedCache.h"
+#include "carl/util/Timer.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef FactorizedPolynomial<Pol> FPol;
+
+namespace {
+
+/// A cheap cached object, such that the benchmark measures the cache itself.
+struct Key {
+	std::size_t value;
+	explicit Key(std::size_t v): value(v) {}
+	std::size_t getHash() const {
+		return value * 0x9e3779b97f4a7c15ull;
+	}
+	void rehash() const {}
+	bool operator==(const Key& k) const {
+		return value == k.value;
+	}
+};
+std::ostream& operator<<(std::ostream& os, const Key& k) {
+	return os << k.value;
+}
+
+/**
+ * Mimics the cache usage of FactorizedPolynomial operations: every thread registers, accesses and
+ * deregisters shared entries, as done when copying and destroying factorized polynomials, and
+ * caches new objects that become unused immediately, as done for intermediate results.
+ */
+template<typename C>
+std::size_t contention(std::size_t threads, std::size_t operations) {
+	C cache(10000);
+	std::vector<typename C::Ref> shared;
+	for (std::size_t i = 0; i < 256; i++) {
+		shared.push_back(cache.cacheAndReg(new Key(i)).first);
+	}
+	std::atomic<std::size_t> checksum(0);
+	Timer timer;
+	std::vector<std::thread> workers;
+	for (std::size_t t = 0; t < threads; t++) {
+		workers.emplace_back([&, t](){
+			std::size_t sum = 0;
+			for (std::size_t i = 0; i < operations / threads; i++) {
+				typename C::Ref ref = shared[(i * 7 + t) % shared.size()];
+				cache.reg(ref);
+				sum += cache.get(ref).value;
+				cache.strengthenActivity(ref);
+				cache.dereg(ref);
+				if (i % 16 == 0) {
+					Key* k = new Key(1000 + t * operations + i);
+					auto res = cache.cacheAndReg(k);
+					if (!res.second) delete k;
+					cache.dereg(res.first);
+				}
+			}
+			checksum += sum;
+		});
+	}
+	for (auto& w: workers) w.join();
+	std::size_t time = timer.passed();
+	for (auto ref: shared) cache.dereg(ref);
+	EXPECT_GT(checksum, 0);
+	return time;
+}
+
+}
+
+/**
+ * Compares the serialized Cache with the ShardedCache when used by an increasing number of threads.
+ */
+TEST(FactorizedPolynomialCacheBenchmark, Contention)
+{
+	std::size_t operations = 1000000;
+	for (std::size_t threads: {1, 2, 4, 8}) {
+		std::size_t serial = contention<Cache<Key>>(threads, operations);
+		std::size_t sharded = contention<ShardedCache<Key>>(threads, operations);
+		std::cout << threads << " threads: " << serial << " ms with Cache, " << sharded << " ms with ShardedCache" << std::endl;
+	}
+}
+
+/**
+ * Computes products, quotients and gcds of factorized polynomials from a shared cache in multiple threads.
+ * Arithmetic on polynomials is only thread safe if carl is built with THREAD_SAFE, in which case FactorizedPolynomial uses the ShardedCache.
+ */
+TEST(FactorizedPolynomialCacheBenchmark, Arithmetic)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	std::shared_ptr<FPol::CACHE> pCache(new FPol::CACHE);
+	std::vector<FPol> factors = {
+		FPol(Pol(x) + Rational(1), pCache),
+		FPol(Pol(y) - Rational(2), pCache),
+		FPol(Pol(x) * y + z, pCache),
+		FPol(Pol(z) * z - x, pCache),
+		FPol(Pol(x) * x + Pol(y) * y + Rational(3), pCache),
+		FPol(Pol(y) * z - Rational(5), pCache),
+	};
+	auto work = [&factors](std::size_t offset, std::size_t rounds) {
+		for (std::size_t r = 0; r < rounds; r++) {
+			std::size_t i = (r + offset) % factors.size();
+			std::size_t j = (r * 5 + offset + 1) % factors.size();
+			FPol a = factors[i] * factors[j] * factors[(i + 2) % factors.size()];
+			FPol b = factors[j] * factors[(j + 3) % factors.size()];
+			FPol g = gcd(a, b);
+			FPol q = (a * b).quotient(g);
+			EXPECT_EQ(computePolynomial(a * b), computePolynomial(q * g));
+		}
+	};
+	std::size_t rounds = 4000;
+	Timer timer;
+	work(0, rounds);
+	std::cout << "1 thread: " << timer.passed() << " ms" << std::endl;
+#ifdef THREAD_SAFE
+	for (std::size_t threads: {2, 4, 8}) {
+		timer.reset();
+		std::vector<std::thread> workers;
+		for (std::size_t t = 0; t < threads; t++) {
+			workers.emplace_back(work, t, rounds / threads);
+		}
+		for (auto& w: workers) w.join();
+		std::cout << threads << " threads: " << timer.passed() << " ms" << std::endl;
+	}
+#else
+	std::cout << "Multiple threads require carl to be built with THREAD_SAFE." << std::endl;
+#endif
+}
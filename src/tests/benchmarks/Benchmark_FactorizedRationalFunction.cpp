@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/FactorizedPolynomial.h"
+#include "carl/core/FactorizedRationalFunction.h"
+#include "carl/core/RationalFunction.h"
+#include "carl/util/Timer.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef FactorizedPolynomial<Pol> FPol;
+
+namespace {
+
+/**
+ * The terms of a sum as it occurs when eliminating states of a parametric Markov chain: the numerators are
+ * products of transition probabilities, the denominators are powers of few loop probabilities.
+ */
+struct ChainTerms {
+	Variable p = freshRealVariable("p");
+	Variable q = freshRealVariable("q");
+	std::vector<Pol> numerators;
+	std::vector<std::vector<Pol>> denominators;
+
+	explicit ChainTerms(std::size_t length) {
+		Pol one(Rational(1));
+		std::vector<Pol> loops = {
+			one - Pol(p) * q,
+			one + Pol(q),
+			one - Pol(p) * p * Rational(1)/Rational(2),
+			Pol(p) + Pol(q) * Rational(3),
+		};
+		for (std::size_t i = 0; i < length; i++) {
+			Pol num = Pol(p) * q;
+			if (i % 2 == 0) num *= one - Pol(p);
+			if (i % 3 == 0) num *= one - Pol(q);
+			numerators.push_back(num * Rational(i + 1));
+			std::vector<Pol> den;
+			for (std::size_t j = 0; j < loops.size(); j++) {
+				for (std::size_t e = 0; e < (i + j) % 3; e++) den.push_back(loops[j]);
+			}
+			denominators.push_back(den);
+		}
+	}
+
+	std::map<Variable, Rational> point() const {
+		return {{p, Rational(1)/Rational(3)}, {q, Rational(2)/Rational(7)}};
+	}
+};
+
+template<typename RF>
+Rational sumUp(const ChainTerms& terms, const std::function<RF(const Pol&, const std::vector<Pol>&)>& create, const std::function<void(RF&)>& finish, const std::string& name) {
+	Timer timer;
+	RF sum = create(Pol(Rational(0)), {});
+	for (std::size_t i = 0; i < terms.numerators.size(); i++) {
+		sum += create(terms.numerators[i], terms.denominators[i]);
+	}
+	finish(sum);
+	std::cout << name << ": " << timer.passed() << " ms" << std::endl;
+	return sum.evaluate(terms.point());
+}
+
+/**
+ * Sums up the given number of terms with the different rational function types, optionally including RationalFunction
+ * over expanded polynomials, which simplifies by a full gcd after every addition.
+ */
+void additionChain(std::size_t length, bool withExpanded)
+{
+	ChainTerms terms(length);
+	std::shared_ptr<FPol::CACHE> pCache(new FPol::CACHE);
+	auto toFPol = [&pCache](const Pol& p) {
+		return p.isConstant() ? FPol(p.constantPart()) : FPol(p, pCache);
+	};
+	auto product = [&toFPol](const std::vector<Pol>& factors) {
+		FPol res(Rational(1));
+		for (const auto& f: factors) res *= toFPol(f);
+		return res;
+	};
+
+	Rational expected = sumUp<FactorizedRationalFunction<Pol, false>>(terms,
+		[&](const Pol& num, const std::vector<Pol>& den) { return FactorizedRationalFunction<Pol, false>(toFPol(num), product(den)); },
+		[](FactorizedRationalFunction<Pol, false>& rf) { rf.simplify(); },
+		"FactorizedRationalFunction simplified at the end"
+	);
+	EXPECT_EQ(expected, (sumUp<FactorizedRationalFunction<Pol, true>>(terms,
+		[&](const Pol& num, const std::vector<Pol>& den) { return FactorizedRationalFunction<Pol, true>(toFPol(num), product(den)); },
+		[](FactorizedRationalFunction<Pol, true>&) {},
+		"FactorizedRationalFunction with AutoSimplify"
+	)));
+	EXPECT_EQ(expected, (sumUp<RationalFunction<FPol, false>>(terms,
+		[&](const Pol& num, const std::vector<Pol>& den) { return RationalFunction<FPol, false>(toFPol(num), product(den)); },
+		[](RationalFunction<FPol, false>& rf) { rf.simplify(); },
+		"RationalFunction<FPol> simplified at the end"
+	)));
+	EXPECT_EQ(expected, (sumUp<RationalFunction<FPol, true>>(terms,
+		[&](const Pol& num, const std::vector<Pol>& den) { return RationalFunction<FPol, true>(toFPol(num), product(den)); },
+		[](RationalFunction<FPol, true>&) {},
+		"RationalFunction<FPol> with AutoSimplify"
+	)));
+	if (!withExpanded) return;
+	EXPECT_EQ(expected, (sumUp<RationalFunction<Pol, true>>(terms,
+		[](const Pol& num, const std::vector<Pol>& den) {
+			Pol d(Rational(1));
+			for (const auto& f: den) d *= f;
+			return RationalFunction<Pol, true>(num, d);
+		},
+		[](RationalFunction<Pol, true>&) {},
+		"RationalFunction<Pol> with AutoSimplify"
+	)));
+}
+
+}
+
+/**
+ * Compares RationalFunction and FactorizedRationalFunction on chains of additions.
+ */
+TEST(FactorizedRationalFunctionBenchmark, AdditionChain)
+{
+	std::cout << "Sum of 30 terms:" << std::endl;
+	additionChain(30, true);
+	std::cout << "Sum of 400 terms:" << std::endl;
+	additionChain(400, false);
+}
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <random>
+
+#include "carl/core/FlatHorner.h"
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/interval/IntervalBatch.h"
+#include "carl/interval/IntervalEvaluation.h"
+#include "carl/util/Timer.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+/**
+ * Compares the evaluation of a polynomial over many boxes one by one with the batched evaluation.
+ */
+TEST(IntervalBatchEvaluation, Throughput)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	Pol p = (Pol(x) * Rational(3) + Pol(y) * y - Pol(z) * Rational(5) + Rational(1)).pow(3) + Pol(x) * y * z;
+	FlatHorner<Pol> flat(p);
+	std::size_t n = 100000;
+	std::mt19937 rand(4711);
+	std::uniform_real_distribution<double> bound(-2, 2);
+	std::vector<std::map<Variable, Interval<double>>> boxes(n);
+	IntervalBatch batch(flat.variables().size(), n);
+	for (std::size_t b = 0; b < n; b++) {
+		for (std::size_t v = 0; v < flat.variables().size(); v++) {
+			double l = bound(rand);
+			Interval<double> i(l, l + 0.01);
+			boxes[b][flat.variables()[v]] = i;
+			batch.set(v, b, i);
+		}
+	}
+
+	Timer timer;
+	std::vector<Interval<double>> generic;
+	generic.reserve(n);
+	for (const auto& box: boxes) generic.push_back(IntervalEvaluation::evaluate(p, box));
+	std::size_t genericTime = timer.passed();
+
+	timer.reset();
+	std::vector<Interval<double>> horner;
+	horner.reserve(n);
+	for (const auto& box: boxes) horner.push_back(flat.evaluate(box));
+	std::size_t hornerTime = timer.passed();
+
+	timer.reset();
+	std::vector<Interval<double>> batched;
+	flat.evaluate(batch, batched);
+	std::size_t batchTime = timer.passed();
+
+	ASSERT_EQ(n, batched.size());
+	for (std::size_t b = 0; b < n; b++) {
+		EXPECT_TRUE(batched[b].contains(horner[b])) << b;
+	}
+	std::cout << n << " boxes: " << genericTime << " ms generic, " << hornerTime << " ms Horner, " << batchTime << " ms batched (AVX2: " << IntervalBatchKernels::avx2() << ")" << std::endl;
+}
@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <random>
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/interval/IntervalEvaluation.h"
+#include "carl/util/Timer.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+/**
+ * Compares the width of the enclosures and the runtime of the evaluation strategies on
+ * polynomials with many dependencies, evaluated over boxes of decreasing size.
+ */
+TEST(IntervalEvaluationStrategies, WidthAndRuntime)
+{
+	std::mt19937 rand(4711);
+	std::uniform_int_distribution<int> coeff(-10, 10);
+	std::vector<Variable> vars;
+	for (std::size_t i = 0; i < 4; i++) vars.push_back(freshRealVariable("x" + std::to_string(i)));
+	std::vector<Pol> polys;
+	for (std::size_t i = 0; i < 50; i++) {
+		// Products of random linear forms yield polynomials with many dependent terms.
+		Pol p(Rational(1));
+		for (std::size_t f = 0; f < 3; f++) {
+			Pol factor(Rational(coeff(rand)));
+			for (Variable v: vars) factor += Rational(coeff(rand)) * v;
+			p *= factor;
+		}
+		polys.push_back(p);
+	}
+	std::size_t rounds = 20;
+	std::vector<std::pair<IntervalEvaluationStrategy, std::string>> strategies = {
+		{IntervalEvaluationStrategy::NAIVE, "naive"},
+		{IntervalEvaluationStrategy::AFFINE, "affine"},
+		{IntervalEvaluationStrategy::MEAN_VALUE, "mean value"}
+	};
+	for (double radius: {1.0, 0.1, 0.01}) {
+		std::map<Variable, Interval<double>> box;
+		for (std::size_t i = 0; i < vars.size(); i++) {
+			box[vars[i]] = Interval<double>(0.5 * double(i) - radius, 0.5 * double(i) + radius);
+		}
+		std::vector<Interval<double>> naive;
+		for (const auto& p: polys) naive.push_back(IntervalEvaluation::evaluate(p, box));
+		for (const auto& s: strategies) {
+			double width = 0;
+			Timer timer;
+			for (std::size_t r = 0; r < rounds; r++) {
+				for (std::size_t i = 0; i < polys.size(); i++) {
+					Interval<double> res = IntervalEvaluation::evaluate(polys[i], box, s.first);
+					if (r == 0) {
+						// All strategies enclose the range of the polynomial.
+						EXPECT_TRUE(res.intersectsWith(naive[i]));
+						width += res.diameter() / naive[i].diameter();
+					}
+				}
+			}
+			std::cout << "Radius " << radius << ", " << s.second << ": " << timer.passed() << " ms, average relative width " << width / double(polys.size()) << std::endl;
+		}
+	}
+}
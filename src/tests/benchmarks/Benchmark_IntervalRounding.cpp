@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <random>
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/interval/Contraction.h"
+#include "carl/interval/IntervalEvaluation.h"
+#include "carl/interval/RoundingScope.h"
+#include "carl/util/Timer.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+namespace {
+	Pol randomPolynomial(std::mt19937& rand, const std::vector<Variable>& vars, std::size_t terms) {
+		std::uniform_int_distribution<std::size_t> var(0, vars.size() - 1);
+		std::uniform_int_distribution<int> coeff(-100, 100);
+		Pol res;
+		for (std::size_t t = 0; t < terms; t++) {
+			Pol term = Pol(Rational(coeff(rand)));
+			for (std::size_t d = 0; d < 4; d++) term *= vars[var(rand)];
+			res += term;
+		}
+		return res;
+	}
+}
+
+/**
+ * Compares interval evaluation and Newton contraction with the rounding mode being switched
+ * for every operation and once for an IntervalRoundingScope.
+ * Interval<double> only leaves the rounding mode to the scope if carl is built with SCOPED_INTERVAL_ROUNDING.
+ */
+TEST(IntervalRounding, EvaluationAndContraction)
+{
+	std::mt19937 rand(4711);
+	std::vector<Variable> vars;
+	Interval<double>::evalintervalmap box;
+	for (std::size_t i = 0; i < 8; i++) {
+		vars.push_back(freshRealVariable("x" + std::to_string(i)));
+		box[vars.back()] = Interval<double>(-1.5 + 0.1 * double(i), 2.0 + 0.3 * double(i));
+	}
+	std::vector<Pol> polys;
+	for (std::size_t i = 0; i < 100; i++) polys.push_back(randomPolynomial(rand, vars, 30));
+	std::size_t rounds = 200;
+
+	std::vector<Interval<double>> perOperation;
+	Timer timer;
+	for (std::size_t r = 0; r < rounds; r++) {
+		for (const auto& p: polys) perOperation.push_back(IntervalEvaluation::evaluate(p, box));
+	}
+	std::size_t evalPerOperation = timer.passed();
+	std::vector<Interval<double>> scoped;
+	timer.reset();
+	{
+		IntervalRoundingScope scope;
+		for (std::size_t r = 0; r < rounds; r++) {
+			for (const auto& p: polys) scoped.push_back(IntervalEvaluation::evaluate(p, box));
+		}
+	}
+	std::size_t evalScoped = timer.passed();
+	EXPECT_EQ(perOperation, scoped);
+
+	std::vector<Contraction<SimpleNewton, Pol>> contractions;
+	for (const auto& p: polys) contractions.emplace_back(p);
+	std::vector<Interval<double>> contracted;
+	timer.reset();
+	for (auto& c: contractions) {
+		for (Variable v: vars) {
+			Interval<double> resA, resB;
+			c(box, v, resA, resB);
+			contracted.push_back(resA);
+		}
+	}
+	std::size_t contractPerOperation = timer.passed();
+	std::vector<Interval<double>> contractedScoped;
+	timer.reset();
+	{
+		IntervalRoundingScope scope;
+		for (auto& c: contractions) {
+			for (Variable v: vars) {
+				Interval<double> resA, resB;
+				c(box, v, resA, resB);
+				contractedScoped.push_back(resA);
+			}
+		}
+	}
+	std::size_t contractScoped = timer.passed();
+	EXPECT_EQ(contracted, contractedScoped);
+
+	std::cout << "Evaluation: " << evalPerOperation << " ms switching per operation, " << evalScoped << " ms in a scope" << std::endl;
+	std::cout << "Contraction: " << contractPerOperation << " ms switching per operation, " << contractScoped << " ms in a scope" << std::endl;
+}
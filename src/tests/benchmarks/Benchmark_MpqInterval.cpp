@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <random>
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/UnivariatePolynomial.h"
+#include "carl/interval/IntervalEvaluation.h"
+#include "carl/interval/MpqIntervalKernels.h"
+#include "carl/util/Timer.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef Interval<mpq_class> MpqInterval;
+
+/**
+ * Compares the generic operations on rational intervals with the MpqIntervalKernels.
+ */
+TEST(MpqIntervalKernels, Arithmetic)
+{
+	std::mt19937 rand(4711);
+	std::uniform_int_distribution<int> num(-1000, 1000);
+	std::uniform_int_distribution<int> den(1, 1000);
+	std::vector<MpqInterval> intervals;
+	for (std::size_t i = 0; i < 1000; i++) {
+		mpq_class a(num(rand), den(rand));
+		mpq_class b(num(rand), den(rand));
+		a.canonicalize();
+		b.canonicalize();
+		intervals.emplace_back(std::min(a, b), std::max(a, b));
+	}
+	std::size_t rounds = 100;
+
+	std::vector<MpqInterval> generic;
+	Timer timer;
+	for (std::size_t r = 0; r < rounds; r++) {
+		MpqInterval sum(0);
+		for (std::size_t i = 1; i < intervals.size(); i++) {
+			sum += intervals[i - 1] * intervals[i];
+		}
+		generic.push_back(sum);
+	}
+	std::size_t genericTime = timer.passed();
+
+	std::vector<MpqInterval> kernel;
+	MpqIntervalKernels kernels;
+	timer.reset();
+	for (std::size_t r = 0; r < rounds; r++) {
+		MpqInterval sum(0);
+		MpqInterval product;
+		for (std::size_t i = 1; i < intervals.size(); i++) {
+			kernels.mul(intervals[i - 1], intervals[i], product);
+			kernels.add(sum, product, sum);
+		}
+		kernel.push_back(sum);
+	}
+	std::size_t kernelTime = timer.passed();
+	EXPECT_EQ(generic, kernel);
+	std::cout << "Sum of products: " << genericTime << " ms generic, " << kernelTime << " ms with kernels" << std::endl;
+}
+
+TEST(MpqIntervalKernels, Evaluation)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	typedef MultivariatePolynomial<mpq_class> Pol;
+	Pol p = (Pol(x) * mpq_class(3, 7) + Pol(y) * y - Pol(z) * mpq_class(5, 11) + mpq_class(1, 3)).pow(5);
+	std::map<Variable, MpqInterval> map = {
+		{x, MpqInterval(mpq_class(-13, 17), mpq_class(19, 23))},
+		{y, MpqInterval(mpq_class(29, 31), mpq_class(37, 41))},
+		{z, MpqInterval(mpq_class(-43, 47), mpq_class(-53, 59))}
+	};
+	std::size_t rounds = 200;
+
+	MpqInterval generic;
+	Timer timer;
+	for (std::size_t r = 0; r < rounds; r++) {
+		generic = MpqInterval(0);
+		for (const auto& t: p) generic += IntervalEvaluation::evaluate(t, map);
+	}
+	std::size_t genericTime = timer.passed();
+	MpqInterval kernel;
+	MpqIntervalKernels kernels;
+	timer.reset();
+	for (std::size_t r = 0; r < rounds; r++) kernels.evaluate(p, map, kernel);
+	std::size_t kernelTime = timer.passed();
+	EXPECT_EQ(generic, kernel);
+	std::cout << "Multivariate evaluation of " << p.nrTerms() << " terms: " << genericTime << " ms generic, " << kernelTime << " ms with kernels" << std::endl;
+
+	UnivariatePolynomial<mpq_class> q = p.substitute(y, Pol(mpq_class(1, 2))).substitute(z, Pol(mpq_class(1, 3))).toUnivariatePolynomial(x).toNumberCoefficients();
+	timer.reset();
+	for (std::size_t r = 0; r < 100 * rounds; r++) {
+		generic = MpqInterval(q.coefficients().back());
+		for (std::size_t i = q.degree(); i > 0; i--) generic = generic * map[x] + MpqInterval(q.coefficients()[i - 1]);
+	}
+	genericTime = timer.passed();
+	timer.reset();
+	for (std::size_t r = 0; r < 100 * rounds; r++) kernels.horner(q, map[x], kernel);
+	kernelTime = timer.passed();
+	EXPECT_EQ(generic, kernel);
+	std::cout << "Horner evaluation of degree " << q.degree() << ": " << genericTime << " ms generic, " << kernelTime << " ms with kernels" << std::endl;
+}
@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <random>
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/RationalFunction.h"
+#include "carl/core/RationalFunctionEvaluator.h"
+#include "carl/interval/IntervalBatch.h"
+#include "carl/util/Timer.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+/**
+ * Compares the evaluation of a rational function with many terms by RationalFunction::evaluate() with
+ * the exact, the double and the certified evaluation of the compiled program.
+ */
+TEST(RationalFunctionEvaluatorBenchmark, Throughput)
+{
+	Variable p = freshRealVariable("p");
+	Variable q = freshRealVariable("q");
+	Variable r = freshRealVariable("r");
+	Pol num = (Pol(p) * Rational(3) + Pol(q) - Pol(r) * Rational(1)/Rational(2) + Rational(1)).pow(8);
+	Pol den = (Pol(p) * q + Pol(r) * Rational(2) + Rational(3)).pow(6) + num * Rational(1)/Rational(5);
+	RationalFunction<Pol> rf(num, den);
+	Timer timer;
+	RationalFunctionEvaluator<Pol> evaluator(rf);
+	std::cout << rf.nominatorAsPolynomial().nrTerms() << " + " << rf.denominatorAsPolynomial().nrTerms() << " terms compiled into "
+		<< evaluator.instructions().size() << " instructions on " << evaluator.registers() << " registers in " << timer.passed() << " ms" << std::endl;
+
+	std::size_t exactPoints = 2000;
+	std::size_t n = 1000000;
+	std::mt19937 rand(4711);
+	std::uniform_int_distribution<int> value(0, 1024);
+	std::size_t vars = evaluator.variables().size();
+	std::vector<std::vector<double>> values(vars, std::vector<double>(n));
+	std::vector<std::map<Variable, Rational>> points(exactPoints);
+	for (std::size_t i = 0; i < n; i++) {
+		for (std::size_t v = 0; v < vars; v++) {
+			Rational x = Rational(value(rand)) / 1024;
+			values[v][i] = carl::toDouble(x);
+			if (i < exactPoints) points[i][evaluator.variables()[v]] = x;
+		}
+	}
+
+	timer.reset();
+	std::vector<Rational> generic;
+	for (const auto& point: points) generic.push_back(rf.evaluate(point));
+	std::size_t genericTime = timer.passed();
+
+	timer.reset();
+	std::vector<Rational> exact;
+	for (const auto& point: points) exact.push_back(evaluator.evaluate(point));
+	std::size_t exactTime = timer.passed();
+	EXPECT_EQ(generic, exact);
+	std::cout << exactPoints << " points: " << genericTime << " ms RationalFunction::evaluate, " << exactTime << " ms exact program" << std::endl;
+
+	std::vector<const double*> input;
+	for (const auto& v: values) input.push_back(v.data());
+	std::vector<double> result(n);
+	timer.reset();
+	evaluator.evaluate(n, input, result.data());
+	std::size_t doubleTime = timer.passed();
+
+	IntervalBatch boxes(vars, n);
+	for (std::size_t v = 0; v < vars; v++) {
+		for (std::size_t i = 0; i < n; i++) boxes.set(v, i, Interval<double>(values[v][i]));
+	}
+	std::vector<Interval<double>> enclosures;
+	std::vector<bool> nearPole;
+	timer.reset();
+	evaluator.evaluate(boxes, enclosures, nearPole);
+	std::size_t certifiedTime = timer.passed();
+
+	for (std::size_t i = 0; i < exactPoints; i++) {
+		double d = carl::toDouble(exact[i]);
+		EXPECT_NEAR(d, result[i], 1e-9 * std::abs(d));
+		EXPECT_FALSE(nearPole[i]);
+		EXPECT_TRUE(enclosures[i].contains(d));
+	}
+	std::cout << n << " points: " << doubleTime << " ms double, " << certifiedTime << " ms certified (AVX2: " << IntervalBatchKernels::avx2() << ")" << std::endl;
+}
@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/formula/parser/SMTLIBReader.h"
+#include "carl/io/BinarySerialization.h"
+#include "carl/io/SMTLIBStream.h"
+#include "carl/util/Timer.h"
+#include "carl/util/parser/RecursiveDescentParser.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef Formula<Pol> FormulaT;
+
+namespace {
+	Pol randomPolynomial(std::mt19937& rand, const std::vector<Variable>& vars, std::size_t terms) {
+		std::uniform_int_distribution<std::size_t> var(0, vars.size() - 1);
+		std::uniform_int_distribution<int> coeff(-1000000, 1000000);
+		Pol res;
+		for (std::size_t t = 0; t < terms; t++) {
+			Pol term = Pol(Rational(coeff(rand)) / Rational(std::abs(coeff(rand)) + 1));
+			for (std::size_t d = 0; d < 3; d++) term *= vars[var(rand)];
+			res += term;
+		}
+		return res;
+	}
+}
+
+/**
+ * Compares writing and reading polynomials in the binary format with printing and parsing them.
+ */
+TEST(Serialization, Polynomials)
+{
+	std::mt19937 rand(4711);
+	std::vector<Variable> vars;
+	for (std::size_t i = 0; i < 20; i++) vars.push_back(freshRealVariable("v" + std::to_string(i)));
+	std::vector<Pol> polys;
+	for (std::size_t i = 0; i < 2000; i++) polys.push_back(randomPolynomial(rand, vars, 50));
+
+	Timer timer;
+	std::vector<std::string> texts;
+	for (const auto& p: polys) {
+		std::stringstream ss;
+		ss << p;
+		texts.push_back(ss.str());
+	}
+	std::size_t textWrite = timer.passed();
+	timer.reset();
+	parser::RecursiveDescentParser<Pol> parser;
+	for (Variable v: vars) parser.addVariable(v);
+	std::size_t textSize = 0;
+	for (std::size_t i = 0; i < polys.size(); i++) {
+		textSize += texts[i].size();
+		EXPECT_EQ(polys[i], parser.polynomial(texts[i]));
+	}
+	std::size_t textRead = timer.passed();
+
+	timer.reset();
+	BinaryWriter<Pol> writer;
+	for (const auto& p: polys) writer.write(p);
+	std::size_t binaryWrite = timer.passed();
+	timer.reset();
+	BinaryReader<Pol> reader(writer.data());
+	for (Variable v: vars) reader.addVariable(v);
+	for (const auto& p: polys) {
+		Pol q;
+		ASSERT_TRUE(reader.read(q));
+		EXPECT_EQ(p, q);
+	}
+	std::size_t binaryRead = timer.passed();
+
+	std::cout << "Text: " << textSize << " bytes, " << textWrite << " ms to write, " << textRead << " ms to read" << std::endl;
+	std::cout << "Binary: " << writer.data().size() << " bytes, " << binaryWrite << " ms to write, " << binaryRead << " ms to read" << std::endl;
+}
+
+/**
+ * Compares the binary format with SMT-LIB on a formula with many shared subformulas,
+ * which are expanded in the SMT-LIB output.
+ */
+TEST(Serialization, SharedFormula)
+{
+	std::mt19937 rand(4711);
+	std::vector<Variable> vars;
+	for (std::size_t i = 0; i < 10; i++) vars.push_back(freshRealVariable("r" + std::to_string(i)));
+	std::vector<FormulaT> layer;
+	for (std::size_t i = 0; i < 64; i++) layer.emplace_back(randomPolynomial(rand, vars, 5), Relation::LEQ);
+	for (std::size_t depth = 0; depth < 6; depth++) {
+		std::vector<FormulaT> next;
+		for (std::size_t i = 0; i < layer.size(); i++) {
+			next.emplace_back(depth % 2 == 0 ? AND : OR, FormulaT(layer[i]), FormulaT(layer[(i + 1) % layer.size()]));
+		}
+		layer = std::move(next);
+	}
+	FormulaT f(AND, std::move(layer));
+
+	Timer timer;
+	std::stringstream ss;
+	ss << outputSMTLIB(Logic::QF_NRA, {f});
+	std::string text = ss.str();
+	std::size_t textWrite = timer.passed();
+	timer.reset();
+	SMTLIBReader<Pol> smtlib(text.data(), text.data() + text.size());
+	auto g = smtlib.parse();
+	std::size_t textRead = timer.passed();
+	ASSERT_TRUE(bool(g));
+
+	timer.reset();
+	BinaryWriter<Pol> writer;
+	ASSERT_TRUE(writer.write(f));
+	std::size_t binaryWrite = timer.passed();
+	timer.reset();
+	BinaryReader<Pol> reader(writer.data());
+	for (Variable v: vars) reader.addVariable(v);
+	FormulaT h;
+	ASSERT_TRUE(reader.read(h));
+	std::size_t binaryRead = timer.passed();
+	EXPECT_EQ(f, h);
+
+	std::cout << "SMT-LIB: " << text.size() << " bytes, " << textWrite << " ms to write, " << textRead << " ms to read" << std::endl;
+	std::cout << "Binary: " << writer.data().size() << " bytes, " << binaryWrite << " ms to write, " << binaryRead << " ms to read" << std::endl;
+}
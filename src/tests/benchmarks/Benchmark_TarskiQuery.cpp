@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+
+#include <iostream>
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/thom/TarskiQuery/MultivariateTarskiQuery.h"
+#include "carl/util/Timer.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+namespace {
+
+/// The product of f and g, computed from the index pairs of the table entries.
+BaseRepresentation<Rational> multiplyByPairs(const MultiplicationTable<Rational>& table, const BaseRepresentation<Rational>& f, const BaseRepresentation<Rational>& g) {
+	BaseRepresentation<Rational> res;
+	for (const auto& entry: table) {
+		if (entry.second.br.isZero()) continue;
+		for (const auto& index_coeff: entry.second.br) {
+			Rational newCoeff(0);
+			for (const auto& pair: entry.second.pairs) {
+				newCoeff += f.get(pair.first) * g.get(pair.second);
+			}
+			if (newCoeff != 0) res[index_coeff.first] += newCoeff * index_coeff.second;
+		}
+	}
+	return res;
+}
+
+/// The trace of the multiplication by f, computed from the table entries of all products.
+Rational traceByEntries(const MultiplicationTable<Rational>& table, const BaseRepresentation<Rational>& f) {
+	const auto& base = table.getBase();
+	Rational res(0);
+	for (const auto& index_coeff: f) {
+		for (std::size_t i = 0; i < base.size(); i++) {
+			res += index_coeff.second * table.getEntry(base[index_coeff.first] * base[i]).br.get(carl::uint(i));
+		}
+	}
+	return res;
+}
+
+/// The tarski query as computed before the table had compressed sparse rows.
+int queryByEntries(const Pol& p, const MultiplicationTable<Rational>& table) {
+	BaseRepresentation<Rational> q = table.reduce(p);
+	std::size_t n = table.getBase().size();
+	CoeffMatrix<Rational> m(n, n);
+	for (const auto& entry: table) {
+		Rational t = traceByEntries(table, multiplyByPairs(table, q, entry.second.br));
+		for (const auto& pair: entry.second.pairs) {
+			m(long(pair.first), long(pair.second)) = t;
+		}
+	}
+	std::vector<Rational> cp = charPol(m);
+	int v1 = int(signVariations(cp.begin(), cp.end(), sgn<Rational>));
+	for (std::size_t i = 1; i < cp.size(); i += 2) cp[i] *= -Rational(1);
+	int v2 = int(signVariations(cp.begin(), cp.end(), sgn<Rational>));
+	return v1 - v2;
+}
+
+}
+
+/**
+ * Compares multivariate tarski queries on a zero-dimensional system with a quotient base of 64 monomials.
+ */
+TEST(TarskiQueryBenchmark, Multivariate)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	std::vector<Pol> system = {
+		Pol(x).pow(4) - Pol(y) * z - Rational(3) * x + Rational(1),
+		Pol(y).pow(4) - Pol(x) * z + Rational(2) * y - Rational(1),
+		Pol(z).pow(4) - Pol(x) * y - Rational(5),
+	};
+	std::vector<Pol> queries = {
+		Pol(Rational(1)),
+		Pol(x),
+		Pol(x) * y - z,
+		Pol(y) * y - Pol(z) * x + Rational(1),
+	};
+	Timer timer;
+	GroebnerBase<Rational> gb(system.begin(), system.end());
+	MultiplicationTable<Rational> table(gb);
+	std::size_t setupTime = timer.passed();
+	std::cout << "Quotient base of size " << table.getBase().size() << " set up in " << setupTime << " ms" << std::endl;
+
+	for (const auto& q: queries) {
+		timer.reset();
+		int old = queryByEntries(q, table);
+		std::size_t oldTime = timer.passed();
+		timer.reset();
+		int res = multivariateTarskiQuery(q, table);
+		std::size_t newTime = timer.passed();
+		EXPECT_EQ(old, res);
+		std::cout << "TaQ(" << q << ") = " << res << ": " << oldTime << " ms with dense powers, " << newTime << " ms with sparse traces and Berkowitz" << std::endl;
+	}
+}
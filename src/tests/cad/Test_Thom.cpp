@@ -68,6 +68,159 @@ TEST(Thom, SignDetermination) {
         sd3.getSignsAndAdd(ellipse.derivative(y));
 }
 
+TEST(Thom, SparseSignMatrix) {
+        typedef SparseSignMatrix<Rational> Matrix;
+        // rows 0 and 2 are linearly dependent
+        Matrix m(3);
+        m.addRow({{0, 1}, {1, 1}, {2, 1}});
+        m.addRow({{1, 1}, {2, -1}});
+        m.addRow({{0, 2}, {1, 2}, {2, 2}});
+        m.addRow({{0, 1}, {2, -1}});
+        EXPECT_EQ(3, m.rank());
+        EXPECT_EQ(Rational(-1), m(1, 2));
+        EXPECT_EQ(Rational(0), m(3, 1));
+
+        SparseRankTracker<Rational> tracker;
+        EXPECT_TRUE(tracker.add(m.row(0)));
+        EXPECT_TRUE(tracker.add(m.row(1)));
+        EXPECT_FALSE(tracker.add(m.row(2)));
+        EXPECT_TRUE(tracker.add(m.row(3)));
+        EXPECT_EQ(3, tracker.rank());
+
+        Matrix sub = m.selectColumns({true, false, true});
+        EXPECT_EQ(2, sub.cols());
+        EXPECT_EQ(Rational(-1), sub(3, 1));
+
+        // solve for the invertible rows 0, 1 and 3 with the solutions (1, 2, 3) and (0, 1, 0)
+        Matrix a(3);
+        a.addRow(m.row(0));
+        a.addRow(m.row(1));
+        a.addRow(m.row(3));
+        std::vector<std::vector<Rational>> rhs = {{6, 1}, {-1, 1}, {-2, 0}};
+        a.solve(rhs);
+        EXPECT_EQ(std::vector<Rational>({1, 0}), rhs[0]);
+        EXPECT_EQ(std::vector<Rational>({2, 1}), rhs[1]);
+        EXPECT_EQ(std::vector<Rational>({3, 0}), rhs[2]);
+}
+
+TEST(Thom, SignDeterminationManyPolynomials) {
+        typedef MultivariatePolynomial<Rational> MPolynomial;
+        Variable x = freshRealVariable("x");
+        // the zero set are the integers from -4 to 4
+        MPolynomial z(Rational(1));
+        for (int r = -4; r <= 4; r++) z *= MPolynomial(x) - Rational(r);
+        std::vector<MPolynomial> zeroSet = {z};
+        std::vector<MPolynomial> polys;
+        for (int r = -4; r <= 4; r++) polys.push_back(MPolynomial(x) - Rational(r) - Rational(1)/Rational(2));
+        SignDetermination<Rational> sd(zeroSet.begin(), zeroSet.end());
+        std::list<SignCondition> signs = sd.getSignsAndAddAll(polys.begin(), polys.end());
+        // every root realizes a distinct sign condition
+        EXPECT_EQ(9, signs.size());
+        EXPECT_EQ(9, sd.matrix().rows());
+        EXPECT_EQ(9, sd.matrix().rank());
+}
+
+
+TEST(Thom, TarskiQueryCache) {
+        typedef MultivariatePolynomial<Rational> MPolynomial;
+        auto& cache = TarskiQueryCache<Rational>::getInstance();
+        cache.clear();
+        Variable x = freshRealVariable("x");
+        Variable y = freshRealVariable("y");
+        MPolynomial circle = MPolynomial(x)*x + MPolynomial(y)*y - Rational(1);
+        MPolynomial line = MPolynomial(x) - MPolynomial(y);
+        std::vector<MPolynomial> zeroSet = {circle, line};
+        // the same zero set, scaled and in a different order
+        std::vector<MPolynomial> permuted = {line * Rational(-3), circle * Rational(2), line};
+        EXPECT_EQ(TarskiQueryCache<Rational>::normalize(zeroSet.begin(), zeroSet.end()), TarskiQueryCache<Rational>::normalize(permuted.begin(), permuted.end()));
+
+        TarskiQueryManager<Rational> taq(zeroSet.begin(), zeroSet.end());
+        EXPECT_EQ(1, cache.misses());
+        EXPECT_EQ(2, taq(Rational(1)));
+        EXPECT_EQ(0, taq(MPolynomial(x)));
+        EXPECT_EQ(2, taq(MPolynomial(x)*x));
+        EXPECT_EQ(-2, taq(MPolynomial(x)*x * Rational(-5)));
+
+        TarskiQueryManager<Rational> shared(permuted.begin(), permuted.end());
+        EXPECT_EQ(1, cache.misses());
+        EXPECT_EQ(1, cache.hits());
+        EXPECT_EQ(1, cache.size());
+        EXPECT_EQ(-2, shared(MPolynomial(x)*x * Rational(-1)));
+        std::size_t memory = cache.memory();
+        EXPECT_GT(memory, 0);
+
+        // a univariate zero set
+        std::vector<MPolynomial> univariate = {MPolynomial(x)*x - Rational(2)};
+        TarskiQueryManager<Rational> taq2(univariate.begin(), univariate.end());
+        EXPECT_EQ(2, taq2(Rational(1)));
+        EXPECT_EQ(0, taq2(MPolynomial(x)));
+        EXPECT_EQ(2, cache.size());
+
+        // only the most recently used zero set is kept, the evicted one stays valid
+        cache.setLimit(0);
+        EXPECT_EQ(1, cache.size());
+        EXPECT_EQ(-2, taq(MPolynomial(x)*x * Rational(-1)));
+        EXPECT_EQ(2, taq(MPolynomial(y)*y + Rational(1)/Rational(2)));
+        cache.setLimit(std::size_t(64) << 20);
+
+        // a zero set that is not zero-dimensional is rejected and not cached
+        std::vector<MPolynomial> lineOnly = {line};
+        std::size_t size = cache.size();
+        EXPECT_THROW(TarskiQueryManager<Rational>(lineOnly.begin(), lineOnly.end()), std::invalid_argument);
+        EXPECT_EQ(size, cache.size());
+        cache.clear();
+}
+
+TEST(Thom, CharPol) {
+        typedef CoeffMatrix<Rational> Matrix;
+        for(long n = 1; n <= 9; n++) {
+                Matrix m(n, n);
+                for(long i = 0; i < n; i++) {
+                        for(long j = 0; j < n; j++) {
+                                // sparse, with a zero leading entry and zero subdiagonal, which Berkowitz handles without division
+                                m(i, j) = ((i * 7 + j * 3) % 5 == 0 || j == i - 1) ? Rational(0) : Rational((i * 13 + j * 5) % 11 - 5, j % 3 + 1);
+                        }
+                }
+                EXPECT_EQ(charPol(m), charPolBerkowitz(m));
+        }
+        Matrix zero = Matrix::Zero(4, 4);
+        EXPECT_EQ(std::vector<Rational>({0, 0, 0, 0, 1}), charPolBerkowitz(zero));
+}
+
+TEST(Thom, MultiplicationTableTraces) {
+        typedef MultivariatePolynomial<Rational> MPolynomial;
+        Variable x = freshRealVariable("x");
+        Variable y = freshRealVariable("y");
+        std::vector<MPolynomial> system = {
+                MPolynomial(x)*x*x - MPolynomial(y) - Rational(2),
+                MPolynomial(y)*y - MPolynomial(x)*Rational(3) + Rational(1)
+        };
+        GroebnerBase<Rational> gb(system.begin(), system.end());
+        MultiplicationTable<Rational> table(gb);
+        const auto& base = table.getBase();
+        std::size_t n = base.size();
+        EXPECT_EQ(6, n);
+        BaseRepresentation<Rational> q = table.reduce(MPolynomial(x)*y*Rational(2) - MPolynomial(y)*y*y + Rational(1)/Rational(3));
+        CoeffMatrix<Rational> m(n, n);
+        table.traceMatrix(q, m);
+        for(std::size_t i = 0; i < n; i++) {
+                for(std::size_t j = 0; j < n; j++) {
+                        // the trace of the multiplication by q * b_i * b_j, computed from its matrix
+                        BaseRepresentation<Rational> f = table.reduce(MPolynomial(base[i]) * base[j]);
+                        f = table.multiply(f, q);
+                        Rational trace(0);
+                        for(std::size_t k = 0; k < n; k++) {
+                                BaseRepresentation<Rational> bk;
+                                bk[carl::uint(k)] = Rational(1);
+                                trace += table.multiply(f, bk).get(carl::uint(k));
+                        }
+                        EXPECT_EQ(trace, m(long(i), long(j)));
+                        EXPECT_EQ(trace, table.trace(table.multiply(f, table.reduce(MPolynomial(Rational(1))))));
+                }
+        }
+        // the trace of 1 is the number of complex solutions
+        EXPECT_EQ(table.trace(table.reduce(MPolynomial(Rational(1)))), Rational(6));
+}
 
 TEST(Thom, RootFinder) {
         typedef MultivariatePolynomial<Rational> Polynomial;
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/CoprimeBase.h"
+#include "carl/core/VariablePool.h"
+#include "carl/util/stringparser.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+namespace {
+	/// Checks that the decompositions multiply to the inputs.
+	void checkDecompositions(const CoprimeBase<Pol>& cb, const std::vector<Pol>& inputs) {
+		for (std::size_t i = 0; i < inputs.size(); i++) {
+			Pol product(Rational(1));
+			for (const auto& part: cb.decomposition(i)) product *= cb.base()[part.first].pow(part.second);
+			EXPECT_EQ(inputs[i], product);
+		}
+	}
+	/// Checks that the base is pairwise coprime and that the decompositions multiply to the inputs.
+	void checkBase(const CoprimeBase<Pol>& cb, const std::vector<Pol>& inputs) {
+		for (std::size_t i = 0; i < cb.base().size(); i++) {
+			for (std::size_t j = i + 1; j < cb.base().size(); j++) {
+				EXPECT_TRUE(carl::gcd(cb.base()[i], cb.base()[j]).isConstant()) << cb.base()[i] << " and " << cb.base()[j];
+			}
+		}
+		checkDecompositions(cb, inputs);
+	}
+}
+
+TEST(CoprimeBase, Decomposition)
+{
+	carl::VariablePool::getInstance().clear();
+	StringParser sp;
+	sp.setVariables({"x", "y", "z"});
+	Pol a = sp.parseMultivariatePolynomial<Rational>("x+y");
+	Pol b = sp.parseMultivariatePolynomial<Rational>("x+1");
+	Pol c = sp.parseMultivariatePolynomial<Rational>("z+2");
+	std::vector<Pol> inputs = { a * b, b * b * c, a * c, a * a * b, c };
+
+	CoprimeBase<Pol> cb;
+	for (const auto& p: inputs) cb.add(p);
+	cb.compute();
+	EXPECT_EQ(3, cb.base().size());
+	checkBase(cb, inputs);
+	EXPECT_EQ(1, cb.decomposition(4).size());
+	EXPECT_EQ(c, cb.base()[cb.decomposition(4).front().first]);
+
+	// Irreducible polynomials are not compared with each other.
+	CoprimeBase<Pol> irreducible;
+	irreducible.add(a, true);
+	irreducible.add(b, true);
+	irreducible.add(c, true);
+	irreducible.compute();
+	EXPECT_EQ(0, irreducible.gcds());
+	EXPECT_EQ(3, irreducible.base().size());
+
+	// Elements of the same group are not made coprime.
+	CoprimeBase<Pol> groups;
+	groups.add(a * b, 1);
+	groups.add(a * c, 1);
+	groups.add(b, 2);
+	groups.compute();
+	checkDecompositions(groups, { a * b, a * c, b });
+	EXPECT_EQ(3, groups.base().size());
+	EXPECT_EQ(1, groups.decomposition(1).size());
+	EXPECT_EQ(2, groups.decomposition(0).size());
+}
+
+TEST(CoprimeBase, Threads)
+{
+	carl::VariablePool::getInstance().clear();
+	StringParser sp;
+	sp.setVariables({"x", "y"});
+	std::vector<Pol> linear;
+	for (int i = 1; i <= 6; i++) {
+		linear.push_back(sp.parseMultivariatePolynomial<Rational>("x+" + std::to_string(i) + "*y+" + std::to_string(i*i)));
+	}
+	std::vector<Pol> inputs;
+	for (std::size_t i = 0; i < linear.size(); i++) {
+		inputs.push_back(linear[i] * linear[(i + 1) % linear.size()] * linear[(i + 3) % linear.size()]);
+	}
+
+	// The result does not depend on the number of threads.
+	CoprimeBase<Pol> sequential(1);
+	CoprimeBase<Pol> parallel(4);
+	for (const auto& p: inputs) {
+		sequential.add(p);
+		parallel.add(p);
+	}
+	sequential.compute();
+	parallel.compute();
+	checkBase(sequential, inputs);
+	EXPECT_EQ(linear.size(), sequential.base().size());
+	EXPECT_EQ(sequential.base(), parallel.base());
+	for (std::size_t i = 0; i < inputs.size(); i++) {
+		EXPECT_EQ(sequential.decomposition(i), parallel.decomposition(i));
+	}
+}
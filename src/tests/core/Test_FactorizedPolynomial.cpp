@@ -19,7 +19,7 @@ using namespace carl;
 typedef mpq_class Rational;
 typedef MultivariatePolynomial<Rational> Pol;
 typedef FactorizedPolynomial<Pol> FPol;
-typedef Cache<PolynomialFactorizationPair<Pol>> CachePol;
+typedef FactorizedPolynomial<Pol>::CACHE CachePol;
 
 /* General testing function for a specific binary operator.
  * It is result = operator( pol1, pol2 ).
@@ -353,6 +353,43 @@ TEST(FactorizedPolynomial, GCD)
     FPol fpolGCD = gcd( fpol1, fpol2, fpolRest1, fpolRest2);
 }
 
+TEST(FactorizedPolynomial, RefineFactorizations)
+{
+    carl::VariablePool::getInstance().clear();
+    StringParser sp;
+    sp.setVariables({"x", "y", "z"});
+    std::shared_ptr<CachePol> pCache( new CachePol );
+    FPol fa1( sp.parseMultivariatePolynomial<Rational>("x^2+(-1)*y^2"), pCache );
+    FPol fa2( sp.parseMultivariatePolynomial<Rational>("x*z+z"), pCache );
+    FPol fb1( sp.parseMultivariatePolynomial<Rational>("x+y"), pCache );
+    FPol fb2( sp.parseMultivariatePolynomial<Rational>("x^2+2*x+1"), pCache );
+    FPol fb3( sp.parseMultivariatePolynomial<Rational>("y+3"), pCache );
+    FPol fpA = fa1 * fa2 * Rational(3);
+    FPol fpB = fb1 * fb2 * fb3;
+    Pol pA = computePolynomial( fpA );
+    Pol pB = computePolynomial( fpB );
+
+    // Without refinement, only the syntactically equal factors are cancelled.
+    EXPECT_FALSE( lazyDiv( fpA, fpB ).second.isOne() );
+    EXPECT_EQ( 3, lazyDiv( fpA, fpB ).second.factorization().size() );
+
+    EXPECT_TRUE( refineFactorizations( fpA, fpB, 2 ) );
+    EXPECT_EQ( pA, computePolynomial( fpA ) );
+    EXPECT_EQ( pB, computePolynomial( fpB ) );
+    // The factors are refined as well.
+    EXPECT_EQ( 2, fa1.factorization().size() );
+    EXPECT_EQ( 2, fa2.factorization().size() );
+    EXPECT_EQ( 1, fb2.factorization().size() );
+    EXPECT_EQ( 2, fb2.factorization().begin()->second );
+
+    auto quotient = lazyDiv( fpA, fpB );
+    EXPECT_EQ( pA * computePolynomial( quotient.second ), pB * computePolynomial( quotient.first ) );
+    EXPECT_EQ( sp.parseMultivariatePolynomial<Rational>("x*y+3*x+y+3"), computePolynomial( quotient.second ) );
+
+    // A second refinement does not change anything.
+    EXPECT_FALSE( refineFactorizations( fpA, fpB, 2 ) );
+}
+
 TEST(FactorizedPolynomial, Flattening)
 {
     carl::VariablePool::getInstance().clear();
@@ -0,0 +1,184 @@
+#include "gtest/gtest.h"
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/FactorizedPolynomial.h"
+#include "carl/core/FactorizedRationalFunction.h"
+#include "carl/core/VariablePool.h"
+#include "carl/util/stringparser.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef FactorizedPolynomial<Pol> FPol;
+typedef FactorizedRationalFunction<Pol, false> FRFunc;
+typedef FactorizedRationalFunction<Pol, true> FRFuncAuto;
+typedef FactorizedPolynomial<Pol>::CACHE CachePol;
+
+namespace {
+	/// Checks whether a/b = c/d by comparing a*d and c*b.
+	template<typename RF>
+	::testing::AssertionResult equalQuotients(const RF& lhs, const RF& rhs) {
+		Pol l = computePolynomial(lhs.nominator()) * computePolynomial(rhs.denominator());
+		Pol r = computePolynomial(rhs.nominator()) * computePolynomial(lhs.denominator());
+		if (l == r) return ::testing::AssertionSuccess();
+		return ::testing::AssertionFailure() << lhs << " != " << rhs;
+	}
+}
+
+TEST(FactorizedRationalFunction, Construction)
+{
+	carl::VariablePool::getInstance().clear();
+	StringParser sp;
+	sp.setVariables({"x", "y"});
+	std::shared_ptr<CachePol> pCache(new CachePol);
+	FPol x(sp.parseMultivariatePolynomial<Rational>("x"), pCache);
+	FPol y(sp.parseMultivariatePolynomial<Rational>("y"), pCache);
+	FPol xy1(sp.parseMultivariatePolynomial<Rational>("x*y+1"), pCache);
+
+	FRFunc zero;
+	EXPECT_TRUE(zero.isZero());
+	EXPECT_TRUE(zero.isConstant());
+	FRFunc c(Rational(3)/Rational(4));
+	EXPECT_TRUE(c.isConstant());
+	EXPECT_EQ(Rational(3)/Rational(4), c.constantPart());
+
+	// The coefficient of the denominator is moved to the numerator.
+	FRFunc r1(x * Rational(3), xy1 * Rational(6));
+	EXPECT_TRUE(r1.denominator().coefficient() == Rational(1));
+	EXPECT_EQ(Rational(1)/Rational(2), r1.nominator().coefficient());
+	EXPECT_FALSE(r1.isConstant());
+
+	// Common factors are cancelled.
+	FRFunc r2(x * xy1, y * xy1);
+	EXPECT_EQ(computePolynomial(x), computePolynomial(r2.nominator()));
+	EXPECT_EQ(computePolynomial(y), computePolynomial(r2.denominator()));
+	FRFunc r3(xy1 * Rational(2), xy1);
+	EXPECT_TRUE(r3.isConstant());
+	EXPECT_EQ(Rational(2), r3.constantPart());
+
+	EXPECT_TRUE(r2.inverse().inverse() == r2);
+	EXPECT_EQ(std::hash<FRFunc>()(r2), std::hash<FRFunc>()(r2.inverse().inverse()));
+	EXPECT_EQ(2, r1.gatherVariables().size());
+}
+
+TEST(FactorizedRationalFunction, Arithmetic)
+{
+	carl::VariablePool::getInstance().clear();
+	StringParser sp;
+	sp.setVariables({"x", "y", "z"});
+	std::shared_ptr<CachePol> pCache(new CachePol);
+	Pol px = sp.parseMultivariatePolynomial<Rational>("x");
+	Pol p1 = sp.parseMultivariatePolynomial<Rational>("3*x*y + x");
+	Pol p2 = sp.parseMultivariatePolynomial<Rational>("5*y + 3*z");
+	Pol p3 = sp.parseMultivariatePolynomial<Rational>("z^2 + 1");
+	Pol p4 = sp.parseMultivariatePolynomial<Rational>("x*z + y");
+
+	FRFunc a(FPol(p1, pCache), FPol(p2, pCache));
+	FRFunc b(FPol(p3, pCache), FPol(p4, pCache));
+	RationalFunction<Pol> ra(p1, p2);
+	RationalFunction<Pol> rb(p3, p4);
+
+	auto check = [&](const FRFunc& f, const RationalFunction<Pol>& r) {
+		FRFunc expected(FPol(r.nominator(), pCache), FPol(r.denominator(), pCache));
+		EXPECT_TRUE(equalQuotients(f, expected));
+	};
+	check(a + b, ra + rb);
+	check(a - b, ra - rb);
+	check(a * b, ra * rb);
+	check(a / b, ra / rb);
+	check(-a, -ra);
+	check(a + Rational(2), ra + Rational(2));
+	check(a * Rational(2), ra * Rational(2));
+	check(a / Rational(2), ra / Rational(2));
+
+	FRFunc c = a;
+	c += c;
+	check(c, ra * Rational(2));
+	c -= c;
+	EXPECT_TRUE(c.isZero());
+	c = a;
+	c /= c;
+	EXPECT_TRUE(c.isOne());
+	c = a;
+	c *= FPol(p2, pCache);
+	check(c, RationalFunction<Pol>(p1));
+
+	std::map<Variable, Rational> point;
+	for (Variable v: (a / b).gatherVariables()) point[v] = Rational(v.getId() + 1);
+	EXPECT_EQ(ra.evaluate(point) / rb.evaluate(point), (a / b).evaluate(point));
+
+	auto rf = (a + b).toRationalFunction<true>();
+	EXPECT_EQ(computePolynomial((a + b).nominator()) * computePolynomial(rf.denominator()), computePolynomial(rf.nominator()) * computePolynomial((a + b).denominator()));
+}
+
+TEST(FactorizedRationalFunction, CommonDenominator)
+{
+	carl::VariablePool::getInstance().clear();
+	StringParser sp;
+	sp.setVariables({"x", "y", "z"});
+	std::shared_ptr<CachePol> pCache(new CachePol);
+	FPol one(Rational(1));
+	FPol fx(sp.parseMultivariatePolynomial<Rational>("x + 1"), pCache);
+	FPol fy(sp.parseMultivariatePolynomial<Rational>("y + 1"), pCache);
+	FPol fz(sp.parseMultivariatePolynomial<Rational>("z + 1"), pCache);
+
+	// 1/((x+1)^2*(y+1)) + 1/((x+1)*(z+1)) has the denominator (x+1)^2*(y+1)*(z+1).
+	FRFunc a(one, fx * fx * fy);
+	FRFunc b(one, fx * fz);
+	FRFunc sum = a + b;
+	EXPECT_EQ(computePolynomial(fx * fx * fy * fz), computePolynomial(sum.denominator()));
+	EXPECT_EQ(3, sum.denominator().factorization().size());
+	EXPECT_TRUE(sum.isSimplified() == false);
+
+	// Sums of many terms with the same factors keep the denominator small.
+	FRFunc chain;
+	for (unsigned i = 0; i < 20; i++) {
+		chain += FRFunc(FPol(Rational(i + 1)), i % 2 == 0 ? fx * fy : fy * fz);
+	}
+	EXPECT_EQ(computePolynomial(fx * fy * fz), computePolynomial(chain.denominator()));
+}
+
+TEST(FactorizedRationalFunction, Simplification)
+{
+	carl::VariablePool::getInstance().clear();
+	StringParser sp;
+	sp.setVariables({"x", "y"});
+	std::shared_ptr<CachePol> pCache(new CachePol);
+	FPol num(sp.parseMultivariatePolynomial<Rational>("x^2 + (-1)*y^2"), pCache);
+	FPol den(sp.parseMultivariatePolynomial<Rational>("x + y"), pCache);
+	FPol den2(sp.parseMultivariatePolynomial<Rational>("x + 2"), pCache);
+
+	// The common divisor x+y is only found by the gcd, which is deferred until simplify() is called.
+	FRFunc r(num, den * den2);
+	EXPECT_FALSE(r.isSimplified());
+	EXPECT_EQ(computePolynomial(den * den2), computePolynomial(r.denominator()));
+	FRFunc expected(FPol(sp.parseMultivariatePolynomial<Rational>("x + (-1)*y"), pCache), den2);
+	EXPECT_TRUE(equalQuotients(r, expected));
+	r.simplify();
+	EXPECT_TRUE(r.isSimplified());
+	EXPECT_EQ(computePolynomial(den2), computePolynomial(r.denominator()));
+	EXPECT_EQ(sp.parseMultivariatePolynomial<Rational>("x + (-1)*y"), computePolynomial(r.nominator()));
+
+	// Refining both factorizations to a coprime base cancels the same divisor.
+	std::shared_ptr<CachePol> pRefinementCache(new CachePol);
+	FPol::refinementThreads = 2;
+	FRFunc refined(FPol(computePolynomial(num), pRefinementCache), FPol(computePolynomial(den * den2), pRefinementCache));
+	refined.simplify();
+	FPol::refinementThreads = 1;
+	EXPECT_EQ(computePolynomial(den2), computePolynomial(refined.denominator()));
+	EXPECT_EQ(sp.parseMultivariatePolynomial<Rational>("x + (-1)*y"), computePolynomial(refined.nominator()));
+
+	// With AutoSimplify, the gcd is computed once the quotient has become complex enough.
+	FPol big(sp.parseMultivariatePolynomial<Rational>("x^6 + 3*x^5*y + y^6 + 7*x^3*y^3 + x^4*y^4 + x^2 + y + 5"), pCache);
+	FRFuncAuto small(num, den * den2);
+	EXPECT_FALSE(small.isSimplified());
+	FRFuncAuto product = small * FRFuncAuto(big, den2);
+	EXPECT_GT(product.complexity(), std::size_t(FRFuncAuto::SIMPLIFICATION_MIN_COMPLEXITY));
+	EXPECT_TRUE(product.isSimplified());
+	EXPECT_EQ(computePolynomial(den2 * den2), computePolynomial(product.denominator()));
+	// Without AutoSimplify, the same product is not simplified.
+	FRFunc lazyProduct = FRFunc(num, den * den2) * FRFunc(big, den2);
+	EXPECT_FALSE(lazyProduct.isSimplified());
+	EXPECT_TRUE(equalQuotients(lazyProduct, FRFunc(product.nominator(), product.denominator())));
+}
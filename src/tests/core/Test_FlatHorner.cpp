@@ -0,0 +1,161 @@
+#include "gtest/gtest.h"
+
+#include "carl/core/FlatHorner.h"
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/VariablePool.h"
+#include "carl/interval/IntervalEvaluation.h"
+
+#include "../Common.h"
+
+#include <random>
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+TEST(FlatHorner, Evaluation)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	std::map<Variable, Interval<double>> map;
+	map[x] = Interval<double>(-1.0, 2.0);
+	map[y] = Interval<double>(0.5, 1.5);
+	map[z] = Interval<double>(-3.0, -2.0);
+	std::vector<Pol> polys = {
+		Pol(Rational(3)),
+		Pol(x),
+		Pol(x)*x*x,
+		Rational(2)*x*y + Rational(3)*x*z - Rational(1)/Rational(2),
+		Pol(x)*x*y*z + Pol(x)*y*y - Rational(7)*z*z*z + Pol(y) + Rational(4),
+		(Pol(x) + y + z).pow(4)
+	};
+	for (const auto& p: polys) {
+		FlatHorner<Pol> flat(p);
+		MultivariateHorner<Pol, strategy> tree(p);
+		Interval<double> res = flat.evaluate(map);
+		EXPECT_EQ(IntervalEvaluation::evaluate(tree, map), res) << p << " -> " << flat;
+		EXPECT_EQ(res, IntervalEvaluation::evaluate(flat, map));
+		// Evaluation at a point of the box is contained in the enclosure.
+		std::map<Variable, Interval<double>> point = {{x, Interval<double>(1.0)}, {y, Interval<double>(1.0)}, {z, Interval<double>(-2.0)}};
+		EXPECT_TRUE(res.contains(flat.evaluate(point))) << p;
+	}
+	FlatHorner<Pol> flat(Pol(x)*x*y + Pol(x)*x*z + Pol(y));
+	std::vector<Interval<double>> values;
+	for (Variable v: flat.variables()) values.push_back(map[v]);
+	EXPECT_EQ(flat.evaluate(map), flat.evaluate(values));
+}
+
+TEST(FlatHorner, Pool)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	auto& pool = FlatHornerPool<Pol>::getInstance();
+	pool.clear();
+	Pol p = Pol(x)*y + Pol(x)*x;
+	auto a = pool.get(p);
+	auto b = pool.get(Pol(x)*x + Pol(x)*y);
+	EXPECT_EQ(a, b);
+	EXPECT_EQ(1, pool.size());
+	{
+		auto c = pool.get(p + Rational(1));
+		EXPECT_NE(a, c);
+		EXPECT_EQ(2, pool.size());
+	}
+	// Schemes are freed when they are no longer used.
+	EXPECT_EQ(1, pool.size());
+	for (int i = 0; i < 1000; i++) pool.get(p + Rational(i));
+	EXPECT_EQ(1, pool.size());
+	EXPECT_EQ(a, pool.get(p));
+	pool.clear();
+	EXPECT_EQ(0, pool.size());
+	std::map<Variable, Interval<double>> map = {{x, Interval<double>(1.0, 2.0)}, {y, Interval<double>(0.0, 1.0)}};
+	EXPECT_TRUE(a->evaluate(map).contains(Interval<double>(1.0, 6.0)));
+}
+
+TEST(FlatHorner, Batch)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	std::vector<Pol> polys = {
+		Pol(Rational(3)),
+		Pol(x)*x,
+		Rational(2)*x*y + Rational(3)*x*z - Rational(1)/Rational(3),
+		Pol(x)*x*y*z + Pol(x)*y*y - Rational(7)*z*z*z + Pol(y) + Rational(4),
+		(Pol(x) + y + z).pow(4)
+	};
+	std::mt19937 rand(42);
+	std::uniform_real_distribution<double> bound(-3, 3);
+	for (const auto& p: polys) {
+		FlatHorner<Pol> flat(p);
+		std::size_t n = 1000;
+		IntervalBatch batch(flat.variables().size(), n);
+		std::vector<std::vector<Interval<double>>> boxes(n);
+		for (std::size_t b = 0; b < n; b++) {
+			for (std::size_t v = 0; v < flat.variables().size(); v++) {
+				double l = bound(rand);
+				double u = bound(rand);
+				Interval<double> i(std::min(l, u), std::max(l, u));
+				if (b % 97 == 1) i = Interval<double>(0.0, BoundType::WEAK, 0.0, BoundType::INFTY);
+				if (b % 89 == 2) i = Interval<double>(1.0);
+				boxes[b].push_back(i);
+				batch.set(v, b, i);
+				EXPECT_EQ(i, batch.get(v, b));
+			}
+		}
+		std::vector<Interval<double>> res;
+		IntervalEvaluation::evaluate(flat, batch, res);
+		ASSERT_EQ(n, res.size());
+		for (std::size_t b = 0; b < n; b++) {
+			Interval<double> single = flat.evaluate(boxes[b]);
+			// The batch result is at most a few ulps wider than the result of the single evaluation.
+			if (single.isUnbounded()) {
+				EXPECT_EQ(single, res[b]);
+				continue;
+			}
+			double slack = 1e-12 * std::max(1.0, single.magnitude());
+			EXPECT_LE(res[b].lower(), single.lower());
+			EXPECT_GE(res[b].upper(), single.upper());
+			EXPECT_GE(res[b].lower(), single.lower() - slack) << p << " on box " << b;
+			EXPECT_LE(res[b].upper(), single.upper() + slack) << p << " on box " << b;
+			// Exact values at the corners are enclosed.
+			std::map<Variable, Rational> corner;
+			for (std::size_t v = 0; v < flat.variables().size(); v++) {
+				corner[flat.variables()[v]] = carl::rationalize<Rational>(b % 2 == 0 ? boxes[b][v].lower() : boxes[b][v].upper());
+			}
+			Rational value = p.evaluate(corner);
+			EXPECT_LE(carl::rationalize<Rational>(res[b].lower()), value);
+			EXPECT_GE(carl::rationalize<Rational>(res[b].upper()), value);
+		}
+	}
+}
+
+TEST(FlatHorner, BatchKernels)
+{
+	std::vector<double> l = {-2, 1, -3, 0, -1, 0.5};
+	std::vector<double> u = {1, 2, -1, 0, 1, 0.5};
+	std::vector<double> rl(l.size());
+	std::vector<double> ru(l.size());
+	// Even powers of intervals containing zero are tight.
+	IntervalBatchKernels::pow(l.size(), l.data(), u.data(), 2, rl.data(), ru.data());
+	EXPECT_EQ(0, rl[0]);
+	EXPECT_LE(4, ru[0]);
+	EXPECT_LE(rl[2], 1);
+	EXPECT_LE(9, ru[2]);
+	EXPECT_EQ(0, rl[3]);
+	IntervalBatchKernels::pow(l.size(), l.data(), u.data(), 3, rl.data(), ru.data());
+	EXPECT_GE(-8, rl[0]);
+	EXPECT_LE(1, ru[0]);
+	EXPECT_GE(-27, rl[2]);
+	EXPECT_LE(-1, ru[2]);
+	EXPECT_GT(0, ru[2]);
+	IntervalBatchKernels::mul(l.size(), l.data(), u.data(), l.data(), u.data(), rl.data(), ru.data());
+	EXPECT_GE(-2, rl[0]);
+	EXPECT_LE(4, ru[0]);
+	// Results may alias the operands, and operands beyond a multiple of four are handled as well.
+	IntervalBatchKernels::add(l.size(), l.data(), u.data(), l.data(), u.data(), l.data(), u.data());
+	EXPECT_GE(1, l[5]);
+	EXPECT_LE(1, u[5]);
+	EXPECT_GT(1.000001, u[5]);
+}
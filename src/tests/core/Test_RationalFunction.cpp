@@ -14,7 +14,7 @@ typedef FactorizedPolynomial<Pol> FPol;
 const bool AutoSimplify = false;
 typedef RationalFunction<Pol,AutoSimplify> RFunc;
 typedef RationalFunction<FPol,AutoSimplify> RFactFunc;
-typedef Cache<PolynomialFactorizationPair<Pol>> CachePol;
+typedef FactorizedPolynomial<Pol>::CACHE CachePol;
 
 TEST(RationalFunction, Construction)
 {
@@ -342,6 +342,26 @@ TEST(RationalFunction, Simplification)
     EXPECT_TRUE( r2.nominator().isOne() );
 }
 
+TEST(RationalFunction, SimplificationByRefinement)
+{
+    carl::VariablePool::getInstance().clear();
+    StringParser sp;
+    sp.setVariables({"x", "y"});
+    std::shared_ptr<CachePol> pCache( new CachePol );
+    FPol f1(sp.parseMultivariatePolynomial<Rational>("x^2+(-1)*y^2"), pCache);
+    FPol f2(sp.parseMultivariatePolynomial<Rational>("x*y+y+x+1"), pCache);
+    FPol g1(sp.parseMultivariatePolynomial<Rational>("x+y"), pCache);
+    FPol g2(sp.parseMultivariatePolynomial<Rational>("y^2+2*y+1"), pCache);
+    FPol g3(sp.parseMultivariatePolynomial<Rational>("x+3"), pCache);
+
+    FPol::refinementThreads = 2;
+    RFactFunc r( f1 * f2, g1 * g2 * g3 );
+    r.simplify();
+    FPol::refinementThreads = 1;
+    EXPECT_EQ( sp.parseMultivariatePolynomial<Rational>("x^2+(-1)*x*y+x+(-1)*y"), computePolynomial( r.nominator() ) );
+    EXPECT_EQ( sp.parseMultivariatePolynomial<Rational>("x*y+3*y+x+3"), computePolynomial( r.denominator() ) );
+}
+
 TEST(RationalFunction, Evaluation)
 {
     carl::VariablePool::getInstance().clear();
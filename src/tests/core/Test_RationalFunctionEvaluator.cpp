@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/RationalFunction.h"
+#include "carl/core/RationalFunctionEvaluator.h"
+
+#include "../Common.h"
+
+#include <random>
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef RationalFunction<Pol> RFunc;
+
+namespace {
+	std::vector<RFunc> functions(Variable x, Variable y, Variable z) {
+		return {
+			RFunc(Rational(3)/Rational(5)),
+			RFunc(Pol(x) * y + Rational(1)),
+			RFunc(Pol(x) * x - Pol(y) * Rational(2), Pol(z) + Rational(3)),
+			RFunc((Pol(x) + y + z).pow(4), (Pol(x) - y).pow(3) + Rational(7)),
+			RFunc(Pol(x) * x * x * z - Pol(y) * y * Rational(1)/Rational(3) + Rational(2), Pol(x) * x * y * y + Pol(z) * z + Rational(1))
+		};
+	}
+}
+
+TEST(RationalFunctionEvaluator, Exact)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	std::mt19937 rand(42);
+	std::uniform_int_distribution<int> num(-20, 20);
+	std::uniform_int_distribution<int> den(1, 7);
+	for (const auto& f: functions(x, y, z)) {
+		RationalFunctionEvaluator<Pol> evaluator(f);
+		for (int i = 0; i < 20; i++) {
+			std::map<Variable, Rational> point = {
+				{x, Rational(num(rand)) / den(rand)},
+				{y, Rational(num(rand)) / den(rand)},
+				{z, Rational(num(rand)) / den(rand)}
+			};
+			if (f.isConstant() || !carl::isZero(f.denominatorAsPolynomial().evaluate(point))) {
+				EXPECT_EQ(f.evaluate(point), evaluator.evaluate(point)) << f << " -> " << evaluator;
+			}
+		}
+	}
+}
+
+TEST(RationalFunctionEvaluator, Sharing)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Pol p = (Pol(x) * Rational(2) + y).pow(5) + Pol(x) * y;
+	RationalFunctionEvaluator<Pol> single(p, Pol(Rational(1)));
+	// The denominator is the same expression as the numerator and does not need any instruction.
+	RationalFunctionEvaluator<Pol> same(p, p);
+	EXPECT_EQ(single.instructions().size(), same.instructions().size());
+	// Powers are shared between numerator and denominator.
+	RationalFunctionEvaluator<Pol> powers(Pol(x).pow(8) + y, Pol(x).pow(9) + Rational(1));
+	RationalFunctionEvaluator<Pol> numerator(Pol(x).pow(8) + y, Pol(Rational(1)));
+	EXPECT_EQ(numerator.instructions().size() + 2, powers.instructions().size()) << powers;
+	// Registers are reused.
+	EXPECT_LT(single.registers(), single.variables().size() + single.instructions().size());
+}
+
+TEST(RationalFunctionEvaluator, Batch)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	std::size_t n = 1000;
+	std::mt19937 rand(7);
+	std::uniform_int_distribution<int> value(-400, 400);
+	for (const auto& f: functions(x, y, z)) {
+		RationalFunctionEvaluator<Pol> evaluator(f);
+		std::size_t vars = evaluator.variables().size();
+		std::vector<std::vector<double>> values(vars, std::vector<double>(n));
+		std::vector<std::map<Variable, Rational>> points(n);
+		IntervalBatch boxes(vars, n);
+		for (std::size_t i = 0; i < n; i++) {
+			for (std::size_t v = 0; v < vars; v++) {
+				Rational r = Rational(value(rand)) / 64;
+				values[v][i] = carl::toDouble(r);
+				points[i][evaluator.variables()[v]] = r;
+				boxes.set(v, i, Interval<double>(values[v][i]));
+			}
+		}
+		std::vector<const double*> input;
+		for (const auto& v: values) input.push_back(v.data());
+		std::vector<double> result(n);
+		evaluator.evaluate(n, input, result.data());
+		std::vector<Interval<double>> enclosures;
+		std::vector<bool> nearPole;
+		evaluator.evaluate(boxes, enclosures, nearPole);
+		ASSERT_EQ(n, enclosures.size());
+		for (std::size_t i = 0; i < n; i++) {
+			if (nearPole[i]) continue;
+			Rational exact = evaluator.evaluate(points[i]);
+			double d = carl::toDouble(exact);
+			EXPECT_NEAR(d, result[i], 1e-9 * std::max(1.0, std::abs(d))) << f;
+			EXPECT_TRUE(enclosures[i].contains(d)) << f << " at " << i << ": " << enclosures[i] << " " << d;
+		}
+	}
+}
+
+TEST(RationalFunctionEvaluator, NearPole)
+{
+	Variable x = freshRealVariable("x");
+	RationalFunctionEvaluator<Pol> evaluator(Pol(Rational(1)), Pol(x) * Rational(3) - Rational(1));
+	std::vector<double> points = {0.0, 1.0 / 3.0, 1.0, 0.3333};
+	IntervalBatch boxes(1, points.size());
+	for (std::size_t i = 0; i < points.size(); i++) boxes.set(0, i, Interval<double>(points[i]));
+	std::vector<Interval<double>> enclosures;
+	std::vector<bool> nearPole;
+	evaluator.evaluate(boxes, enclosures, nearPole);
+	EXPECT_FALSE(nearPole[0]);
+	EXPECT_TRUE(enclosures[0].contains(-1.0));
+	// The double closest to 1/3 is not a pole, but the rounding errors do not allow to separate the denominator from zero.
+	EXPECT_TRUE(nearPole[1]);
+	EXPECT_TRUE(enclosures[1].isInfinite());
+	EXPECT_FALSE(nearPole[2]);
+	EXPECT_TRUE(enclosures[2].contains(0.5));
+	EXPECT_FALSE(nearPole[3]);
+	EXPECT_LT(enclosures[3].upper(), -1000.0);
+}
@@ -67,3 +67,30 @@ TEST(RealAlgebraicNumber, Evaluation2)
 	auto res = RealAlgebraicNumberEvaluation::evaluate(MultivariatePolynomial<Rational>(mp), point, vars);
 	std::cerr << res << std::endl;
 }
+
+TEST(RealAlgebraicNumber, EvaluateSign)
+{
+	Variable t = freshRealVariable("t");
+	UnivariatePolynomial<Rational> p(t, std::initializer_list<Rational>{-3, 0, 1});
+	std::vector<Variable> vars({t});
+	Interval<Rational> i(Rational(13)/8, BoundType::STRICT, Rational(7)/4, BoundType::STRICT);
+
+	MultivariatePolynomial<Rational> mt(t);
+	// t^2 - 3 - 1/10^6 is negative at sqrt(3), but only after refining the interval.
+	MultivariatePolynomial<Rational> close = mt*mt - Rational(3) - Rational(1)/Rational(1000000);
+	for (const auto& q: {mt - Rational(2), close, mt*mt*mt - Rational(3)*mt + Rational(1)/Rational(3)}) {
+		Sign s;
+		RealAlgebraicPoint<Rational> point({RealAlgebraicNumber<Rational>(p, i)});
+		ASSERT_TRUE(RealAlgebraicNumberEvaluation::evaluateSign(q, point, vars, s));
+		RealAlgebraicPoint<Rational> exactPoint({RealAlgebraicNumber<Rational>(p, i)});
+		EXPECT_EQ(RealAlgebraicNumberEvaluation::evaluate(q, exactPoint, vars).sgn(), s);
+	}
+	// The sign of a root of the defining polynomial is never certified.
+	Sign s;
+	RealAlgebraicPoint<Rational> point({RealAlgebraicNumber<Rational>(p, i)});
+	// A single round does not refine the interval, which is too large for close.
+	EXPECT_FALSE(RealAlgebraicNumberEvaluation::evaluateSign(close, point, vars, s, RealAlgebraicNumberSettings::ADAPTIVE_INITIAL_PRECISION));
+	EXPECT_EQ(i, point[0].getInterval());
+	EXPECT_FALSE(RealAlgebraicNumberEvaluation::evaluateSign(mt*mt - Rational(3), point, vars, s));
+	EXPECT_EQ(Sign::ZERO, RealAlgebraicNumberEvaluation::evaluate(mt*mt - Rational(3), point, vars).sgn());
+}
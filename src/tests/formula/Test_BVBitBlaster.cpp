@@ -0,0 +1,223 @@
+#include "gtest/gtest.h"
+
+#include <carl/core/MultivariatePolynomial.h>
+#include <carl/formula/bitvector/BVBitBlaster.h>
+#include <carl/formula/bitvector/BVConstraintPool.h>
+#include <carl/formula/bitvector/BVTermPool.h>
+
+#include <random>
+
+#include "../Common.h"
+
+using namespace carl;
+
+namespace {
+	/**
+	 * Computes the values of all variables by unit propagation, starting from
+	 * the given assignment of the input bits. As every gate is fully defined
+	 * by its inputs, this assigns all gates that depend on the inputs.
+	 * @return false, if some clause is violated.
+	 */
+	bool propagate(const BVClauseBuffer& clauses, std::vector<int>& assignment) {
+		auto value = [&assignment](int lit) {
+			int v = assignment[std::size_t(std::abs(lit))];
+			return lit > 0 ? v : -v;
+		};
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			bool conflict = false;
+			clauses.forEachClause([&](const int* begin, const int* end) {
+				int unassigned = 0;
+				int last = 0;
+				for (const int* lit = begin; lit != end; ++lit) {
+					if (value(*lit) == 1) return;
+					if (value(*lit) == 0) {
+						unassigned++;
+						last = *lit;
+					}
+				}
+				if (unassigned == 0) conflict = true;
+				if (unassigned == 1) {
+					assignment[std::size_t(std::abs(last))] = last > 0 ? 1 : -1;
+					changed = true;
+				}
+			});
+			if (conflict) return false;
+		}
+		return true;
+	}
+
+	BVValue readBits(const BVBitBlaster::Bits& bits, const std::vector<int>& assignment) {
+		BVValue res(bits.size());
+		for (std::size_t i = 0; i < bits.size(); i++) {
+			int v = assignment[std::size_t(std::abs(bits[i]))];
+			EXPECT_NE(0, v);
+			res[i] = (bits[i] > 0) == (v == 1);
+		}
+		return res;
+	}
+
+	void assignBits(const BVBitBlaster::Bits& bits, const BVValue& value, std::vector<int>& assignment) {
+		for (std::size_t i = 0; i < bits.size(); i++) {
+			assignment[std::size_t(bits[i])] = value[i] ? 1 : -1;
+		}
+	}
+}
+
+class BVBitBlasterTest: public testing::Test {
+protected:
+	using Bits = BVBitBlaster::Bits;
+	std::mt19937 rand;
+	BVTerm a;
+	BVTerm b;
+
+	BVBitBlasterTest(): rand(4711) {
+		SortManager& sm = SortManager::getInstance();
+		sm.clear();
+		Sort bvSort = sm.addSort("BitVec", VariableType::VT_UNINTERPRETED);
+		sm.makeSortIndexable(bvSort, 1, VariableType::VT_BITVECTOR);
+		Sort bv8Sort = getSort("BitVec", std::vector<std::size_t>({8}));
+		a = BVTerm(BVTermType::VARIABLE, BVVariable(freshBitvectorVariable("a"), bv8Sort));
+		b = BVTerm(BVTermType::VARIABLE, BVVariable(freshBitvectorVariable("b"), bv8Sort));
+	}
+
+	BVValue random() {
+		return BVValue(8, carl::uint(rand() % 256));
+	}
+
+	/// Evaluates the blasted term for the given values of a and b.
+	BVValue evaluate(BVBitBlaster& bb, const BVTerm& term, const BVValue& va, const BVValue& vb) {
+		Bits bits = bb.blast(term);
+		Bits bitsA = bb.blast(a);
+		Bits bitsB = bb.blast(b);
+		std::vector<int> assignment(bb.variables() + 1, 0);
+		assignment[std::size_t(bb.trueLiteral())] = 1;
+		assignBits(bitsA, va, assignment);
+		assignBits(bitsB, vb, assignment);
+		EXPECT_TRUE(propagate(bb.clauses(), assignment));
+		return readBits(bits, assignment);
+	}
+};
+
+TEST_F(BVBitBlasterTest, BinaryTerms)
+{
+	BVBitBlaster bb;
+	for (BVTermType type: {BVTermType::CONCAT, BVTermType::AND, BVTermType::OR, BVTermType::XOR, BVTermType::NAND,
+			BVTermType::NOR, BVTermType::XNOR, BVTermType::ADD, BVTermType::SUB, BVTermType::MUL, BVTermType::DIV_U,
+			BVTermType::DIV_S, BVTermType::MOD_U, BVTermType::MOD_S1, BVTermType::MOD_S2, BVTermType::EQ, BVTermType::LSHIFT,
+			BVTermType::RSHIFT_LOGIC, BVTermType::RSHIFT_ARITH}) {
+		BVTerm term(type, a, b);
+		for (int i = 0; i < 50; i++) {
+			BVValue va = random();
+			BVValue vb = random();
+			if (vb.isZero()) continue;
+			BVTerm expected(type, BVTerm(BVTermType::CONSTANT, va), BVTerm(BVTermType::CONSTANT, vb));
+			EXPECT_EQ(expected.value(), evaluate(bb, term, va, vb)) << term << " with " << va << ", " << vb;
+		}
+	}
+}
+
+TEST_F(BVBitBlasterTest, UnaryTerms)
+{
+	BVBitBlaster bb;
+	std::vector<BVTerm> terms = {
+		BVTerm(BVTermType::NOT, a), BVTerm(BVTermType::NEG, a),
+		BVTerm(BVTermType::LROTATE, a, 3), BVTerm(BVTermType::RROTATE, a, 11),
+		BVTerm(BVTermType::EXT_U, a, 5), BVTerm(BVTermType::EXT_S, a, 5),
+		BVTerm(BVTermType::REPEAT, a, 3), BVTerm(BVTermType::EXTRACT, a, 6, 2)
+	};
+	for (const auto& term: terms) {
+		for (int i = 0; i < 20; i++) {
+			BVValue va = random();
+			BVTerm expected = term.substitute({{a.variable(), BVTerm(BVTermType::CONSTANT, va)}});
+			EXPECT_EQ(expected.value(), evaluate(bb, term, va, random())) << term << " with " << va;
+		}
+	}
+}
+
+TEST_F(BVBitBlasterTest, DivisionByZero)
+{
+	BVBitBlaster bb;
+	BVValue zero(8, 0);
+	for (int i = 0; i < 20; i++) {
+		BVValue va = random();
+		EXPECT_EQ(~zero, evaluate(bb, BVTerm(BVTermType::DIV_U, a, b), va, zero));
+		EXPECT_EQ(va, evaluate(bb, BVTerm(BVTermType::MOD_U, a, b), va, zero));
+	}
+}
+
+TEST_F(BVBitBlasterTest, SignedRemainder)
+{
+	// bvsrem and bvsmod as defined by SMT-LIB
+	BVBitBlaster bb;
+	BVTerm srem(BVTermType::MOD_S1, a, b);
+	BVTerm smod(BVTermType::MOD_S2, a, b);
+	for (int i = 0; i < 100; i++) {
+		BVValue s = random();
+		BVValue t = random();
+		if (t.isZero()) continue;
+		bool sNegative = s[7];
+		bool tNegative = t[7];
+		BVValue u = (sNegative ? -s : s) % (tNegative ? -t : t);
+		EXPECT_EQ(sNegative ? -u : u, evaluate(bb, srem, s, t)) << s << " bvsrem " << t;
+		BVValue expected = u;
+		if (!u.isZero()) {
+			if (sNegative && !tNegative) expected = -u + t;
+			else if (!sNegative && tNegative) expected = u + t;
+			else if (sNegative && tNegative) expected = -u;
+		}
+		EXPECT_EQ(expected, evaluate(bb, smod, s, t)) << s << " bvsmod " << t;
+	}
+}
+
+TEST_F(BVBitBlasterTest, Constraints)
+{
+	BVBitBlaster bb;
+	for (BVCompareRelation rel: {BVCompareRelation::EQ, BVCompareRelation::NEQ, BVCompareRelation::ULT,
+			BVCompareRelation::ULE, BVCompareRelation::UGT, BVCompareRelation::UGE, BVCompareRelation::SLT,
+			BVCompareRelation::SLE, BVCompareRelation::SGT, BVCompareRelation::SGE}) {
+		BVConstraint c = BVConstraint::create(rel, a, b);
+		BVBitBlaster::Literal lit = bb.blast(c);
+		Bits bitsA = bb.blast(a);
+		Bits bitsB = bb.blast(b);
+		for (int i = 0; i < 50; i++) {
+			BVValue va = random();
+			BVValue vb = (i % 5 == 0) ? va : random();
+			BVConstraint expected = BVConstraint::create(rel, BVTerm(BVTermType::CONSTANT, va), BVTerm(BVTermType::CONSTANT, vb));
+			std::vector<int> assignment(bb.variables() + 1, 0);
+			assignment[std::size_t(bb.trueLiteral())] = 1;
+			assignBits(bitsA, va, assignment);
+			assignBits(bitsB, vb, assignment);
+			EXPECT_TRUE(propagate(bb.clauses(), assignment));
+			int value = assignment[std::size_t(std::abs(lit))] * (lit > 0 ? 1 : -1);
+			EXPECT_EQ(expected.isAlwaysConsistent(), value == 1) << c << " with " << va << ", " << vb;
+		}
+	}
+}
+
+TEST_F(BVBitBlasterTest, StructuralHashing)
+{
+	BVBitBlaster bb;
+	BVTerm product(BVTermType::MUL, a, b);
+	bb.blast(product);
+	std::size_t clauses = bb.clauses().size();
+	// The same term and a term sharing it are not translated again.
+	bb.blast(BVTerm(BVTermType::MUL, a, b));
+	EXPECT_EQ(clauses, bb.clauses().size());
+	bb.blast(BVTerm(BVTermType::NOT, product));
+	EXPECT_EQ(clauses, bb.clauses().size());
+	// Constant operands do not produce any clauses.
+	bb.blast(BVTerm(BVTermType::AND, a, BVTerm(BVTermType::CONSTANT, BVValue(8, 0))));
+	EXPECT_EQ(clauses, bb.clauses().size());
+}
+
+TEST_F(BVBitBlasterTest, ToFormula)
+{
+	BVBitBlaster bb;
+	bb.assertConstraint(BVConstraint::create(BVCompareRelation::ULT, a, b));
+	std::vector<Variable> vars;
+	Formula<MultivariatePolynomial<Rational>> f = toFormula<MultivariatePolynomial<Rational>>(bb.clauses(), vars);
+	EXPECT_EQ(bb.variables(), vars.size());
+	EXPECT_EQ(FormulaType::AND, f.getType());
+}
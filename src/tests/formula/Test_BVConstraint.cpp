@@ -93,3 +93,38 @@ TEST(BVConstraint, Construction)
     /* BV_TERM_POOL.print();
     BV_CONSTRAINT_POOL.print(); */
 }
+
+TEST(BVConstraint, CopyAndMove)
+{
+    Variable a = freshBitvectorVariable("a");
+
+    carl::SortManager::getInstance().clear();
+    Sort bvSort = SortManager::getInstance().addSort("BitVec");
+    SortManager::getInstance().makeSortIndexable(bvSort, 1, VariableType::VT_BITVECTOR);
+    Sort bv8Sort = SortManager::getInstance().index(bvSort, {8});
+
+    BVTerm a_t(BVTermType::VARIABLE, BVVariable(a, bv8Sort));
+    BVTerm five(BVTermType::CONSTANT, BVValue(8, 5));
+
+    std::size_t before = BV_CONSTRAINT_POOL.size();
+    {
+        BVConstraint c = BVConstraint::create(BVCompareRelation::ULT, a_t, five);
+        EXPECT_EQ(before + 1, BV_CONSTRAINT_POOL.size());
+
+        BVConstraint copy(c);
+        BVConstraint moved(std::move(copy));
+        EXPECT_TRUE(moved == c);
+        EXPECT_EQ(c.id(), moved.id());
+
+        BVConstraint other = BVConstraint::create(BVCompareRelation::UGT, a_t, five);
+        EXPECT_EQ(before + 2, BV_CONSTRAINT_POOL.size());
+        other = std::move(moved);
+        // The pooled instance of other is not used anymore.
+        EXPECT_EQ(before + 1, BV_CONSTRAINT_POOL.size());
+        EXPECT_TRUE(other == c);
+
+        moved = other;
+        EXPECT_TRUE(moved == c);
+    }
+    EXPECT_EQ(before, BV_CONSTRAINT_POOL.size());
+}
@@ -2,6 +2,9 @@
 
 #include <carl/formula/bitvector/BVTerm.h>
 #include <carl/formula/bitvector/BVTermPool.h>
+#include <carl/formula/bitvector/BVConstraint.h>
+
+#include <thread>
 
 #include "../Common.h"
 
@@ -39,3 +42,109 @@ TEST(BVTerm, Variable)
 	EXPECT_FALSE(bvt.isInvalid());
 	EXPECT_EQ(bvv, bvt.variable());
 }
+
+TEST(BVTerm, Rewriting)
+{
+	carl::SortManager& sm = carl::SortManager::getInstance();
+	sm.clear();
+	carl::Sort bvSort = sm.addSort("BitVec", carl::VariableType::VT_UNINTERPRETED);
+	sm.makeSortIndexable(bvSort, 1, carl::VariableType::VT_BITVECTOR);
+	carl::Sort bv8Sort = carl::getSort("BitVec", std::vector<std::size_t>({8}));
+	carl::BVTerm a(carl::BVTermType::VARIABLE, carl::BVVariable(carl::freshBitvectorVariable("a"), bv8Sort));
+	carl::BVTerm b(carl::BVTermType::VARIABLE, carl::BVVariable(carl::freshBitvectorVariable("b"), bv8Sort));
+	carl::BVTerm zero(carl::BVTermType::CONSTANT, carl::BVValue(8, 0));
+	carl::BVTerm one(carl::BVTermType::CONSTANT, carl::BVValue(8, 1));
+
+	// Algebraic identities
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::ADD, a, zero));
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::MUL, one, a));
+	EXPECT_EQ(zero, carl::BVTerm(carl::BVTermType::XOR, a, a));
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::NOT, carl::BVTerm(carl::BVTermType::NOT, a)));
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::EXT_U, a, 5), carl::BVTerm(carl::BVTermType::EXT_U, carl::BVTerm(carl::BVTermType::EXT_U, a, 2), 3));
+
+	// Constant folding of nested constant subterms
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::CONSTANT, carl::BVValue(8, 2)), carl::BVTerm(carl::BVTermType::ADD, one, one));
+
+	// Extract and concat fusion
+	carl::BVTerm ab(carl::BVTermType::CONCAT, a, b);
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::EXTRACT, ab, 15, 8));
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::EXTRACT, b, 5, 2), carl::BVTerm(carl::BVTermType::EXTRACT, ab, 5, 2));
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::EXTRACT, a, 4, 3), carl::BVTerm(carl::BVTermType::EXTRACT, carl::BVTerm(carl::BVTermType::EXTRACT, a, 6, 2), 2, 1));
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::CONCAT, carl::BVTerm(carl::BVTermType::EXTRACT, a, 7, 3), carl::BVTerm(carl::BVTermType::EXTRACT, a, 2, 0)));
+
+	// Commutative operations are ordered
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::ADD, a, b), carl::BVTerm(carl::BVTermType::ADD, b, a));
+	EXPECT_FALSE(carl::BVTerm(carl::BVTermType::SUB, a, b) == carl::BVTerm(carl::BVTermType::SUB, b, a));
+	EXPECT_EQ(one, carl::BVTerm(carl::BVTermType::AND, one, a).second());
+
+	// Without rewriting, terms are kept as they are
+	carl::BVTermPool& pool = carl::BVTermPool::getInstance();
+	carl::BVTermRewriting rewriting = pool.rewriting();
+	pool.setRewriting(carl::BVTermRewriting::none());
+	carl::BVTerm sum(carl::BVTermType::ADD, a, zero);
+	EXPECT_EQ(carl::BVTermType::ADD, sum.type());
+	EXPECT_EQ(carl::BVTermType::ADD, carl::BVTerm(carl::BVTermType::ADD, one, one).type());
+	EXPECT_EQ(b, carl::BVTerm(carl::BVTermType::ADD, b, a).first());
+	pool.setRewriting(rewriting);
+}
+
+TEST(BVTerm, Reclamation)
+{
+	carl::SortManager& sm = carl::SortManager::getInstance();
+	sm.clear();
+	carl::Sort bvSort = sm.addSort("BitVec", carl::VariableType::VT_UNINTERPRETED);
+	sm.makeSortIndexable(bvSort, 1, carl::VariableType::VT_BITVECTOR);
+	carl::Sort bv16Sort = carl::getSort("BitVec", std::vector<std::size_t>({16}));
+	carl::BVTerm a(carl::BVTermType::VARIABLE, carl::BVVariable(carl::freshBitvectorVariable("a"), bv16Sort));
+	carl::BVTermPool& pool = carl::BVTermPool::getInstance();
+
+	std::size_t size = pool.size();
+	std::size_t maxId = 0;
+	for (int round = 0; round < 3; round++) {
+		std::vector<carl::BVTerm> terms;
+		for (unsigned i = 0; i < 100; i++) {
+			carl::BVTerm c(carl::BVTermType::CONSTANT, carl::BVValue(16, 1000 + i));
+			terms.emplace_back(carl::BVTermType::MUL, a, carl::BVTerm(carl::BVTermType::ADD, a, c));
+		}
+		carl::BVConstraint constraint = carl::BVConstraint::create(carl::BVCompareRelation::ULT, terms.front(), terms.back());
+		EXPECT_EQ(size + 300, pool.size());
+		for (const auto& t: terms) {
+			if (round == 0) maxId = std::max(maxId, t.id());
+			else EXPECT_LE(t.id(), maxId);
+		}
+	}
+	// All terms have been released, their ids are reused
+	EXPECT_EQ(size, pool.size());
+}
+
+TEST(BVTerm, ConcurrentCreation)
+{
+	carl::SortManager& sm = carl::SortManager::getInstance();
+	sm.clear();
+	carl::Sort bvSort = sm.addSort("BitVec", carl::VariableType::VT_UNINTERPRETED);
+	sm.makeSortIndexable(bvSort, 1, carl::VariableType::VT_BITVECTOR);
+	carl::Sort bv16Sort = carl::getSort("BitVec", std::vector<std::size_t>({16}));
+	carl::BVTerm a(carl::BVTermType::VARIABLE, carl::BVVariable(carl::freshBitvectorVariable("a"), bv16Sort));
+
+	// Every thread repeatedly creates and releases the same terms and keeps the last ones
+	std::vector<std::vector<carl::BVTerm>> results(4);
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < results.size(); t++) {
+		threads.emplace_back([&a,&results,t]() {
+			for (unsigned round = 0; round < 50; round++) {
+				std::vector<carl::BVTerm> terms;
+				for (unsigned i = 0; i < 50; i++) {
+					terms.emplace_back(carl::BVTermType::ADD, a, carl::BVTerm(carl::BVTermType::CONSTANT, carl::BVValue(16, i + 1)));
+				}
+				results[t] = terms;
+			}
+		});
+	}
+	for (auto& t: threads) t.join();
+	for (std::size_t t = 1; t < results.size(); t++) {
+		for (std::size_t i = 0; i < results[t].size(); i++) {
+			EXPECT_EQ(results[0][i], results[t][i]);
+			EXPECT_EQ(results[0][i].id(), results[t][i].id());
+		}
+	}
+}
@@ -4,6 +4,8 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <random>
+
 #include "../Common.h"
 
 using BDB = boost::dynamic_bitset<>;
@@ -218,3 +220,137 @@ TYPED_TEST(BVValueTest, Multiplication)
 	EXPECT_EQ(carl::BVValue(32, 1073741823), this->bv32_e30 * this->bv32_1);
 	EXPECT_EQ(carl::BVValue(32, 2147483649), this->bv32_e30 * this->bv32_e30);
 }
+
+namespace bitserial {
+	// Bit-serial reference implementation of the bit vector operations,
+	// used to check the word-level implementation of BVValue.
+	BDB add(const BDB& a, const BDB& b) {
+		bool carry = false;
+		BDB sum(a.size());
+		for (std::size_t i = 0; i < a.size(); ++i) {
+			sum[i] = (a[i] != b[i]) != carry;
+			carry = (a[i] && b[i]) || (carry && (a[i] || b[i]));
+		}
+		return sum;
+	}
+	BDB neg(const BDB& a) {
+		return add(~a, BDB(a.size(), 1));
+	}
+	BDB mul(const BDB& a, const BDB& b) {
+		BDB product(a.size());
+		BDB summand(a);
+		for (std::size_t i = 0; i < a.size(); ++i) {
+			if (b[i]) product = add(product, summand);
+			summand <<= 1;
+		}
+		return product;
+	}
+	BDB divide(const BDB& a, const BDB& b, bool remainder) {
+		BDB quotient(a.size());
+		BDB rem(a);
+		BDB divisor(b);
+		std::size_t index = 0;
+		while (!divisor[divisor.size()-1] && rem > divisor) {
+			++index;
+			divisor <<= 1;
+		}
+		while (true) {
+			if (rem >= divisor) {
+				quotient[index] = true;
+				rem = add(rem, neg(divisor));
+			}
+			if (index == 0) break;
+			divisor >>= 1;
+			--index;
+		}
+		return remainder ? rem : quotient;
+	}
+	BDB shift(const BDB& a, const BDB& b, bool left, bool arithmetic) {
+		bool fill = !left && arithmetic && a[a.size()-1];
+		for (std::size_t i = 0; i < b.size(); ++i) {
+			if (b[i] && (i >= 64 || (std::size_t(1) << i) >= a.size())) {
+				return fill ? ~BDB(a.size()) : BDB(a.size());
+			}
+		}
+		std::size_t by = b.to_ulong();
+		BDB shifted(fill ? ~a : a);
+		if (left) shifted <<= by;
+		else shifted >>= by;
+		return fill ? ~shifted : shifted;
+	}
+	BDB rotateLeft(const BDB& a, std::size_t n) {
+		BDB lower(a);
+		BDB upper(a);
+		lower <<= n % a.size();
+		upper >>= a.size() - (n % a.size());
+		return lower ^ upper;
+	}
+	BDB extract(const BDB& a, std::size_t highest, std::size_t lowest) {
+		BDB res(highest - lowest + 1);
+		for (std::size_t i = 0; i < res.size(); ++i) res[i] = a[lowest + i];
+		return res;
+	}
+	BDB concat(const BDB& a, const BDB& b) {
+		BDB res(a);
+		res.resize(a.size() + b.size());
+		res <<= b.size();
+		BDB other(b);
+		other.resize(res.size());
+		return res | other;
+	}
+}
+
+TEST(BVValue, DifferentialAgainstBitSerial)
+{
+	std::mt19937_64 rand(42);
+	auto randomValue = [&rand](std::size_t width) {
+		// Mix uniform values with values that have long runs of zeros or ones.
+		carl::BVValue res(width);
+		std::uniform_int_distribution<int> kind(0, 3);
+		int k = kind(rand);
+		for (std::size_t i = 0; i < width; ++i) {
+			if (k == 0) res[i] = (rand() & 1) != 0;
+			else if (k == 1) res[i] = i < 3 && (rand() & 1) != 0;
+			else if (k == 2) res[i] = i + 3 >= width || (rand() & 1) != 0;
+			else res[i] = (rand() % 8) == 0;
+		}
+		return res;
+	};
+	for (std::size_t width: {1, 2, 7, 31, 32, 33, 63, 64, 65, 127, 128, 129, 200}) {
+		for (int iteration = 0; iteration < 50; ++iteration) {
+			carl::BVValue a = randomValue(width);
+			carl::BVValue b = randomValue(width);
+			BDB ra(a);
+			BDB rb(b);
+			EXPECT_EQ(BDB(-a), bitserial::neg(ra));
+			EXPECT_EQ(BDB(~a), ~ra);
+			EXPECT_EQ(BDB(a + b), bitserial::add(ra, rb));
+			EXPECT_EQ(BDB(a - b), bitserial::add(ra, bitserial::neg(rb)));
+			EXPECT_EQ(BDB(a * b), bitserial::mul(ra, rb));
+			if (!b.isZero()) {
+				EXPECT_EQ(BDB(a / b), bitserial::divide(ra, rb, false));
+				EXPECT_EQ(BDB(a % b), bitserial::divide(ra, rb, true));
+			}
+			EXPECT_EQ(BDB(a << b), bitserial::shift(ra, rb, true, false));
+			EXPECT_EQ(BDB(a >> b), bitserial::shift(ra, rb, false, false));
+			EXPECT_EQ(BDB(a.rightShiftArithmetic(b)), bitserial::shift(ra, rb, false, true));
+			carl::BVValue amount(width, uint(rand() % (width + 2)));
+			EXPECT_EQ(BDB(a << amount), bitserial::shift(ra, BDB(amount), true, false));
+			EXPECT_EQ(BDB(a.rightShiftArithmetic(amount)), bitserial::shift(ra, BDB(amount), false, true));
+			std::size_t n = rand() % (2 * width + 1);
+			EXPECT_EQ(BDB(a.rotateLeft(n)), bitserial::rotateLeft(ra, n));
+			std::size_t lowest = rand() % width;
+			std::size_t highest = lowest + rand() % (width - lowest);
+			EXPECT_EQ(BDB(a.extract(highest, lowest)), bitserial::extract(ra, highest, lowest));
+			EXPECT_EQ(BDB(a.concat(b)), bitserial::concat(ra, rb));
+			EXPECT_EQ(BDB(a.extendSignedBy(n)), bitserial::extract(bitserial::concat(a[width-1] ? ~BDB(n) : BDB(n), ra), width + n - 1, 0));
+			EXPECT_EQ(a < b, ra < rb);
+			EXPECT_EQ(a == b, ra == rb);
+			EXPECT_EQ(a.isZero(), ra.none());
+			std::string bits;
+			boost::to_string(ra, bits);
+			EXPECT_EQ(a, carl::BVValue(width, mpz_class(bits, 2)));
+			EXPECT_EQ(a, carl::BVValue(bits));
+		}
+	}
+}
@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+
+#include <carl/core/MultivariatePolynomial.h>
+#include <carl/io/BinarySerialization.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef Formula<Pol> FormulaT;
+
+TEST(BinarySerialization, Varint)
+{
+	std::string data;
+	for (std::uint64_t n: {std::uint64_t(0), std::uint64_t(127), std::uint64_t(128), std::uint64_t(300), ~std::uint64_t(0)}) {
+		binary_detail::writeVarint(data, n);
+	}
+	EXPECT_EQ(1 + 1 + 2 + 2 + 10, data.size());
+	const char* pos = data.data();
+	for (std::uint64_t n: {std::uint64_t(0), std::uint64_t(127), std::uint64_t(128), std::uint64_t(300), ~std::uint64_t(0)}) {
+		std::uint64_t res;
+		ASSERT_TRUE(binary_detail::readVarint(pos, data.data() + data.size(), res));
+		EXPECT_EQ(n, res);
+	}
+	data.clear();
+	for (const char* n: {"0", "-1", "255", "-256", "123456789012345678901234567890"}) {
+		binary_detail::writeInteger(data, mpz_class(n));
+	}
+	pos = data.data();
+	for (const char* n: {"0", "-1", "255", "-256", "123456789012345678901234567890"}) {
+		mpz_class res;
+		ASSERT_TRUE(binary_detail::readInteger(pos, data.data() + data.size(), res));
+		EXPECT_EQ(mpz_class(n), res);
+	}
+}
+
+TEST(BinarySerialization, Polynomials)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshIntegerVariable("y");
+	Pol p = Rational(3)/Rational(7)*x*x*y - Rational("123456789012345678901234567890")*y + Rational(-5);
+	BinaryWriter<Pol> writer;
+	writer.write(x);
+	writer.write(createMonomial(y, 3));
+	writer.write(Monomial::Arg());
+	writer.write(p);
+	writer.write(Pol());
+
+	BinaryReader<Pol> reader(writer.data());
+	reader.addVariable(x);
+	reader.addVariable(y);
+	Variable v;
+	Monomial::Arg m;
+	Pol q;
+	ASSERT_TRUE(reader.read(v));
+	EXPECT_EQ(x, v);
+	ASSERT_TRUE(reader.read(m));
+	EXPECT_EQ(createMonomial(y, 3), m);
+	ASSERT_TRUE(reader.read(m));
+	EXPECT_EQ(nullptr, m);
+	ASSERT_TRUE(reader.read(q));
+	EXPECT_EQ(p, q);
+	ASSERT_TRUE(reader.read(q));
+	EXPECT_TRUE(q.isZero());
+	EXPECT_TRUE(reader.atEnd());
+	EXPECT_FALSE(reader.read(q));
+}
+
+TEST(BinarySerialization, FreshVariables)
+{
+	Variable x = freshRealVariable("x");
+	Variable b = freshBooleanVariable("b");
+	BinaryWriter<Pol> writer;
+	FormulaT f(OR, {FormulaT(b), FormulaT(Pol(x)*x - Rational(2), Relation::LESS)});
+	ASSERT_TRUE(writer.write(f));
+
+	// Without known variables, fresh ones of the same name and type are created.
+	BinaryReader<Pol> reader(writer.data());
+	FormulaT g;
+	ASSERT_TRUE(reader.read(g));
+	EXPECT_NE(f, g);
+	Variables vars;
+	g.allVars(vars);
+	ASSERT_EQ(2, vars.size());
+	for (Variable v: vars) {
+		EXPECT_TRUE(v != x && v != b);
+		EXPECT_EQ(v.getType() == VariableType::VT_BOOL ? "b" : "x", v.getName());
+	}
+}
+
+TEST(BinarySerialization, Formulas)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable b = freshBooleanVariable("b");
+	FormulaT c1(Pol(x) - y, Relation::LEQ);
+	FormulaT c2(Pol(x)*y + Rational(1), Relation::NEQ);
+	FormulaT shared(AND, {c1, FormulaT(NOT, c2)});
+	FormulaT f(OR, {
+		FormulaT(IMPLIES, {FormulaT(b), shared}),
+		FormulaT(ITE, {c2, shared, FormulaT(XOR, {FormulaT(b), c1})}),
+		FormulaT(IFF, {shared, FormulaT(b)}),
+		FormulaT(EXISTS, std::vector<Variable>({y}), shared)
+	});
+
+	BinaryWriter<Pol> writer;
+	ASSERT_TRUE(writer.write(f));
+	writer.write(c2.constraint());
+	ASSERT_TRUE(writer.write(shared));
+	ASSERT_TRUE(writer.write(FormulaT(TRUE)));
+	std::size_t size = writer.data().size();
+	// Writing an object again only adds a reference.
+	ASSERT_TRUE(writer.write(f));
+	EXPECT_EQ(size + 2, writer.data().size());
+
+	BinaryReader<Pol> reader(writer.data());
+	reader.addVariable(x);
+	reader.addVariable(y);
+	reader.addVariable(b);
+	FormulaT g;
+	Constraint<Pol> c;
+	ASSERT_TRUE(reader.read(g));
+	EXPECT_EQ(f, g);
+	ASSERT_TRUE(reader.read(c));
+	EXPECT_EQ(c2.constraint(), c);
+	ASSERT_TRUE(reader.read(g));
+	EXPECT_EQ(shared, g);
+	ASSERT_TRUE(reader.read(g));
+	EXPECT_TRUE(g.isTrue());
+	ASSERT_TRUE(reader.read(g));
+	EXPECT_EQ(f, g);
+	EXPECT_TRUE(reader.atEnd());
+}
+
+TEST(BinarySerialization, Errors)
+{
+	Variable x = freshRealVariable("x");
+	EXPECT_FALSE(BinaryReader<Pol>(std::string("CRAL")).isValid());
+	BinaryWriter<Pol> writer;
+	writer.write(Pol(x) + Rational(1));
+	std::string data = writer.data();
+	data.resize(data.size() - 1);
+	BinaryReader<Pol> reader(data);
+	Pol p;
+	EXPECT_FALSE(reader.read(p));
+	EXPECT_FALSE(reader.isValid());
+
+	BinaryReader<Pol> wrongKind(writer.data());
+	FormulaT f;
+	EXPECT_FALSE(wrongKind.read(f));
+
+	// Replace the denominator of a constant by zero, which is a single header byte.
+	BinaryWriter<Pol> constant;
+	constant.write(Pol(Rational(5)));
+	std::string zeroDenom = constant.data();
+	ASSERT_EQ(std::string("\x02\x01"), zeroDenom.substr(zeroDenom.size() - 2));
+	zeroDenom.resize(zeroDenom.size() - 2);
+	zeroDenom.push_back('\0');
+	BinaryReader<Pol> zeroReader(zeroDenom);
+	EXPECT_FALSE(zeroReader.read(p));
+	EXPECT_FALSE(zeroReader.isValid());
+}
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+
+#include <carl/formula/SortManager.h>
+#include <carl/formula/uninterpreted/CongruenceClosure.h>
+#include <carl/formula/uninterpreted/UFInstanceManager.h>
+#include <carl/formula/uninterpreted/UFManager.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+class CongruenceClosureTest: public testing::Test {
+protected:
+	Sort sort;
+	UninterpretedFunction f;
+	UninterpretedFunction g;
+	UVariable x, y, z, u;
+
+	CongruenceClosureTest() {
+		SortManager& sm = SortManager::getInstance();
+		sm.clear();
+		sort = sm.addSort("S", VariableType::VT_UNINTERPRETED);
+		f = newUninterpretedFunction("f", {sort}, sort);
+		g = newUninterpretedFunction("g", {sort, sort}, sort);
+		x = UVariable(freshUninterpretedVariable("x"), sort);
+		y = UVariable(freshUninterpretedVariable("y"), sort);
+		z = UVariable(freshUninterpretedVariable("z"), sort);
+		u = UVariable(freshUninterpretedVariable("u"), sort);
+	}
+
+	UFInstance app(const UninterpretedFunction& fun, std::vector<UVariable> args) {
+		return newUFInstance(fun, std::move(args));
+	}
+};
+
+TEST_F(CongruenceClosureTest, Congruence)
+{
+	CongruenceClosure cc;
+	EXPECT_TRUE(cc.add(UEquality(z, app(f, {x}), false)));
+	EXPECT_TRUE(cc.add(UEquality(u, app(f, {y}), false)));
+	EXPECT_FALSE(cc.areEqual(z, u));
+	EXPECT_TRUE(cc.add(UEquality(x, y, false)));
+	EXPECT_TRUE(cc.areEqual(z, u));
+	EXPECT_TRUE(cc.areEqual(app(f, {x}), app(f, {y})));
+	EXPECT_EQ(3, cc.explain(z, u).size());
+
+	// g(x,z) = g(y,u) follows from the above
+	EXPECT_TRUE(cc.add(UEquality(app(g, {x, z}), app(g, {y, u}), true)) == false);
+	EXPECT_FALSE(cc.consistent());
+	auto conflict = cc.conflict();
+	EXPECT_EQ(4, conflict.size());
+}
+
+TEST_F(CongruenceClosureTest, Backtracking)
+{
+	CongruenceClosure cc;
+	EXPECT_TRUE(cc.add(UEquality(z, app(f, {x}), false)));
+	EXPECT_TRUE(cc.add(UEquality(u, app(f, {y}), false)));
+	EXPECT_TRUE(cc.add(UEquality(z, u, true)));
+	cc.push();
+	EXPECT_FALSE(cc.add(UEquality(x, y, false)));
+	std::vector<UEquality> conflict = cc.conflict();
+	ASSERT_EQ(4, conflict.size());
+	cc.pop();
+	EXPECT_TRUE(cc.consistent());
+	EXPECT_FALSE(cc.areEqual(x, y));
+	EXPECT_FALSE(cc.areEqual(z, u));
+	cc.push();
+	EXPECT_TRUE(cc.add(UEquality(x, z, false)));
+	EXPECT_TRUE(cc.add(UEquality(y, u, false)));
+	EXPECT_FALSE(cc.areEqual(x, y));
+	cc.pop();
+	EXPECT_EQ(0, cc.level());
+	EXPECT_FALSE(cc.areEqual(x, z));
+}
+
+TEST_F(CongruenceClosureTest, NestedChain)
+{
+	// x0 = x, x_{i+1} = f(x_i), f^5(x) = x and f^3(x) = x imply f(x) = x
+	std::vector<UVariable> chain({x});
+	CongruenceClosure cc;
+	for (std::size_t i = 0; i < 5; i++) {
+		chain.emplace_back(freshUninterpretedVariable(), sort);
+		EXPECT_TRUE(cc.add(UEquality(chain.back(), app(f, {chain[i]}), false)));
+	}
+	EXPECT_TRUE(cc.add(UEquality(chain[5], x, false)));
+	EXPECT_FALSE(cc.areEqual(chain[1], x));
+	EXPECT_TRUE(cc.add(UEquality(chain[3], x, false)));
+	EXPECT_TRUE(cc.areEqual(chain[1], x));
+	EXPECT_TRUE(cc.areEqual(app(f, {x}), x));
+	EXPECT_FALSE(cc.add(UEquality(chain[2], x, true)));
+}
+
+TEST_F(CongruenceClosureTest, Model)
+{
+	CongruenceClosure cc;
+	EXPECT_TRUE(cc.add(UEquality(z, app(f, {x}), false)));
+	EXPECT_TRUE(cc.add(UEquality(x, y, false)));
+	EXPECT_TRUE(cc.add(UEquality(u, app(f, {y}), false)));
+	EXPECT_TRUE(cc.add(UEquality(x, z, true)));
+	std::map<UVariable, SortValue> variables;
+	std::map<UninterpretedFunction, UFModel> functions;
+	cc.model(variables, functions);
+	EXPECT_EQ(4, variables.size());
+	EXPECT_EQ(variables[x], variables[y]);
+	EXPECT_EQ(variables[z], variables[u]);
+	EXPECT_FALSE(variables[x] == variables[z]);
+	ASSERT_EQ(1, functions.size());
+	EXPECT_EQ(variables[z], functions.at(f).get({variables[x]}));
+}
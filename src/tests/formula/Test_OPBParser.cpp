@@ -3,6 +3,11 @@
 #include "../Common.h"
 
 #include <carl/formula/parser/OPBImporter.h>
+#include <carl/formula/parser/OPBReader.h>
+#include <carl/formula/pseudoboolean/PBDatabase.h>
+
+#include <cstdio>
+#include <fstream>
 
 using namespace carl;
 using Poly = carl::MultivariatePolynomial<mpq_class>;
@@ -12,3 +17,69 @@ TEST(OPBParser, Basic)
 	//OPBImporter<Poly> importer("../sep6.5.opb");
 	//importer.parse();
 }
+
+namespace {
+	const std::string example =
+		"* #variable= 3 #constraint= 3\n"
+		"min: +1 x1 -2 x2 ;\n"
+		"+1 x1 +1 x2 +1 x3 >= 2 ;\n"
+		"* a comment between the constraints\n"
+		"+3 x1 -2 x2 = 1;\n"
+		"+100000000000000000000 x3 +1 x1 >= 100000000000000000001 ;\n";
+}
+
+TEST(OPBParser, Reader)
+{
+	OPBReader reader(example.data(), example.data() + example.size());
+	auto file = reader.parse();
+	ASSERT_TRUE(bool(file));
+	ASSERT_EQ(2, file->objective.size());
+	EXPECT_EQ(mpz_class(-2), file->objective[1].first);
+	ASSERT_EQ(3, file->constraints.size());
+	EXPECT_EQ(Relation::GEQ, std::get<1>(file->constraints[0]));
+	EXPECT_EQ(Relation::EQ, std::get<1>(file->constraints[1]));
+	// Variables are identified by their names.
+	EXPECT_EQ(file->objective[0].second, std::get<0>(file->constraints[1])[0].second);
+	EXPECT_EQ(mpz_class("100000000000000000000"), std::get<0>(file->constraints[2])[0].first);
+	EXPECT_EQ(mpz_class("100000000000000000001"), std::get<2>(file->constraints[2]));
+}
+
+TEST(OPBParser, ReaderErrors)
+{
+	std::string missingRhs = "+1 x1 +1 x2 >= ;\n";
+	EXPECT_FALSE(bool(OPBReader(missingRhs.data(), missingRhs.data() + missingRhs.size()).parse()));
+	std::string missingSemicolon = "+1 x1 +1 x2 >= 1\n+1 x1 >= 1 ;\n";
+	EXPECT_FALSE(bool(OPBReader(missingSemicolon.data(), missingSemicolon.data() + missingSemicolon.size()).parse()));
+	EXPECT_FALSE(bool(OPBReader("does-not-exist.opb").parse()));
+}
+
+TEST(OPBParser, ReaderDatabase)
+{
+	OPBReader reader(example.data(), example.data() + example.size());
+	PBDatabase db;
+	OPBPolynomial objective;
+	ASSERT_TRUE(reader.parse(db, objective));
+	EXPECT_EQ(2, objective.size());
+	// The equality is split into two constraints.
+	EXPECT_EQ(4, db.size());
+	EXPECT_TRUE(db.consistent());
+	// The last constraint implies x3 and x1, and then x2 by the equality.
+	EXPECT_EQ(3, db.trail().size());
+	for (auto l: db.trail()) EXPECT_TRUE(l > 0);
+}
+
+TEST(OPBParser, Importer)
+{
+	std::string filename = "Test_OPBParser_Importer.opb";
+	{
+		std::ofstream out(filename);
+		out << example;
+	}
+	OPBImporter<Poly> importer(filename);
+	auto res = importer.parse();
+	std::remove(filename.c_str());
+	ASSERT_TRUE(bool(res));
+	EXPECT_EQ(FormulaType::AND, res->first.getType());
+	EXPECT_EQ(3, res->first.size());
+	EXPECT_EQ(2, res->second.nrTerms());
+}
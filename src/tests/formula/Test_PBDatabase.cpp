@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+
+#include <carl/core/MultivariatePolynomial.h>
+#include <carl/core/VariablePool.h>
+#include <carl/formula/pseudoboolean/PBDatabase.h>
+#include <carl/numbers/numbers.h>
+
+using namespace carl;
+
+class PBDatabaseTest: public testing::Test {
+protected:
+	PBDatabase db;
+	PBDatabase::Literal x, y, z, u;
+
+	PBDatabaseTest() {
+		x = db.literal(freshBooleanVariable("x"));
+		y = db.literal(freshBooleanVariable("y"));
+		z = db.literal(freshBooleanVariable("z"));
+		u = db.literal(freshBooleanVariable("u"));
+	}
+
+	std::vector<PBDatabase::Term> terms(std::initializer_list<std::pair<int,PBDatabase::Literal>> _terms) {
+		std::vector<PBDatabase::Term> res;
+		for (const auto& t: _terms) res.emplace_back(t.first, t.second);
+		return res;
+	}
+};
+
+TEST_F(PBDatabaseTest, Normalization)
+{
+	std::vector<PBDatabase::Term> normalized;
+	// 3x - 2y + 5z + 4u >= 4  ->  5z + 4u + 3x + 2~y >= 6
+	ASSERT_TRUE(db.add(terms({{3, x}, {-2, y}, {5, z}, {4, u}}), Relation::GEQ, 4));
+	EXPECT_EQ(mpz_class(6), db.constraint(0, normalized));
+	EXPECT_EQ(terms({{5, z}, {4, u}, {3, x}, {2, -y}}), normalized);
+	EXPECT_TRUE(db.isNative(0));
+	EXPECT_FALSE(db.isCardinality(0));
+	// 4x + 6y + 2z + 2u >= 7  ->  3y + 2x + z + u >= 4
+	ASSERT_TRUE(db.add(terms({{4, x}, {6, y}, {2, z}, {2, u}}), Relation::GEQ, 7));
+	EXPECT_EQ(mpz_class(4), db.constraint(1, normalized));
+	EXPECT_EQ(terms({{3, y}, {2, x}, {1, z}, {1, u}}), normalized);
+	// x + y <= 1  ->  ~x + ~y >= 1
+	ASSERT_TRUE(db.add(terms({{1, x}, {1, y}}), Relation::LEQ, 1));
+	EXPECT_EQ(mpz_class(1), db.constraint(2, normalized));
+	EXPECT_EQ(terms({{1, -y}, {1, -x}}), normalized);
+	EXPECT_TRUE(db.isCardinality(2));
+	// 2x + 3~x + 2y >= 3  ->  ~x + 2y >= 1  ->  ~x + y >= 1
+	ASSERT_TRUE(db.add(terms({{2, x}, {3, -x}, {2, y}}), Relation::GEQ, 3));
+	EXPECT_EQ(mpz_class(1), db.constraint(3, normalized));
+	EXPECT_EQ(terms({{1, -x}, {1, y}}), normalized);
+	// Trivially satisfied constraints are not stored.
+	ASSERT_TRUE(db.add(terms({{1, x}, {-1, y}}), Relation::GEQ, -1));
+	EXPECT_EQ(4, db.size());
+	EXPECT_EQ(0, db.trail().size());
+}
+
+TEST_F(PBDatabaseTest, Cardinality)
+{
+	ASSERT_TRUE(db.add(terms({{1, x}, {1, y}, {1, z}, {1, u}}), Relation::GEQ, 3));
+	ASSERT_TRUE(db.isCardinality(0));
+	EXPECT_TRUE(db.assign(y));
+	EXPECT_EQ(1, db.trail().size());
+	EXPECT_TRUE(db.assign(-x));
+	EXPECT_TRUE(db.isTrue(z));
+	EXPECT_TRUE(db.isTrue(u));
+	EXPECT_EQ(0, db.reason(z));
+	EXPECT_EQ(PBDatabase::NONE, db.reason(x));
+	db.backtrack(1);
+	EXPECT_FALSE(db.isAssigned(x));
+	EXPECT_FALSE(db.isAssigned(z));
+	EXPECT_TRUE(db.isTrue(y));
+	EXPECT_TRUE(db.assign(-z));
+	EXPECT_TRUE(db.isTrue(x));
+	EXPECT_TRUE(db.isTrue(u));
+	db.backtrack(0);
+	EXPECT_EQ(0, db.trail().size());
+}
+
+TEST_F(PBDatabaseTest, Counters)
+{
+	// 3x + 2y + z >= 3 has slack 3
+	ASSERT_TRUE(db.add(terms({{3, x}, {2, y}, {1, z}}), Relation::GEQ, 3));
+	ASSERT_TRUE(db.isNative(0));
+	EXPECT_TRUE(db.assign(-x));
+	EXPECT_TRUE(db.isTrue(y));
+	EXPECT_TRUE(db.isTrue(z));
+	db.backtrack(0);
+	EXPECT_TRUE(db.assign(-y));
+	EXPECT_TRUE(db.isTrue(x));
+	EXPECT_FALSE(db.isAssigned(z));
+	EXPECT_TRUE(db.assign(-z));
+	db.backtrack(0);
+	// The slack is restored completely.
+	EXPECT_TRUE(db.assign(-z));
+	EXPECT_TRUE(db.isTrue(x));
+	EXPECT_FALSE(db.isAssigned(y));
+}
+
+TEST_F(PBDatabaseTest, Conflict)
+{
+	ASSERT_TRUE(db.add(terms({{1, x}, {1, y}}), Relation::GEQ, 1));
+	ASSERT_TRUE(db.add(terms({{2, x}, {1, z}, {1, u}}), Relation::GEQ, 2));
+	ASSERT_TRUE(db.add(terms({{1, y}, {1, z}}), Relation::LEQ, 1));
+	EXPECT_FALSE(db.assign(-x));
+	EXPECT_FALSE(db.consistent());
+	EXPECT_NE(PBDatabase::NONE, db.conflict());
+	db.backtrack(0);
+	EXPECT_TRUE(db.consistent());
+	EXPECT_TRUE(db.assign(x));
+	EXPECT_TRUE(db.assign(y));
+	EXPECT_TRUE(db.isFalse(z));
+	EXPECT_FALSE(db.isAssigned(u));
+}
+
+TEST_F(PBDatabaseTest, BigCoefficients)
+{
+	mpz_class big("1000000000000000000000000000000");
+	std::vector<PBDatabase::Term> lhs;
+	lhs.emplace_back(big, x);
+	lhs.emplace_back(big, y);
+	lhs.emplace_back(1, z);
+	ASSERT_TRUE(db.add(lhs, Relation::GEQ, big + 1));
+	EXPECT_FALSE(db.isNative(0));
+	EXPECT_TRUE(db.assign(-x));
+	EXPECT_TRUE(db.isTrue(y));
+	EXPECT_TRUE(db.isTrue(z));
+	db.backtrack(0);
+	EXPECT_TRUE(db.assign(-z));
+	EXPECT_TRUE(db.isTrue(x));
+	EXPECT_TRUE(db.isTrue(y));
+}
+
+TEST_F(PBDatabaseTest, Equality)
+{
+	ASSERT_TRUE(db.add(terms({{1, x}, {1, y}, {1, z}}), Relation::EQ, 1));
+	EXPECT_EQ(2, db.size());
+	EXPECT_TRUE(db.assign(y));
+	EXPECT_TRUE(db.isFalse(x));
+	EXPECT_TRUE(db.isFalse(z));
+	db.backtrack(0);
+	// Unsatisfiable on the lowest level.
+	EXPECT_FALSE(db.add(terms({{2, x}, {2, u}}), Relation::EQ, 3));
+	EXPECT_FALSE(db.consistent());
+}
+
+TEST_F(PBDatabaseTest, PBConstraint)
+{
+	using Poly = MultivariatePolynomial<mpq_class>;
+	Variable a = freshBooleanVariable("a");
+	Variable b = freshBooleanVariable("b");
+	std::vector<std::pair<mpq_class,Variable>> lhs({{2, a}, {2, b}});
+	ASSERT_TRUE(db.add(PBConstraint<Poly>(lhs, Relation::GREATER, 2)));
+	// 2a + 2b > 2  ->  a + b >= 2
+	EXPECT_TRUE(db.isTrue(db.literal(a)));
+	EXPECT_TRUE(db.isTrue(db.literal(b)));
+	EXPECT_EQ(db.variable(db.literal(a)), a);
+}
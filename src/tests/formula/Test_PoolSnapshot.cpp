@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+
+#include <carl/core/MultivariatePolynomial.h>
+#include <carl/io/PoolSnapshot.h>
+
+#include "../Common.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+TEST(PoolSnapshot, Restore)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshIntegerVariable("y");
+	Variable anonymous = freshRealVariable();
+	Constraint<Pol> c1(Pol(x)*x - y, Relation::LESS);
+	Constraint<Pol> c2(Pol(x)*anonymous + Rational(3)/Rational(2), Relation::EQ);
+	Monomial::Arg m = createMonomial(y, 4);
+
+	std::string data = PoolSnapshot<Pol>::serialize();
+	PoolSnapshot<Pol> snapshot;
+	ASSERT_TRUE(snapshot.restore(data.data(), data.data() + data.size()));
+	// All objects are found in the pools, hence the ids do not change.
+	EXPECT_EQ(MonomialPool::getInstance().monomials().size(), snapshot.monomials().size());
+	EXPECT_EQ(ConstraintPool<Pol>::getInstance().size(), snapshot.constraints().size());
+	EXPECT_NE(snapshot.monomials().end(), std::find(snapshot.monomials().begin(), snapshot.monomials().end(), m));
+	EXPECT_NE(snapshot.constraints().end(), std::find(snapshot.constraints().begin(), snapshot.constraints().end(), c1));
+	EXPECT_NE(snapshot.constraints().end(), std::find(snapshot.constraints().begin(), snapshot.constraints().end(), c2));
+	for (std::size_t i = 1; i < snapshot.constraints().size(); i++) {
+		EXPECT_LT(snapshot.constraints()[i - 1].id(), snapshot.constraints()[i].id());
+	}
+	EXPECT_EQ("x", x.getName());
+	EXPECT_EQ(data, PoolSnapshot<Pol>::serialize());
+}
+
+TEST(PoolSnapshot, FreedIds)
+{
+	Variable x = freshRealVariable("gap");
+	Pol p1 = Pol(x)*x*x - Rational(5);
+	Pol p3 = Pol(x)*x*x*x - Rational(7);
+	std::string data;
+	std::size_t id3;
+	{
+		Constraint<Pol> c1(p1, Relation::LEQ);
+		{
+			// Frees an id between c1 and c3.
+			Constraint<Pol> c2(Pol(x)*x*x + Rational(6), Relation::GREATER);
+		}
+		Constraint<Pol> c3(p3, Relation::NEQ);
+		id3 = c3.id();
+		data = PoolSnapshot<Pol>::serialize();
+	}
+	// The constraints are freed, hence loading the snapshot creates them again.
+	PoolSnapshot<Pol> snapshot;
+	ASSERT_TRUE(snapshot.restore(data.data(), data.data() + data.size()));
+	Constraint<Pol> c1(p1, Relation::LEQ);
+	Constraint<Pol> c3(p3, Relation::NEQ);
+	EXPECT_NE(snapshot.constraints().end(), std::find(snapshot.constraints().begin(), snapshot.constraints().end(), c1));
+	EXPECT_NE(snapshot.constraints().end(), std::find(snapshot.constraints().begin(), snapshot.constraints().end(), c3));
+	EXPECT_LT(c1.id(), c3.id());
+	EXPECT_NE(id3, c3.id());
+}
+
+TEST(PoolSnapshot, File)
+{
+	Variable x = freshRealVariable("x");
+	Constraint<Pol> c(Pol(x) + Rational(1), Relation::GEQ);
+	std::string filename = "pool_snapshot.bin";
+	ASSERT_TRUE(PoolSnapshot<Pol>::write(filename));
+	PoolSnapshot<Pol> snapshot;
+	EXPECT_TRUE(snapshot.load(filename));
+	EXPECT_NE(snapshot.constraints().end(), std::find(snapshot.constraints().begin(), snapshot.constraints().end(), c));
+	std::remove(filename.c_str());
+	EXPECT_FALSE(snapshot.load(filename));
+}
+
+TEST(PoolSnapshot, Errors)
+{
+	Variable x = freshRealVariable("x");
+	Constraint<Pol> c(Pol(x)*x - Rational(2), Relation::NEQ);
+	std::string data = PoolSnapshot<Pol>::serialize();
+	PoolSnapshot<Pol> snapshot;
+	EXPECT_FALSE(snapshot.restore(data.data() + 1, data.data() + data.size()));
+	EXPECT_FALSE(snapshot.restore(data.data(), data.data() + data.size() - 1));
+	// A snapshot that names x differently does not fit the current pool.
+	std::string renamed = data;
+	std::size_t pos = renamed.find(std::string("\x01x", 2));
+	ASSERT_NE(std::string::npos, pos);
+	renamed[pos + 1] = 'z';
+	EXPECT_FALSE(snapshot.restore(renamed.data(), renamed.data() + renamed.size()));
+	EXPECT_TRUE(snapshot.constraints().empty());
+}
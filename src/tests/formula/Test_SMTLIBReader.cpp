@@ -0,0 +1,192 @@
+#include "gtest/gtest.h"
+
+#include <carl/core/MultivariatePolynomial.h>
+#include <carl/formula/parser/SMTLIBReader.h>
+
+#include "../Common.h"
+
+#include <sstream>
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef Formula<Pol> FormulaT;
+
+namespace {
+	boost::optional<FormulaT> parse(const std::string& input) {
+		SMTLIBReader<Pol> reader(input.data(), input.data() + input.size());
+		return reader.parse();
+	}
+
+	Variable variable(const FormulaT& f, const std::string& name) {
+		Variables vars;
+		f.collectVariables(vars, true, true, true, true, true);
+		for (Variable v: vars) {
+			if (v.getName() == name) return v;
+		}
+		return Variable::NO_VARIABLE;
+	}
+
+	/// Records the commands passed on by the reader.
+	struct Recorder {
+		std::vector<std::string> commands;
+		void add(Formulas<Pol>&& batch) {
+			commands.push_back("assert " + std::to_string(batch.size()));
+		}
+		void push(std::size_t n) {
+			commands.push_back("push " + std::to_string(n));
+		}
+		void pop(std::size_t n) {
+			commands.push_back("pop " + std::to_string(n));
+		}
+		void checkSat() {
+			commands.push_back("check-sat");
+		}
+	};
+}
+
+TEST(SMTLIBReader, Arithmetic)
+{
+	auto f = parse(
+		"(set-logic QF_NRA)\n"
+		"(set-info :source |multi\nline|)\n"
+		"(declare-fun x () Real)\n"
+		"(declare-const y Real)\n"
+		"; a comment\n"
+		"(assert (< (* x x) (+ y 1.5)))\n"
+		"(assert (let ((z (- x y))) (and (>= z 0) (distinct z (/ 4 2)))))\n"
+		"(check-sat)\n"
+		"(exit)\n"
+	);
+	ASSERT_TRUE(bool(f));
+	Variable x = variable(*f, "x");
+	Variable y = variable(*f, "y");
+	ASSERT_NE(Variable::NO_VARIABLE, x);
+	ASSERT_NE(Variable::NO_VARIABLE, y);
+	Pol z = Pol(x) - y;
+	FormulaT expected(AND, {
+		FormulaT(Pol(x)*x - y - Rational(3)/Rational(2), Relation::LESS),
+		FormulaT(z, Relation::GEQ),
+		FormulaT(z - Rational(2), Relation::NEQ)
+	});
+	EXPECT_EQ(expected, *f);
+
+	// Negative literals as written by SMTLIBStream.
+	f = parse("(declare-fun x () Real) (assert (<= (+ (* -3 (* x x)) -0.5) 0))");
+	ASSERT_TRUE(bool(f));
+	x = variable(*f, "x");
+	EXPECT_EQ(FormulaT(Rational(-3)*x*x - Rational(1)/Rational(2), Relation::LEQ), *f);
+}
+
+TEST(SMTLIBReader, Let)
+{
+	// Deeply nested lets are neither expanded nor read recursively.
+	std::stringstream ss;
+	ss << "(declare-fun p () Bool) (declare-fun q () Bool)\n(assert ";
+	std::size_t depth = 50000;
+	ss << "(let ((a0 p)) ";
+	for (std::size_t i = 1; i <= depth; i++) ss << "(let ((a" << i << " (and a" << (i - 1) << " q))) ";
+	ss << "(! (or a" << depth << " (not a0)) :named phi)";
+	for (std::size_t i = 0; i <= depth; i++) ss << ")";
+	ss << ")\n(assert (xor phi p))";
+	auto f = parse(ss.str());
+	ASSERT_TRUE(bool(f));
+	FormulaT p(variable(*f, "p"));
+	FormulaT q(variable(*f, "q"));
+	FormulaT phi(OR, {FormulaT(AND, {p, q}), FormulaT(NOT, p)});
+	EXPECT_EQ(FormulaT(AND, {phi, FormulaT(XOR, {phi, p})}), *f);
+
+	// Bindings of a single let are parallel and shadow outer ones.
+	f = parse("(declare-fun p () Bool) (declare-fun q () Bool) (assert (let ((p q) (q p)) (=> p (not q))))");
+	ASSERT_TRUE(bool(f));
+	p = FormulaT(variable(*f, "p"));
+	q = FormulaT(variable(*f, "q"));
+	EXPECT_EQ(FormulaT(IMPLIES, {q, FormulaT(NOT, p)}), *f);
+}
+
+TEST(SMTLIBReader, Commands)
+{
+	std::string input =
+		"(declare-fun x () Int)\n"
+		"(assert (> x 0)) (assert (< x 10))\n"
+		"(push 1)\n"
+		"(declare-fun y () Int)\n"
+		"(assert (= x y))\n"
+		"(check-sat)\n"
+		"(pop 1)\n"
+		"(get-model)\n"
+		"(assert (= x 5))\n"
+		"(check-sat)\n";
+	SMTLIBReader<Pol> reader(input.data(), input.data() + input.size());
+	Recorder recorder;
+	ASSERT_TRUE(reader.read(recorder));
+	std::vector<std::string> expected({"assert 2", "push 1", "assert 1", "check-sat", "pop 1", "assert 1", "check-sat"});
+	EXPECT_EQ(expected, recorder.commands);
+
+	auto f = parse(input);
+	ASSERT_TRUE(bool(f));
+	EXPECT_EQ(AND, f->getType());
+	EXPECT_EQ(3, f->size());
+
+	// Declarations are removed by pop.
+	EXPECT_FALSE(bool(parse("(push 1) (declare-fun y () Int) (pop 1) (assert (= y 0))")));
+}
+
+TEST(SMTLIBReader, Bitvectors)
+{
+	auto f = parse(
+		"(set-logic QF_BV)\n"
+		"(declare-fun a () (_ BitVec 8))\n"
+		"(assert (bvult (bvadd a #x01) (concat ((_ extract 3 0) a) #b0000)))\n"
+		"(assert (= ((_ zero_extend 8) a) (_ bv300 16)))\n"
+	);
+	ASSERT_TRUE(bool(f));
+	Sort sort = getSort("BitVec", std::vector<std::size_t>({8}));
+	BVTerm a(BVTermType::VARIABLE, BVVariable(variable(*f, "a"), sort));
+	BVTerm one(BVTermType::CONSTANT, BVValue(8, 1u));
+	BVTerm zeros(BVTermType::CONSTANT, BVValue(std::string("0000")));
+	BVTerm low(BVTermType::EXTRACT, a, 3, 0);
+	FormulaT lt(BVConstraint::create(BVCompareRelation::ULT, BVTerm(BVTermType::ADD, a, one), BVTerm(BVTermType::CONCAT, low, zeros)));
+	FormulaT eq(BVConstraint::create(BVCompareRelation::EQ, BVTerm(BVTermType::EXT_U, a, 8), BVTerm(BVTermType::CONSTANT, BVValue(16, 300u))));
+	EXPECT_EQ(FormulaT(AND, {lt, eq}), *f);
+
+	EXPECT_FALSE(bool(parse("(declare-fun a () (_ BitVec 8)) (declare-fun b () (_ BitVec 4)) (assert (bvule a b))")));
+}
+
+TEST(SMTLIBReader, Uninterpreted)
+{
+	auto f = parse(
+		"(set-logic QF_UF)\n"
+		"(declare-sort S 0)\n"
+		"(declare-fun f (S) S)\n"
+		"(declare-fun x () S)\n"
+		"(declare-fun y () S)\n"
+		"(assert (= (f (f x)) x))\n"
+		"(assert (distinct (f (f x)) (f y) y))\n"
+	);
+	ASSERT_TRUE(bool(f));
+	// f(x) is replaced by a fresh variable once, defined by an equality, and five (dis)equalities are asserted.
+	ASSERT_EQ(AND, f->getType());
+	EXPECT_EQ(5, f->size());
+	std::size_t negated = 0;
+	for (const auto& sub: *f) {
+		ASSERT_EQ(UEQ, sub.getType());
+		if (sub.uequality().negated()) negated++;
+	}
+	EXPECT_EQ(3, negated);
+
+	EXPECT_FALSE(bool(parse("(declare-sort S 0) (declare-fun f (S) S) (assert (= (f 1) (f 2)))")));
+}
+
+TEST(SMTLIBReader, Errors)
+{
+	EXPECT_FALSE(bool(parse("(assert x)")));
+	EXPECT_FALSE(bool(parse("(declare-fun x () Real) (assert (and x true))")));
+	EXPECT_FALSE(bool(parse("(declare-fun x () Real) (assert (< x 1)")));
+	EXPECT_FALSE(bool(parse("(declare-fun x () Real) (declare-fun x () Real)")));
+	EXPECT_FALSE(bool(parse("(declare-fun x () Real) (assert (< (ite true x 1) 1))")));
+	EXPECT_FALSE(bool(parse("(assert (forall ((x Real)) (< x 1)))")));
+	auto f = parse("(set-option :produce-models true) (check-sat)");
+	ASSERT_TRUE(bool(f));
+	EXPECT_TRUE(f->isTrue());
+}
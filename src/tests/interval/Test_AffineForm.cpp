@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+
+#include "carl/interval/AffineForm.h"
+
+#include <cmath>
+
+using namespace carl;
+
+TEST(AffineForm, Construction)
+{
+	AffineForm c(3.0);
+	EXPECT_EQ(3.0, c.center());
+	EXPECT_TRUE(c.terms().empty());
+	EXPECT_TRUE(c.interval().contains(3.0));
+
+	AffineForm x(Interval<double>(1, 3), 0);
+	EXPECT_EQ(2.0, x.center());
+	ASSERT_EQ(1, x.terms().size());
+	EXPECT_TRUE(x.interval().contains(Interval<double>(1, 3)));
+	EXPECT_LT(x.interval().diameter(), 2.001);
+
+	AffineForm e(Interval<double>(1, 3));
+	EXPECT_TRUE(e.terms().empty());
+	EXPECT_TRUE(e.interval().contains(Interval<double>(1, 3)));
+}
+
+TEST(AffineForm, Dependencies)
+{
+	AffineForm x(Interval<double>(1, 3), 0);
+	AffineForm y(Interval<double>(-1, 1), 1);
+	AffineForm zero = x - x;
+	EXPECT_TRUE(zero.terms().empty());
+	EXPECT_LT(zero.interval().diameter(), 1e-10);
+	// Interval arithmetic yields [-1,5] for x + y - x.
+	Interval<double> sum = (x + y - x).interval();
+	EXPECT_TRUE(sum.contains(Interval<double>(-1, 1)));
+	EXPECT_LT(sum.diameter(), 2.001);
+	// x * (y - x) encloses the exact range [-12, 0].
+	Interval<double> prod = (x * (y - x)).interval();
+	EXPECT_TRUE(prod.contains(Interval<double>(-12, 0)));
+	EXPECT_TRUE(x.pow(2).interval().contains(Interval<double>(1, 9)));
+}
+
+TEST(AffineForm, Rounding)
+{
+	AffineForm x(Interval<double>(0.1, 0.3), 0);
+	AffineForm sum(0.0);
+	for (int i = 0; i < 10; i++) sum = sum + x * 0.1;
+	// The exact range is [0.1, 0.3].
+	EXPECT_TRUE(sum.interval().contains(Interval<double>(0.1, 0.3)));
+	EXPECT_GT(sum.error(), 0);
+}
+
+TEST(AffineForm, Condense)
+{
+	AffineForm sum(0.0);
+	for (std::size_t i = 0; i < 10; i++) {
+		sum = sum + AffineForm(Interval<double>(0.0, double(i + 1)), i);
+	}
+	Interval<double> before = sum.interval();
+	sum.condense(3);
+	EXPECT_EQ(3, sum.terms().size());
+	EXPECT_EQ(9, sum.terms().back().first);
+	// Condensing loses no precision for independent symbols, the exact range is [0, 55].
+	EXPECT_TRUE(sum.interval().contains(Interval<double>(0.0, 55.0)));
+	EXPECT_LT(sum.interval().diameter(), before.diameter() * 1.001);
+}
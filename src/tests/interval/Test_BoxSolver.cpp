@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/VariablePool.h"
+#include "carl/formula/Constraint.h"
+#include "carl/interval/BoxSolver.h"
+
+#include "../Common.h"
+
+#include <cmath>
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef Constraint<Pol> ConstraintT;
+
+TEST(BoxSolver, Satisfiable)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	for (auto heuristic: {BoxSplitHeuristic::LARGEST_WIDTH, BoxSplitHeuristic::SMEAR}) {
+		for (std::size_t threads: {1, 4}) {
+			BoxSolverSettings settings;
+			settings.heuristic = heuristic;
+			settings.threads = threads;
+			settings.minWidth = 1e-2;
+			BoxSolver<Pol> solver(settings);
+			std::vector<ConstraintT> constraints({
+				ConstraintT(Pol(x)*x + Pol(y)*y - Rational(1), Relation::LESS),
+				ConstraintT(Pol(x) + Pol(y) - Rational(1), Relation::GREATER)
+			});
+			for (const auto& c: constraints) solver.addConstraint(c);
+			BoxSolver<Pol>::Box box;
+			box[x] = Interval<double>(-10, 10);
+			auto res = solver.solve(box);
+			ASSERT_EQ(BoxSolverStatus::SAT, res.status);
+			EXPECT_FALSE(res.inner.empty());
+			for (const auto& c: constraints) {
+				EXPECT_EQ(1, c.satisfiedBy(res.point));
+			}
+		}
+	}
+}
+
+TEST(BoxSolver, Boundary)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	for (std::size_t threads: {1, 4}) {
+		BoxSolverSettings settings;
+		settings.threads = threads;
+		settings.minWidth = 1e-4;
+		BoxSolver<Pol> solver(settings);
+		solver.addConstraint(ConstraintT(Pol(x)*x + Pol(y)*y - Rational(1), Relation::EQ));
+		solver.addConstraint(ConstraintT(Pol(x) - y, Relation::EQ));
+		BoxSolver<Pol>::Box box;
+		box[x] = Interval<double>(-10, 10);
+		box[y] = Interval<double>(-10, 10);
+		auto res = solver.solve(box);
+		// The solutions are irrational, hence they are only enclosed by boundary boxes.
+		EXPECT_EQ(BoxSolverStatus::UNKNOWN, res.status);
+		EXPECT_TRUE(res.inner.empty());
+		ASSERT_FALSE(res.boundary.empty());
+		bool positive = false;
+		bool negative = false;
+		for (const auto& b: res.boundary) {
+			EXPECT_LE(b.at(x).diameter(), 1e-4);
+			positive = positive || (b.at(x).contains(std::sqrt(0.5)) && b.at(y).contains(std::sqrt(0.5)));
+			negative = negative || (b.at(x).contains(-std::sqrt(0.5)) && b.at(y).contains(-std::sqrt(0.5)));
+		}
+		EXPECT_TRUE(positive);
+		EXPECT_TRUE(negative);
+	}
+}
+
+TEST(BoxSolver, Unsatisfiable)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	for (std::size_t threads: {1, 4}) {
+		BoxSolverSettings settings;
+		settings.threads = threads;
+		settings.heuristic = BoxSplitHeuristic::SMEAR;
+		BoxSolver<Pol> solver(settings);
+		// x*y <= 1/2 on the unit disk.
+		solver.addConstraint(ConstraintT(Pol(x)*x + Pol(y)*y - Rational(1), Relation::LEQ));
+		solver.addConstraint(ConstraintT(Pol(x)*y - Rational(3)/Rational(5), Relation::GEQ));
+		auto res = solver.solve(BoxSolver<Pol>::Box());
+		EXPECT_EQ(BoxSolverStatus::UNSAT, res.status);
+		EXPECT_TRUE(res.inner.empty());
+		EXPECT_TRUE(res.boundary.empty());
+		EXPECT_GT(res.boxes, 1);
+	}
+}
+
+TEST(BoxSolver, Integer)
+{
+	Variable x = freshIntegerVariable("x");
+	Variable y = freshRealVariable("y");
+	BoxSolverSettings settings;
+	settings.stopAtInnerBox = true;
+	BoxSolver<Pol> solver(settings);
+	solver.addConstraint(ConstraintT(Pol(x)*x - Rational(4), Relation::EQ));
+	solver.addConstraint(ConstraintT(Pol(y) - x, Relation::GREATER));
+	solver.addConstraint(ConstraintT(Pol(y) - Rational(3), Relation::LESS));
+	BoxSolver<Pol>::Box box;
+	box[x] = Interval<double>(-10, 10);
+	auto res = solver.solve(box);
+	ASSERT_EQ(BoxSolverStatus::SAT, res.status);
+	EXPECT_EQ(Rational(4), res.point.at(x) * res.point.at(x));
+}
+
+TEST(BoxSolver, Limit)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	BoxSolverSettings settings;
+	settings.maxBoxes = 10;
+	settings.minWidth = 1e-8;
+	BoxSolver<Pol> solver(settings);
+	solver.addConstraint(ConstraintT(Pol(x)*x + Pol(y)*y - Rational(1), Relation::EQ));
+	BoxSolver<Pol>::Box box;
+	box[x] = Interval<double>(-2, 2);
+	box[y] = Interval<double>(-2, 2);
+	auto res = solver.solve(box);
+	// Boxes beyond the limit are not refuted.
+	EXPECT_EQ(10, res.boxes);
+	EXPECT_FALSE(res.boundary.empty());
+	EXPECT_NE(BoxSolverStatus::UNSAT, res.status);
+}
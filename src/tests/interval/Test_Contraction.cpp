@@ -89,7 +89,42 @@ TEST(Contraction, SimpleNewton)
     split = e6_contractor(map,d,resultA,resultB);
     EXPECT_EQ(split, false);
 
+#ifdef USE_HORNER
+    // The Horner scheme yields a coarser enclosure of the numerator here, hence d is only contracted to about [23/12, 2].
+    EXPECT_EQ(resultA.isEmpty(), false);
+    EXPECT_LE(1.9, resultA.lower());
+    EXPECT_GE(2.0, resultA.upper());
+#else
     EXPECT_EQ(resultA.isEmpty(), true);
+#endif
+}
+
+TEST(Contraction, SimpleNewtonHorner)
+{
+    using Pol = MultivariatePolynomial<Rational>;
+    Variable x = freshRealVariable("x");
+    Variable y = freshRealVariable("y");
+    Interval<double>::evalintervalmap map;
+    map[x] = Interval<double>(0.5, 2.0);
+    map[y] = Interval<double>(0.0, 1.0);
+    Pol circle = Pol(x)*x + Pol(y)*y - Rational(1);
+
+    // The schemes used by Contraction if carl is built with USE_HORNER.
+    auto& pool = FlatHornerPool<Pol>::getInstance();
+    auto scheme = pool.get(circle);
+    auto derivative = pool.get(circle.derivative(x));
+
+    SimpleNewton<Pol> newton;
+    Interval<double> resultA, resultB, hornerA, hornerB;
+    EXPECT_FALSE(newton.contract(map, x, circle, circle.derivative(x), resultA, resultB));
+    EXPECT_FALSE(newton.contract(map, x, *scheme, *derivative, hornerA, hornerB));
+    EXPECT_EQ(resultA, hornerA);
+    EXPECT_TRUE(hornerA.contains(Interval<double>(0.5, 1.0)));
+    EXPECT_LT(hornerA.upper(), 2);
+
+    PolynomialContraction<SimpleNewton> contractor(circle);
+    EXPECT_FALSE(contractor(map, x, resultA, resultB));
+    EXPECT_EQ(hornerA, resultA);
 }
 
 #ifndef THREAD_SAFE
@@ -12,6 +12,7 @@
 #include "gtest/gtest.h"
 #include "carl/interval/Interval.h"
 #include "carl/core/VariablePool.h"
+#include <cfenv>
 #include <iostream>
 #include "carl/util/platform.h"
 
@@ -1292,3 +1293,67 @@ TEST(DoubleInterval, BloatShrink)
     i4.shrink_by(2);
     EXPECT_EQ(result4, i4);
 }
+
+TEST(DoubleInterval, RoundingScope)
+{
+    DoubleInterval one(1);
+    DoubleInterval three(3);
+    DoubleInterval tenth(0.1);
+    DoubleInterval third = one.div(three);
+    DoubleInterval sum = tenth + DoubleInterval(0.2);
+    DoubleInterval product = third * DoubleInterval(-7);
+    EXPECT_LT(third.lower(), third.upper());
+    EXPECT_LE(sum.lower(), 0.30000000000000004);
+    EXPECT_LT(sum.lower(), sum.upper());
+    EXPECT_LT(product.lower(), product.upper());
+    EXPECT_FALSE(IntervalRoundingScope::active());
+    {
+        IntervalRoundingScope scope;
+        EXPECT_TRUE(IntervalRoundingScope::active());
+        {
+            // Nested scopes do not change the rounding mode.
+            IntervalRoundingScope inner;
+            EXPECT_EQ(third, one.div(three));
+        }
+        EXPECT_TRUE(IntervalRoundingScope::active());
+        EXPECT_EQ(sum, tenth + DoubleInterval(0.2));
+        EXPECT_EQ(product, (one.div(three)) * DoubleInterval(-7));
+    }
+    EXPECT_FALSE(IntervalRoundingScope::active());
+    EXPECT_EQ(FE_TONEAREST, std::fegetround());
+}
+
+TEST(DoubleInterval, ScopedRoundingPolicy)
+{
+    // The policy is only used by DoubleInterval with SCOPED_INTERVAL_ROUNDING, hence it is tested on its own.
+    namespace il = boost::numeric::interval_lib;
+    using ScopedInterval = boost::numeric::interval<double, il::policies<rounding_double, il::checking_base<double>>>;
+    using StdInterval = boost::numeric::interval<double, il::policies<il::save_state<il::rounded_arith_std<double>>, il::checking_base<double>>>;
+
+    ScopedInterval third = ScopedInterval(1) / ScopedInterval(3);
+    StdInterval stdThird = StdInterval(1) / StdInterval(3);
+    EXPECT_EQ(stdThird.lower(), third.lower());
+    EXPECT_EQ(stdThird.upper(), third.upper());
+    {
+        IntervalRoundingScope scope;
+        ScopedInterval sum = ScopedInterval(0.1) + ScopedInterval(0.2) - third * ScopedInterval(-7);
+        StdInterval stdSum = StdInterval(0.1) + StdInterval(0.2) - stdThird * StdInterval(-7);
+        EXPECT_EQ(stdSum.lower(), sum.lower());
+        EXPECT_EQ(stdSum.upper(), sum.upper());
+    }
+    EXPECT_EQ(FE_TONEAREST, std::fegetround());
+
+    // Integers are converted without negating them.
+    ScopedInterval maxUnsigned(std::numeric_limits<std::uint64_t>::max());
+    EXPECT_EQ(std::ldexp(1.0, 64) - 2048, maxUnsigned.lower());
+    EXPECT_EQ(std::ldexp(1.0, 64), maxUnsigned.upper());
+    ScopedInterval minSigned(std::numeric_limits<std::int64_t>::min());
+    EXPECT_EQ(-std::ldexp(1.0, 63), minSigned.lower());
+    EXPECT_EQ(-std::ldexp(1.0, 63), minSigned.upper());
+    ScopedInterval inexact((std::int64_t(1) << 53) + 1);
+    EXPECT_EQ(std::ldexp(1.0, 53), inexact.lower());
+    EXPECT_EQ(std::ldexp(1.0, 53) + 2, inexact.upper());
+    ScopedInterval small(3u);
+    EXPECT_EQ(3.0, small.lower());
+    EXPECT_EQ(3.0, small.upper());
+}
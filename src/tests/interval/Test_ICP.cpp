@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/VariablePool.h"
+#include "carl/interval/ICP.h"
+
+#include "../Common.h"
+
+#include <cmath>
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+TEST(ICP, Propagation)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	ICP<Pol> icp;
+	icp.addConstraint(Pol(x) - y - Rational(1), Relation::EQ);
+	icp.addConstraint(Pol(y) - z - Rational(1), Relation::EQ);
+	ICP<Pol>::Box box;
+	box[z] = Interval<double>(0, 1);
+	ASSERT_TRUE(icp.contract(box));
+	// Bounds are propagated along the chain to previously unbounded variables.
+	EXPECT_EQ(Interval<double>(1, 2), box[y]);
+	EXPECT_EQ(Interval<double>(2, 3), box[x]);
+}
+
+TEST(ICP, Circle)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	for (bool newton: {false, true}) {
+		ICPSettings settings;
+		settings.useNewton = newton;
+		settings.maxSplits = 1000;
+		settings.minWidth = 1e-4;
+		ICP<Pol> icp(settings);
+		icp.addConstraint(Pol(x)*x + Pol(y)*y - Rational(1), Relation::EQ);
+		icp.addConstraint(Pol(x) - y, Relation::EQ);
+		ICP<Pol>::Box box;
+		box[x] = Interval<double>(-10, 10);
+		box[y] = Interval<double>(0, 10);
+		// The box [0,1]^2 is a fixpoint of the contraction.
+		ASSERT_TRUE(icp.contract(box));
+		EXPECT_EQ(Interval<double>(0, 1), box[x]);
+		EXPECT_EQ(Interval<double>(0, 1), box[y]);
+		ASSERT_TRUE(icp.split(box));
+		EXPECT_TRUE(box[x].contains(std::sqrt(0.5)));
+		EXPECT_TRUE(box[y].contains(std::sqrt(0.5)));
+		EXPECT_LE(box[x].diameter(), 1e-4);
+		EXPECT_GT(icp.revisions(), 2);
+	}
+}
+
+TEST(ICP, Infeasible)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable i = freshIntegerVariable("i");
+	ICP<Pol> icp;
+	icp.addConstraint(Pol(x)*y - Rational(4), Relation::GEQ);
+	ICP<Pol>::Box box;
+	box[x] = Interval<double>(0, 1);
+	box[y] = Interval<double>(0, 1);
+	EXPECT_FALSE(icp.contract(box));
+
+	ICP<Pol> squares;
+	squares.addConstraint(Pol(x)*x + Rational(1), Relation::LEQ);
+	box.clear();
+	EXPECT_FALSE(squares.contract(box));
+
+	ICP<Pol> integers;
+	integers.addConstraint(Rational(2)*i - Rational(3), Relation::EQ);
+	box.clear();
+	EXPECT_FALSE(integers.contract(box));
+}
+
+TEST(ICP, Split)
+{
+	Variable x = freshRealVariable("x");
+	ICPSettings settings;
+	settings.maxSplits = 200;
+	settings.minWidth = 1e-6;
+	ICP<Pol> icp(settings);
+	icp.addConstraint(Pol(x)*x - Rational(2), Relation::EQ);
+	ICP<Pol>::Box box;
+	box[x] = Interval<double>(-10, 10);
+	// Contraction alone cannot separate the two roots.
+	ICP<Pol>::Box hull = box;
+	ASSERT_TRUE(icp.contract(hull));
+	EXPECT_TRUE(hull[x].contains(0.0));
+	ASSERT_TRUE(icp.split(box));
+	EXPECT_LE(box[x].diameter(), 1e-6);
+	EXPECT_TRUE(box[x].contains(std::sqrt(2.0)) || box[x].contains(-std::sqrt(2.0)));
+	EXPECT_GT(icp.splits(), 0);
+
+	ICP<Pol> disjoint(settings);
+	disjoint.addConstraint(Pol(x)*x - Rational(4), Relation::GEQ);
+	disjoint.addConstraint(Pol(x)*x*x - Rational(1), Relation::LEQ);
+	disjoint.addConstraint(Pol(x) + Rational(1), Relation::GEQ);
+	box.clear();
+	box[x] = Interval<double>(-10, 10);
+	EXPECT_FALSE(disjoint.split(box));
+}
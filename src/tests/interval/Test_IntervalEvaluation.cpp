@@ -69,3 +69,26 @@ TEST(IntervalEvaluation, Term)
 TEST(IntervalEvaluation, MultivariatePolynomial)
 {
 }
+
+TEST(IntervalEvaluation, Strategies)
+{
+    typedef MultivariatePolynomial<Rational> Pol;
+    Variable x = freshRealVariable("x");
+    Variable y = freshRealVariable("y");
+    std::map<Variable, Interval<double>> map;
+    map[x] = Interval<double>(1, 2);
+    map[y] = Interval<double>(1.0, 1.5);
+    // (x-y)^2 - 1/3 ranges over [-1/3, 1-1/3].
+    Pol p = Pol(x)*x - Rational(2)*x*y + Pol(y)*y - Rational(1)/Rational(3);
+    Interval<double> naive = IntervalEvaluation::evaluate(p, map, IntervalEvaluationStrategy::NAIVE);
+    EXPECT_EQ(IntervalEvaluation::evaluate(p, map), naive);
+    for (auto s: {IntervalEvaluationStrategy::AFFINE, IntervalEvaluationStrategy::MEAN_VALUE}) {
+        Interval<double> res = IntervalEvaluation::evaluate(p, map, s);
+        EXPECT_TRUE(res.contains(-1.0/3)) << res;
+        EXPECT_TRUE(res.contains(1 - 1.0/3)) << res;
+        EXPECT_LT(res.diameter(), naive.diameter()) << res;
+    }
+    map[y] = Interval<double>(0, BoundType::INFTY, 0, BoundType::INFTY);
+    EXPECT_EQ(naive = IntervalEvaluation::evaluate(p, map), IntervalEvaluation::evaluate(p, map, IntervalEvaluationStrategy::AFFINE));
+    EXPECT_EQ(naive, IntervalEvaluation::evaluate(p, map, IntervalEvaluationStrategy::MEAN_VALUE));
+}
@@ -13,6 +13,8 @@ CLANG_WARNING_DISABLE("-Wsign-compare")
 #include "gtest/gtest.h"
 CLANG_WARNING_RESET
 #include "carl/interval/Interval.h"
+#include "carl/interval/IntervalEvaluation.h"
+#include "carl/interval/MpqIntervalKernels.h"
 #include "carl/core/VariablePool.h"
 #include "carl/core/MultivariatePolynomial.h"
 #ifdef __WIN
@@ -1176,3 +1178,66 @@ TEST(MpqInterval, BloatShrink)
     i4.shrink_by(2);
     EXPECT_EQ(result4, i4);
 }
+
+TEST(MpqInterval, Kernels)
+{
+    std::vector<MpqInterval> intervals;
+    std::vector<mpq_class> bounds = { mpq_class(-3, 2), mpq_class(-1), mpq_class(0), mpq_class(2, 3), mpq_class(5, 2) };
+    std::vector<BoundType> types = { BoundType::WEAK, BoundType::STRICT };
+    for (std::size_t l = 0; l < bounds.size(); l++) {
+        for (std::size_t u = l; u < bounds.size(); u++) {
+            for (BoundType lt: types) {
+                for (BoundType ut: types) {
+                    intervals.emplace_back(bounds[l], lt, bounds[u], ut);
+                }
+            }
+        }
+        intervals.emplace_back(bounds[l], BoundType::WEAK, bounds[l], BoundType::INFTY);
+        intervals.emplace_back(bounds[l], BoundType::INFTY, bounds[l], BoundType::STRICT);
+    }
+    intervals.push_back(MpqInterval::unboundedInterval());
+    intervals.push_back(MpqInterval::emptyInterval());
+
+    MpqIntervalKernels kernels;
+    MpqInterval result;
+    for (const auto& a: intervals) {
+        for (const auto& b: intervals) {
+            kernels.add(a, b, result);
+            EXPECT_EQ(a.add(b), result) << a << " + " << b;
+            kernels.mul(a, b, result);
+            EXPECT_EQ(a.mul(b), result) << a << " * " << b;
+            result = a;
+            kernels.mul(result, b, result);
+            EXPECT_EQ(a.mul(b), result) << a << " * " << b;
+        }
+        for (carl::uint exp = 0; exp < 6; exp++) {
+            kernels.pow(a, exp, result);
+            EXPECT_EQ(a.pow(exp), result) << a << " ^ " << exp;
+        }
+    }
+
+    Variable x = freshRealVariable("x");
+    Variable y = freshRealVariable("y");
+    MultivariatePolynomial<mpq_class> p = MultivariatePolynomial<mpq_class>(x)*x*y - mpq_class(3, 2)*x + mpq_class(7)*y*y*y + mpq_class(1, 3);
+    for (const auto& a: intervals) {
+        if (a.isEmpty()) continue;
+        for (const auto& b: intervals) {
+            if (b.isEmpty()) continue;
+            std::map<Variable, MpqInterval> map = {{x, a}, {y, b}};
+            MpqInterval generic(0);
+            for (const auto& t: p) generic += IntervalEvaluation::evaluate(t, map);
+            kernels.evaluate(p, map, result);
+            EXPECT_EQ(generic, result) << p << " on " << a << ", " << b;
+            EXPECT_EQ(result, IntervalEvaluation::evaluate(p, map));
+        }
+    }
+
+    UnivariatePolynomial<mpq_class> q(x, {mpq_class(1, 3), mpq_class(-3, 2), mpq_class(0), mpq_class(2)});
+    for (const auto& a: intervals) {
+        if (a.isEmpty()) continue;
+        kernels.horner(q, a, result);
+        // 2x^3 - 3/2 x + 1/3 evaluated by Horner's scheme
+        MpqInterval expected = ((MpqInterval(mpq_class(2)).mul(a).mul(a) + MpqInterval(mpq_class(-3, 2))).mul(a)) + MpqInterval(mpq_class(1, 3));
+        EXPECT_EQ(expected, result) << a;
+    }
+}
@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "carl/numbers/numbers.h"
+#include "carl/core/Variable.h"
+#include "carl/util/parser/Parser.h"
+#include "carl/util/parser/RecursiveDescentParser.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+using Pol = MultivariatePolynomial<Rational>;
+
+TEST(RecursiveDescentParser, Polynomial)
+{
+	carl::parser::RecursiveDescentParser<Pol> parser;
+	carl::Variable x = freshRealVariable("x");
+	carl::Variable y = freshRealVariable("y");
+	parser.addVariable(x);
+	parser.addVariable(y);
+
+	EXPECT_EQ(Rational(1), parser.polynomial("1"));
+	EXPECT_EQ(Rational(2)*x, parser.polynomial("2*x"));
+	EXPECT_EQ(x, parser.polynomial("x"));
+	EXPECT_EQ(x*y, parser.polynomial("x*y"));
+	EXPECT_EQ(x*x, parser.polynomial("x*x"));
+	EXPECT_EQ(x*x, parser.polynomial("x^2"));
+	EXPECT_EQ(Rational(2)*x, parser.polynomial("2 x"));
+	EXPECT_EQ(-Pol(x), parser.polynomial("-x"));
+	EXPECT_EQ(Pol(x) - Rational(3), parser.polynomial("x - 3"));
+	EXPECT_EQ(Rational(3)/Rational(2)*x, parser.polynomial("1.5*x"));
+	EXPECT_EQ(Pol(Rational(1)/Rational(4)), parser.polynomial(".25"));
+	EXPECT_EQ(Rational(300)*y*y*y, parser.polynomial("3e2*y^3"));
+	EXPECT_EQ(Rational(2)*x*x - Rational(2)*y*y, parser.polynomial("2*(x+y)*(x-y)"));
+	EXPECT_EQ(Pol(Rational(-1)), parser.polynomial("(x+1)*(x-1) - x^2"));
+
+	Pol expected = Rational(2)*x*x + Rational(3)*x + Rational(4);
+	EXPECT_EQ(expected, parser.polynomial("2*x^2+3*x+4"));
+	EXPECT_EQ(expected, parser.polynomial("(2*x^2)+(3*x)+4"));
+	EXPECT_EQ(Rational(1)/Rational(4)*x - y, parser.polynomial("0.25 * x - y"));
+	EXPECT_EQ(Pol(Rational(1)/Rational(1000)), parser.polynomial("1e-3"));
+	EXPECT_EQ(Pol(x*x*y), parser.polynomial("x*y*x"));
+	EXPECT_EQ(Rational(-3)/Rational(7)*x*y + Rational(1)/Rational(2), parser.polynomial("(-3/7)*x*y+1/2"));
+
+	// Unknown variables are created.
+	Pol p = parser.polynomial("z^2 + x");
+	EXPECT_EQ(2, p.gatherVariables().size());
+
+	Pol res;
+	EXPECT_FALSE(parser.polynomial("x +", res));
+	EXPECT_FALSE(parser.polynomial("(x + y", res));
+	EXPECT_FALSE(parser.polynomial("x y", res));
+	EXPECT_FALSE(parser.polynomial("x^", res));
+}
+
+TEST(RecursiveDescentParser, RationalFunction)
+{
+	using RF = RationalFunction<Pol>;
+	carl::parser::RecursiveDescentParser<Pol> parser;
+	carl::Variable x = freshRealVariable("x");
+	parser.addVariable(x);
+
+	EXPECT_EQ(RF(Pol(Rational(2)*x)), parser.rationalFunction("2*x"));
+	EXPECT_EQ(RF(Pol(x*x)), parser.rationalFunction("x^2"));
+	EXPECT_EQ(RF(Pol(Rational(2)*x), Pol(x*x)), parser.rationalFunction("2*x / x^2"));
+	EXPECT_EQ(RF(Pol(x), Pol(x) + Rational(1)), parser.rationalFunction("x / (x + 1)"));
+	EXPECT_EQ(RF(Pol(x), Pol(Rational(2))), parser.rationalFunction("x / 2"));
+}
+
+TEST(RecursiveDescentParser, AgreesWithParser)
+{
+	carl::parser::Parser<Pol> reference;
+	carl::parser::RecursiveDescentParser<Pol> parser;
+	for (const char* name: {"a", "b", "c"}) {
+		carl::Variable v = freshRealVariable(name);
+		reference.addVariable(v);
+		parser.addVariable(v);
+	}
+
+	// Parser binds + and - tighter than *, and reads a / following a number as part of a fraction,
+	// hence sums of products are parenthesized and fractions are avoided.
+	for (const char* input: {
+		"1", "0", "-7", "a", "-a", "3*a", "2.5*a", "a*b*c", "a^3", "a^2*b^10",
+		"a+b", "a-b", "a+b-c", "a*b - b*a", "(2*a^2)+(3*a)+4", "(a*b)-(b*c)+(c*a)",
+		"a*(b+c)", "(a+b)*(a-b)", "(a+1)*(a+1)*(a-1)", "(0.5*a)-(1.25*b)",
+		"(12345678901234567890*c^2) - 98765432109876543210",
+	}) {
+		SCOPED_TRACE(input);
+		EXPECT_EQ(reference.polynomial(input), parser.polynomial(input));
+	}
+
+	for (const char* input: {
+		"a", "2*a", "a^2", "2*a / a^2", "a / (a + 1)", "(a+b) / (a-b)",
+		"(a*b) / (b*c)", "((a^2)-1) / (a+1)", "(a+b) / ((a^2)+(b^2)+1)",
+	}) {
+		SCOPED_TRACE(input);
+		EXPECT_EQ(reference.rationalFunction(input), parser.rationalFunction(input));
+	}
+}
+
+TEST(RecursiveDescentParser, Formula)
+{
+	using FT = Formula<Pol>;
+	carl::parser::RecursiveDescentParser<Pol> parser;
+	std::vector<carl::Variable> vars;
+	for (const char* name: {"O4853", "O3838", "O4848", "O4851", "O4849", "O4850", "O6262", "O6285", "O6217", "O8504", "O8665"}) {
+		vars.push_back(freshBooleanVariable(name));
+		parser.addVariable(vars.back());
+	}
+
+	std::string input = "(O4853 IMPLIES (O3838 AND ((((((((O4848) OR (O4851)) OR (O4849)) OR (O4850)) OR (O6262)) OR (O6285)) OR (O6217)) OR (O8504)) AND (NOT O8665)))";
+	FT result = parser.formula(input);
+	EXPECT_EQ(FT(IMPLIES, {FT(vars[0]), FT(AND, {FT(vars[1]), FT(OR, {FT(vars[2]), FT(vars[3]), FT(vars[4]), FT(vars[5]), FT(vars[6]), FT(vars[7]), FT(vars[8]), FT(vars[9])}), FT(NOT, FT(vars[10]))})}), result);
+
+	EXPECT_EQ(FT(XOR, {FT(vars[0]), FT(vars[1])}), parser.formula("(O4853 xor O3838)"));
+	EXPECT_EQ(FT(NOT, FT(vars[0])), parser.formula("(not O4853)"));
+	// Keywords are only recognized as whole words.
+	FT notVar = parser.formula("(NOTE)");
+	EXPECT_EQ(FormulaType::BOOL, notVar.getType());
+
+	FT res;
+	EXPECT_FALSE(parser.formula("(O4853 AND O3838", res));
+	EXPECT_FALSE(parser.formula("(O4853 AND)", res));
+}
@@ -0,0 +1,170 @@
+#include "gtest/gtest.h"
+
+#include "carl/util/ShardedCache.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace carl;
+
+namespace {
+	/// A cached value, whose hash can be changed by setting a new key and calling rehash().
+	struct Value {
+		static std::atomic<int> instances;
+		mutable int key;
+		mutable int next;
+		mutable std::size_t hash;
+		explicit Value(int k): key(k), next(k), hash(std::size_t(k)) {
+			++instances;
+		}
+		~Value() {
+			--instances;
+		}
+		std::size_t getHash() const {
+			return hash;
+		}
+		void rehash() const {
+			key = next;
+			hash = std::size_t(key);
+		}
+		bool operator==(const Value& v) const {
+			return key == v.key;
+		}
+	};
+	std::atomic<int> Value::instances(0);
+	std::ostream& operator<<(std::ostream& os, const Value& v) {
+		return os << v.key;
+	}
+}
+
+TEST(ShardedCache, Basic)
+{
+	{
+		ShardedCache<Value> cache(100, 0.2, 0.98, 4);
+		auto a = cache.cacheAndReg(new Value(1));
+		EXPECT_TRUE(a.second);
+		auto b = cache.cacheAndReg(new Value(2));
+		EXPECT_TRUE(b.second);
+		EXPECT_NE(a.first, b.first);
+		// The equal object is not cached again, hence it is up to the caller to delete it.
+		Value* duplicate = new Value(1);
+		auto c = cache.cacheAndReg(duplicate);
+		EXPECT_FALSE(c.second);
+		EXPECT_EQ(a.first, c.first);
+		delete duplicate;
+		EXPECT_EQ(1, cache.get(a.first).key);
+		EXPECT_EQ(2, cache.get(b.first).key);
+		EXPECT_EQ(2, cache.size());
+		EXPECT_GT(cache.memory(), 0);
+		cache.reg(a.first);
+		cache.dereg(a.first);
+		cache.dereg(a.first);
+		cache.dereg(a.first);
+		cache.strengthenActivity(b.first);
+		cache.decayActivity();
+		EXPECT_EQ(2, cache.size());
+	}
+	EXPECT_EQ(0, Value::instances);
+}
+
+TEST(ShardedCache, Clean)
+{
+	{
+		ShardedCache<Value> cache(8, 0.2, 0.98, 1);
+		std::vector<ShardedCache<Value>::Ref> used;
+		for (int i = 0; i < 4; i++) used.push_back(cache.cacheAndReg(new Value(i)).first);
+		for (int i = 4; i < 8; i++) cache.dereg(cache.cacheAndReg(new Value(i)).first);
+		EXPECT_EQ(8, cache.size());
+		// The shard is full, hence the unused entries are removed.
+		auto ref = cache.cacheAndReg(new Value(8)).first;
+		EXPECT_EQ(5, cache.size());
+		for (std::size_t i = 0; i < used.size(); i++) {
+			EXPECT_EQ(int(i), cache.get(used[i]).key);
+		}
+		EXPECT_EQ(8, cache.get(ref).key);
+		// The removed objects are freed as no other thread can access them.
+		EXPECT_EQ(5, Value::instances);
+		for (auto r: used) cache.dereg(r);
+		cache.dereg(ref);
+		// Shards that are not full are left as they are.
+		cache.clean();
+		EXPECT_EQ(5, cache.size());
+	}
+	EXPECT_EQ(0, Value::instances);
+}
+
+TEST(ShardedCache, Rehash)
+{
+	{
+		ShardedCache<Value> cache(100, 0.2, 0.98, 4);
+		auto a = cache.cacheAndReg(new Value(1)).first;
+		auto b = cache.cacheAndReg(new Value(2)).first;
+		auto c = cache.cacheAndReg(new Value(3)).first;
+		// The entry of a moves to another shard.
+		cache.get(a).next = 5;
+		cache.rehash(a);
+		EXPECT_EQ(5, cache.get(a).key);
+		EXPECT_EQ(3, cache.size());
+		// The entry of b becomes equal to the entry of c and is kept as a duplicate.
+		cache.get(b).next = 3;
+		cache.rehash(b);
+		EXPECT_EQ(2, cache.size());
+		EXPECT_EQ(3, cache.get(b).key);
+		// Equal objects are found in the entry of c from now on.
+		Value* v = new Value(3);
+		auto d = cache.cacheAndReg(v);
+		EXPECT_FALSE(d.second);
+		EXPECT_EQ(c, d.first);
+		delete v;
+		cache.dereg(c);
+		cache.dereg(c);
+		EXPECT_EQ(3, cache.get(b).key);
+		cache.dereg(b);
+		// The unused duplicate is removed.
+		cache.clean();
+		EXPECT_EQ(2, Value::instances);
+		cache.dereg(a);
+	}
+	EXPECT_EQ(0, Value::instances);
+}
+
+TEST(ShardedCache, Concurrent)
+{
+	{
+		ShardedCache<Value> cache(256, 0.2, 0.98, 16);
+		cache.startCleaner(std::chrono::milliseconds(1));
+		std::size_t threads = 8;
+		std::vector<std::thread> workers;
+		std::atomic<bool> failed(false);
+		for (std::size_t t = 0; t < threads; t++) {
+			workers.emplace_back([&cache, &failed, t](){
+				for (int round = 0; round < 200; round++) {
+					std::vector<ShardedCache<Value>::Ref> refs;
+					for (int i = 0; i < 64; i++) {
+						// Threads share half of the values.
+						int key = (i % 2 == 0) ? i : int(t) * 1000 + round * 64 + i;
+						Value* v = new Value(key);
+						auto ret = cache.cacheAndReg(v);
+						if (!ret.second) delete v;
+						refs.push_back(ret.first);
+						cache.reg(ret.first);
+						cache.strengthenActivity(ret.first);
+					}
+					for (std::size_t i = 0; i < refs.size(); i++) {
+						int expected = (i % 2 == 0) ? int(i) : int(t) * 1000 + round * 64 + int(i);
+						if (cache.get(refs[i]).key != expected) failed = true;
+						cache.dereg(refs[i]);
+					}
+					for (auto r: refs) cache.dereg(r);
+				}
+			});
+		}
+		for (auto& w: workers) w.join();
+		cache.stopCleaner();
+		EXPECT_FALSE(failed);
+		cache.clean();
+		EXPECT_LE(cache.size(), 256);
+	}
+	EXPECT_EQ(0, Value::instances);
+}